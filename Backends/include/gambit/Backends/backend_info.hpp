@@ -56,9 +56,15 @@
 namespace Gambit
 {
 
+  // Forward declarations
+  class functor;
+
   namespace Backends
   {
 
+    // Forward declarations
+    class backend_instance_ptr;
+
     /// Structure providing some basic info on backend libraries
     struct backend_info
     {
@@ -155,6 +161,29 @@ namespace Gambit
         /// C/C++/Fortran backends that have been successfully loaded (Key: name+version)
         std::map<str, void*> loaded_C_CXX_Fortran_backends;
 
+        /// A backend functor wrapping a symbol in a C/C++/Fortran library
+        struct functor_symbol
+        {
+          functor* f;
+          str name;
+          bool is_variable;
+        };
+
+        /// Backend functors wrapping symbols in C/C++/Fortran libraries (Key: name+version)
+        std::map<str, std::vector<functor_symbol> > functor_symbols;
+
+        /// Pointers to symbols in C/C++/Fortran libraries used by initialisation and convenience functions (Key: name+version)
+        std::map<str, std::vector<std::pair<str, backend_instance_ptr*> > > instance_ptrs;
+
+        /// Handles of all copies of C/C++/Fortran backends loaded with loadInstances, first copy first (Key: name+version)
+        std::map<str, std::vector<void*> > loaded_instances;
+
+        /// Load extra copies of a C/C++/Fortran backend library into separate link namespaces, one for each thread.
+        void loadInstances(const str&, const str&, int);
+
+        /// Number of copies of a backend library that have been loaded (one unless more were loaded with loadInstances)
+        std::size_t ninstances(const str&, const str&) const;
+
         #ifdef HAVE_MATHEMATICA
           /// Python backends that have been successfully loaded (Key: name+version)
           std::map<str, WSLINK> loaded_mathematica_backends;
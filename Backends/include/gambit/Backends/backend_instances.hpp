@@ -0,0 +1,161 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Selection of the copy of a C, C++ or Fortran
+///  backend library used by the calling thread,
+///  when several copies have been loaded (see
+///  backend_info::loadInstances).
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __backend_instances_hpp__
+#define __backend_instances_hpp__
+
+#include <vector>
+#include <algorithm>
+#include <sstream>
+
+#include "gambit/Utils/util_types.hpp"
+#include "gambit/Utils/thread_slots.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+
+/// Most copies of a backend library that can be loaded (glibc allows 16 link namespaces in total).
+#define GAMBIT_MAX_BACKEND_INSTANCES 16
+
+namespace Gambit
+{
+
+  namespace Backends
+  {
+
+    /// Copy of the backend libraries that the calling thread is bound to, or -1 if it is not bound to any.
+    inline int& bound_backend_instance()
+    {
+      static thread_local int instance = -1;
+      return instance;
+    }
+
+    /// Binds the calling thread to one copy of the backend libraries for the lifetime of the object, e.g.
+    /// while the initialisation function of a backend runs for that copy.
+    class backend_instance_binding
+    {
+      public:
+        backend_instance_binding(int instance) : previous(bound_backend_instance()) { bound_backend_instance() = instance; }
+        ~backend_instance_binding() { bound_backend_instance() = previous; }
+      private:
+        int previous;
+    };
+
+    /// A variable with a separate value for each copy of the backend libraries, for the static state of backend
+    /// initialisation functions (e.g. whether scan-level initialisation has been done for a copy yet).  Resolves
+    /// to the value of the copy the calling thread is bound to, or of the first copy if it is not bound to any.
+    template <typename TYPE>
+    class per_instance
+    {
+      public:
+        explicit per_instance(const TYPE& initial) { std::fill_n(values, GAMBIT_MAX_BACKEND_INSTANCES, initial); }
+        TYPE& get() { return values[std::max(bound_backend_instance(), 0)]; }
+        operator TYPE&() { return get(); }
+        per_instance& operator=(const TYPE& value) { get() = value; return *this; }
+      private:
+        TYPE values[GAMBIT_MAX_BACKEND_INSTANCES];
+    };
+
+    /// Index of the copy of a backend library to be used by the calling thread, out of ninstances loaded
+    /// copies: the copy the thread is bound to if there is one, otherwise its thread slot (Utils::thread_slot).
+    inline std::size_t backend_instance_index(std::size_t ninstances, const str& what)
+    {
+      const int bound = bound_backend_instance();
+      const std::size_t index = (bound < 0 ? Utils::thread_slot() : bound);
+      if (index >= ninstances)
+      {
+        std::ostringstream ss;
+        ss << "Thread slot " << index << " has tried to use " << what << "," << std::endl
+           << "but only " << ninstances << " copies of that backend have been loaded. Please increase" << std::endl
+           << "the number given for it under backend_instances in your yaml file to at least " << index+1 << ".";
+        utils_error().raise(LOCAL_INFO,ss.str());
+      }
+      return index;
+    }
+
+    /// Base class for pointers to symbols in C, C++ and Fortran backend libraries that resolve to the copy of the
+    /// library used by the calling thread.
+    class backend_instance_ptr
+    {
+      public:
+        virtual ~backend_instance_ptr() {}
+        /// Set the address of the symbol in each loaded copy of the library, first copy first
+        virtual void set_instances(const std::vector<void*>&) = 0;
+    };
+
+    /// Pointer to a function in a C, C++ or Fortran backend library, as used in backend initialisation and
+    /// convenience functions.  It can be called like the function pointer it converts to.
+    template <typename PTR>
+    class backend_function_ptr : public backend_instance_ptr
+    {
+      public:
+        backend_function_ptr(PTR ptr, const char* symbol) : first(ptr), name(symbol) {}
+
+        void set_instances(const std::vector<void*>& addresses)
+        {
+          // Go via a union to avoid warnings about casting between object and function pointers.
+          union { void* ptr; PTR fptr; } address;
+          copies.clear();
+          for (void* ptr : addresses)
+          {
+            address.ptr = ptr;
+            copies.push_back(address.fptr);
+          }
+        }
+
+        /// The function in the copy of the library used by the calling thread
+        operator PTR() const { return copies.empty() ? first : copies[backend_instance_index(copies.size(), name)]; }
+
+      private:
+        PTR first;
+        const char* name;
+        std::vector<PTR> copies;
+    };
+
+    /// Pointer to a variable in a C, C++ or Fortran backend library, as used in backend initialisation and
+    /// convenience functions.  It can be used like the TYPE* it converts to.
+    template <typename TYPE>
+    class backend_variable_ptr : public backend_instance_ptr
+    {
+      public:
+        backend_variable_ptr(TYPE* ptr, const char* symbol) : first(ptr), name(symbol) {}
+
+        void set_instances(const std::vector<void*>& addresses)
+        {
+          copies.clear();
+          for (void* ptr : addresses) copies.push_back(static_cast<TYPE*>(ptr));
+        }
+
+        /// The variable in the copy of the library used by the calling thread
+        /// @{
+        TYPE* get() const { return copies.empty() ? first : copies[backend_instance_index(copies.size(), name)]; }
+        operator TYPE*() const { return get(); }
+        TYPE& operator*() const { return *get(); }
+        TYPE* operator->() const { return get(); }
+        /// @}
+
+      private:
+        TYPE* first;
+        const char* name;
+        std::vector<TYPE*> copies;
+    };
+
+  }
+
+}
+
+#endif //#defined __backend_instances_hpp__
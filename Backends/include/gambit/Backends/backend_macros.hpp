@@ -52,6 +52,7 @@
 #include "gambit/Elements/functor_definitions.hpp"
 #include "gambit/Logs/logger.hpp"
 #include "gambit/Backends/ini_functions.hpp"
+#include "gambit/Backends/backend_instances.hpp"
 #include "gambit/Backends/common_macros.hpp"
 #include "gambit/Backends/interoperability.hpp"
 #ifndef STANDALONE
@@ -341,8 +342,9 @@ namespace Gambit                                                              \
     {                                                                         \
                                                                               \
       /* Set the variable pointer and the getptr function. */                 \
-      extern TYPE* const NAME =                                               \
-       load_backend_symbol<TYPE*>(SYMBOLNAME,                                 \
+      extern backend_variable_ptr<TYPE> NAME(load_backend_symbol<TYPE*>(      \
+       SYMBOLNAME, STRINGIFY(BACKENDNAME), STRINGIFY(VERSION)), SYMBOLNAME);  \
+      int CAT(iptr_,NAME) = register_backend_instance_ptr(NAME, SYMBOLNAME,   \
        STRINGIFY(BACKENDNAME), STRINGIFY(VERSION));                           \
       TYPE* CAT(getptr,NAME)() { return NAME; }                               \
                                                                               \
@@ -377,7 +379,7 @@ namespace Gambit                                                              \
                                                                               \
       /* Disable the functor if the library is missing or symbol not found. */\
       int CAT(vstatus_,NAME) = set_backend_functor_status(Functown::NAME,     \
-       SYMBOLNAME);                                                           \
+       SYMBOLNAME, true);                                                     \
                                                                               \
     } /* end namespace BACKENDNAME_SAFE_VERSION */                            \
   } /* end namespace Backends */                                              \
@@ -448,8 +450,11 @@ namespace Gambit
       /* Define a type NAME_type to be a suitable function pointer. */                          \
       typedef TYPE (*NAME##_type) CONVERT_VARIADIC_ARG(ARGLIST);                                \
                                                                                                 \
-      extern const NAME##_type NAME = load_backend_symbol<NAME##_type>(SYMBOLNAME,              \
-      STRINGIFY(BACKENDNAME), STRINGIFY(VERSION));                                              \
+      /* Get the pointer to the function, in all copies of the library if more are loaded. */   \
+      extern backend_function_ptr<NAME##_type> NAME(load_backend_symbol<NAME##_type>(           \
+       SYMBOLNAME, STRINGIFY(BACKENDNAME), STRINGIFY(VERSION)), SYMBOLNAME);                    \
+      int CAT(iptr_,NAME) = register_backend_instance_ptr(NAME, SYMBOLNAME,                     \
+       STRINGIFY(BACKENDNAME), STRINGIFY(VERSION));                                             \
                                                                                                 \
     }                                                                                           \
   }                                                                                             \
@@ -570,4 +575,25 @@ namespace Gambit
   }                                                                                             \
 }                                                                                               \
 
+/// \name Memoisation macro for backend functions
+/// BE_MEMOISE(NAME, MAX_ENTRIES) caches up to MAX_ENTRIES results of the backend function or convenience
+/// function NAME, keyed on the exact values of its arguments.  The results are only kept in the scratch
+/// directory for reuse in later runs if the persistent store is switched on in the YAML file (see
+/// BackendCallCache::set_persistence).  Only for pure functions whose arguments are all inputs; this is
+/// checked at compile time as far as possible.  Functions whose results also depend on state set by earlier
+/// calls to the backend, or on callbacks, must not be memoised: e.g. DarkSUSY's dsrdtab integrates the rate
+/// passed in as a function pointer over the model held in DarkSUSY's COMMON blocks, and nulike's nubounds
+/// calls back into the neutrino yield function, so equal arguments do not imply equal results.
+#define BE_MEMOISE(NAME, MAX_ENTRIES)                                                           \
+namespace Gambit                                                                                \
+{                                                                                               \
+  namespace Backends                                                                            \
+  {                                                                                             \
+    namespace CAT_3(BACKENDNAME,_,SAFE_VERSION)                                                 \
+    {                                                                                           \
+      int CAT(fmemo_,NAME) = set_backend_memoisation(Functown::NAME, MAX_ENTRIES);              \
+    }                                                                                           \
+  }                                                                                             \
+}                                                                                               \
+
 #endif // __BACKEND_MACROS_HPP__
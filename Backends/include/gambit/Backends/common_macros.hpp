@@ -20,6 +20,7 @@
 
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Elements/types_rollcall.hpp"
+#include "gambit/Backends/backend_instances.hpp"
 
 #include <boost/preprocessor/control/iif.hpp>
 #include <boost/preprocessor/seq/transform.hpp>
@@ -37,7 +38,9 @@
 /// Intermediate macro for expanding BE_ALLOW_MODELS.
 #define BE_ALLOW_MODEL_INTERMEDIATE(r,data,MODEL) BE_ALLOW_MODEL(MODEL)
 
-/// Boilerplate code for point-level backend initialisation function definitions
+/// Boilerplate code for point-level backend initialisation function definitions.  The body is run once for
+/// each loaded copy of the backend library, with the thread bound to that copy; static variables in it that
+/// must be kept separately for each copy should be declared as Backends::per_instance.
 #define BE_INI_FUNCTION                                                     \
 namespace Gambit                                                            \
 {                                                                           \
@@ -51,10 +54,22 @@ namespace Gambit                                                            \
          path_dir(STRINGIFY(BACKENDNAME), STRINGIFY(VERSION));              \
       }                                                                     \
     }                                                                       \
+    void CAT_4(BACKENDNAME,_,SAFE_VERSION,_init_instance)();                \
     void CAT_4(BACKENDNAME,_,SAFE_VERSION,_init)()                          \
+    {                                                                       \
+      const std::size_t n = Backends::backendInfo().                        \
+       ninstances(STRINGIFY(BACKENDNAME), STRINGIFY(VERSION));              \
+      for (std::size_t i = 0; i < n; ++i)                                   \
+      {                                                                     \
+        Backends::backend_instance_binding binding(i);                      \
+        CAT_4(BACKENDNAME,_,SAFE_VERSION,_init_instance)();                 \
+      }                                                                     \
+    }                                                                       \
+    void CAT_4(BACKENDNAME,_,SAFE_VERSION,_init_instance)()                 \
     {                                                                       \
       using namespace Pipes :: CAT_4(BACKENDNAME,_,SAFE_VERSION,_init) ;    \
       using namespace Backends :: CAT_3(BACKENDNAME,_,SAFE_VERSION) ;       \
+      using Backends::per_instance;                                         \
 
 /// Boilerplate code for convenience function definitions
 #define BE_NAMESPACE                                                        \
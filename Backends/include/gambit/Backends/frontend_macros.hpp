@@ -94,7 +94,7 @@ namespace Gambit                                                              \
       /* Choose the type to define the variable pointer */                    \
       typedef MATH_TYPE(TYPE) NAME##_type;                                    \
       /* Set the variable pointer and the getptr function. */                 \
-      extern NAME##_type* const NAME;                                         \
+      extern BE_VARIABLE_PTR_TYPE(TYPE) NAME;                                 \
     }                                                                         \
   }                                                                           \
                                                                               \
@@ -134,7 +134,7 @@ namespace Gambit
       /* Define a type NAME_type to be a suitable function pointer. */                          \
       typedef TYPE (*NAME##_type) CONVERT_VARIADIC_ARG(ARGLIST);                                \
       /* Get the pointer to the function in the shared library. */                              \
-      extern const NAME##_type NAME;                                                            \
+      extern BE_FUNCTION_PTR_TYPE(NAME##_type) NAME;                                            \
     }                                                                                           \
   }                                                                                             \
                                                                                                 \
@@ -162,4 +162,7 @@ namespace Gambit
   MAKE_INUSE_POINTER(NAME)                                                                      \
 }                                                                                               \
 
+/// Memoisation of backend functions is set up in the main executable only.
+#define BE_MEMOISE(NAME, MAX_ENTRIES)
+
 #endif // __FRONTEND_MACROS_HPP__
@@ -94,5 +94,13 @@ BE_CONV_FUNCTION(A_BXstautau_highq2_CONV, double, (const parameters*), "A_BXstau
 BE_CONV_FUNCTION(SI_AI_BKstarmumu_CONV, double, (const parameters*), "SI_AI_BKstarmumu_CONV", (MSSM63atQ, MSSM63atMGUT, WC))
 BE_CONV_FUNCTION(SI_AI_BKstarmumu_zero_CONV, double, (const parameters*), "SI_AI_BKstarmumu_zero_CONV", (MSSM63atQ, MSSM63atMGUT, WC))
 
+// Memoise the most expensive convenience functions
+BE_MEMOISE(BKstarmumu_CONV, 1000)
+BE_MEMOISE(RKstar_CONV, 1000)
+BE_MEMOISE(RK_CONV, 1000)
+BE_MEMOISE(bsgamma_CONV, 1000)
+BE_MEMOISE(Bsll_untag_CONV, 1000)
+BE_MEMOISE(Bll_CONV, 1000)
+
 // Undefine macros to avoid conflict with other backends
 #include "gambit/Backends/backend_undefs.hpp"
@@ -55,7 +55,7 @@ namespace Gambit
   int register_type(str bever, str classname);
 
   /// Disable a backend functor if its library is missing or the symbol cannot be found.
-  int set_backend_functor_status(functor&, const str&);
+  int set_backend_functor_status(functor&, const str&, bool is_variable = false);
 
   /// Disable a backend initialisation function if the backend is missing.
   int set_BackendIniBit_functor_status(functor&, str, str);
@@ -75,6 +75,13 @@ namespace Gambit
   namespace Backends
   {
 
+    // Forward declarations
+    class backend_instance_ptr;
+
+    /// Register a pointer to a symbol in a C, C++ or Fortran backend library, so that it can be pointed at each
+    /// copy of the library if more copies are loaded.
+    int register_backend_instance_ptr(backend_instance_ptr&, const str&, const str&, const str&);
+
     /// Simplify pointers to void functions
     typedef void(*voidFptr)();
 
@@ -123,6 +130,18 @@ namespace Gambit
       return result;
     }
 
+    /// Switch on memoisation of the results of a backend function.
+    template <typename F>
+    int set_backend_memoisation(F& be_functor, std::size_t max_entries)
+    {
+      try
+      {
+        be_functor.setMemoisation(max_entries);
+      }
+      catch (std::exception& e) { ini_catch(e); }
+      return 0;
+    }
+
     /// Provide the factory pointer to a BOSSed type's wrapper constructor.
     template <typename T>
     T handover_factory_pointer(str be, str ver, str name, str barename,
@@ -74,6 +74,20 @@
                   USING_PYTHON, python_variable<TYPE>,                                          \
                   /*USING NONE OF THE ABOVE*/ TYPE)
 
+/// Macros to choose the types of the pointers to backend functions (with pointer type PTR) and variables (of
+/// type TYPE) seen by initialisation and convenience functions; C, C++ and Fortran backends use pointers that
+/// resolve to the copy of the library used by the calling thread (see backend_instances.hpp).
+/// @{
+#define BE_FUNCTION_PTR_TYPE(PTR)                                                               \
+        IF_ELSEIF(USING_MATHEMATICA, const PTR,                                                 \
+                  USING_PYTHON, const PTR,                                                      \
+                  /*USING NONE OF THE ABOVE*/ Gambit::Backends::backend_function_ptr<PTR>)
+#define BE_VARIABLE_PTR_TYPE(TYPE)                                                              \
+        IF_ELSEIF(USING_MATHEMATICA, mathematica_variable<TYPE>* const,                         \
+                  USING_PYTHON, python_variable<TYPE>* const,                                   \
+                  /*USING NONE OF THE ABOVE*/ Gambit::Backends::backend_variable_ptr<TYPE>)
+/// @}
+
 /// Macro that determines whether the language of the backend is C
 #define USING_CC IF_ELSE_TOKEN_DEFINED(BACKENDLANG,                                             \
         BOOST_PP_EQUAL(CAT(BACKENDLANG,_LANG), CC_LANG), 0)
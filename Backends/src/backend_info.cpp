@@ -14,12 +14,18 @@
 ///  \date 2014 Dec
 ///  \date 2017 Dec
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include <dlfcn.h>
 
 #include "gambit/cmake/cmake_variables.hpp"
 #include "gambit/Backends/backend_info.hpp"
+#include "gambit/Backends/backend_instances.hpp"
+#include "gambit/Elements/functors.hpp"
 #include "gambit/Logs/logger.hpp"
 
 #ifdef HAVE_MATHEMATICA
@@ -425,6 +431,104 @@ namespace Gambit
   }
 
 
+  /// Load extra copies of a C/C++/Fortran backend library into separate link namespaces, so that each
+  /// thread can call the backend through its own copy, with its own global variables and COMMON blocks.
+  /// The thread in slot i (see Utils::thread_slot) uses copy i; the first copy is the one loaded at startup.
+  /// If ninstances < 1, one copy is loaded for each thread of the main OpenMP team.  The initialisation
+  /// function of the backend is run once for each copy (see BE_INI_FUNCTION).
+  void Backends::backend_info::loadInstances(const str& be, const str& ver, int ninstances)
+  {
+    const str key = be+ver;
+    const str path = corrected_path(be,ver);
+    if (ninstances < 1) ninstances = Utils::main_team_thread_slots();
+    if (ninstances > GAMBIT_MAX_BACKEND_INSTANCES)
+    {
+      std::ostringstream err;
+      err << "Cannot load " << ninstances << " copies of backend " << be << " v" << ver << "." << endl
+          << "At most " << GAMBIT_MAX_BACKEND_INSTANCES << " copies of a backend can be loaded.";
+      backend_error().raise(LOCAL_INFO,err.str());
+    }
+
+    auto it = works.find(key);
+    if (it == works.end() or not it->second)
+    {
+      std::ostringstream err;
+      err << "Cannot load " << ninstances << " copies of backend " << be << " v" << ver << "," << endl
+          << "as that backend is not present or could not be loaded.";
+      backend_warning().raise(LOCAL_INFO,err.str());
+      return;
+    }
+    if (needsMathematica.at(key) or needsPython.at(key) or classloader.at(key))
+    {
+      std::ostringstream err;
+      err << "Cannot load several copies of backend " << be << " v" << ver << "." << endl
+          << "This is only possible for C, C++ and Fortran backends without BOSSed classes.";
+      backend_error().raise(LOCAL_INFO,err.str());
+    }
+
+    #ifdef HAVE_LINK_H
+      std::vector<void*>& handles = loaded_instances[key];
+      if (handles.empty()) handles.push_back(loaded_C_CXX_Fortran_backends.at(key));
+      while (handles.size() < std::size_t(ninstances))
+      {
+        // Each copy goes into a new link namespace, so that it gets its own copy of all the
+        // libraries it depends on too.  Note that glibc only allows 16 namespaces in total.
+        void* pHandle = dlmopen(LM_ID_NEWLM, path.c_str(), RTLD_LAZY | RTLD_LOCAL);
+        if (not pHandle)
+        {
+          std::ostringstream err;
+          err << "Failed loading copy " << handles.size()+1 << " of library " << path << " due to: " << endl << dlerror();
+          backend_error().raise(LOCAL_INFO,err.str());
+        }
+        handles.push_back(pHandle);
+      }
+
+      // Addresses of a symbol in all copies
+      auto addresses = [&](const str& name)
+      {
+        std::vector<void*> result;
+        for (void* pHandle : handles)
+        {
+          void* address = dlsym(pHandle, name.c_str());
+          if (address == NULL)
+          {
+            std::ostringstream err;
+            err << "Symbol " << name << " not found in copy " << result.size()+1 << " of library " << path << ".";
+            backend_error().raise(LOCAL_INFO,err.str());
+          }
+          result.push_back(address);
+        }
+        return result;
+      };
+
+      // Hand the addresses of each function and variable in all copies over to the corresponding functors,
+      // and to the pointers used by the initialisation and convenience functions.
+      for (const functor_symbol& symbol : functor_symbols[key])
+      {
+        symbol.f->setBackendInstances(addresses(symbol.name), symbol.is_variable);
+      }
+      for (const auto& symbol : instance_ptrs[key])
+      {
+        symbol.second->set_instances(addresses(symbol.first));
+      }
+      logger() << "Loaded " << handles.size() << " copies of " << path << LogTags::backends << LogTags::info << EOM;
+    #else
+      std::ostringstream err;
+      err << "Cannot load several copies of backend " << be << " v" << ver << "," << endl
+          << "as this system does not support dlmopen.";
+      backend_error().raise(LOCAL_INFO,err.str());
+    #endif
+  }
+
+
+  /// Number of copies of a backend library that have been loaded
+  std::size_t Backends::backend_info::ninstances(const str& be, const str& ver) const
+  {
+    auto it = loaded_instances.find(be+ver);
+    return (it == loaded_instances.end() or it->second.empty()) ? 1 : it->second.size();
+  }
+
+
   #ifdef HAVE_MATHEMATICA
 
     /// Load WSTP for Mathematica backends
@@ -58,14 +58,14 @@ BE_INI_FUNCTION
 {
 
   // Halo model parameters and pointers to their entries in the Params map.
-  static double rho0_eff = 0.4, vrot = 235, v0 = 235, vesc = 550;
+  static per_instance<double> rho0_eff(0.4), vrot(235), v0(235), vesc(550);
   static safe_ptr<LocalMaxwellianHalo> LocalHaloParameters_ptr;
 
   // Fraction of DM
   double fraction = *Dep::RD_fraction;
 
   // Scan-level initialization -----------------------------
-  static bool scan_level = true;
+  static per_instance<bool> scan_level(true);
   if (scan_level)
   {
     // Initialize halo and WIMP models
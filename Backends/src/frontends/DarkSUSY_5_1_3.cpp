@@ -59,7 +59,7 @@ END_BE_NAMESPACE
 BE_INI_FUNCTION
 {
   // Initialize DarkSUSY if run for the first time
-  bool static scan_level = true;
+  static per_instance<bool> scan_level(true);
 
   if (scan_level)
   {
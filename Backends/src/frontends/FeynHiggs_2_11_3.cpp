@@ -31,7 +31,7 @@ BE_INI_FUNCTION
   int error = 1;
 
   // Scan-level initialisation
-  static bool scan_level = true;
+  static per_instance<bool> scan_level(true);
   if(scan_level)
   {
     // initialize FeynHiggs flags
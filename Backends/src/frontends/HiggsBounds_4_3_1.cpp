@@ -28,7 +28,7 @@ BE_INI_FUNCTION
 {
 
   // Scan-level initialisation
-  static bool scan_level = true;
+  static per_instance<bool> scan_level(true);
   if(scan_level)
   {
     int nHneut = 3; // number of neutral higgses
@@ -24,7 +24,7 @@
 BE_INI_FUNCTION
 {
 
-  static bool scan_level = true;
+  static per_instance<bool> scan_level(true);
   if(scan_level)
   {
     int nHneut = 3; // number of neutral higgses
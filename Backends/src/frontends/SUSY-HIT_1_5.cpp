@@ -369,7 +369,7 @@ BE_INI_FUNCTION
   // If the user provides a file list, just read in SLHA files for debugging and ignore the MSSM_spectrum dependency.
   if (runOptions->hasKey("debug_SLHA_filenames"))
   {
-    static unsigned int counter = 0;
+    static per_instance<unsigned int> counter(0);
     std::vector<str> filenames = runOptions->getValue<std::vector<str> >("debug_SLHA_filenames");
     logger() << "Reading SLHA file: " << filenames[counter] << EOM;
     std::ifstream ifs(filenames[counter]);
@@ -26,7 +26,7 @@ BE_INI_FUNCTION
 {
 
   // Scan-level initialisation
-  static bool scan_level = true;
+  static per_instance<bool> scan_level(true);
   if (scan_level)
   {
 
@@ -156,9 +156,10 @@ namespace Gambit
   }
 
   /// Disable a C, C++ or Fortran backend functor if its library is missing or the symbol cannot be found.
-  void set_backend_functor_status_C_CXX_Fortran(functor& be_functor, const str& symbol_name)
+  void set_backend_functor_status_C_CXX_Fortran(functor& be_functor, const str& symbol_name, bool is_variable)
   {
-    bool present = Backends::backendInfo().works.at(be_functor.origin() + be_functor.version());
+    const str be = be_functor.origin() + be_functor.version();
+    bool present = Backends::backendInfo().works.at(be);
     if (not present)
     {
       be_functor.setStatus(-1);
@@ -171,6 +172,11 @@ namespace Gambit
       backend_warning().raise(LOCAL_INFO, err.str());
       be_functor.setStatus(-2);
     }
+    else if(symbol_name != "no_symbol")
+    {
+      // Remember the symbol, in case more copies of the library are loaded later.
+      Backends::backendInfo().functor_symbols[be].push_back({&be_functor, symbol_name, is_variable});
+    }
   }
 
   #ifdef HAVE_MATHEMATICA
@@ -255,7 +261,7 @@ namespace Gambit
 
 
   /// Disable a backend functor if its library is missing or the symbol cannot be found.
-  int set_backend_functor_status(functor& be_functor, const str& symbol_name)
+  int set_backend_functor_status(functor& be_functor, const str& symbol_name, bool is_variable)
   {
     // Extract the backend that we're dealing with from the functor metadata.
     str be = be_functor.origin() + be_functor.version();
@@ -291,7 +297,7 @@ namespace Gambit
       }
       else
       {
-        set_backend_functor_status_C_CXX_Fortran(be_functor, symbol_name);
+        set_backend_functor_status_C_CXX_Fortran(be_functor, symbol_name, is_variable);
       }
 
     }
@@ -300,6 +306,22 @@ namespace Gambit
   }
 
 
+  /// Register a pointer to a symbol in a C, C++ or Fortran backend library, if the symbol is present.
+  int Backends::register_backend_instance_ptr(backend_instance_ptr& ptr, const str& symbol_name, const str& be, const str& ver)
+  {
+    try
+    {
+      if (backendInfo().works.at(be+ver))
+      {
+        void* pHandle = backendInfo().loaded_C_CXX_Fortran_backends.at(be+ver);
+        if (dlsym(pHandle, symbol_name.c_str()) != NULL) backendInfo().instance_ptrs[be+ver].push_back({symbol_name, &ptr});
+      }
+    }
+    catch (std::exception& e) { ini_catch(e); }
+    return 0;
+  }
+
+
   /// Disable a backend initialisation function if the backend is missing.
   int set_BackendIniBit_functor_status(functor& ini_functor, str be, str v)
   {
@@ -0,0 +1,171 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Unit tests of calling separate copies of a
+///  backend library from different threads
+///  (backend_function_ptr, backend_variable_ptr,
+///  backend_instance_binding and per_instance),
+///  using two copies of the example library
+///  LibFirst.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <iostream>
+#include <dlfcn.h>
+#include <omp.h>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Backends/backend_instances.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/cmake/cmake_variables.hpp"
+
+#ifdef HAVE_LINK_H
+  #include <link.h>
+#endif
+
+using namespace Gambit;
+using namespace Gambit::Backends;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  typedef void(*initialize_type)(int);
+  typedef void(*someFunction_type)();
+
+  /// Address of a symbol in a copy of the library
+  void* symbol(void* handle, const char* name)
+  {
+    void* address = dlsym(handle, name);
+    if (address == NULL) std::cout << "Symbol " << name << " not found: " << dlerror() << std::endl;
+    return address;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  logger().disable();
+  const str path = (argc > 1 ? argv[1] : "Backends/examples/libfirst.so");
+
+  #ifdef HAVE_LINK_H
+
+    // Load two copies of LibFirst, each in its own link namespace, as backend_info::loadInstances does
+    std::vector<void*> handles;
+    for (int i = 0; i < 2; ++i)
+    {
+      void* handle = (i == 0 ? dlopen(path.c_str(), RTLD_LAZY | RTLD_LOCAL) : dlmopen(LM_ID_NEWLM, path.c_str(), RTLD_LAZY | RTLD_LOCAL));
+      if (handle == NULL)
+      {
+        std::cout << "Could not load " << path << ": " << dlerror() << std::endl;
+        return 1;
+      }
+      handles.push_back(handle);
+    }
+    auto addresses = [&](const char* name) { return std::vector<void*>{symbol(handles[0], name), symbol(handles[1], name)}; };
+
+    // Pointers to the functions and variables, as used by initialisation and convenience functions
+    union { void* ptr; initialize_type fptr; } first_initialize;
+    union { void* ptr; someFunction_type fptr; } first_someFunction;
+    first_initialize.ptr = symbol(handles[0], "_Z10initializei");
+    first_someFunction.ptr = symbol(handles[0], "_Z12someFunctionv");
+    backend_function_ptr<initialize_type> initialize(first_initialize.fptr, "_Z10initializei");
+    backend_function_ptr<someFunction_type> someFunction(first_someFunction.fptr, "_Z12someFunctionv");
+    backend_variable_ptr<int> SomeInt(static_cast<int*>(symbol(handles[0], "someInt")), "someInt");
+    backend_variable_ptr<double> SomeDouble(static_cast<double*>(symbol(handles[0], "someDouble")), "someDouble");
+
+    std::cout << "Single copy:" << std::endl;
+    initialize(1);
+    check(*SomeInt == 1, "without extra copies, all threads use the first copy");
+
+    initialize.set_instances(addresses("_Z10initializei"));
+    someFunction.set_instances(addresses("_Z12someFunctionv"));
+    SomeInt.set_instances(addresses("someInt"));
+    SomeDouble.set_instances(addresses("someDouble"));
+    check(symbol(handles[0], "someInt") != symbol(handles[1], "someInt"), "each copy has its own global variables");
+
+    std::cout << "Binding (as in BE_INI_FUNCTION):" << std::endl;
+    for (int i = 0; i < 2; ++i)
+    {
+      backend_instance_binding binding(i);
+      initialize(10*(i+1));
+    }
+    {
+      backend_instance_binding binding(1);
+      check(*SomeInt == 20, "a bound thread uses its copy");
+    }
+    check(*SomeInt == 10, "the binding is released at the end of its scope");
+
+    std::cout << "Per-copy state of initialisation functions:" << std::endl;
+    per_instance<bool> scan_level(true);
+    for (int i = 0; i < 2; ++i)
+    {
+      backend_instance_binding binding(i);
+      if (i == 0) scan_level = false;
+    }
+    {
+      backend_instance_binding binding(1);
+      check(scan_level, "each copy keeps its own value");
+    }
+    check(not scan_level, "an unbound thread sees the value of the first copy");
+
+    std::cout << "Threads:" << std::endl;
+    int nthreads = 0;
+    int seen[2] = {0, 0};
+    double result[2] = {0., 0.};
+    #pragma omp parallel num_threads(2)
+    {
+      const int slot = Utils::thread_slot();
+      #pragma omp single
+      nthreads = omp_get_num_threads();
+      if (slot < 2)
+      {
+        // Set different state in each copy at the same time, then check that neither was overwritten
+        for (int n = 0; n < 20; ++n)
+        {
+          initialize(100*(slot+1) + n);
+          someFunction();
+          seen[slot] = *SomeInt;
+          result[slot] = *SomeDouble;
+          if (seen[slot] != 100*(slot+1) + n) break;
+        }
+      }
+    }
+    if (nthreads == 2)
+    {
+      check(seen[0] == 119 and seen[1] == 219, "each thread slot keeps its own state in its own copy");
+      check(result[0] == 3.1415*119 and result[1] == 3.1415*219, "calculations in one copy do not see the other");
+    }
+    else std::cout << "  skipped: OpenMP gave " << nthreads << " thread(s) rather than 2" << std::endl;
+
+    bool caught = false;
+    {
+      backend_instance_binding binding(2);
+      try { initialize(0); }
+      catch (std::exception&) { caught = true; }
+    }
+    check(caught, "using a copy that was not loaded is an error");
+
+  #else
+    std::cout << "This system does not support dlmopen; nothing to test." << std::endl;
+  #endif
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
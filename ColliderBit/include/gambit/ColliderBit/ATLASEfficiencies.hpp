@@ -166,8 +166,10 @@ namespace Gambit {
                                                        0.25*0.25,0.25*0.25,0.25*0.25,
                                                        0.,       0.,       0.}});
 
-          // Now loop over the electrons and smear the 4-vectors
-          for (HEPUtils::Particle* e : electrons) {
+          // Now loop over the electrons and smear the 4-vectors, with unit normal deviates drawn in one go
+          const double* z = unit_normals(electrons.size());
+          for (size_t i = 0; i < electrons.size(); ++i) {
+            HEPUtils::Particle* e = electrons[i];
             if (e->abseta() > 5) continue;
 
             // Look up / calculate resolution
@@ -177,8 +179,7 @@ namespace Gambit {
             const double resolution = sqrt(c1*HEPUtils::sqr(e->E()) + c2*e->E() + c3);
 
             // Smear by a Gaussian centered on the current energy, with width given by the resolution
-            std::normal_distribution<> d(e->E(), resolution);
-            double smeared_E = d(Random::rng());
+            double smeared_E = e->E() + resolution*z[i];
             if (smeared_E < 0) smeared_E = 0;
             // double smeared_pt = smeared_E/cosh(e->eta()); ///< @todo Should be cosh(|eta|)?
             // std::cout << "BEFORE eta " << electron->eta() << std::endl;
@@ -198,16 +199,17 @@ namespace Gambit {
                                                      {{0.,0.03,0.02,0.03,0.05,
                                                        0.,0.04,0.03,0.04,0.05}});
 
-          // Now loop over the muons and smear the 4-vectors
-          for (HEPUtils::Particle* mu : muons) {
+          // Now loop over the muons and smear the 4-vectors, with unit normal deviates drawn in one go
+          const double* z = unit_normals(muons.size());
+          for (size_t i = 0; i < muons.size(); ++i) {
+            HEPUtils::Particle* mu = muons[i];
             if (mu->abseta() > 2.5) continue;
 
             // Look up resolution
             const double resolution = _muEff.get_at(mu->abseta(), mu->pT());
 
             // Smear by a Gaussian centered on the current energy, with width given by the resolution
-            std::normal_distribution<> d(mu->pT(), resolution*mu->pT());
-            double smeared_pt = d(Random::rng());
+            double smeared_pt = mu->pT()*(1 + resolution*z[i]);
             if (smeared_pt < 0) smeared_pt = 0;
             // const double smeared_E = smeared_pt*cosh(mu->eta()); ///< @todo Should be cosh(|eta|)?
             // std::cout << "Muon pt " << mu_pt << " smeared " << smeared_pt << endl;
@@ -231,12 +233,13 @@ namespace Gambit {
           const std::vector<double> JetsJER = {0.145,0.115,0.095,0.075,0.07,0.05,0.04};
           static HEPUtils::BinnedFn2D<double> _resJets2D(binedges_eta,binedges_pt,JetsJER);
 
-          // Now loop over the jets and smear the 4-vectors
-          for (HEPUtils::Jet* jet : jets) {
+          // Now loop over the jets and smear the 4-vectors, with unit normal deviates drawn in one go
+          const double* z = unit_normals(jets.size());
+          for (size_t i = 0; i < jets.size(); ++i) {
+            HEPUtils::Jet* jet = jets[i];
             const double resolution = _resJets2D.get_at(jet->abseta(), jet->pT());
-            std::normal_distribution<> d(1., resolution);
             // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-            double smear_factor = d(Random::rng());
+            double smear_factor = 1. + resolution*z[i];
             /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
             jet->set_mom(HEPUtils::P4::mkXYZM(jet->mom().px()*smear_factor, jet->mom().py()*smear_factor, jet->mom().pz()*smear_factor, jet->mass()));
           }
@@ -250,11 +253,12 @@ namespace Gambit {
           // Const resolution for now
           const double resolution = 0.03;
 
-          // Now loop over the jets and smear the 4-vectors
-          std::normal_distribution<> d(1., resolution);
-          for (HEPUtils::Particle* p : taus) {
+          // Now loop over the jets and smear the 4-vectors, with unit normal deviates drawn in one go
+          const double* z = unit_normals(taus.size());
+          for (size_t i = 0; i < taus.size(); ++i) {
+            HEPUtils::Particle* p = taus[i];
             // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-            double smear_factor = d(Random::rng());
+            double smear_factor = 1. + resolution*z[i];
             /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
             p->set_mom(HEPUtils::P4::mkXYZM(p->mom().px()*smear_factor, p->mom().py()*smear_factor, p->mom().pz()*smear_factor, p->mass()));
           }
@@ -95,8 +95,10 @@ namespace Gambit {
       /// We need to smear E, then recalculate pT, then reset the 4-vector.
       inline void smearElectronEnergy(std::vector<HEPUtils::Particle*>& electrons) {
 
-        // Now loop over the electrons and smear the 4-vectors
-        for (HEPUtils::Particle* e : electrons) {
+        // Now loop over the electrons and smear the 4-vectors, with unit normal deviates drawn in one go
+        const double* z = unit_normals(electrons.size());
+        for (size_t i = 0; i < electrons.size(); ++i) {
+          HEPUtils::Particle* e = electrons[i];
 
           // Calculate resolution
           // for pT > 0.1 GeV, E resolution = |eta| < 0.5 -> sqrt(0.06^2 + pt^2 * 1.3e-3^2)
@@ -116,8 +118,7 @@ namespace Gambit {
 
           // Smear by a Gaussian centered on the current energy, with width given by the resolution
           if (resolution > 0) {
-            std::normal_distribution<> d(e->E(), resolution);
-            double smeared_E = d(Random::rng());
+            double smeared_E = e->E() + resolution*z[i];
             if (smeared_E < 0) smeared_E = 0;
             // double smeared_pt = smeared_E/cosh(e->eta()); ///< @todo Should be cosh(|eta|)?
             // std::cout << "BEFORE eta " << electron->eta() << std::std::endl;
@@ -134,8 +135,10 @@ namespace Gambit {
       /// We need to smear pT, then recalculate E, then reset the 4-vector.
       inline void smearMuonMomentum(std::vector<HEPUtils::Particle*>& muons) {
 
-        // Now loop over the muons and smear the 4-vectors
-        for (HEPUtils::Particle* p : muons) {
+        // Now loop over the muons and smear the 4-vectors, with unit normal deviates drawn in one go
+        const double* z = unit_normals(muons.size());
+        for (size_t i = 0; i < muons.size(); ++i) {
+          HEPUtils::Particle* p = muons[i];
 
           // Calculate resolution
           // for pT > 0.1 GeV, mom resolution = |eta| < 0.5 -> sqrt(0.01^2 + pt^2 * 2.0e-4^2)
@@ -154,8 +157,7 @@ namespace Gambit {
           }
 
           // Smear by a Gaussian centered on the current pT, with width given by the resolution
-          std::normal_distribution<> d(p->pT(), resolution*p->pT());
-          double smeared_pt = d(Random::rng());
+          double smeared_pt = p->pT()*(1 + resolution*z[i]);
           if (smeared_pt < 0) smeared_pt = 0;
           // const double smeared_E = smeared_pt*cosh(mu->eta()); ///< @todo Should be cosh(|eta|)?
           // std::cout << "Muon pt " << mu_pt << " smeared " << smeared_pt << std::endl;
@@ -188,12 +190,13 @@ namespace Gambit {
         const std::vector<double> JetsJER = {0.3,0.2,0.16,0.145,0.12,0.1,0.09,0.08,0.06,0.05};
         static HEPUtils::BinnedFn2D<double> _resJets2D(binedges_eta,binedges_pt,JetsJER);
 
-        // Now loop over the jets and smear the 4-vectors
-        for (HEPUtils::Jet* jet : jets) {
+        // Now loop over the jets and smear the 4-vectors, with unit normal deviates drawn in one go
+        const double* z = unit_normals(jets.size());
+        for (size_t i = 0; i < jets.size(); ++i) {
+          HEPUtils::Jet* jet = jets[i];
           const double resolution = _resJets2D.get_at(jet->abseta(), jet->pT());
-          std::normal_distribution<> d(1., resolution);
           // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-          double smear_factor = d(Random::rng());
+          double smear_factor = 1. + resolution*z[i];
           jet->set_mom(HEPUtils::P4::mkXYZM(jet->mom().px()*smear_factor, jet->mom().py()*smear_factor, jet->mom().pz()*smear_factor, jet->mass()));
         }
       }
@@ -210,11 +213,12 @@ namespace Gambit {
         // Const resolution for now
         const double resolution = 0.03;
 
-        // Now loop over the jets and smear the 4-vectors
-        std::normal_distribution<> d(1., resolution);
-        for (HEPUtils::Particle* p : taus) {
+        // Now loop over the jets and smear the 4-vectors, with unit normal deviates drawn in one go
+        const double* z = unit_normals(taus.size());
+        for (size_t i = 0; i < taus.size(); ++i) {
+          HEPUtils::Particle* p = taus[i];
           // Smear by a Gaussian centered on 1 with width given by the (fractional) resolution
-          double smear_factor = d(Random::rng());
+          double smear_factor = 1. + resolution*z[i];
           /// @todo Is this the best way to smear? Should we preserve the mean jet energy, or pT, or direction?
           p->set_mom(HEPUtils::P4::mkXYZM(p->mom().px()*smear_factor, p->mom().py()*smear_factor, p->mom().pz()*smear_factor, p->mass()));
         }
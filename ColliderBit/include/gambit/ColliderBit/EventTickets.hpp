@@ -0,0 +1,85 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Shared event counters of the parallel
+///  ColliderBit event loop: hands out event
+///  numbers and places among the max_nEvents
+///  good events to the threads.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///  *********************************************
+
+#ifndef __EventTickets_hpp__
+#define __EventTickets_hpp__
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// @brief Event numbers and places for the threads of the event loop, so that it ends with exactly
+    /// max_nEvents successfully generated events.
+    ///
+    /// Before generating an event, a thread claims one of the max_nEvents places and takes the next unused event
+    /// number.  A failed event gives its place back (but not its number, which is never reused), so that another
+    /// event is generated in its stead.  When every place is taken by events still in progress, the thread has to
+    /// wait and try again, as one of those events may yet fail.  All counters are only ever touched with omp
+    /// atomics, so any thread may call any member function at any time.
+    class EventTickets
+    {
+
+      public:
+
+        /// Outcome of claiming an event
+        enum status
+        {
+          granted,  ///< Generate the event with the given number, then call succeeded() or failed()
+          wait,     ///< Every place is taken by events still in progress; try again later
+          finished  ///< max_nEvents events have been generated successfully
+        };
+
+        /// Constructor
+        EventTickets(int max_nEvents);
+
+        /// Claim a place and an event number
+        status claim(int& eventNumber);
+
+        /// Record that the claimed event was generated successfully
+        void succeeded();
+
+        /// Record that the claimed event failed, giving its place back
+        void failed();
+
+        /// Number of events generated successfully so far
+        int n_done() const;
+
+        /// Number of event numbers handed out so far
+        int n_numbered() const;
+
+      private:
+
+        /// Number of successfully generated events to stop at
+        const int max_nEvents;
+
+        /// Event numbers handed out to threads so far (each number is only ever used once)
+        int nEventsNumbered;
+
+        /// Number of events in progress or successfully completed (failed events give their claim back)
+        int nEventsClaimed;
+
+        /// Number of successfully completed events
+        int nEventsDone;
+
+    };
+
+  }
+}
+
+#endif
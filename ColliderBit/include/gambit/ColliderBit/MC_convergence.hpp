@@ -15,6 +15,10 @@
 ///  \author Anders Kvellestad
 ///          (anders.kvellestad@fys.uio.no)
 ///  \date 2018 May
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
 ///  *********************************************
 
 #ifndef __MC_convergence_hpp__
@@ -51,7 +55,7 @@ namespace Gambit
         /// The index in the convergence settings to use
         int _collider;
 
-        /// Pointer to an array holding the signal counts on each thread
+        /// Pointer to an array holding a snapshot of the signal counts on each thread
         std::vector<int>* n_signals;
 
         /// Total number of threads that the checker is configured to deal with
@@ -84,6 +88,8 @@ namespace Gambit
         void clear();
 
         /// Update the convergence data.  This is the only routine meant to be called in parallel.
+        /// Each thread copies its own signal counts into its own slot, so achieved() may be run by one
+        /// thread while the others keep generating events, provided none of them calls update() meanwhile.
         void update(const HEPUtilsAnalysisContainer&);
 
         /// Check if convergence has been achieved across threads, and across all instances of this class
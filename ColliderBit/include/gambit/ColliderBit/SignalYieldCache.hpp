@@ -0,0 +1,171 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  ColliderBit cache of simulated signal yields,
+///  for reuse between parameter points with the
+///  same (or nearly the same) collider simulation
+///  inputs.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///  *********************************************
+
+#ifndef __SignalYieldCache_hpp__
+#define __SignalYieldCache_hpp__
+
+#include "gambit/Utils/util_types.hpp"
+#include "gambit/ColliderBit/analyses/HEPUtilsAnalysisContainer.hpp"
+#include "SLHAea/slhaea.h"
+
+#include <list>
+#include <map>
+#include <vector>
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// @brief A bounded, least-recently-used cache of post-detector-simulation signal region yields.
+    ///
+    /// For every collider, the raw signal region counts and generated cross-sections of all analyses
+    /// in all analysis containers are stored, together with the generated cross-section of each hard
+    /// process, under a key made of everything that determines them: the collider, its Pythia settings
+    /// and event-loop settings, the analyses run in each container, and the parts of the SLHA input that
+    /// Pythia reads for the hard processes and decays (masses, decays and mixing matrices; see
+    /// Key::set_spectrum).  A later point whose key differs from a stored one by no more than the
+    /// configured tolerance then reuses the stored counts instead of generating new events, with the
+    /// cross-sections rescaled to those of its own hard processes (see xsec_scale).
+    class SignalYieldCache
+    {
+
+      public:
+
+        /// Everything that determines the signal yields of one collider at one point
+        struct Key
+        {
+          str collider;
+          /// Pythia and event-loop settings
+          std::vector<str> settings;
+          /// Names of the analyses run, by analysis container
+          std::map<str,std::vector<str> > analyses;
+          /// Masses, total widths and trilinear couplings, by SLHA block and indices.  Compared relative to their size.
+          std::map<str,double> dimensionful;
+          /// Branching fractions, mixing matrices, Yukawa couplings and model selection, by SLHA block and indices.
+          /// Compared absolutely.
+          std::map<str,double> dimensionless;
+
+          /// Set the spectrum from the SLHA input given to Pythia
+          void set_spectrum(const SLHAea::Coll&);
+          /// Has the spectrum been set?
+          bool has_spectrum() const { return not dimensionful.empty(); }
+          /// Clear everything but the spectrum, ready for a new collider
+          void new_collider(const str&);
+          /// The largest difference between the spectrum entries of two keys with the same collider, settings,
+          /// analyses and spectrum entries, or infinity if they differ in any of those
+          double distance(const Key&) const;
+        };
+
+        /// Yields of a single analysis, before scaling to luminosity
+        struct AnalysisYields
+        {
+          std::vector<double> n_signal;
+          double num_events;
+          double xsec;
+          double xsec_err;
+        };
+
+        /// Everything stored for one collider at one point
+        struct Entry
+        {
+          Key key;
+          int n_events;
+          /// Generated cross-section (in pb) of each hard process, by process code
+          std::map<int,double> process_xsecs;
+          /// First key is the analysis container name, second key is the analysis name.
+          std::map<str,std::map<str,AnalysisYields> > yields;
+        };
+
+        /// Constructor
+        SignalYieldCache() : have_pending(false), max_entries(0), tolerance(0.), hits(0), misses(0) {}
+
+        /// Set the maximum number of stored entries, and the largest spectrum difference (see Key::distance) at
+        /// which an entry is reused.  A size of zero switches the cache off.
+        void configure(size_t, double tolerance = 0.);
+        /// Is the cache switched on?
+        bool enabled() const { return max_entries > 0; }
+
+        /// Find the entry closest to the given key, within the tolerance, that holds the yields of all its
+        /// analyses, or NULL if there is none.  Counts as a hit or a miss.
+        const Entry* find(const Key&);
+        /// Count the last hit as a miss, for an entry that turned out not to be reusable (see xsec_scale)
+        void reject();
+
+        /// The factor by which to scale the cross-sections of an entry for a point with the given generated
+        /// cross-section (in pb) of each hard process, by process code.  This is the ratio of the new to the
+        /// stored cross-sections of the processes in the entry, which assumes that their signal region
+        /// efficiencies are unchanged within the tolerance.  Returns a negative number if the entry is not
+        /// reusable: if either cross-section vanishes, or if processes that are not in the entry carry more
+        /// than the tolerance as a fraction of the new cross-section.
+        double xsec_scale(const Entry&, const std::map<int,double>&) const;
+
+        /// Start a new (pending) entry for the given key
+        void start(const Key&);
+        /// Store the yields of all analyses in the given container for the current collider in the pending entry.
+        /// @note Must be called after the signal has been collected from all threads, and before scaling.
+        void store(const str&, const HEPUtilsAnalysisContainer&);
+        /// Store the yields of a single analysis, by container and analysis name, in the pending entry
+        void store(const str&, const str&, const AnalysisYields&);
+        /// Add the generated cross-section (in pb) and number of tried events of each hard process of one Pythia
+        /// instance, by process code, to the pending entry.  Instances are combined weighting by tried events.
+        /// @note Not thread safe; call from one thread at a time.
+        void add_process_xsecs(const std::map<int,std::pair<double,long> >&);
+        /// Move the pending entry into the cache, dropping the least recently used entry if the cache is full
+        void commit(int);
+        /// Discard the pending entry
+        void discard();
+
+        /// Restore the yields of all analyses in the given container from an entry, with their cross-sections
+        /// multiplied by the given factor.  Returns false if the entry does not match the container's analyses.
+        static bool restore(const Entry&, const str&, HEPUtilsAnalysisContainer&, double xsec_scale = 1.);
+        /// Restore the yields of a single analysis, with its cross-section multiplied by the given factor.
+        /// Returns false if the yields do not match the analysis' signal regions.
+        static bool restore(const AnalysisYields&, HEPUtilsAnalysis&, double xsec_scale = 1.);
+
+        /// @name Cache statistics
+        /// @{
+        unsigned long long n_hits() const { return hits; }
+        unsigned long long n_misses() const { return misses; }
+        size_t size() const { return entries.size(); }
+        /// @}
+
+      private:
+
+        /// Does an entry hold the yields of every analysis in its key?
+        static bool complete(const Entry&);
+
+        /// Stored entries, most recently used first
+        std::list<Entry> entries;
+        /// Entry being filled for the current collider
+        Entry pending;
+        bool have_pending;
+        /// Sums over Pythia instances of tried events times cross-section, and of tried events, by process code
+        std::map<int,std::pair<double,double> > pending_xsec_sums;
+
+        size_t max_entries;
+        double tolerance;
+        unsigned long long hits;
+        unsigned long long misses;
+
+    };
+
+  }
+}
+
+#endif // __SignalYieldCache_hpp__
@@ -144,9 +144,39 @@ namespace Gambit {
     //@}
 
 
+    /// @name Bulk random deviates
+    //@{
+
+    /// Draw n unit normal deviates in one call, into a per-thread buffer that is valid until the next call on this thread
+    const double* unit_normals(size_t n);
+
+    /// Draw n uniform deviates on [0,1) in one call, into a per-thread buffer that is valid until the next call on this thread
+    const double* uniforms(size_t n);
+
+    //@}
+
+
     /// @name Random filtering by efficiency
     //@{
 
+    /// @brief Structure-of-arrays view of the kinematics and ID of a list of particles
+    ///
+    /// Lets efficiency and smearing code work through contiguous arrays rather than
+    /// chasing Particle pointers; see filtereff_pt and filtereff_etapt.
+    struct ParticleArrays {
+      /// Bits in the flags array
+      enum { PROMPT = 1 };
+      std::vector<double> pT, eta, phi, E;
+      std::vector<int> pid;
+      std::vector<unsigned char> flags;
+      /// Fill the arrays from a list of particles (reusing their memory)
+      void fill(const std::vector<HEPUtils::Particle*>& particles);
+      size_t size() const { return pT.size(); }
+    };
+
+    /// Remove the particles whose entry in keep is zero, preserving the order of the rest, in one pass
+    void compact(std::vector<HEPUtils::Particle*>& particles, const std::vector<unsigned char>& keep, bool do_delete=true);
+
     /// Utility function for filtering a supplied particle vector by sampling wrt an efficiency scalar
     void filtereff(std::vector<HEPUtils::Particle*>& particles, double eff, bool do_delete=true);
 
@@ -0,0 +1,97 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  ColliderBit pre-screening of parameter points
+///  with a fast, conservative estimate of the total
+///  SUSY production cross-section, for applying the
+///  xsec veto before Pythia is initialised.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///  *********************************************
+
+#ifndef __XsecPrescreen_hpp__
+#define __XsecPrescreen_hpp__
+
+#include "gambit/Utils/util_types.hpp"
+#include "SLHAea/slhaea.h"
+
+#include <utility>
+#include <vector>
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// @brief A fast upper bound on the total SUSY production cross-section of an MSSM spectrum.
+    ///
+    /// The bound is a sum over production channels (strong production of gluinos and light-flavour
+    /// squarks, pair production of each third-generation squark, chargino/neutralino production and
+    /// slepton/sneutrino production), each taken from a tabulated 13 TeV NLO+NLL envelope that is
+    /// interpolated in log(sigma) as a function of the lightest relevant mass.  The tables are
+    /// rounded upwards, strong production is evaluated with all coloured sparticles at the mass of
+    /// the lightest one, and electroweakino production is taken to be wino-like.  The result is then
+    /// multiplied by a configurable safety margin, which also has to cover the difference between
+    /// these cross-sections and Pythia's estimate of the maximum cross-section.
+    ///
+    /// The tables are only valid up to 13 TeV (cross-sections grow with energy, so they are upper
+    /// bounds for lower energies); colliders at higher or unknown energies are never vetoed, and
+    /// neither are spectra without the full set of MSSM sparticles.
+    class XsecPrescreen
+    {
+
+      public:
+
+        /// A cross-section table: (mass [GeV], cross-section [pb]), in increasing mass
+        typedef std::vector<std::pair<double,double> > xsec_table;
+
+        /// Constructor
+        XsecPrescreen() : margin(0), n_screened(0), n_vetoed(0) {}
+
+        /// Set the safety margin (a factor multiplying the bound).  A margin of zero switches the pre-screen off.
+        void configure(double);
+        /// Is the pre-screen switched on?
+        bool enabled() const { return margin > 0; }
+
+        /// Conservative upper bound (in fb, including the margin) on the total SUSY cross-section of a spectrum,
+        /// for a collider with the given centre-of-mass energy (in GeV, or negative if not known).
+        /// Returns infinity if the bound can't be computed, including for unknown energies.
+        double xsec_upper_limit_fb(const SLHAea::Coll&, double) const;
+
+        /// Does a bound from xsec_upper_limit_fb (in fb) fall below the xsec veto (in fb) for this collider?
+        /// Counts the collider as screened, and as vetoed if so.
+        bool vetoes(double, double);
+
+        /// Get the centre-of-mass energy (in GeV) of a collider from its Pythia settings ("Beams:eCM"), or else
+        /// from a name ending in e.g. "_13TeV".  Returns -1 if it is not known (Pythia would then default to 14 TeV).
+        static double collider_ecm(const str&, const std::vector<str>&);
+
+        /// Interpolate a cross-section table (in pb) linearly in log(sigma) at the given mass, extrapolating beyond
+        /// the last point with the last slope.  Returns infinity for masses below the table.
+        static double interpolate(const xsec_table&, double);
+
+        /// @name Pre-screen statistics
+        /// @{
+        unsigned long long n_colliders_screened() const { return n_screened; }
+        unsigned long long n_colliders_vetoed() const { return n_vetoed; }
+        /// @}
+
+      private:
+
+        double margin;
+        unsigned long long n_screened;
+        unsigned long long n_vetoed;
+
+    };
+
+  }
+}
+
+#endif // __XsecPrescreen_hpp__
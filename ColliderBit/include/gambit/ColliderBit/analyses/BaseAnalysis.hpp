@@ -9,6 +9,7 @@
 
 #include "gambit/ColliderBit/ColliderBit_macros.hpp"
 #include "gambit/ColliderBit/analyses/AnalysisData.hpp"
+#include "gambit/ColliderBit/analyses/EventObjectCache.hpp"
 
 #include "gambit/ColliderBit/Utils.hpp"
 #include "HEPUtils/MathUtils.h"
@@ -40,6 +41,9 @@ namespace Gambit {
       AnalysisData _results;
       typedef EventT EventType;
       std::string _analysis_name;
+      /// The shared cache of the event being analysed, or null to use this analysis' own
+      EventObjectCache* _objects;
+      EventObjectCache _own_objects;
 
     public:
 
@@ -48,7 +52,8 @@ namespace Gambit {
 
       BaseAnalysis() : _ntot(0), _xsec(0), _xsecerr(0), _luminosity(0),
                        _xsec_is_set(false), _luminosity_is_set(false),
-                       _is_scaled(false), _needs_collection(true) {  }
+                       _is_scaled(false), _needs_collection(true),
+                       _objects(nullptr) {  }
 
       virtual ~BaseAnalysis() { }
 
@@ -87,7 +92,19 @@ namespace Gambit {
       /// Analyze the event (accessed by reference).
       void do_analysis(const EventT& e) { do_analysis(&e); }
       /// Analyze the event (accessed by pointer).
-      void do_analysis(const EventT* e) { _needs_collection = true; analyze(e); }
+      void do_analysis(const EventT* e) {
+        _own_objects.reset(e);
+        do_analysis(e, nullptr);
+      }
+      /// Analyze the event, taking common object selections from a cache shared with other analyses
+      /// (or from this analysis' own cache, if null).
+      /// @note The cache must already have been reset for this event.
+      void do_analysis(const EventT* e, EventObjectCache* objects) {
+        _needs_collection = true;
+        _objects = objects;
+        analyze(e);
+        _objects = nullptr;
+      }
 
       /// Return the total number of events seen so far.
       double num_events() const { return _ntot; }
@@ -165,6 +182,8 @@ namespace Gambit {
       /// Analyze the event (accessed by pointer).
       /// @note Needs to be called from Derived::analyze().
       virtual void analyze(const EventT*) { _ntot += 1; }
+      /// The per-event cache of common object selections (pT and |eta| cuts) and event variables.
+      EventObjectCache& objects() { return _objects != nullptr ? *_objects : _own_objects; }
       /// Add the given result to the internal results list.
       void add_result(const SignalRegionData& sr) { _results.add(sr); }
       /// Set the covariance matrix, expressing SR correlations
@@ -229,6 +248,20 @@ namespace Gambit {
           }
         }
       }
+      /// @brief Set the signal region counts, event count and cross-section directly, instead of analysing events.
+      /// @note The signal region definitions still come from collect_results(). Returns false if the number of
+      /// signal regions does not match.
+      bool restore(const std::vector<double>& n_signal, double ntot, double xs, double xserr) {
+        collect_results();
+        if (n_signal.size() != _results.size()) return false;
+        for (size_t i = 0; i < _results.size(); ++i) {
+          _results[i].n_signal = n_signal[i];
+        }
+        _needs_collection = false;
+        _ntot = ntot;
+        set_xsec(xs, xserr);
+        return true;
+      }
       /// Combine cross-sections and errors for the same process type, assuming uncorrelated errors.
       void improve_xsec(double xs, double xserr) {
         if (xs > 0) {
@@ -0,0 +1,152 @@
+#pragma once
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  The EventObjectCache class: per-event memoisation
+///  of the kinematic object selections and simple
+///  event variables shared by many analyses.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include "HEPUtils/Event.h"
+
+#include <vector>
+#include <deque>
+#include <cstddef>
+
+namespace Gambit {
+  namespace ColliderBit {
+
+    /// @brief Per-event cache of baseline object selections, keyed by their cut signature.
+    ///
+    /// Many analyses start by filtering the event into electrons, muons, jets etc. with
+    /// a minimum pT and maximum |eta|, often with the same numbers. A single instance of
+    /// this class is shared by all analyses in a HEPUtilsAnalysisContainer, and reset
+    /// once per event, so each distinct selection is only made once per event.
+    ///
+    /// The returned vectors keep the ordering of the event's own object lists, so they
+    /// can be dropped in for the usual hand-written selection loops.  The pT cut is
+    /// strict (pT > ptmin) unless inclusive is set (pT >= ptmin), so that loops written
+    /// either way can be replaced without changing which objects are selected.
+    ///
+    /// @note Only deterministic selections are cached. The detector ID and isolation
+    /// efficiencies in ATLASEfficiencies/CMSEfficiencies draw random numbers, and each
+    /// analysis is meant to apply them independently, so they stay in the analyses.
+    class EventObjectCache {
+    public:
+
+      typedef std::vector<const HEPUtils::Particle*> Particles;
+      typedef std::vector<const HEPUtils::Jet*> Jets;
+
+      EventObjectCache() : _event(nullptr) {}
+
+      /// Start on a new event, invalidating all cached selections (but keeping their memory).
+      void reset(const HEPUtils::Event* event) {
+        _event = event;
+        for (auto& s : _electrons) s.valid = false;
+        for (auto& s : _muons) s.valid = false;
+        for (auto& s : _taus) s.valid = false;
+        for (auto& s : _photons) s.valid = false;
+        for (auto& s : _jets) s.valid = false;
+        for (auto& s : _bjets) s.valid = false;
+        for (auto& s : _ht) s.valid = false;
+      }
+
+      /// The event the cache currently refers to.
+      const HEPUtils::Event* event() const { return _event; }
+
+      /// @name Cached object selections: pT > ptmin (pT >= ptmin if inclusive) and |eta| < absetamax
+      //@{
+      const Particles& electrons(double ptmin, double absetamax, bool inclusive=false) { return select(_electrons, _event->electrons(), ptmin, absetamax, inclusive); }
+      const Particles& muons(double ptmin, double absetamax, bool inclusive=false) { return select(_muons, _event->muons(), ptmin, absetamax, inclusive); }
+      const Particles& taus(double ptmin, double absetamax, bool inclusive=false) { return select(_taus, _event->taus(), ptmin, absetamax, inclusive); }
+      const Particles& photons(double ptmin, double absetamax, bool inclusive=false) { return select(_photons, _event->photons(), ptmin, absetamax, inclusive); }
+      const Jets& jets(double ptmin, double absetamax, bool inclusive=false) { return select(_jets, _event->jets(), ptmin, absetamax, inclusive); }
+
+      /// B-tagged subset of jets(ptmin, absetamax, inclusive).
+      const Jets& bjets(double ptmin, double absetamax, bool inclusive=false) {
+        Selection<const HEPUtils::Jet*>& s = slot(_bjets, ptmin, absetamax, inclusive);
+        if (!s.valid) {
+          s.objects.clear();
+          for (const HEPUtils::Jet* j : jets(ptmin, absetamax, inclusive))
+            if (j->btag()) s.objects.push_back(j);
+          s.valid = true;
+        }
+        return s.objects;
+      }
+      //@}
+
+      /// @name Cached event variables
+      //@{
+      /// Scalar sum of the pT of jets(ptmin, absetamax, inclusive).
+      double HT(double ptmin, double absetamax, bool inclusive=false) {
+        Variable& v = slot(_ht, ptmin, absetamax, inclusive);
+        if (!v.valid) {
+          v.value = 0;
+          for (const HEPUtils::Jet* j : jets(ptmin, absetamax, inclusive)) v.value += j->pT();
+          v.valid = true;
+        }
+        return v.value;
+      }
+      //@}
+
+    private:
+
+      /// One cached selection and its cut signature.
+      template <typename T>
+      struct Selection {
+        double ptmin, absetamax;
+        bool inclusive;
+        bool valid;
+        std::vector<T> objects;
+      };
+
+      /// One cached event variable and the cut signature of the objects it is built from.
+      struct Variable {
+        double ptmin, absetamax;
+        bool inclusive;
+        bool valid;
+        double value;
+      };
+
+      /// Find (or add) the cache slot for a cut signature. Linear search: there are only ever a handful.
+      /// Slots live in a deque, so references handed out earlier in the event stay valid.
+      template <typename S>
+      static S& slot(std::deque<S>& slots, double ptmin, double absetamax, bool inclusive) {
+        for (auto& s : slots)
+          if (s.ptmin == ptmin && s.absetamax == absetamax && s.inclusive == inclusive) return s;
+        slots.push_back(S{ptmin, absetamax, inclusive, false, {}});
+        return slots.back();
+      }
+
+      template <typename T, typename U>
+      static const std::vector<const T*>& select(std::deque<Selection<const T*> >& selections,
+                                                 const std::vector<U*>& all, double ptmin, double absetamax, bool inclusive) {
+        Selection<const T*>& s = slot(selections, ptmin, absetamax, inclusive);
+        if (!s.valid) {
+          s.objects.clear();
+          for (const T* p : all)
+            if ((inclusive ? p->pT() >= ptmin : p->pT() > ptmin) && p->abseta() < absetamax) s.objects.push_back(p);
+          s.valid = true;
+        }
+        return s.objects;
+      }
+
+      const HEPUtils::Event* _event;
+      std::deque<Selection<const HEPUtils::Particle*> > _electrons, _muons, _taus, _photons;
+      std::deque<Selection<const HEPUtils::Jet*> > _jets, _bjets;
+      std::deque<Variable> _ht;
+
+    };
+
+  }
+}
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <vector>
 #include <map>
+#include <memory>
 
 // Forward declarations, to avoid header-chaining into CB_types.hpp
 namespace HEPUtils { class Event; }
@@ -12,6 +13,7 @@ namespace Gambit {
     template <typename EventT>
     class BaseAnalysis;
     using HEPUtilsAnalysis = BaseAnalysis<HEPUtils::Event>;
+    class EventObjectCache;
   }
 }
 
@@ -56,6 +58,13 @@ namespace Gambit {
         /// Key for the instances_map
         string base_key;
 
+        /// Object selections shared by all analyses, reset for every event
+        std::unique_ptr<EventObjectCache> event_objects;
+
+        /// Wall-clock time (in seconds) spent in each analysis on this thread.
+        /// First key is the collider name, second key is the analysis name.
+        mutable std::map<string,std::map<string,double> > analysis_seconds;
+
         /// A vector with pointers to all instances of this class. The key is the OMP thread number.
         /// (There should only be one instance of this class per OMP thread.)
         static std::map<string,std::map<int,HEPUtilsAnalysisContainer*> > instances_map;
@@ -105,7 +114,7 @@ namespace Gambit {
         /// Get analyses map for a specific collider
         const std::map<string,HEPUtilsAnalysis*>& get_collider_analyses_map(string) const;
         /// Get analyses map for the current collider
-        const std::map<string,HEPUtilsAnalysis*>& get_current_analyses_map() const;
+        const std::map<string,HEPUtilsAnalysis*>& get_current_analyses_map() const { return analyses_map.at(current_collider); }
         /// Get the full analyses map
         const std::map<string,std::map<string,HEPUtilsAnalysis*> >& get_full_analyses_map() const;
 
@@ -156,6 +165,11 @@ namespace Gambit {
         /// for all analyses for the current collider
         void collect_and_improve_xsec();
 
+        /// Get the time spent in each analysis for the current collider, on this thread
+        const std::map<string,double>& get_analysis_timings() const;
+        /// Get the time spent in each analysis for the current collider, summed over all threads
+        std::map<string,double> collect_analysis_timings() const;
+
         /// Scale results for specific analysis
         void scale(string, string, double factor=-1);
         /// Scale results for all analyses for given collider
@@ -5,7 +5,10 @@
 ///
 ///  The SpecializablePythia class.
 
+#include <map>
 #include <ostream>
+#include <string>
+#include <vector>
 // #include "gambit/Elements/gambit_module_headers.hpp"
 // #include "gambit/ColliderBit/ColliderBit_rollcall.hpp"
 #include "gambit/ColliderBit/colliders/BaseCollider.hpp"
@@ -17,17 +20,35 @@ namespace Gambit {
     /// A specializable, recyclable class interfacing ColliderBit and Pythia.
     class SpecializablePythia : public BaseCollider<Pythia8::Event>
     {
+      public:
+        /// The maximum cross section of a hard process, as estimated by Pythia at initialization.
+        struct ProcessXsec
+        {
+          int code;
+          std::string name;
+          double xsecMax_pb;
+        };
+
       protected:
         Pythia8::Pythia* _pythiaInstance;
         Pythia8::Pythia* _pythiaBase;
         std::vector<std::string> _pythiaSettings;
         void (*_specialInit)(SpecializablePythia*);
+        std::vector<ProcessXsec> _processXsecs;
+
+        /// Initialize _pythiaInstance, keeping the estimated process cross sections from its settings.
+        void _initInstance(std::ostream& os);
 
       /// @name Getters:
       //@{
       public:
         /// Get the Pythia instance.
         const Pythia8::Pythia* pythia() const { return _pythiaInstance; }
+        /// Get the estimated maximum cross section of each process, from the last initialization.
+        /// @note Requires the GAMBIT patch to Pythia's ProcessLevel; empty without it.
+        const std::vector<ProcessXsec>& processXsecEstimates() const { return _processXsecs; }
+        /// Get the sum of the estimated maximum cross sections (in pb) of all processes.
+        double xsecEstimate_pb() const;
       //@}
 
       /// @name Custom exceptions:
@@ -123,9 +144,13 @@ namespace Gambit {
         }
 
         /// Report the cross section (in pb) at the end of the subprocess.
-        double xsec_pb() const { return _pythiaInstance->info.sigmaGen() * 1e9; }
+        /// @note Zero if this instance was never initialized (e.g. when no events were needed).
+        double xsec_pb() const { return _pythiaInstance ? _pythiaInstance->info.sigmaGen() * 1e9 : 0.; }
         /// Report the cross section uncertainty (in pb) at the end of the subprocess.
-        double xsecErr_pb() const { return _pythiaInstance->info.sigmaErr() * 1e9; }
+        double xsecErr_pb() const { return _pythiaInstance ? _pythiaInstance->info.sigmaErr() * 1e9 : 0.; }
+        /// Report the cross section (in pb) generated so far for each hard process, with the number of events
+        /// tried for it, by process code.
+        std::map<int, std::pair<double,long> > processXsecs_pb() const;
       ///@}
      };
 
@@ -0,0 +1,141 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  ColliderBit Monte Carlo marginalisation of
+///  Poisson likelihoods over correlated signal
+///  region uncertainties.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __covariance_marginalisation_hpp__
+#define __covariance_marginalisation_hpp__
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "Eigen/Core"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// Running log(sum_i exp(x_i)), robust against under- and overflow of the individual terms
+    class logsumexp_accumulator
+    {
+      public:
+
+        /// Constructor
+        logsumexp_accumulator();
+
+        /// Add a set of log terms
+        void add(const Eigen::Ref<const Eigen::ArrayXd>&);
+
+        /// Merge the terms accumulated by another accumulator into this one
+        void add(const logsumexp_accumulator&);
+
+        /// Return log(sum_i exp(x_i)); -inf if no terms have been added
+        double value() const;
+
+        /// Return log(<exp(x)>) = log(sum_i exp(x_i)) - log(n) for n terms
+        double log_mean(std::size_t n) const;
+
+      private:
+
+        /// Reference shift (largest term seen so far) and sum of exp(x_i - shift)
+        double shift;
+        double sum;
+    };
+
+    /// Batched sampler of the Poisson likelihood of a set of correlated signal regions,
+    /// with the expected rates drawn from a multivariate Gaussian given by
+    /// mean rates n_pred and covariance V diag(sqrtE^2) V^T.
+    /// Whole blocks of samples are drawn at once, rotated into the SR basis with a single
+    /// matrix-matrix product, and evaluated with Eigen's vectorised array log/exp functions.
+    class marg_poisson_sampler
+    {
+      public:
+
+        /// Number of samples drawn per block by each thread
+        static const std::size_t block_size = 256;
+
+        /// Constructor
+        marg_poisson_sampler(const Eigen::ArrayXd& n_obs, const Eigen::ArrayXd& logfact_n_obs,
+                             const Eigen::ArrayXd& n_pred, const Eigen::ArrayXd& sqrtE, const Eigen::MatrixXd& V);
+
+        /// Draw nsample samples (in parallel if OpenMP is active) and add their log-likelihoods to result
+        void sample(std::size_t nsample, logsumexp_accumulator& result) const;
+
+      private:
+
+        /// Observed counts and the sum of their log-factorials
+        const Eigen::VectorXd _n_obs;
+        const double _sum_logfact_n_obs;
+
+        /// Mean predicted rates
+        const Eigen::VectorXd _n_pred;
+
+        /// Rotation matrix into the SR basis, with the columns pre-scaled by the square roots of the eigenvalues
+        const Eigen::MatrixXd _scaled_rotation;
+    };
+
+    /// Background-only quantities of an analysis with a signal region covariance matrix
+    struct bkg_covariance
+    {
+      /// Log-factorials of the observed counts
+      Eigen::ArrayXd logfact_n_obs;
+      /// Square roots of the eigenvalues and the eigenvectors of the background covariance matrix
+      Eigen::ArrayXd sqrtEb;
+      Eigen::MatrixXd Vb;
+    };
+
+    /// Cache of the background-only quantities of each analysis, which never change during a scan.
+    /// Entries are computed the first time an analysis is seen, and are safe to look up from
+    /// several threads at once; references to them stay valid for the lifetime of the cache.
+    class bkg_covariance_cache
+    {
+      public:
+
+        /// Constructor
+        bkg_covariance_cache();
+
+        /// Get the entry for an analysis, calling fill to compute it if this is the first time it is asked for
+        const bkg_covariance& get(const std::string& analysis, const std::function<void(bkg_covariance&)>& fill);
+
+        /// Get the background-only marginalised log-likelihood of an analysis, if it is known
+        bool get_loglike_b(const std::string& analysis, double& loglike_b) const;
+
+        /// Keep the background-only marginalised log-likelihood of an analysis already in the cache (the first value given is kept)
+        void set_loglike_b(const std::string& analysis, double loglike_b);
+
+        /// Numbers of lookups that found an entry and that had to compute one
+        unsigned long long hits() const;
+        unsigned long long misses() const;
+
+      private:
+
+        struct entry
+        {
+          bkg_covariance bkg;
+          bool have_loglike_b = false;
+          double loglike_b = 0;
+        };
+        std::map<std::string, entry> _entries;
+        unsigned long long _hits, _misses;
+    };
+
+  }
+}
+
+#endif // defined __covariance_marginalisation_hpp__
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gambit/ColliderBit/detectors/BaseDetector.hpp"
+#include "gambit/ColliderBit/detectors/EventObjectPool.hpp"
 
 namespace Gambit {
   namespace ColliderBit {
@@ -18,9 +19,16 @@ namespace Gambit {
         /// @note Also performs the jet clustering algorithm.
         void convertPythia8PartonEvent(const EventInType&, EventOutType&) const;
         /// Perform the BuckFast simple smearing on the next collider event by reference.
+        /// @note The particles and jets already in the output event are recycled for the new one.
         virtual void processEvent(const EventInType&, EventOutType&) const = 0;
       //@}
 
+      protected:
+        /// Particles and jets recycled between events (each instance is only used by one thread).
+        mutable EventObjectPool _pool;
+
+      public:
+
       /// @name Construction, Destruction, and Recycling
       //@{
         BuckFastBase() : partonOnly(false), antiktR(0.4) { }
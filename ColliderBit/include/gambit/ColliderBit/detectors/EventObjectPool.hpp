@@ -0,0 +1,98 @@
+#pragma once
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  The EventObjectPool class: recycling of the
+///  Particle and Jet objects making up the events
+///  produced by the BuckFast detector simulations.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include "HEPUtils/Event.h"
+#include "HEPUtils/Particle.h"
+#include "HEPUtils/Jet.h"
+
+#include <vector>
+
+namespace Gambit {
+  namespace ColliderBit {
+
+    /// @brief A free list of heap-allocated Particles and Jets, reused from one event to the next.
+    ///
+    /// HEPUtils::Event owns its Particle and Jet pointers and deletes them when cleared.
+    /// Calling recycle() instead takes the objects back out of the event before it is
+    /// cleared, so that the next event can be built from them without going through the
+    /// allocator. Objects removed from an event by the efficiency functions are still
+    /// deleted as before; the pool simply tops itself back up with new ones.
+    ///
+    /// Each detector simulation instance belongs to a single thread, so no locking is needed.
+    class EventObjectPool {
+    public:
+
+      EventObjectPool() { }
+      /// Copies start with an empty pool, so that no two pools ever own the same object.
+      EventObjectPool(const EventObjectPool&) { }
+      EventObjectPool& operator=(const EventObjectPool&) { return *this; }
+      ~EventObjectPool() { release(); }
+
+      /// Take all the particles and jets out of the event, keep them for reuse, and clear the event.
+      void recycle(HEPUtils::Event& event) {
+        take(event.photons(), _particles);
+        take(event.electrons(), _particles);
+        take(event.muons(), _particles);
+        take(event.taus(), _particles);
+        take(event.invisible_particles(), _particles);
+        take(event.jets(), _jets);
+        event.clear();
+      }
+
+      /// Get a particle with the given momentum and PDG ID, reusing a pooled one if possible.
+      HEPUtils::Particle* particle(const HEPUtils::P4& mom, int pid) {
+        if (_particles.empty()) return new HEPUtils::Particle(mom, pid);
+        HEPUtils::Particle* p = _particles.back();
+        _particles.pop_back();
+        *p = HEPUtils::Particle(mom, pid);
+        return p;
+      }
+
+      /// Get a jet with the given momentum and tags, reusing a pooled one if possible.
+      HEPUtils::Jet* jet(const HEPUtils::P4& mom, bool isB, bool isC) {
+        if (_jets.empty()) return new HEPUtils::Jet(mom, isB, isC);
+        HEPUtils::Jet* j = _jets.back();
+        _jets.pop_back();
+        *j = HEPUtils::Jet(mom, isB, isC);
+        return j;
+      }
+
+      /// Delete all pooled objects.
+      void release() {
+        for (HEPUtils::Particle* p : _particles) delete p;
+        for (HEPUtils::Jet* j : _jets) delete j;
+        _particles.clear();
+        _jets.clear();
+      }
+
+    private:
+
+      template <typename T>
+      static void take(std::vector<T*>& from, std::vector<T*>& to) {
+        to.insert(to.end(), from.begin(), from.end());
+        from.clear();
+      }
+
+      std::vector<HEPUtils::Particle*> _particles;
+      std::vector<HEPUtils::Jet*> _jets;
+
+    };
+
+  }
+}
@@ -16,6 +16,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2016 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *************************************
 
 #pragma once
@@ -27,6 +31,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -42,6 +47,29 @@ namespace Gambit
     /// @brief Factory function for lines
     inline LineSegment makeLine(const P2& pt1, const P2& pt2) { return LineSegment(pt1, pt2); }
 
+    /// @brief Uniform grid over the segments of one limit contour.
+    ///
+    /// Used to restrict intersection tests to the segments lying near a query
+    /// line. The candidate set is conservative, so results are identical to
+    /// testing every segment.
+    class SegmentGrid
+    {
+      public:
+        /// @brief Bin the segments of a contour
+        void build(const std::vector<LineSegment>& segments);
+
+        /// @brief Indices of all segments that could intersect the query segment
+        void candidates(const LineSegment& query, std::vector<unsigned>& result) const;
+
+      private:
+        double _xmin, _ymin, _xmax, _ymax, _dx, _dy;
+        int _nx, _ny;
+        std::vector<std::vector<unsigned> > _cells;
+
+        int column(double x) const;
+        int row(double y) const;
+    };
+
     /// @brief Base class for experimental limit curve interpolation
     class BaseLimitContainer
     {
@@ -66,6 +94,21 @@ namespace Gambit
         // Some point external to all limit contours
         P2 _externalPoint;
 
+      private:
+        /// Segment grids, one per limit contour, built on first use
+        /// (the derived class constructors fill the contours after this base is constructed).
+        mutable std::vector<SegmentGrid> _segmentGrids;
+        mutable std::once_flag _segmentGridsBuilt;
+        void buildSegmentGrids() const;
+
+        /// Indices of the segments of limit contour index to test against query: those
+        /// near it according to the segment grid, or all of them.
+        void segmentCandidates(unsigned index, const LineSegment& query, bool useSegmentGrids,
+                               std::vector<unsigned>& result) const;
+
+        /// The two-pi averaging interpolation behind limitAverage and limitAverageExact
+        double interpolateLimit(double x, double y, double mZ, bool useSegmentGrids) const;
+
       //@}
 
       /// @name Construction and Destruction
@@ -96,6 +139,10 @@ namespace Gambit
         /// @brief Two-pi averaging interpolator to find limits between limit curves
         double limitAverage(double x, double y, double mZ) const;
 
+        /// @brief As limitAverage, but testing every contour segment rather than using
+        /// the segment grids (for validating them; see lep_limit_grid_benchmark)
+        double limitAverageExact(double x, double y, double mZ) const;
+
         /// @brief Dump limit average data into a file for average debugging
         void dumpPlotData(double xlow, double xhigh, double ylow, double yhigh,
                           double mZ, std::string filename, int ngrid=100) const;
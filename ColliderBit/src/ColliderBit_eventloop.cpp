@@ -31,20 +31,31 @@
 ///  \date   2018 Jan
 ///  \date   2018 May
 ///
+///  \author agent
+///          (agent@local)
+///  \date   2026 Oct
+///
 ///  *********************************************
 
 #include <cmath>
 #include <string>
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <fstream>
 #include <memory>
 #include <numeric>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "gambit/Elements/gambit_module_headers.hpp"
 #include "gambit/ColliderBit/MC_convergence.hpp"
+#include "gambit/ColliderBit/EventTickets.hpp"
+#include "gambit/ColliderBit/SignalYieldCache.hpp"
+#include "gambit/ColliderBit/XsecPrescreen.hpp"
 #include "gambit/ColliderBit/ColliderBit_rollcall.hpp"
+#include "gambit/ColliderBit/covariance_marginalisation.hpp"
 #include "gambit/ColliderBit/analyses/BaseAnalysis.hpp"
 
 #include "boost/math/distributions/poisson.hpp"
@@ -117,8 +128,175 @@ namespace Gambit
     bool useBuckFastIdentityDetector;
     bool haveUsedBuckFastIdentityDetector;
 
+    /// Background-only quantities for analyses with SR covariance matrices.
+    /// These never change during a scan, so they are computed on the first
+    /// point and cached by analysis name.
+    bkg_covariance_cache bkgCovarianceCache;
+
+    /// Optional reuse of the signal yields of an earlier point with (nearly) the same collider simulation inputs.
+    /// - currentYieldKey: the spectrum is set by getPythia at BASE_INIT (left empty if the cache is off), and
+    ///   the collider, Pythia settings and analyses by operateLHCLoop, getPythia and the analysis containers
+    ///   at COLLIDER_INIT
+    /// - reusedYields: the cache entry used for the current collider, or NULL if events are generated
+    /// - reusedYieldsScale: the factor by which the cross-sections of that entry are scaled for this point
+    /// - masterPythia: the master Pythia instance of the current collider, if it has been initialised, used to
+    ///   estimate the cross-section of each hard process when reusing an entry for a different spectrum
+    SignalYieldCache signalYieldCache;
+    SignalYieldCache::Key currentYieldKey;
+    const SignalYieldCache::Entry* reusedYields = NULL;
+    double reusedYieldsScale = 1.;
+    SpecializablePythia* masterPythia = NULL;
+
+    /// Pythia is initialised once per collider on thread 0 (the master instance) at COLLIDER_INIT, so that the
+    /// xsec veto and the signal yield cache can be decided on before the other threads initialise their own
+    /// instances at START_SUBPROCESS.  This is false if no events will be generated for the current collider.
+    bool pythiaThreadInitNeeded;
+
     /// @}
 
+    /// Initialise a Pythia instance for the current collider with the given seed, retrying once with a new
+    /// random seed if that fails.  Returns false, having flagged the point as invalid, if Pythia can't initialise.
+    bool initPythia(SpecializablePythia& pythia, const str& pythia_doc_path, const std::vector<str>& pythiaCommonOptions,
+                    const SLHAstruct* slha, int seed)
+    {
+      std::vector<str> pythiaOptions = pythiaCommonOptions;
+      pythiaOptions.push_back("Random:seed = " + std::to_string(seed));
+
+      #ifdef COLLIDERBIT_DEBUG
+      cout << debug_prefix() << "initPythia: My Pythia seed is: " << std::to_string(seed) << endl;
+      #endif
+
+      pythia.resetSpecialization(*iterPythiaNames);
+
+      try
+      {
+        pythia.init(pythia_doc_path, pythiaOptions, slha);
+      }
+      catch (SpecializablePythia::InitializationError &e)
+      {
+        // Append new seed to override the previous one
+        int newSeedBase = int(Random::draw() * 899990000.);
+        pythiaOptions.push_back("Random:seed = " + std::to_string(newSeedBase));
+        pythia.resetSpecialization(*iterPythiaNames);
+        try
+        {
+          pythia.init(pythia_doc_path, pythiaOptions, slha);
+        }
+        catch (SpecializablePythia::InitializationError &e)
+        {
+          #ifdef COLLIDERBIT_DEBUG
+          cout << debug_prefix() << "SpecializablePythia::InitializationError caught in initPythia. Will discard this point." << endl;
+          #endif
+          piped_invalid_point.request("Bad point: Pythia can't initialize");
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// Initialise the master Pythia instance on thread 0 at COLLIDER_INIT, and apply the xsec veto
+    /// based on its estimate of the total cross-section.  Returns false if event generation should be skipped.
+    bool initMasterPythia(SpecializablePythia& pythia, const str& pythia_doc_path, const std::vector<str>& pythiaCommonOptions,
+                          const SLHAstruct* slha, double totalxsec_fb_veto)
+    {
+      if (not initPythia(pythia, pythia_doc_path, pythiaCommonOptions, slha, seedBase)) return false;
+
+      // Get the upper limit xsec as estimated by Pythia
+      double totalxsec_pb = pythia.xsecEstimate_pb();
+
+      #ifdef COLLIDERBIT_DEBUG
+      cout << debug_prefix() << "totalxsec [fb] = " << totalxsec_pb * 1e3 << ", veto limit [fb] = " << totalxsec_fb_veto << endl;
+      #endif
+
+      // Check for NaN xsec
+      if (Utils::isnan(totalxsec_pb))
+      {
+        #ifdef COLLIDERBIT_DEBUG
+        cout << debug_prefix() << "Got NaN cross-section estimate from Pythia." << endl;
+        #endif
+        piped_invalid_point.request("Got NaN cross-section estimate from Pythia.");
+        return false;
+      }
+
+      // Wrap up loop if veto applies
+      if (totalxsec_pb * 1e3 < totalxsec_fb_veto)
+      {
+        #ifdef COLLIDERBIT_DEBUG
+        cout << debug_prefix() << "Cross-section veto applies. Will now call Loop::wrapup() to skip event generation for this collider." << endl;
+        #endif
+        return false;
+      }
+      return true;
+    }
+
+    /// Initialise the Pythia instance of the current thread at START_SUBPROCESS.  Thread 0 keeps the master
+    /// instance; the other threads only initialise their own (with their own seeds) if events will be generated.
+    /// Returns false if Pythia can't initialise.
+    bool initThreadPythia(SpecializablePythia& pythia, const str& pythia_doc_path, const std::vector<str>& pythiaCommonOptions,
+                          const SLHAstruct* slha)
+    {
+      int thread = omp_get_thread_num();
+      if (thread == 0) return true;
+      if (not pythiaThreadInitNeeded)
+      {
+        pythia.clear();
+        return true;
+      }
+      return initPythia(pythia, pythia_doc_path, pythiaCommonOptions, slha, seedBase + thread);
+    }
+
+    /// Write the time spent in each analysis (summed over threads) for the current collider to the log
+    void logAnalysisTimings(const HEPUtilsAnalysisContainer& container)
+    {
+      std::stringstream ss;
+      ss << "Time spent in each analysis for collider " << container.get_current_collider() << ":";
+      for (auto& analysis_time_pair : container.collect_analysis_timings())
+      {
+        ss << "\n  " << analysis_time_pair.first << ": " << analysis_time_pair.second << " s";
+      }
+      logger() << LogTags::debug << ss.str() << EOM;
+    }
+
+    /// Add the analyses of a container to the signal yield cache key of the current collider
+    void addToYieldKey(const str& container_name, const std::vector<str>& analysis_names)
+    {
+      if (signalYieldCache.enabled()) currentYieldKey.analyses[container_name] = analysis_names;
+    }
+
+    /// If the current collider reuses cached signal yields, restore and scale them for all analyses in the container
+    bool restoreCachedYields(HEPUtilsAnalysisContainer& container, const str& container_name)
+    {
+      if (reusedYields == NULL) return false;
+      // The entry was checked against the analyses in its key before the event loop, so this cannot fail unless an
+      // analysis has changed its signal regions; if it does, the point is skipped rather than given wrong yields.
+      if (not SignalYieldCache::restore(*reusedYields, container_name, container, reusedYieldsScale))
+      {
+        logger() << LogTags::debug << "The cached signal yields do not match the analyses in " << container_name << "." << EOM;
+        piped_invalid_point.request("Cached signal yields do not match the analyses in " + container_name);
+        return true;
+      }
+      container.scale();
+      return true;
+    }
+
+    /// Estimate the cross-section (in pb) of each hard process at the current point, by process code, from a
+    /// short run of the master Pythia instance.  Returns an empty map if there is no master instance.
+    std::map<int,double> probeProcessXsecs(int nEvents)
+    {
+      std::map<int,double> result;
+      if (masterPythia == NULL) return result;
+      Pythia8::Event event;
+      for (int i = 0; i < nEvents; ++i)
+      {
+        // Failed events count as tried, but are otherwise ignored
+        try { masterPythia->nextEvent(event); }
+        catch (SpecializablePythia::EventGenerationError& e) {}
+      }
+      for (auto& code_xsec_pair : masterPythia->processXsecs_pb()) result[code_xsec_pair.first] = code_xsec_pair.second.first;
+      return result;
+    }
+
+
     // *************************************************
     // Rollcalled functions properly hooked up to Gambit
     // *************************************************
@@ -200,6 +378,15 @@ namespace Gambit
       // Allow the user to specify the Pythia seed base (for debugging). If the default value -1
       // is used, a new seed is generated for every new Pythia configuration and parameter point.
       int yaml_seedBase = runOptions->getValueOrDef<int>(-1, "pythiaSeedBase");
+      // Optionally reuse the signal yields of an earlier point with the same collider simulation inputs, up to a
+      // tolerance on the spectrum (see SignalYieldCache::Key::distance).  Off by default.  Reused yields from a
+      // different spectrum are rescaled with the process cross-sections of a short run of the master instance.
+      const bool reuseYields = runOptions->getValueOrDef<bool>(false, "reuse_yields");
+      signalYieldCache.configure(reuseYields ? runOptions->getValueOrDef<int>(16, "yield_cache_size") : 0,
+                                 runOptions->getValueOrDef<double>(0., "yield_reuse_tolerance"));
+      const int yieldReuseProbeEvents = runOptions->getValueOrDef<int>(500, "yield_reuse_probe_events");
+      currentYieldKey = SignalYieldCache::Key();
+      reusedYields = NULL;
 
       // Check that length of pythiaNames and nEvents agree!
       if (pythiaNames.size() != Dep::MC_ConvergenceSettings->min_nEvents.size())
@@ -232,6 +419,7 @@ namespace Gambit
         // Store some collider info
         colliderInfo[*iterPythiaNames]["seed_base"] = seedBase;
         colliderInfo[*iterPythiaNames]["final_event_count"] = 0;  // Will be updated later
+        colliderInfo[*iterPythiaNames]["reused_yields"] = 0;
 
         // Get the minimum and maximum number of events to run for this collider, and the convergence step
         int min_nEvents = Dep::MC_ConvergenceSettings->min_nEvents[indexPythiaNames];
@@ -244,6 +432,14 @@ namespace Gambit
 
         piped_invalid_point.check();
         Loop::reset();
+        masterPythia = NULL;
+
+        // Start the signal yield cache key for this collider with its event-loop settings
+        currentYieldKey.new_collider(*iterPythiaNames);
+        currentYieldKey.settings.push_back("min_nEvents = " + std::to_string(min_nEvents));
+        currentYieldKey.settings.push_back("max_nEvents = " + std::to_string(max_nEvents));
+        currentYieldKey.settings.push_back("stoppingres = " + std::to_string(stoppingres));
+
         #ifdef COLLIDERBIT_DEBUG
         cout << debug_prefix() << "operateLHCLoop: Will execute COLLIDER_INIT" << endl;
         #endif
@@ -253,13 +449,43 @@ namespace Gambit
         piped_warnings.check(ColliderBit_warning());
         piped_errors.check(ColliderBit_error());
 
+        // Can we reuse the signal yields of an earlier point instead of generating events?
+        // (The key has been completed by getPythia and the analysis containers at COLLIDER_INIT.)
+        reusedYields = NULL;
+        reusedYieldsScale = 1.;
+        signalYieldCache.discard();
+        if (signalYieldCache.enabled() and currentYieldKey.has_spectrum() and not *Loop::done)
+        {
+          reusedYields = signalYieldCache.find(currentYieldKey);
+          // An entry for a different spectrum is only reused if the process cross-sections allow it
+          if (reusedYields != NULL and reusedYields->key.distance(currentYieldKey) > 0)
+          {
+            reusedYieldsScale = signalYieldCache.xsec_scale(*reusedYields, probeProcessXsecs(yieldReuseProbeEvents));
+            logger() << LogTags::debug << "operateLHCLoop: " << *iterPythiaNames << ": cross-section scale factor of the "
+                     << "closest signal yield cache entry: " << reusedYieldsScale << "." << EOM;
+            if (reusedYieldsScale < 0)
+            {
+              signalYieldCache.reject();
+              reusedYields = NULL;
+              reusedYieldsScale = 1.;
+            }
+          }
+          if (reusedYields == NULL) signalYieldCache.start(currentYieldKey);
+          else eventsGenerated = true;
+          logger() << LogTags::debug << "operateLHCLoop: " << *iterPythiaNames << ": signal yield cache "
+                   << (reusedYields == NULL ? "miss" : "hit") << " (" << signalYieldCache.n_hits() << " hits, "
+                   << signalYieldCache.n_misses() << " misses, " << signalYieldCache.size() << " entries)." << EOM;
+        }
+
+        // Only initialise Pythia on the other threads if we will actually generate events
+        pythiaThreadInitNeeded = (reusedYields == NULL and not *Loop::done);
+
         //
         // OMP parallelized sections begin here
         //
         #ifdef COLLIDERBIT_DEBUG
         cout << debug_prefix() << "operateLHCLoop: Will execute START_SUBPROCESS";
         #endif
-        int currentEvent = 0;
         #pragma omp parallel
         {
           Loop::executeIteration(START_SUBPROCESS);
@@ -268,68 +494,145 @@ namespace Gambit
         piped_warnings.check(ColliderBit_warning());
         piped_errors.check(ColliderBit_error());
 
-        // Convergence loop
-        while(currentEvent < max_nEvents and not *Loop::done)
-        {
-          int eventCountBetweenConvergenceChecks = 0;
+        // Shared event-loop counters, only ever touched with omp atomics.
+        // - tickets: event numbers and places among the max_nEvents good events (see EventTickets)
+        // - snapshotRequest: incremented by the checking thread to ask every thread to refresh its convergence data
+        // - snapshotsReported: number of threads that have refreshed their convergence data for the current request
+        EventTickets tickets(max_nEvents);
+        int snapshotRequest = 0;
+        int snapshotsReported = 0;
+        std::vector<long long> eventsPerThread(omp_get_max_threads(), 0);
+        std::vector<double> secondsPerThread(omp_get_max_threads(), 0.0);
+        double loopStart = omp_get_wtime();
 
-          #ifdef COLLIDERBIT_DEBUG
-          cout << debug_prefix() << "Starting main event loop.  Will do " << stoppingres << " events before testing convergence." << endl;
-          #endif
+        #ifdef COLLIDERBIT_DEBUG
+        cout << debug_prefix() << "Starting main event loop.  Will test convergence every " << stoppingres << " events." << endl;
+        #endif
 
-          // Main event loop
-          #pragma omp parallel
+        // Main event loop.  A single parallel region is used for the whole collider; convergence is checked
+        // by thread 0 in between its own events, on per-thread snapshots of the analysis results, while the
+        // other threads carry on generating events.  A snapshot is only ever rewritten after a new request,
+        // and a new request is only made once the previous check has finished, so no thread ever writes
+        // convergence data while it is being read.
+        #pragma omp parallel
+        {
+          const int thread = omp_get_thread_num();
+          const int nThreads = omp_get_num_threads();
+          const double threadStart = omp_get_wtime();
+          long long myEvents = 0;
+          int mySnapshot = 0;
+          int nextCheck = stoppingres;
+          bool checkPending = false;
+
+          while(reusedYields == NULL and
+                not *Loop::done and
+                not piped_errors.inquire() and
+                nFailedEvents <= maxFailedEvents)
           {
-            while(eventCountBetweenConvergenceChecks < stoppingres and
-                  currentEvent < max_nEvents and
-                  not *Loop::done and
-                  not piped_errors.inquire() and
-                  nFailedEvents <= maxFailedEvents)
+            // Refresh this thread's convergence snapshot if the checking thread has asked for it
+            int request;
+            #pragma omp atomic read
+            request = snapshotRequest;
+            if (request != mySnapshot)
+            {
+              Loop::executeIteration(COLLECT_CONVERGENCE_DATA);
+              mySnapshot = request;
+              #pragma omp atomic update
+              snapshotsReported++;
+            }
+
+            // Thread 0 decides when to take snapshots, and checks convergence once all threads have reported
+            if (thread == 0)
             {
-              if (!eventsGenerated) eventsGenerated = true;
-              try
+              const int done = tickets.n_done();
+              int reported;
+              #pragma omp atomic read
+              reported = snapshotsReported;
+              if (checkPending)
               {
-                Loop::executeIteration(currentEvent);
-                currentEvent++;
-                eventCountBetweenConvergenceChecks++;
+                if (reported == nThreads)
+                {
+                  Loop::executeIteration(CHECK_CONVERGENCE);
+                  checkPending = false;
+                  #pragma omp atomic write
+                  snapshotsReported = 0;
+                  if (*Loop::done) break;
+                }
               }
-              catch (std::domain_error& e)
+              else if (done >= nextCheck)
               {
-                cout << "\n   Continuing to the next event...\n\n";
+                while (nextCheck <= done) nextCheck += stoppingres;
+                // Don't bother with convergence stuff if we haven't passed the minimum number of events yet
+                if (done >= min_nEvents)
+                {
+                  checkPending = true;
+                  #pragma omp atomic update
+                  snapshotRequest++;
+                }
               }
             }
+
+            // Claim a place and an event number.  Stop once max_nEvents events have been generated successfully;
+            // if every place is taken by events still in progress, wait and try again, as one of those events may
+            // yet fail and give its place back.
+            int eventNumber;
+            const EventTickets::status ticket = tickets.claim(eventNumber);
+            if (ticket == EventTickets::finished) break;
+            if (ticket == EventTickets::wait)
+            {
+              std::this_thread::yield();
+              continue;
+            }
+
+            if (!eventsGenerated)
+            {
+              #pragma omp atomic write
+              eventsGenerated = true;
+            }
+            try
+            {
+              Loop::executeIteration(eventNumber);
+              myEvents++;
+              tickets.succeeded();
+            }
+            catch (std::domain_error& e)
+            {
+              // Give the place back so that another event is generated in its stead
+              tickets.failed();
+              cout << "\n   Continuing to the next event...\n\n";
+            }
           }
-          // Any problems during the main event loop?
-          piped_warnings.check(ColliderBit_warning());
-          piped_errors.check(ColliderBit_error());
 
-          #ifdef COLLIDERBIT_DEBUG
-          cout << debug_prefix() << "Did " << eventCountBetweenConvergenceChecks << " events of " << currentEvent << " simulated so far." << endl;
-          #endif
+          eventsPerThread[thread] = myEvents;
+          secondsPerThread[thread] = omp_get_wtime() - threadStart;
+        }
+        double loopSeconds = omp_get_wtime() - loopStart;
+        int currentEvent = (reusedYields == NULL ? tickets.n_done() : reusedYields->n_events);
+
+        // Any problems during the main event loop?
+        piped_warnings.check(ColliderBit_warning());
+        piped_errors.check(ColliderBit_error());
 
-          // Break convergence loop if too many events fail
-          if(nFailedEvents > maxFailedEvents) break;
+        #ifdef COLLIDERBIT_DEBUG
+        cout << debug_prefix() << "Did " << currentEvent << " events in " << loopSeconds << " s." << endl;
+        #endif
 
-          // Don't bother with convergence stuff if we haven't passed the minimum number of events yet
-          if (currentEvent >= min_nEvents)
+        // Report the event generation rate, in total and for each thread
+        if (reusedYields == NULL)
+        {
+          std::stringstream rates;
+          rates << "operateLHCLoop: " << *iterPythiaNames << ": " << currentEvent << " events in " << loopSeconds
+                << " s (" << (loopSeconds > 0 ? currentEvent/loopSeconds : 0.0) << " events/s). Events/s per thread:";
+          for (size_t i = 0; i != eventsPerThread.size(); ++i)
           {
-            #pragma omp parallel
-            {
-              Loop::executeIteration(COLLECT_CONVERGENCE_DATA);
-            }
-            // Any problems during the COLLECT_CONVERGENCE_DATA step?
-            piped_warnings.check(ColliderBit_warning());
-            piped_errors.check(ColliderBit_error());
-
-            Loop::executeIteration(CHECK_CONVERGENCE);
-            // Any problems during the CHECK_CONVERGENCE step?
-            piped_warnings.check(ColliderBit_warning());
-            piped_errors.check(ColliderBit_error());
+            rates << " " << (secondsPerThread[i] > 0 ? eventsPerThread[i]/secondsPerThread[i] : 0.0);
           }
+          logger() << LogTags::debug << rates.str() << EOM;
         }
 
-        // Store the number of generated events
-        colliderInfo[*iterPythiaNames]["final_event_count"] = currentEvent;  // Will be updated later
+        // Store the number of generated (or reused) events
+        colliderInfo[*iterPythiaNames]["final_event_count"] = currentEvent;
+        colliderInfo[*iterPythiaNames]["reused_yields"] = (reusedYields != NULL);
 
         // Break collider loop if too many events have failed
         if(nFailedEvents > maxFailedEvents)
@@ -351,6 +654,9 @@ namespace Gambit
         //
 
         Loop::executeIteration(COLLIDER_FINALIZE);
+
+        // Keep the signal yields of this collider for later points
+        if (reusedYields == NULL and currentEvent > 0) signalYieldCache.commit(currentEvent);
       }
 
       // Nicely thank the loop for being quiet, and restore everyone's vocal cords
@@ -366,27 +672,53 @@ namespace Gambit
 
     // *** Hard Scattering Collider Simulators ***
 
+    /// Options of getPythia, parsed once per set of options (see Options::getParsed)
+    struct Pythia_options
+    {
+      str doc_path;
+      bool has_xsec_vetos;
+      std::vector<double> xsec_vetos;
+      double xsec_prescreen_margin;
+      /// Extra Pythia settings, by collider name
+      std::map<str, std::vector<str> > collider_settings;
+
+      Pythia_options(const Options& runOptions)
+      {
+        const str default_doc_path = GAMBIT_DIR "/Backends/installed/Pythia/" +
+          Backends::backendInfo().default_version("Pythia") +
+          "/share/Pythia8/xmldoc/";
+        doc_path = runOptions.getValueOrDef<str>(default_doc_path, "Pythia_doc_path");
+        has_xsec_vetos = runOptions.hasKey("xsec_vetos");
+        if (has_xsec_vetos) xsec_vetos = runOptions.getValue<std::vector<double> >("xsec_vetos");
+        // Safety margin of the xsec pre-screen (see XsecPrescreen); zero switches it off
+        xsec_prescreen_margin = runOptions.getValueOrDef<double>(0., "xsec_prescreen_margin");
+        // Any list-valued option may hold the settings for a collider of the same name
+        for (const str& name : runOptions.getNames())
+        {
+          if (runOptions.getNode(name).IsSequence()) collider_settings[name] = runOptions.getValue<std::vector<str> >(name);
+        }
+      }
+    };
+
     void getPythia(SpecializablePythia &result)
     {
       using namespace Pipes::getPythia;
 
       static str pythia_doc_path;
-      static str default_doc_path;
       static bool pythia_doc_path_needs_setting = true;
       static std::vector<str> pythiaCommonOptions;
       static SLHAstruct slha;
       static SLHAstruct spectrum;
       static std::vector<double> xsec_vetos;
+      static XsecPrescreen xsecPrescreen;
+      const Pythia_options& options = runOptions->getParsed<Pythia_options>();
 
       if (*Loop::iteration == BASE_INIT)
       {
         // Setup the Pythia documentation path
         if (pythia_doc_path_needs_setting)
         {
-          default_doc_path = GAMBIT_DIR "/Backends/installed/Pythia/" +
-            Backends::backendInfo().default_version("Pythia") +
-            "/share/Pythia8/xmldoc/";
-          pythia_doc_path = runOptions->getValueOrDef<str>(default_doc_path, "Pythia_doc_path");
+          pythia_doc_path = options.doc_path;
           // Print the Pythia banner once.
           result.banner(pythia_doc_path);
           pythia_doc_path_needs_setting = false;
@@ -413,10 +745,13 @@ namespace Gambit
           ColliderBit_error().raise(LOCAL_INFO, "No spectrum object available for this model.");
         }
 
+        // The spectrum identifies the point in the signal yield cache
+        if (signalYieldCache.enabled()) currentYieldKey.set_spectrum(slha);
+
         // Read xsec veto values and store in static variable 'xsec_vetos'
-        std::vector<double> default_xsec_vetos(pythiaNames.size(), 0.0);
-        xsec_vetos = runOptions->getValueOrDef<std::vector<double> >(default_xsec_vetos, "xsec_vetos");
+        xsec_vetos = options.has_xsec_vetos ? options.xsec_vetos : std::vector<double>(pythiaNames.size(), 0.0);
         CHECK_EQUAL_VECTOR_LENGTH(xsec_vetos, pythiaNames)
+        xsecPrescreen.configure(options.xsec_prescreen_margin);
       }
 
       else if (*Loop::iteration == COLLIDER_INIT)
@@ -429,115 +764,63 @@ namespace Gambit
         pythiaCommonOptions.push_back("SLHA:verbose = 0");
 
         // Get options from yaml file. If the SpecializablePythia specialization is hard-coded, okay with no options.
-        if (runOptions->hasKey(*iterPythiaNames))
+        auto addPythiaOptions = options.collider_settings.find(*iterPythiaNames);
+        if (addPythiaOptions != options.collider_settings.end())
         {
-          std::vector<str> addPythiaOptions = runOptions->getValue<std::vector<str>>(*iterPythiaNames);
-          pythiaCommonOptions.insert(pythiaCommonOptions.end(), addPythiaOptions.begin(), addPythiaOptions.end());
+          pythiaCommonOptions.insert(pythiaCommonOptions.end(), addPythiaOptions->second.begin(), addPythiaOptions->second.end());
         }
 
-        // We need showProcesses for the xsec veto.
-        pythiaCommonOptions.push_back("Init:showProcesses = on");
-
         // We need "SLHA:file = slhaea" for the SLHAea interface.
         pythiaCommonOptions.push_back("SLHA:file = slhaea");
-      }
-
-      else if (*Loop::iteration == START_SUBPROCESS)
-      {
-        // Variables needed for the xsec veto
-        std::stringstream processLevelOutput;
-        str _junk, readline;
-        int code, nxsec;
-        double xsec, totalxsec;
-
-        // Each thread needs an independent Pythia instance at the start
-        // of each event generation loop.
-        // Thus, the actual Pythia initialization is
-        // *after* COLLIDER_INIT, within omp parallel.
-
-        result.clear();
-
-        // Get the Pythia options that are common across all OMP threads ('pythiaCommonOptions')
-        // and then add the thread-specific seed
-        std::vector<str> pythiaOptions = pythiaCommonOptions;
-        pythiaOptions.push_back("Random:seed = " + std::to_string(seedBase + omp_get_thread_num()));
-
-        #ifdef COLLIDERBIT_DEBUG
-        cout << debug_prefix() << "getPythia: My Pythia seed is: " << std::to_string(seedBase + omp_get_thread_num()) << endl;
-        #endif
 
-        result.resetSpecialization(*iterPythiaNames);
-
-        try
+        // The Pythia settings are part of the signal yield cache key
+        if (signalYieldCache.enabled())
         {
-          result.init(pythia_doc_path, pythiaOptions, &slha, processLevelOutput);
+          currentYieldKey.settings.insert(currentYieldKey.settings.end(), pythiaCommonOptions.begin(), pythiaCommonOptions.end());
         }
-        catch (SpecializablePythia::InitializationError &e)
+
+        // If the pre-screen's upper limit on the cross-section is already below the veto, skip Pythia altogether
+        if (xsecPrescreen.enabled() and xsec_vetos[indexPythiaNames] > 0)
         {
-          // Append new seed to override the previous one
-          int newSeedBase = int(Random::draw() * 899990000.);
-          pythiaOptions.push_back("Random:seed = " + std::to_string(newSeedBase));
-          try
-          {
-            result.init(pythia_doc_path, pythiaOptions, &slha, processLevelOutput);
-          }
-          catch (SpecializablePythia::InitializationError &e)
+          const double ecm = XsecPrescreen::collider_ecm(*iterPythiaNames, pythiaCommonOptions);
+          const double upper_limit_fb = xsecPrescreen.xsec_upper_limit_fb(slha, ecm);
+          const bool vetoed = xsecPrescreen.vetoes(upper_limit_fb, xsec_vetos[indexPythiaNames]);
+          logger() << LogTags::debug << "getPythia: " << *iterPythiaNames << ": xsec pre-screen upper limit "
+                   << upper_limit_fb << " fb, veto " << xsec_vetos[indexPythiaNames] << " fb. "
+                   << "Pythia initialisations avoided so far: " << xsecPrescreen.n_colliders_vetoed() << " of "
+                   << xsecPrescreen.n_colliders_screened() << "." << EOM;
+          if (vetoed)
           {
             #ifdef COLLIDERBIT_DEBUG
-            cout << debug_prefix() << "SpecializablePythia::InitializationError caught in getPythia. Will discard this point." << endl;
+            cout << debug_prefix() << "Cross-section pre-screen veto applies. Will now call Loop::wrapup() to skip Pythia for this collider." << endl;
             #endif
-            piped_invalid_point.request("Bad point: Pythia can't initialize");
+            result.clear();
             Loop::wrapup();
             return;
           }
         }
 
-        // Should we apply the xsec veto and skip event generation?
-
-        // - Get the xsec veto value for the current collider
-        double totalxsec_fb_veto = xsec_vetos[indexPythiaNames];
-
-        // - Get the upper limt xsec as estimated by Pythia
-        code = -1;
-        nxsec = 0;
-        totalxsec = 0.;
-        while(true)
-        {
-          std::getline(processLevelOutput, readline);
-          std::istringstream issPtr(readline);
-          issPtr.seekg(47, issPtr.beg);
-          issPtr >> code;
-          if (!issPtr.good() && nxsec > 0) break;
-          issPtr >> _junk >> xsec;
-          if (issPtr.good())
-          {
-            totalxsec += xsec;
-            nxsec++;
-          }
-        }
-
-        #ifdef COLLIDERBIT_DEBUG
-        cout << debug_prefix() << "totalxsec [fb] = " << totalxsec * 1e12 << ", veto limit [fb] = " << totalxsec_fb_veto << endl;
-        #endif
+        // Initialise the master Pythia instance (thread 0) and apply the xsec veto
+        if (not initMasterPythia(result, pythia_doc_path, pythiaCommonOptions, &slha, xsec_vetos[indexPythiaNames])) Loop::wrapup();
+        else masterPythia = &result;
+      }
 
-        // - Check for NaN xsed
-        if (Utils::isnan(totalxsec))
-        {
-          #ifdef COLLIDERBIT_DEBUG
-          cout << debug_prefix() << "Got NaN cross-section estimate from Pythia." << endl;
-          #endif
-          piped_invalid_point.request("Got NaN cross-section estimate from Pythia.");
-          Loop::wrapup();
-          return;
-        }
+      else if (*Loop::iteration == START_SUBPROCESS)
+      {
+        // Each thread needs an independent Pythia instance at the start of each event generation loop.
+        // Thread 0 already has the master instance from COLLIDER_INIT; the others initialise their own
+        // here, within omp parallel, using the thread-specific seed.
+        if (not initThreadPythia(result, pythia_doc_path, pythiaCommonOptions, &slha)) Loop::wrapup();
+      }
 
-        // - Wrap up loop if veto applies
-        if (totalxsec * 1e12 < totalxsec_fb_veto)
+      else if (*Loop::iteration == END_SUBPROCESS)
+      {
+        // Keep the cross-section of each hard process for the signal yield cache
+        if (signalYieldCache.enabled() and reusedYields == NULL)
         {
-          #ifdef COLLIDERBIT_DEBUG
-          cout << debug_prefix() << "Cross-section veto applies. Will now call Loop::wrapup() to skip event generation for this collider." << endl;
-          #endif
-          Loop::wrapup();
+          const std::map<int, std::pair<double,long> > processXsecs = result.processXsecs_pb();
+          #pragma omp critical (signalYieldCache)
+          signalYieldCache.add_process_xsecs(processXsecs);
         }
       }
     }
@@ -603,99 +886,19 @@ namespace Gambit
           pythiaCommonOptions.insert(pythiaCommonOptions.end(), addPythiaOptions.begin(), addPythiaOptions.end());
         }
 
-        // We need showProcesses for the xsec veto.
-        pythiaCommonOptions.push_back("Init:showProcesses = on");
-
         // We need to control "SLHA:file" for the SLHA interface.
         pythiaCommonOptions.push_back("SLHA:file = " + filenames.at(fileCounter));
+
+        logger() << "Reading SLHA file: " << filenames.at(fileCounter) << EOM;
+
+        // Initialise the master Pythia instance (thread 0) and apply the xsec veto
+        if (not initMasterPythia(result, pythia_doc_path, pythiaCommonOptions, nullptr, xsec_vetos[indexPythiaNames])) Loop::wrapup();
       }
 
       if (*Loop::iteration == START_SUBPROCESS)
       {
-        // variables for xsec veto
-        std::stringstream processLevelOutput;
-        str _junk, readline;
-        int code, nxsec;
-        double xsec, totalxsec;
-
-        // Each thread needs an independent Pythia instance at the start
-        // of each event generation loop.
-        // Thus, the actual Pythia initialization is
-        // *after* COLLIDER_INIT, within omp parallel.
-
-        result.clear();
-
-        if (omp_get_thread_num() == 0) logger() << "Reading SLHA file: " << filenames.at(fileCounter) << EOM;
-
-        // Get the Pythia options that are common across all OMP threads ('pythiaCommonOptions')
-        // and then add the thread-specific seed
-        std::vector<str> pythiaOptions = pythiaCommonOptions;
-        pythiaOptions.push_back("Random:seed = " + std::to_string(seedBase + omp_get_thread_num()));
-
-        #ifdef COLLIDERBIT_DEBUG
-        cout << debug_prefix() << "getPythiaFileReader: My Pythia seed is: " << std::to_string(seedBase + omp_get_thread_num()) << endl;
-        #endif
-
-        result.resetSpecialization(*iterPythiaNames);
-
-        try
-        {
-          result.init(pythia_doc_path, pythiaOptions, processLevelOutput);
-        }
-        catch (SpecializablePythia::InitializationError &e)
-        {
-          // Append new seed to override the previous one
-          int newSeedBase = int(Random::draw() * 899990000.);
-          pythiaOptions.push_back("Random:seed = " + std::to_string(newSeedBase));
-          try
-          {
-            result.init(pythia_doc_path, pythiaOptions, processLevelOutput);
-          }
-          catch (SpecializablePythia::InitializationError &e)
-          {
-            piped_invalid_point.request("Bad point: Pythia can't initialize");
-            Loop::wrapup();
-            return;
-          }
-        }
-
-        // Should we apply the xsec veto and skip event generation?
-
-        // - Get the xsec veto value for the current collider
-        double totalxsec_fb_veto = xsec_vetos[indexPythiaNames];
-
-        // - Get the upper limt xsec as estimated by Pythia
-        code = -1;
-        nxsec = 0;
-        totalxsec = 0.;
-        while(true)
-        {
-          std::getline(processLevelOutput, readline);
-          std::istringstream issPtr(readline);
-          issPtr.seekg(47, issPtr.beg);
-          issPtr >> code;
-          if (!issPtr.good() && nxsec > 0) break;
-          issPtr >> _junk >> xsec;
-          if (issPtr.good())
-          {
-            totalxsec += xsec;
-            nxsec++;
-          }
-        }
-
-        #ifdef COLLIDERBIT_DEBUG
-        cout << debug_prefix() << "totalxsec [fb] = " << totalxsec * 1e12 << ", veto limit [fb] = " << totalxsec_fb_veto << endl;
-        #endif
-
-        // - Wrap up loop if veto applies
-        if (totalxsec * 1e12 < totalxsec_fb_veto)
-        {
-          #ifdef COLLIDERBIT_DEBUG
-          cout << debug_prefix() << "Cross-section veto applies. Will now call Loop::wrapup() to skip event generation for this collider." << endl;
-          #endif
-          Loop::wrapup();
-        }
-
+        // Thread 0 already has the master instance from COLLIDER_INIT (see getPythia)
+        if (not initThreadPythia(result, pythia_doc_path, pythiaCommonOptions, nullptr)) Loop::wrapup();
       }
 
       if (*Loop::iteration == BASE_FINALIZE) fileCounter++;
@@ -705,6 +908,22 @@ namespace Gambit
 
     // *** Detector Simulators ***
 
+    /// Options of the getBuckFast* functions, parsed once per set of options (see Options::getParsed).
+    /// Lists not given in the options are left empty, to be replaced by per-collider defaults.
+    struct BuckFast_options
+    {
+      std::vector<bool> useDetector;
+      std::vector<bool> partonOnly;
+      std::vector<double> antiktR;
+
+      BuckFast_options(const Options& runOptions)
+      {
+        useDetector = runOptions.getValueOrDef<std::vector<bool> >(std::vector<bool>(), "useDetector");
+        partonOnly = runOptions.getValueOrDef<std::vector<bool> >(std::vector<bool>(), "partonOnly");
+        antiktR = runOptions.getValueOrDef<std::vector<double> >(std::vector<double>(), "antiktR");
+      }
+    };
+
     void getBuckFastATLAS(BuckFastSmearATLAS &result)
     {
       using namespace Pipes::getBuckFastATLAS;
@@ -715,16 +934,14 @@ namespace Gambit
       if (*Loop::iteration == BASE_INIT)
       {
         // Read options
-        std::vector<bool> default_useDetector(pythiaNames.size(), true);  // BuckFastATLAS is switched on by default
-        useDetector = runOptions->getValueOrDef<std::vector<bool> >(default_useDetector, "useDetector");
+        const BuckFast_options& options = runOptions->getParsed<BuckFast_options>();
+        useDetector = options.useDetector.empty() ? std::vector<bool>(pythiaNames.size(), true) : options.useDetector;  // BuckFastATLAS is switched on by default
         CHECK_EQUAL_VECTOR_LENGTH(useDetector,pythiaNames)
 
-        std::vector<bool> default_partonOnly(pythiaNames.size(), false);
-        partonOnly = runOptions->getValueOrDef<std::vector<bool> >(default_partonOnly, "partonOnly");
+        partonOnly = options.partonOnly.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.partonOnly;
         CHECK_EQUAL_VECTOR_LENGTH(partonOnly,pythiaNames)
 
-        std::vector<double> default_antiktR(pythiaNames.size(), 0.4);
-        antiktR = runOptions->getValueOrDef<std::vector<double> >(default_antiktR, "antiktR");
+        antiktR = options.antiktR.empty() ? std::vector<double>(pythiaNames.size(), 0.4) : options.antiktR;
         CHECK_EQUAL_VECTOR_LENGTH(antiktR,pythiaNames)
 
         return;
@@ -762,16 +979,14 @@ namespace Gambit
       if (*Loop::iteration == BASE_INIT)
       {
         // Read options
-        std::vector<bool> default_useDetector(pythiaNames.size(), false);  // BuckFastATLASnoeff is switched off by default
-        useDetector = runOptions->getValueOrDef<std::vector<bool> >(default_useDetector, "useDetector");
+        const BuckFast_options& options = runOptions->getParsed<BuckFast_options>();
+        useDetector = options.useDetector.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.useDetector;  // BuckFastATLASnoeff is switched off by default
         CHECK_EQUAL_VECTOR_LENGTH(useDetector,pythiaNames)
 
-        std::vector<bool> default_partonOnly(pythiaNames.size(), false);
-        partonOnly = runOptions->getValueOrDef<std::vector<bool> >(default_partonOnly, "partonOnly");
+        partonOnly = options.partonOnly.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.partonOnly;
         CHECK_EQUAL_VECTOR_LENGTH(partonOnly,pythiaNames)
 
-        std::vector<double> default_antiktR(pythiaNames.size(), 0.4);
-        antiktR = runOptions->getValueOrDef<std::vector<double> >(default_antiktR, "antiktR");
+        antiktR = options.antiktR.empty() ? std::vector<double>(pythiaNames.size(), 0.4) : options.antiktR;
         CHECK_EQUAL_VECTOR_LENGTH(antiktR,pythiaNames)
 
         return;
@@ -809,16 +1024,14 @@ namespace Gambit
       if (*Loop::iteration == BASE_INIT)
       {
         // Read options
-        std::vector<bool> default_useDetector(pythiaNames.size(), true);  // BuckFastCMS is switched on by default
-        useDetector = runOptions->getValueOrDef<std::vector<bool> >(default_useDetector, "useDetector");
+        const BuckFast_options& options = runOptions->getParsed<BuckFast_options>();
+        useDetector = options.useDetector.empty() ? std::vector<bool>(pythiaNames.size(), true) : options.useDetector;  // BuckFastCMS is switched on by default
         CHECK_EQUAL_VECTOR_LENGTH(useDetector,pythiaNames)
 
-        std::vector<bool> default_partonOnly(pythiaNames.size(), false);
-        partonOnly = runOptions->getValueOrDef<std::vector<bool> >(default_partonOnly, "partonOnly");
+        partonOnly = options.partonOnly.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.partonOnly;
         CHECK_EQUAL_VECTOR_LENGTH(partonOnly,pythiaNames)
 
-        std::vector<double> default_antiktR(pythiaNames.size(), 0.4);
-        antiktR = runOptions->getValueOrDef<std::vector<double> >(default_antiktR, "antiktR");
+        antiktR = options.antiktR.empty() ? std::vector<double>(pythiaNames.size(), 0.4) : options.antiktR;
         CHECK_EQUAL_VECTOR_LENGTH(antiktR,pythiaNames)
 
         return;
@@ -853,16 +1066,14 @@ namespace Gambit
       if (*Loop::iteration == BASE_INIT)
       {
         // Read options
-        std::vector<bool> default_useDetector(pythiaNames.size(), false);  // BuckFastCMSnoeff is switched off by default
-        useDetector = runOptions->getValueOrDef<std::vector<bool> >(default_useDetector, "useDetector");
+        const BuckFast_options& options = runOptions->getParsed<BuckFast_options>();
+        useDetector = options.useDetector.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.useDetector;  // BuckFastCMSnoeff is switched off by default
         CHECK_EQUAL_VECTOR_LENGTH(useDetector,pythiaNames)
 
-        std::vector<bool> default_partonOnly(pythiaNames.size(), false);
-        partonOnly = runOptions->getValueOrDef<std::vector<bool> >(default_partonOnly, "partonOnly");
+        partonOnly = options.partonOnly.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.partonOnly;
         CHECK_EQUAL_VECTOR_LENGTH(partonOnly,pythiaNames)
 
-        std::vector<double> default_antiktR(pythiaNames.size(), 0.4);
-        antiktR = runOptions->getValueOrDef<std::vector<double> >(default_antiktR, "antiktR");
+        antiktR = options.antiktR.empty() ? std::vector<double>(pythiaNames.size(), 0.4) : options.antiktR;
         CHECK_EQUAL_VECTOR_LENGTH(antiktR,pythiaNames)
 
         return;
@@ -897,16 +1108,14 @@ namespace Gambit
       if (*Loop::iteration == BASE_INIT)
       {
         // Read options
-        std::vector<bool> default_useDetector(pythiaNames.size(), false);  // BuckFastIdentity is switched off by default
-        useDetector = runOptions->getValueOrDef<std::vector<bool> >(default_useDetector, "useDetector");
+        const BuckFast_options& options = runOptions->getParsed<BuckFast_options>();
+        useDetector = options.useDetector.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.useDetector;  // BuckFastIdentity is switched off by default
         CHECK_EQUAL_VECTOR_LENGTH(useDetector,pythiaNames)
 
-        std::vector<bool> default_partonOnly(pythiaNames.size(), false);
-        partonOnly = runOptions->getValueOrDef<std::vector<bool> >(default_partonOnly, "partonOnly");
+        partonOnly = options.partonOnly.empty() ? std::vector<bool>(pythiaNames.size(), false) : options.partonOnly;
         CHECK_EQUAL_VECTOR_LENGTH(partonOnly,pythiaNames)
 
-        std::vector<double> default_antiktR(pythiaNames.size(), 0.4);
-        antiktR = runOptions->getValueOrDef<std::vector<double> >(default_antiktR, "antiktR");
+        antiktR = options.antiktR.empty() ? std::vector<double>(pythiaNames.size(), 0.4) : options.antiktR;
         CHECK_EQUAL_VECTOR_LENGTH(antiktR,pythiaNames)
 
         return;
@@ -981,6 +1190,9 @@ namespace Gambit
           ColliderBit_error().raise(LOCAL_INFO, errmsg);
         }
 
+        // The analyses are part of the signal yield cache key
+        addToYieldKey("ATLASAnalysisContainer", analyses[indexPythiaNames]);
+
         return;
       }
 
@@ -1025,8 +1237,11 @@ namespace Gambit
 
       if (*Loop::iteration == COLLIDER_FINALIZE)
       {
+        if (restoreCachedYields(result, "ATLASAnalysisContainer")) return;
+        logAnalysisTimings(result);
         result.collect_and_add_signal();
         result.collect_and_improve_xsec();
+        signalYieldCache.store("ATLASAnalysisContainer", result);
         result.scale();
         return;
       }
@@ -1083,6 +1298,9 @@ namespace Gambit
           ColliderBit_error().raise(LOCAL_INFO, errmsg);
         }
 
+        // The analyses are part of the signal yield cache key
+        addToYieldKey("ATLASnoeffAnalysisContainer", analyses[indexPythiaNames]);
+
         return;
       }
 
@@ -1127,8 +1345,11 @@ namespace Gambit
 
       if (*Loop::iteration == COLLIDER_FINALIZE)
       {
+        if (restoreCachedYields(result, "ATLASnoeffAnalysisContainer")) return;
+        logAnalysisTimings(result);
         result.collect_and_add_signal();
         result.collect_and_improve_xsec();
+        signalYieldCache.store("ATLASnoeffAnalysisContainer", result);
         result.scale();
         return;
       }
@@ -1185,6 +1406,9 @@ namespace Gambit
           ColliderBit_error().raise(LOCAL_INFO, errmsg);
         }
 
+        // The analyses are part of the signal yield cache key
+        addToYieldKey("CMSAnalysisContainer", analyses[indexPythiaNames]);
+
         return;
       }
 
@@ -1229,8 +1453,11 @@ namespace Gambit
 
       if (*Loop::iteration == COLLIDER_FINALIZE)
       {
+        if (restoreCachedYields(result, "CMSAnalysisContainer")) return;
+        logAnalysisTimings(result);
         result.collect_and_add_signal();
         result.collect_and_improve_xsec();
+        signalYieldCache.store("CMSAnalysisContainer", result);
         result.scale();
         return;
       }
@@ -1286,6 +1513,9 @@ namespace Gambit
           ColliderBit_error().raise(LOCAL_INFO, errmsg);
         }
 
+        // The analyses are part of the signal yield cache key
+        addToYieldKey("CMSnoeffAnalysisContainer", analyses[indexPythiaNames]);
+
         return;
       }
 
@@ -1330,8 +1560,11 @@ namespace Gambit
 
       if (*Loop::iteration == COLLIDER_FINALIZE)
       {
+        if (restoreCachedYields(result, "CMSnoeffAnalysisContainer")) return;
+        logAnalysisTimings(result);
         result.collect_and_add_signal();
         result.collect_and_improve_xsec();
+        signalYieldCache.store("CMSnoeffAnalysisContainer", result);
         result.scale();
         return;
       }
@@ -1388,6 +1621,9 @@ namespace Gambit
           ColliderBit_error().raise(LOCAL_INFO, errmsg);
         }
 
+        // The analyses are part of the signal yield cache key
+        addToYieldKey("IdentityAnalysisContainer", analyses[indexPythiaNames]);
+
         return;
       }
 
@@ -1432,8 +1668,11 @@ namespace Gambit
 
       if (*Loop::iteration == COLLIDER_FINALIZE)
       {
+        if (restoreCachedYields(result, "IdentityAnalysisContainer")) return;
+        logAnalysisTimings(result);
         result.collect_and_add_signal();
         result.collect_and_improve_xsec();
+        signalYieldCache.store("IdentityAnalysisContainer", result);
         result.scale();
         return;
       }
@@ -1490,7 +1729,7 @@ namespace Gambit
     {
       using namespace Pipes::smearEventATLAS;
       if (*Loop::iteration <= BASE_INIT or !useBuckFastATLASDetector) return;
-      result.clear();
+      // No need to clear the result: processEvent recycles its particles and jets for the new event.
 
       // Get the next event from Pythia8, convert to HEPUtils::Event, and smear it
       try
@@ -1522,7 +1761,7 @@ namespace Gambit
     {
       using namespace Pipes::smearEventATLASnoeff;
       if (*Loop::iteration <= BASE_INIT or !useBuckFastATLASnoeffDetector) return;
-      result.clear();
+      // No need to clear the result: processEvent recycles its particles and jets for the new event.
 
       // Get the next event from Pythia8, convert to HEPUtils::Event, and smear it
       try
@@ -1554,7 +1793,7 @@ namespace Gambit
     {
       using namespace Pipes::smearEventCMS;
       if (*Loop::iteration <= BASE_INIT or !useBuckFastCMSDetector) return;
-      result.clear();
+      // No need to clear the result: processEvent recycles its particles and jets for the new event.
 
       // Get the next event from Pythia8, convert to HEPUtils::Event, and smear it
       try
@@ -1586,7 +1825,7 @@ namespace Gambit
     {
       using namespace Pipes::smearEventCMSnoeff;
       if (*Loop::iteration <= BASE_INIT or !useBuckFastCMSnoeffDetector) return;
-      result.clear();
+      // No need to clear the result: processEvent recycles its particles and jets for the new event.
 
       // Get the next event from Pythia8, convert to HEPUtils::Event, and smear it
       try
@@ -1618,7 +1857,7 @@ namespace Gambit
     {
       using namespace Pipes::copyEvent;
       if (*Loop::iteration <= BASE_INIT or !useBuckFastIdentityDetector) return;
-      result.clear();
+      // No need to clear the result: processEvent recycles its particles and jets for the new event.
 
       // Get the next event from Pythia8 and convert to HEPUtils::Event
       try
@@ -2280,8 +2519,30 @@ namespace Gambit
             continue;
           }
 
+          // Look up the cached background-only quantities for this analysis, creating them if this is the first time we see it
+          const bkg_covariance& bkg_cache = bkgCovarianceCache.get(adata.analysis_name, [&](bkg_covariance& entry)
+          {
+            // Log factorial of observed number of events.
+            // Currently use the ln(Gamma(x)) function gsl_sf_lngamma from GSL. (Need continuous function.)
+            // We may want to switch to using Sterlings approximation: ln(n!) ~ n*ln(n) - n
+            entry.logfact_n_obs.resize(adata.size());
+            for (size_t SR = 0; SR < adata.size(); ++SR) entry.logfact_n_obs(SR) = gsl_sf_lngamma(adata[SR].n_observed + 1.);
+
+            // Diagonalise the background-only covariance matrix, extracting the rotation matrix
+            const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig_b(adata.srcov);
+            entry.sqrtEb = eig_b.eigenvalues().array().sqrt();
+            entry.Vb = eig_b.eigenvectors();
+          });
+          const Eigen::ArrayXd& logfact_n_obs = bkg_cache.logfact_n_obs;
+          const Eigen::ArrayXd& sqrtEb = bkg_cache.sqrtEb;
+          const Eigen::MatrixXd& Vb = bkg_cache.Vb;
+
+          // If the background-only marginalised likelihood is already known, only the s+b one needs sampling
+          double known_loglike_b = 0;
+          const bool sample_b = !bkgCovarianceCache.get_loglike_b(adata.analysis_name, known_loglike_b);
+
           // Construct vectors of SR numbers
-          Eigen::ArrayXd n_obs(adata.size()), logfact_n_obs(adata.size()), n_pred_b(adata.size()), n_pred_sb(adata.size()), abs_unc_s(adata.size());
+          Eigen::ArrayXd n_obs(adata.size()), n_pred_b(adata.size()), n_pred_sb(adata.size()), abs_unc_s(adata.size());
           for (size_t SR = 0; SR < adata.size(); ++SR)
           {
             const SignalRegionData srData = adata[SR];
@@ -2289,11 +2550,6 @@ namespace Gambit
             // Actual observed number of events
             n_obs(SR) = srData.n_observed;
 
-            // Log factorial of observed number of events.
-            // Currently use the ln(Gamma(x)) function gsl_sf_lngamma from GSL. (Need continuous function.)
-            // We may want to switch to using Sterlings approximation: ln(n!) ~ n*ln(n) - n
-            logfact_n_obs(SR) = gsl_sf_lngamma(n_obs(SR) + 1.);
-
             // A contribution to the predicted number of events that is not known exactly
             n_pred_b(SR) = srData.n_background;
             n_pred_sb(SR) = srData.n_signal_at_lumi + srData.n_background;
@@ -2304,16 +2560,6 @@ namespace Gambit
             abs_unc_s(SR) = HEPUtils::add_quad(abs_uncertainty_s_stat, abs_uncertainty_s_sys);
           }
 
-          // Diagonalise the background-only covariance matrix, extracting the rotation matrix
-          /// @todo No need to recompute the background-only covariance decomposition for every point!
-          /// Ben: Actually don't need to recompute the background-only marginalisation at all. It
-          ///      is always the same, so can just do it once at the start of the scan.
-          const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig_b(adata.srcov);
-          const Eigen::ArrayXd Eb = eig_b.eigenvalues();
-          const Eigen::ArrayXd sqrtEb = Eb.sqrt();
-          const Eigen::MatrixXd Vb = eig_b.eigenvectors();
-          //const Eigen::MatrixXd Vbinv = Vb.inverse();
-
           // Construct and diagonalise the s+b covariance matrix, adding the diagonal signal uncertainties in quadrature
           /// @todo Is this the best way, or should we just sample the s numbers independently and then be able to completely cache the cov matrix diagonalisation?
           const Eigen::MatrixXd srcov_s = abs_unc_s.array().square().matrix().asDiagonal();
@@ -2324,9 +2570,6 @@ namespace Gambit
           const Eigen::MatrixXd Vsb = eig_sb.eigenvectors();
           //const Eigen::MatrixXd Vsbinv = Vsb.inverse();
 
-          ///////////////////
-          /// @todo Split this whole chunk off into a lnlike-style utility function?
-
           // Sample correlated SR rates from a rotated Gaussian defined by the covariance matrix and offset by the mean rates
           static const double CONVERGENCE_TOLERANCE_ABS = runOptions->getValueOrDef<double>(0.05, "covariance_marg_convthres_abs");
           static const double CONVERGENCE_TOLERANCE_REL = runOptions->getValueOrDef<double>(0.05, "covariance_marg_convthres_rel");
@@ -2338,124 +2581,33 @@ namespace Gambit
           double diff_abs = 9999;
           double diff_rel = 1;
 
-          // Likelihood variables (note use of long double to guard against blow-up of L as opposed to log(L1/L0))
-          long double ana_like_b_prev = 1;
-          long double ana_like_sb_prev = 1;
-          long double ana_like_b = 1;
-          long double ana_like_sb = 1;
-          long double lsum_b_prev = 0;
-          long double lsum_sb_prev = 0;
-
-          std::normal_distribution<double> unitnormdbn(0,1);
- 
-          // Check absolute difference between independent estimates
-          /// @todo Should also implement a check of relative difference
+          /// @note How to correct negative rates? Discard (scales badly), set to
+          /// epsilon (= discontinuous & unphysical pdf), transform to log-space
+          /// (distorts the pdf quite badly), or something else (skew term)?
+          /// We're using the "set to epsilon" version for now.
+          /// Ben: I would vote for 'discard'. It can't be that inefficient, surely?
+          ///
+          /// @todo Add option for normal sampling in log(rate), i.e. "multidimensional log-normal"
+          const marg_poisson_sampler sampler_b(n_obs, logfact_n_obs, n_pred_b, sqrtEb, Vb);
+          const marg_poisson_sampler sampler_sb(n_obs, logfact_n_obs, n_pred_sb, sqrtEsb, Vsb);
+
+          // Log-likelihood variables. The samples are accumulated with log-sum-exp, so the likelihoods
+          // themselves never need to be represented outside of log space.
+          double ana_loglike_b_prev = known_loglike_b;
+          double ana_loglike_sb_prev = 0;
+          double ana_loglike_b = known_loglike_b;
+          double ana_loglike_sb = 0;
+          logsumexp_accumulator lsum_b_prev;
+          logsumexp_accumulator lsum_sb_prev;
+
+          // Check absolute and relative differences between independent estimates
           while ((diff_abs > CONVERGENCE_TOLERANCE_ABS && diff_rel > CONVERGENCE_TOLERANCE_REL) || 1.0/sqrt(NSAMPLE) > CONVERGENCE_TOLERANCE_ABS)
           {
-            long double lsum_b = 0;
-            long double lsum_sb = 0;
-
-            // typedef Eigen::Array<long double, Eigen::Dynamic, 1> ArrayXld;
-
-            /// @note How to correct negative rates? Discard (scales badly), set to
-            /// epsilon (= discontinuous & unphysical pdf), transform to log-space
-            /// (distorts the pdf quite badly), or something else (skew term)?
-            /// We're using the "set to epsilon" version for now.
-            /// Ben: I would vote for 'discard'. It can't be that inefficient, surely?
-            ///
-            /// @todo Add option for normal sampling in log(rate), i.e. "multidimensional log-normal"
+            logsumexp_accumulator lsum_b;
+            logsumexp_accumulator lsum_sb;
 
-            const bool COVLOGNORMAL = false;
-            if (!COVLOGNORMAL)
-            {
-
-              #pragma omp parallel
-              {
-                double lsum_b_private  = 0;
-                double lsum_sb_private = 0;
-
-                // Sample correlated SR rates from a rotated Gaussian defined by the covariance matrix and offset by the mean rates
-                #pragma omp for nowait
-                for (size_t i = 0; i < NSAMPLE; ++i) {
-
-                  Eigen::VectorXd norm_sample_b(adata.size()), norm_sample_sb(adata.size());
-                  for (size_t j = 0; j < adata.size(); ++j) {
-                    norm_sample_b(j) = sqrtEb(j) * unitnormdbn(Random::rng());
-                    norm_sample_sb(j) = sqrtEsb(j) * unitnormdbn(Random::rng());
-                   }
-
-                  // Rotate rate deltas into the SR basis and shift by SR mean rates
-                  const Eigen::VectorXd n_pred_b_sample  = n_pred_b + (Vb*norm_sample_b).array();
-                  const Eigen::VectorXd n_pred_sb_sample = n_pred_sb + (Vsb*norm_sample_sb).array();
-
-                  // Calculate Poisson likelihood and add to composite likelihood calculation
-                  double combined_loglike_b = 0;
-                  double combined_loglike_sb = 0;
-                  for (size_t j = 0; j < adata.size(); ++j) {
-                    const double lambda_b_j = std::max(n_pred_b_sample(j), 1e-3); //< manually avoid <= 0 rates
-                    const double lambda_sb_j = std::max(n_pred_sb_sample(j), 1e-3); //< manually avoid <= 0 rates
-                    const double loglike_b_j  = n_obs(j)*log(lambda_b_j) - lambda_b_j - logfact_n_obs(j);
-                    const double loglike_sb_j = n_obs(j)*log(lambda_sb_j) - lambda_sb_j - logfact_n_obs(j);
-                    combined_loglike_b  += loglike_b_j;
-                    combined_loglike_sb += loglike_sb_j;
-                  }
-                  // Add combined likelihood to running sums (to later calculate averages)
-                  lsum_b_private  += exp(combined_loglike_b);
-                  lsum_sb_private += exp(combined_loglike_sb);
-                }
-                #pragma omp critical
-                {
-                  lsum_b  += lsum_b_private;
-                  lsum_sb += lsum_sb_private;
-                }
-              } // End omp parallel
-            }  // End if !COVLOGNORMAL
-
-            // /// @todo Check that this log-normal sampling works as expected.
-            // else // COVLOGNORMAL
-            // {
-
-            //   const Eigen::ArrayXd ln_n_pred_b = n_pred_b.log();
-            //   const Eigen::ArrayXd ln_n_pred_sb = n_pred_sb.log();
-            //   const Eigen::ArrayXd ln_sqrtEb = (n_pred_b + sqrtEb).log() - ln_n_pred_b;
-            //   const Eigen::ArrayXd ln_sqrtEsb = (n_pred_sb + sqrtEsb).log() - ln_n_pred_sb;
-
-            //   #pragma omp parallel
-            //   {
-            //     std::normal_distribution<> unitnormdbn{0,1};
-            //     Eigen::ArrayXd llrsums_private = Eigen::ArrayXd::Zero(adata.size());
-
-            //     #pragma omp for nowait
-
-            //     // Sample correlated SR rates from a rotated Gaussian defined by the covariance matrix and offset by the mean rates
-            //     for (size_t i = 0; i < NSAMPLE; ++i) {
-            //       Eigen::VectorXd ln_norm_sample_b(adata.size()), ln_norm_sample_sb(adata.size());
-            //       for (size_t j = 0; j < adata.size(); ++j) {
-            //         ln_norm_sample_b(j) = ln_sqrtEb(j) * unitnormdbn(Random::rng());
-            //         ln_norm_sample_sb(j) = ln_sqrtEsb(j) * unitnormdbn(Random::rng());
-            //       }
-
-            //       // Rotate rate deltas into the SR basis and shift by SR mean rates
-            //       const Eigen::ArrayXd delta_ln_n_pred_b_sample = Vb*ln_norm_sample_b;
-            //       const Eigen::ArrayXd delta_ln_n_pred_sb_sample = Vsb*ln_norm_sample_sb;
-            //       const Eigen::ArrayXd n_pred_b_sample = (ln_n_pred_b + delta_ln_n_pred_b_sample).exp();
-            //       const Eigen::ArrayXd n_pred_sb_sample = (ln_n_pred_sb + delta_ln_n_pred_sb_sample).exp();
-
-            //       // Calculate Poisson LLR and add to aggregated LL calculation
-            //       for (size_t j = 0; j < adata.size(); ++j) {
-            //         const double lambda_b_j = std::max(n_pred_b_sample(j), 1e-3); //< shouldn't be needed in log-space sampling
-            //         const double lambda_sb_j = std::max(n_pred_sb_sample(j), 1e-3); //< shouldn't be needed in log-space sampling
-            //         const double llr_j = n_obs(j)*log(lambda_sb_j/lambda_b_j) - (lambda_sb_j - lambda_b_j);
-            //         llrsums_private(j) += llr_j;
-            //       }
-            //     }
-
-            //     #pragma omp critical
-            //     {
-            //       for (size_t j = 0; j < adata.size(); ++j) { llrsums(j) += llrsums_private(j); }
-            //     }
-            //   } // End omp parallel
-            // }
+            if (sample_b) sampler_b.sample(NSAMPLE, lsum_b);
+            sampler_sb.sample(NSAMPLE, lsum_sb);
 
             // Compare convergence to previous independent batch
             if (first_iteration)  // The first round must be generated twice
@@ -2466,11 +2618,19 @@ namespace Gambit
             }
             else
             {
-              ana_like_b_prev = lsum_b_prev / (double)NSAMPLE;
-              ana_like_sb_prev = lsum_sb_prev / (double)NSAMPLE;
-              ana_like_b = lsum_b / (double)NSAMPLE;
-              ana_like_sb = lsum_sb / (double)NSAMPLE;
+              if (sample_b)
+              {
+                ana_loglike_b_prev = lsum_b_prev.log_mean(NSAMPLE);
+                ana_loglike_b = lsum_b.log_mean(NSAMPLE);
+              }
+              ana_loglike_sb_prev = lsum_sb_prev.log_mean(NSAMPLE);
+              ana_loglike_sb = lsum_sb.log_mean(NSAMPLE);
               //
+              // Convergence is tested on the likelihoods themselves, as before; long double guards against underflow here
+              const long double ana_like_b_prev = std::exp((long double)ana_loglike_b_prev);
+              const long double ana_like_sb_prev = std::exp((long double)ana_loglike_sb_prev);
+              const long double ana_like_b = std::exp((long double)ana_loglike_b);
+              const long double ana_like_sb = std::exp((long double)ana_loglike_sb);
               const double diff_abs_b = fabs(ana_like_b_prev - ana_like_b);
               const double diff_abs_sb = fabs(ana_like_sb_prev - ana_like_sb);
               const double diff_rel_b = diff_abs_b/ana_like_b;
@@ -2480,8 +2640,8 @@ namespace Gambit
               diff_abs = std::max(diff_abs_b, diff_abs_sb);  // Absolute convergence check
 
               // Update variables
-              lsum_b_prev += lsum_b;  // Aggregate result. This doubles the effective batch size for lsum_prev.
-              lsum_sb_prev += lsum_sb;  // Aggregate result. This doubles the effective batch size for lsum_prev.
+              lsum_b_prev.add(lsum_b);  // Aggregate result. This doubles the effective batch size for lsum_prev.
+              lsum_sb_prev.add(lsum_sb);  // Aggregate result. This doubles the effective batch size for lsum_prev.
               NSAMPLE *=2;  // This ensures that the next batch for lsum is as big as the current batch size for lsum_prev, so they can be compared directly.
             }
 
@@ -2489,10 +2649,10 @@ namespace Gambit
               cout << debug_prefix()
                    << "diff_rel: " << diff_rel << endl
                    <<  "   diff_abs: " << diff_abs << endl
-                   << "   ana_llr_prev: " << log(ana_like_sb_prev/ana_like_b_prev) << endl
-                   << "   ana_dll: " << log(ana_like_sb/ana_like_b) << endl
-                   << "   logl_sb: " << log(ana_like_sb) << endl
-                   << "   logl_b: " << log(ana_like_b) << endl;
+                   << "   ana_llr_prev: " << ana_loglike_sb_prev - ana_loglike_b_prev << endl
+                   << "   ana_dll: " << ana_loglike_sb - ana_loglike_b << endl
+                   << "   logl_sb: " << ana_loglike_sb << endl
+                   << "   logl_b: " << ana_loglike_b << endl;
                cout << debug_prefix() << "NSAMPLE for the next iteration is: " << NSAMPLE << endl;
               cout << debug_prefix() << endl;
             #endif
@@ -2500,11 +2660,19 @@ namespace Gambit
 
           // Combine the independent estimates ana_like and ana_like_prev.
           // Use equal weights since the estimates are based on equal batch sizes.
-          ana_like_b = 0.5*(ana_like_b + ana_like_b_prev);
-          ana_like_sb = 0.5*(ana_like_sb + ana_like_sb_prev);
+          const auto log_average = [](double a, double b)
+          {
+            const double m = std::max(a, b);
+            return m + log(0.5*(exp(a-m) + exp(b-m)));
+          };
+          ana_loglike_b = log_average(ana_loglike_b, ana_loglike_b_prev);
+          ana_loglike_sb = log_average(ana_loglike_sb, ana_loglike_sb_prev);
+
+          // The background-only likelihood is the same at every point, so keep it for the rest of the scan
+          if (sample_b) bkgCovarianceCache.set_loglike_b(adata.analysis_name, ana_loglike_b);
 
           // Compute LLR from mean s+b and b likelihoods
-          const double ana_dll = log(ana_like_sb) - log(ana_like_b);
+          const double ana_dll = ana_loglike_sb - ana_loglike_b;
           #ifdef COLLIDERBIT_DEBUG
             cout << debug_prefix() << "Combined estimate: ana_dll: " << ana_dll << "   (based on 2*NSAMPLE=" << 2*NSAMPLE << " samples)" << endl;
           #endif
@@ -2656,6 +2824,9 @@ namespace Gambit
 
       }
 
+      logger() << LogTags::debug << "calc_LHC_LogLikes: background covariance cache hits: "
+               << bkgCovarianceCache.hits() << ", misses: " << bkgCovarianceCache.misses() << EOM;
+
     }
 
     // Extract the combined log likelihood for each analysis
@@ -2806,6 +2977,7 @@ namespace Gambit
       {
         result["seed_base_" + name] = colliderInfo[name]["seed_base"];
         result["final_event_count_" + name] = colliderInfo[name]["final_event_count"];
+        result["reused_yields_" + name] = colliderInfo[name]["reused_yields"];
       }
 
     }
@@ -0,0 +1,91 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Shared event counters of the parallel
+///  ColliderBit event loop: hands out event
+///  numbers and places among the max_nEvents
+///  good events to the threads.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///  *********************************************
+
+#include "gambit/ColliderBit/EventTickets.hpp"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// Constructor
+    EventTickets::EventTickets(int max_nEvents)
+     : max_nEvents(max_nEvents)
+     , nEventsNumbered(0)
+     , nEventsClaimed(0)
+     , nEventsDone(0)
+    {}
+
+    /// Claim a place and an event number
+    EventTickets::status EventTickets::claim(int& eventNumber)
+    {
+      // Stop once max_nEvents events have been generated successfully
+      if (n_done() >= max_nEvents) return finished;
+
+      // Claim one of the max_nEvents places.  If they are all taken by events still in progress, give the claim
+      // back straight away, as one of those events may yet fail and give its place back.
+      int claimed;
+      #pragma omp atomic capture
+      claimed = nEventsClaimed++;
+      if (claimed >= max_nEvents)
+      {
+        #pragma omp atomic update
+        nEventsClaimed--;
+        return wait;
+      }
+
+      // Take the next unused event number
+      #pragma omp atomic capture
+      eventNumber = nEventsNumbered++;
+      return granted;
+    }
+
+    /// Record that the claimed event was generated successfully
+    void EventTickets::succeeded()
+    {
+      #pragma omp atomic update
+      nEventsDone++;
+    }
+
+    /// Record that the claimed event failed, giving its place back
+    void EventTickets::failed()
+    {
+      #pragma omp atomic update
+      nEventsClaimed--;
+    }
+
+    /// Number of events generated successfully so far
+    int EventTickets::n_done() const
+    {
+      int result;
+      #pragma omp atomic read
+      result = nEventsDone;
+      return result;
+    }
+
+    /// Number of event numbers handed out so far
+    int EventTickets::n_numbered() const
+    {
+      int result;
+      #pragma omp atomic read
+      result = nEventsNumbered;
+      return result;
+    }
+
+  }
+}
@@ -0,0 +1,299 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  ColliderBit cache of simulated signal yields,
+///  for reuse between parameter points with the
+///  same (or nearly the same) collider simulation
+///  inputs.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///  *********************************************
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "gambit/Logs/logger.hpp"
+#include "gambit/ColliderBit/SignalYieldCache.hpp"
+#include "gambit/ColliderBit/analyses/AnalysisData.hpp"
+#include "gambit/ColliderBit/analyses/BaseAnalysis.hpp"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    namespace
+    {
+      /// Read a number from an SLHA field, returning false if it is not one
+      bool read_number(const str& field, double& value)
+      {
+        char* end;
+        value = std::strtod(field.c_str(), &end);
+        return end != field.c_str() and *end == '\0';
+      }
+
+      /// Difference of two dimensionful numbers relative to the larger of them
+      double relative_difference(double a, double b)
+      {
+        const double scale = std::max(std::abs(a), std::abs(b));
+        return scale > 0 ? std::abs(a-b)/scale : 0.;
+      }
+
+      /// The largest difference between the entries of two maps with the same keys, or infinity if their keys differ
+      template <typename DIFFERENCE>
+      double max_difference(const std::map<str,double>& a, const std::map<str,double>& b, DIFFERENCE difference)
+      {
+        if (a.size() != b.size()) return std::numeric_limits<double>::infinity();
+        double result = 0.;
+        for (auto ia = a.begin(), ib = b.begin(); ia != a.end(); ++ia, ++ib)
+        {
+          if (ia->first != ib->first) return std::numeric_limits<double>::infinity();
+          result = std::max(result, difference(ia->second, ib->second));
+        }
+        return result;
+      }
+    }
+
+    /// Set the spectrum from the SLHA input given to Pythia.  Only the blocks that Pythia reads for the SUSY
+    /// hard processes and decays are kept: MASS, DECAY, the mixing matrices (blocks ending in MIX), ALPHA,
+    /// the trilinear and Yukawa couplings, and MODSEL.
+    void SignalYieldCache::Key::set_spectrum(const SLHAea::Coll& slha)
+    {
+      dimensionful.clear();
+      dimensionless.clear();
+      for (const SLHAea::Block& block : slha)
+      {
+        auto def = block.find_block_def();
+        if (def == block.end() or def->data_size() < 2) continue;
+        str type = (*def)[0], name = (*def)[1];
+        std::transform(type.begin(), type.end(), type.begin(), ::toupper);
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        double value;
+
+        if (type == "DECAY")
+        {
+          // Total width, then the branching fraction of each channel, by its (ordered) decay products
+          if (def->data_size() > 2 and read_number((*def)[2], value)) dimensionful["DECAY " + name] = value;
+          for (const SLHAea::Line& line : block)
+          {
+            if (not line.is_data_line() or line.data_size() < 3 or not read_number(line[0], value)) continue;
+            std::vector<str> products(line.begin() + 2, line.begin() + line.data_size());
+            std::sort(products.begin(), products.end());
+            str channel = "DECAY " + name + " ->";
+            for (const str& product : products) channel += " " + product;
+            dimensionless[channel] = value;
+          }
+          continue;
+        }
+
+        const bool is_dimensionful = (name == "MASS" or name == "AU" or name == "AD" or name == "AE");
+        const bool is_dimensionless = (name == "ALPHA" or name == "MODSEL" or name == "YU" or name == "YD" or name == "YE"
+                                       or (name.size() >= 3 and name.compare(name.size() - 3, 3, "MIX") == 0));
+        if (not is_dimensionful and not is_dimensionless) continue;
+        std::map<str,double>& entries = (is_dimensionful ? dimensionful : dimensionless);
+        for (const SLHAea::Line& line : block)
+        {
+          if (not line.is_data_line() or not read_number(line[line.data_size()-1], value)) continue;
+          str indices = name;
+          for (size_t i = 0; i + 1 < line.data_size(); ++i) indices += " " + line[i];
+          entries[indices] = value;
+        }
+      }
+    }
+
+    /// Clear everything but the spectrum, ready for a new collider
+    void SignalYieldCache::Key::new_collider(const str& collider_name)
+    {
+      collider = collider_name;
+      settings.clear();
+      analyses.clear();
+    }
+
+    /// The largest difference between the spectrum entries of two keys
+    double SignalYieldCache::Key::distance(const Key& other) const
+    {
+      if (collider != other.collider or settings != other.settings or analyses != other.analyses)
+      {
+        return std::numeric_limits<double>::infinity();
+      }
+      return std::max(max_difference(dimensionful, other.dimensionful, relative_difference),
+                      max_difference(dimensionless, other.dimensionless, [](double a, double b) { return std::abs(a-b); }));
+    }
+
+    /// Set the maximum number of stored entries, and the tolerance
+    void SignalYieldCache::configure(size_t size, double spectrum_tolerance)
+    {
+      max_entries = size;
+      tolerance = spectrum_tolerance;
+      while (entries.size() > max_entries) entries.pop_back();
+    }
+
+    /// Does an entry hold the yields of every analysis in its key?
+    bool SignalYieldCache::complete(const Entry& entry)
+    {
+      for (auto& container_analyses_pair : entry.key.analyses)
+      {
+        auto stored = entry.yields.find(container_analyses_pair.first);
+        if (stored == entry.yields.end()) return false;
+        for (const str& analysis : container_analyses_pair.second)
+        {
+          if (stored->second.find(analysis) == stored->second.end()) return false;
+        }
+      }
+      return true;
+    }
+
+    /// Find the entry closest to the given key
+    const SignalYieldCache::Entry* SignalYieldCache::find(const Key& key)
+    {
+      auto closest = entries.end();
+      double closest_distance = std::numeric_limits<double>::infinity();
+      for (auto it = entries.begin(); it != entries.end(); )
+      {
+        const double d = it->key.distance(key);
+        if (d > tolerance or d >= closest_distance) { ++it; continue; }
+        if (not complete(*it))
+        {
+          // Should not happen, but if it does, generate events as if there were no entry
+          logger() << LogTags::debug << "SignalYieldCache: the entry for collider " << key.collider
+                   << " does not hold the yields of all its analyses; dropping it." << EOM;
+          it = entries.erase(it);
+          continue;
+        }
+        closest = it;
+        closest_distance = d;
+        ++it;
+      }
+      if (closest == entries.end())
+      {
+        misses++;
+        return NULL;
+      }
+      // Move to the front, so that the least recently used entry is always at the back
+      entries.splice(entries.begin(), entries, closest);
+      hits++;
+      return &entries.front();
+    }
+
+    /// Count the last hit as a miss
+    void SignalYieldCache::reject()
+    {
+      if (hits > 0) hits--;
+      misses++;
+    }
+
+    /// The factor by which to scale the cross-sections of an entry
+    double SignalYieldCache::xsec_scale(const Entry& entry, const std::map<int,double>& process_xsecs) const
+    {
+      double stored = 0., matched = 0., unmatched = 0.;
+      for (auto& code_xsec_pair : entry.process_xsecs) stored += code_xsec_pair.second;
+      for (auto& code_xsec_pair : process_xsecs)
+      {
+        if (entry.process_xsecs.count(code_xsec_pair.first)) matched += code_xsec_pair.second;
+        else unmatched += code_xsec_pair.second;
+      }
+      if (not (stored > 0) or not (matched > 0) or unmatched > tolerance * (matched + unmatched)) return -1.;
+      return matched / stored;
+    }
+
+    /// Start a new pending entry
+    void SignalYieldCache::start(const Key& key)
+    {
+      pending = Entry();
+      pending.key = key;
+      pending.n_events = 0;
+      pending_xsec_sums.clear();
+      have_pending = true;
+    }
+
+    /// Store the yields of all analyses in the given container in the pending entry
+    void SignalYieldCache::store(const str& container_name, const HEPUtilsAnalysisContainer& container)
+    {
+      if (not have_pending) return;
+      for (auto& analysis_pointer_pair : container.get_current_analyses_map())
+      {
+        HEPUtilsAnalysis* analysis = analysis_pointer_pair.second;
+        AnalysisYields yields;
+        const AnalysisData& results = analysis->get_results();
+        yields.n_signal.resize(results.size());
+        for (size_t i = 0; i < results.size(); ++i) yields.n_signal[i] = results[i].n_signal;
+        yields.num_events = analysis->num_events();
+        yields.xsec = analysis->xsec();
+        yields.xsec_err = analysis->xsec_err();
+        store(container_name, analysis_pointer_pair.first, yields);
+      }
+    }
+
+    /// Store the yields of a single analysis in the pending entry
+    void SignalYieldCache::store(const str& container_name, const str& analysis_name, const AnalysisYields& yields)
+    {
+      if (have_pending) pending.yields[container_name][analysis_name] = yields;
+    }
+
+    /// Add the generated cross-section and number of tried events of each hard process of one Pythia instance
+    void SignalYieldCache::add_process_xsecs(const std::map<int,std::pair<double,long> >& process_xsecs)
+    {
+      if (not have_pending) return;
+      for (auto& code_xsec_pair : process_xsecs)
+      {
+        std::pair<double,double>& sums = pending_xsec_sums[code_xsec_pair.first];
+        sums.first += code_xsec_pair.second.first * code_xsec_pair.second.second;
+        sums.second += code_xsec_pair.second.second;
+      }
+    }
+
+    /// Move the pending entry into the cache
+    void SignalYieldCache::commit(int n_events)
+    {
+      if (not have_pending) return;
+      have_pending = false;
+      if (not enabled()) return;
+      pending.n_events = n_events;
+      pending.process_xsecs.clear();
+      for (auto& code_sums_pair : pending_xsec_sums)
+      {
+        if (code_sums_pair.second.second > 0) pending.process_xsecs[code_sums_pair.first] = code_sums_pair.second.first / code_sums_pair.second.second;
+      }
+      entries.push_front(std::move(pending));
+      while (entries.size() > max_entries) entries.pop_back();
+    }
+
+    /// Discard the pending entry
+    void SignalYieldCache::discard()
+    {
+      have_pending = false;
+      pending = Entry();
+      pending_xsec_sums.clear();
+    }
+
+    /// Restore the yields of all analyses in the given container from an entry
+    bool SignalYieldCache::restore(const Entry& entry, const str& container_name, HEPUtilsAnalysisContainer& container, double xsec_scale)
+    {
+      auto stored = entry.yields.find(container_name);
+      if (stored == entry.yields.end()) return false;
+      for (auto& analysis_pointer_pair : container.get_current_analyses_map())
+      {
+        auto yields = stored->second.find(analysis_pointer_pair.first);
+        if (yields == stored->second.end()) return false;
+        if (not restore(yields->second, *analysis_pointer_pair.second, xsec_scale)) return false;
+      }
+      return true;
+    }
+
+    /// Restore the yields of a single analysis
+    bool SignalYieldCache::restore(const AnalysisYields& yields, HEPUtilsAnalysis& analysis, double xsec_scale)
+    {
+      return analysis.restore(yields.n_signal, yields.num_events, xsec_scale * yields.xsec, xsec_scale * yields.xsec_err);
+    }
+
+  }
+}
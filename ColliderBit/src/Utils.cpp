@@ -1,6 +1,7 @@
 #include "gambit/ColliderBit/Utils.hpp"
 #include "gambit/Utils/threadsafe_rng.hpp"
 #include <iostream>
+#include <cmath>
 using namespace std;
 
 namespace Gambit {
@@ -13,55 +14,118 @@ namespace Gambit {
     }
 
 
+    const double* unit_normals(size_t n) {
+      static thread_local std::vector<double> buffer;
+      if (buffer.size() < n) buffer.resize(n);
+      Random::fill_normal(buffer.data(), n);
+      return buffer.data();
+    }
+
+
+    const double* uniforms(size_t n) {
+      static thread_local std::vector<double> buffer;
+      if (buffer.size() < n) buffer.resize(n);
+      Random::fill(buffer.data(), n);
+      return buffer.data();
+    }
+
+
+    namespace {
+
+      /// Per-thread efficiency and keep-mask buffers for the filtereff functions
+      std::vector<double>& eff_buffer(size_t n) {
+        static thread_local std::vector<double> buffer;
+        buffer.resize(n);
+        return buffer;
+      }
+      std::vector<unsigned char>& keep_buffer(size_t n) {
+        static thread_local std::vector<unsigned char> buffer;
+        buffer.resize(n);
+        return buffer;
+      }
+
+      /// Sample all particles at once against their efficiencies, then remove the rejected ones
+      void filter_by_eff(std::vector<HEPUtils::Particle*>& particles, const std::vector<double>& eff, bool do_delete) {
+        const size_t n = particles.size();
+        const double* u = uniforms(n);
+        std::vector<unsigned char>& keep = keep_buffer(n);
+        for (size_t i = 0; i < n; ++i) keep[i] = u[i] < eff[i];
+        compact(particles, keep, do_delete);
+      }
+
+    }
+
+
+    void ParticleArrays::fill(const std::vector<HEPUtils::Particle*>& particles) {
+      const size_t n = particles.size();
+      pT.resize(n); eta.resize(n); phi.resize(n); E.resize(n); pid.resize(n); flags.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+        const HEPUtils::Particle* p = particles[i];
+        pT[i] = p->pT();
+        eta[i] = p->eta();
+        phi[i] = p->phi();
+        E[i] = p->E();
+        pid[i] = p->pid();
+        flags[i] = p->is_prompt() ? PROMPT : 0;
+      }
+    }
+
+
+    void compact(std::vector<HEPUtils::Particle*>& particles, const std::vector<unsigned char>& keep, bool do_delete) {
+      size_t nkept = 0;
+      for (size_t i = 0; i < particles.size(); ++i) {
+        if (keep[i]) particles[nkept++] = particles[i];
+        else if (do_delete) delete particles[i];
+      }
+      particles.resize(nkept);
+    }
+
+
+    // Each of the filtereff functions first evaluates the efficiencies of all the particles, then draws all the
+    // random numbers in one call and compares them against the efficiencies in a single pass, and finally removes
+    // the rejected particles in order.  The deviates are drawn in particle order, but only after all the
+    // efficiencies have been evaluated.  With the standard-library engines (including the default mt19937_64) each
+    // particle gets the same deviate as from one Random::draw() per particle; the philox engine fills in a different order.
     void filtereff(std::vector<HEPUtils::Particle*>& particles, double eff, bool do_delete) {
       if (particles.empty()) return;
-      auto keptParticlesEnd = std::remove_if(particles.begin(), particles.end(),
-                                             [&](HEPUtils::Particle* p) {
-                                               const bool rm = !random_bool(eff);
-                                               if (do_delete && rm) delete p;
-                                               return rm;
-                                             } );
-      particles.erase(keptParticlesEnd, particles.end());
+      const size_t n = particles.size();
+      const double* u = uniforms(n);
+      std::vector<unsigned char>& keep = keep_buffer(n);
+      for (size_t i = 0; i < n; ++i) keep[i] = u[i] < eff;
+      compact(particles, keep, do_delete);
     }
 
 
     /// Utility function for filtering a supplied particle vector by sampling wrt a binned 1D efficiency map in pT
     void filtereff(std::vector<HEPUtils::Particle*>& particles, std::function<double(HEPUtils::Particle*)> eff_fn, bool do_delete) {
       if (particles.empty()) return;
-      auto keptParticlesEnd = std::remove_if(particles.begin(), particles.end(),
-                                             [&](HEPUtils::Particle* p) {
-                                               const double eff = eff_fn(p);
-                                               const bool rm = !random_bool(eff);
-                                               if (do_delete && rm) delete p;
-                                               return rm;
-                                             } );
-      particles.erase(keptParticlesEnd, particles.end());
+      std::vector<double>& eff = eff_buffer(particles.size());
+      for (size_t i = 0; i < particles.size(); ++i) eff[i] = eff_fn(particles[i]);
+      filter_by_eff(particles, eff, do_delete);
     }
 
 
-    // Utility function for filtering a supplied particle vector by sampling wrt a binned 1D efficiency map in pT
+    // Utility function for filtering a supplied particle vector by sampling wrt a binned 1D efficiency map in pT.
+    // The efficiencies are looked up from a per-thread structure-of-arrays copy of the kinematics.
     void filtereff_pt(std::vector<HEPUtils::Particle*>& particles, const HEPUtils::BinnedFn1D<double>& eff_pt, bool do_delete) {
       if (particles.empty()) return;
-      auto keptParticlesEnd = std::remove_if(particles.begin(), particles.end(),
-                                             [&](const HEPUtils::Particle* p) {
-                                               const bool rm = !random_bool(eff_pt, p->pT());
-                                               if (do_delete && rm) delete p;
-                                               return rm;
-                                             } );
-      particles.erase(keptParticlesEnd, particles.end());
+      static thread_local ParticleArrays arrays;
+      arrays.fill(particles);
+      std::vector<double>& eff = eff_buffer(arrays.size());
+      for (size_t i = 0; i < arrays.size(); ++i) eff[i] = eff_pt.get_at(arrays.pT[i]);
+      filter_by_eff(particles, eff, do_delete);
     }
 
 
-    // Utility function for filtering a supplied particle vector by sampling wrt a binned 2D efficiency map in |eta| and pT
+    // Utility function for filtering a supplied particle vector by sampling wrt a binned 2D efficiency map in |eta| and pT.
+    // Structure-of-arrays, as for filtereff_pt.
     void filtereff_etapt(std::vector<HEPUtils::Particle*>& particles, const HEPUtils::BinnedFn2D<double>& eff_etapt, bool do_delete) {
       if (particles.empty()) return;
-      auto keptParticlesEnd = std::remove_if(particles.begin(), particles.end(),
-                                             [&](const HEPUtils::Particle* p) {
-                                               const bool rm = !random_bool(eff_etapt, p->abseta(), p->pT());
-                                               if (do_delete && rm) delete p;
-                                               return rm;
-                                             } );
-      particles.erase(keptParticlesEnd, particles.end());
+      static thread_local ParticleArrays arrays;
+      arrays.fill(particles);
+      std::vector<double>& eff = eff_buffer(arrays.size());
+      for (size_t i = 0; i < arrays.size(); ++i) eff[i] = eff_etapt.get_at(std::fabs(arrays.eta[i]), arrays.pT[i]);
+      filter_by_eff(particles, eff, do_delete);
     }
 
 
@@ -0,0 +1,168 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  ColliderBit pre-screening of parameter points
+///  with a fast, conservative estimate of the total
+///  SUSY production cross-section, for applying the
+///  xsec veto before Pythia is initialised.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///  *********************************************
+
+#include <cmath>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <utility>
+#include "gambit/ColliderBit/XsecPrescreen.hpp"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    namespace
+    {
+
+      typedef XsecPrescreen::xsec_table xsec_table;
+
+      /// 13 TeV envelopes, rounded upwards from NLO+NLL reference cross-sections.
+      /// @{
+      /// Total strong production, with the gluino and the eight light-flavour squarks all at the given mass
+      const xsec_table strong_xsecs = {{200, 3.0e4}, {400, 2.0e3}, {600, 2.5e2}, {800, 4.5e1}, {1000, 1.0e1},
+                                       {1250, 2.0}, {1500, 5.0e-1}, {1750, 1.4e-1}, {2000, 4.0e-2},
+                                       {2500, 4.0e-3}, {3000, 4.5e-4}};
+      /// Pair production of a single third-generation squark
+      const xsec_table squark3_xsecs = {{100, 1.9e3}, {200, 8.0e1}, {300, 1.2e1}, {400, 2.5}, {500, 7.5e-1},
+                                        {600, 2.5e-1}, {800, 3.5e-2}, {1000, 8.5e-3}, {1250, 1.5e-3},
+                                        {1500, 3.0e-4}, {2000, 1.5e-5}};
+      /// All wino-like chargino/neutralino channels involving a chargino of the given mass
+      const xsec_table ewino_xsecs = {{100, 4.0e1}, {200, 4.0}, {300, 1.0}, {400, 3.5e-1}, {500, 1.4e-1},
+                                      {600, 6.5e-2}, {800, 1.6e-2}, {1000, 4.5e-3}, {1250, 1.0e-3},
+                                      {1500, 3.0e-4}, {2000, 3.5e-5}};
+      /// Pair and associated production of a single slepton or sneutrino
+      const xsec_table slepton_xsecs = {{100, 6.0e-1}, {200, 7.0e-2}, {300, 1.8e-2}, {400, 6.0e-3},
+                                        {500, 2.5e-3}, {700, 5.5e-4}, {1000, 9.0e-5}, {1500, 8.0e-6}};
+      /// @}
+
+      /// Highest centre-of-mass energy (in GeV) for which the tables are upper bounds
+      const double max_ecm = 13000.;
+
+    }
+
+    /// Interpolate a table linearly in log(sigma).  Extrapolating beyond the last point with the last slope
+    /// overestimates the cross-section, as cross-sections fall ever more steeply with mass.  Masses below the
+    /// table are not bounded.
+    double XsecPrescreen::interpolate(const xsec_table& table, double mass)
+    {
+      if (mass < table.front().first) return std::numeric_limits<double>::infinity();
+      size_t i = 1;
+      while (i < table.size() - 1 and mass > table[i].first) ++i;
+      const double m0 = table[i-1].first, m1 = table[i].first;
+      const double l0 = std::log(table[i-1].second), l1 = std::log(table[i].second);
+      return std::exp(l0 + (l1 - l0) * (mass - m0) / (m1 - m0));
+    }
+
+    /// Set the safety margin
+    void XsecPrescreen::configure(double safety_margin)
+    {
+      margin = safety_margin;
+    }
+
+    /// Conservative upper bound on the total SUSY cross-section of a spectrum
+    double XsecPrescreen::xsec_upper_limit_fb(const SLHAea::Coll& slha, double ecm) const
+    {
+      const double inf = std::numeric_limits<double>::infinity();
+      if (ecm <= 0 or ecm > max_ecm) return inf;
+
+      // Collect the sparticle masses
+      SLHAea::Coll::const_iterator block = slha.find("MASS");
+      if (block == slha.end()) return inf;
+      std::map<int,double> masses;
+      for (const SLHAea::Line& line : *block)
+      {
+        if (line.is_data_line() and line.size() >= 2) masses[SLHAea::to<int>(line[0])] = std::abs(SLHAea::to<double>(line[1]));
+      }
+      auto mass = [&](int pdg) { auto it = masses.find(pdg); return it == masses.end() ? -1. : it->second; };
+
+      const std::vector<int> coloured = {1000021, 1000001, 1000002, 1000003, 1000004, 2000001, 2000002, 2000003, 2000004};
+      const std::vector<int> squarks3 = {1000005, 2000005, 1000006, 2000006};
+      const std::vector<int> charginos = {1000024, 1000037};
+      const std::vector<int> sleptons = {1000011, 2000011, 1000012, 1000013, 2000013, 1000014, 1000015, 2000015, 1000016};
+
+      double xsec_pb = 0;
+
+      // Strong production, with everything at the mass of the lightest gluino or light-flavour squark
+      double m_coloured = inf;
+      for (int pdg : coloured)
+      {
+        if (mass(pdg) < 0) return inf;
+        m_coloured = std::min(m_coloured, mass(pdg));
+      }
+      xsec_pb += interpolate(strong_xsecs, m_coloured);
+
+      // Third-generation squarks, charginos/neutralinos and sleptons, channel by channel
+      for (int pdg : squarks3)
+      {
+        if (mass(pdg) < 0) return inf;
+        xsec_pb += interpolate(squark3_xsecs, mass(pdg));
+      }
+      for (int pdg : charginos)
+      {
+        if (mass(pdg) < 0) return inf;
+        xsec_pb += interpolate(ewino_xsecs, mass(pdg));
+      }
+      for (int pdg : sleptons)
+      {
+        if (mass(pdg) < 0) return inf;
+        xsec_pb += interpolate(slepton_xsecs, mass(pdg));
+      }
+
+      return margin * xsec_pb * 1e3;
+    }
+
+    /// Does the bound fall below the xsec veto for this collider?
+    bool XsecPrescreen::vetoes(double upper_limit_fb, double xsec_veto_fb)
+    {
+      n_screened++;
+      if (upper_limit_fb >= xsec_veto_fb) return false;
+      n_vetoed++;
+      return true;
+    }
+
+    /// Get the centre-of-mass energy of a collider, from its settings or else from its name
+    double XsecPrescreen::collider_ecm(const str& collider, const std::vector<str>& settings)
+    {
+      // An explicit setting wins (the last one, as in Pythia).  Pythia settings are case- and whitespace-insensitive.
+      double ecm = -1;
+      const str key = "beams:ecm=";
+      for (const str& setting : settings)
+      {
+        str compact;
+        for (char c : setting) if (not std::isspace(static_cast<unsigned char>(c))) compact += std::tolower(static_cast<unsigned char>(c));
+        if (compact.compare(0, key.size(), key) == 0) ecm = std::atof(compact.c_str() + key.size());
+      }
+      if (ecm > 0) return ecm;
+
+      // Otherwise rely on the SpecializablePythia naming convention, e.g. Pythia_SUSY_LHC_8TeV
+      const str suffix = "TeV";
+      if (collider.size() <= suffix.size() or collider.compare(collider.size() - suffix.size(), suffix.size(), suffix) != 0) return -1;
+      size_t start = collider.find_last_of('_');
+      if (start == str::npos) return -1;
+      char* end;
+      const str number = collider.substr(start + 1, collider.size() - suffix.size() - start - 1);
+      ecm = std::strtod(number.c_str(), &end);
+      return (not number.empty() and *end == '\0' and ecm > 0) ? ecm * 1e3 : -1;
+    }
+
+  }
+}
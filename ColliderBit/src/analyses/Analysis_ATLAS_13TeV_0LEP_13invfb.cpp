@@ -64,23 +64,13 @@ namespace Gambit {
 
         // Get baseline jets
         /// @todo Drop b-tag if pT < 50 GeV or |eta| > 2.5?
-        vector<const Jet*> baselineJets;
-        for (const Jet* jet : event->jets())
-          if (jet->pT() > 20. && jet->abseta() < 2.8) {
-            baselineJets.push_back(jet);
-          }
+        const vector<const Jet*>& baselineJets = objects().jets(20., 2.8);
 
         // Get baseline electrons
-        vector<const Particle*> baselineElectrons;
-        for (const Particle* electron : event->electrons())
-          if (electron->pT() > 10. && electron->abseta() < 2.47)
-            baselineElectrons.push_back(electron);
+        const vector<const Particle*>& baselineElectrons = objects().electrons(10., 2.47);
 
         // Get baseline muons
-        vector<const Particle*> baselineMuons;
-        for (const Particle* muon : event->muons())
-          if (muon->pT() > 10. && muon->abseta() < 2.7)
-            baselineMuons.push_back(muon);
+        const vector<const Particle*>& baselineMuons = objects().muons(10., 2.7);
 
         // Full isolation details:
         //  - Remove electrons within dR = 0.2 of a b-tagged jet
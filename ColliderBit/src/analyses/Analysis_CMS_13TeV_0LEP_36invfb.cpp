@@ -42,19 +42,13 @@ namespace Gambit {
         // FinalState cfs(Cuts::abseta < 2.5 && Cuts::abscharge != 0);
 
         // Get baseline jets
-        vector<const Jet*> jets24, jets50;
-        for (const Jet* jet : event->jets()) {
-          if (jet->pT() < 30) continue;
-          if (jet->abseta() < 2.4) jets24.push_back(jet);
-          if (jet->abseta() < 5.0) jets50.push_back(jet);
-        }
+        const vector<const Jet*>& jets24 = objects().jets(30., 2.4, true);
+        const vector<const Jet*>& jets50 = objects().jets(30., 5.0, true);
         if (jets24.size() < 2) return;
         _cutflow.fill(1);
 
         // HT cut
-        double sumptj = 0;
-        for (const Jet* j : jets24) sumptj += j->pT();
-        const double ht = sumptj;
+        const double ht = objects().HT(30., 2.4, true);
         if (ht < 300) return;
         _cutflow.fill(2);
 
@@ -67,16 +61,10 @@ namespace Gambit {
 
 
         // Get baseline electrons
-        vector<const Particle*> baseelecs;
-        for (const Particle* electron : event->electrons())
-          if (electron->pT() > 10. && electron->abseta() < 2.5)
-            baseelecs.push_back(electron);
+        const vector<const Particle*>& baseelecs = objects().electrons(10., 2.5);
 
         // Get baseline muons
-        vector<const Particle*> basemuons;
-        for (const Particle* muon : event->muons())
-          if (muon->pT() > 10. && muon->abseta() < 2.4)
-            basemuons.push_back(muon);
+        const vector<const Particle*>& basemuons = objects().muons(10., 2.4);
 
         // Electron isolation
         /// @todo Sum should actually be over all non-e/mu calo particles
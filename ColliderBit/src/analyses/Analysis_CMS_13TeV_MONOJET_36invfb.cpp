@@ -53,9 +53,7 @@ namespace Gambit {
         for (const Particle* y : event->photons()) if (y->pT() > 15 && y->abseta() < 2.5) return; //< VETO
 
         // Get jets
-        vector<const Jet*> jets4;
-        for (const Jet* jet : event->jets())
-          if (jet->pT() > 20) jets4.push_back(jet);
+        const vector<const Jet*>& jets4 = objects().jets(20., DBL_MAX);
 
         // Veto if there are any b-tagged jets (reduce top background)
         for (const Jet* jet : jets4) {
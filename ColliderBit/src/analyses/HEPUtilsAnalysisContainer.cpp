@@ -2,7 +2,9 @@
 #include "gambit/ColliderBit/ColliderBit_macros.hpp"
 #include "gambit/ColliderBit/analyses/HEPUtilsAnalysisContainer.hpp"
 #include "gambit/ColliderBit/analyses/BaseAnalysis.hpp"
+#include "gambit/ColliderBit/analyses/EventObjectCache.hpp"
 #include <stdexcept>
+#include <chrono>
 #include <omp.h>
 using namespace std;
 
@@ -127,7 +129,8 @@ namespace Gambit
       ready(false),
       is_registered(false),
       n_threads(omp_get_max_threads()),
-      base_key("")
+      base_key(""),
+      event_objects(new EventObjectCache())
     {
       #ifdef ANALYSISCONTAINER_DEBUG
         std::cout << "DEBUG: thread " << omp_get_thread_num() << ": HEPUtilsAnalysisContainer::ctor: created at " << this << std::endl;
@@ -272,6 +275,7 @@ namespace Gambit
       {
         analysis_pointer_pair.second->reset();
       }
+      analysis_seconds[collider_name].clear();
     }
 
     /// Reset all analyses for the current collider
@@ -302,12 +306,6 @@ namespace Gambit
       return analyses_map.at(collider_name);
     }
 
-    /// Get analyses map for the current collider
-    const std::map<string,HEPUtilsAnalysis*>& HEPUtilsAnalysisContainer::get_current_analyses_map() const
-    {
-      return analyses_map.at(current_collider);
-    }
-
     /// Get the full analyses map
     const std::map<string,std::map<string,HEPUtilsAnalysis*> >& HEPUtilsAnalysisContainer::get_full_analyses_map() const
     {
@@ -318,15 +316,21 @@ namespace Gambit
     /// Pass event through specific analysis
     void HEPUtilsAnalysisContainer::analyze(const HEPUtils::Event& event, string collider_name, string analysis_name) const
     {
-      analyses_map.at(collider_name).at(analysis_name)->do_analysis(event);
+      event_objects->reset(&event);
+      analyses_map.at(collider_name).at(analysis_name)->do_analysis(&event, event_objects.get());
     }
 
     /// Pass event through all analysis for a specific collider
     void HEPUtilsAnalysisContainer::analyze(const HEPUtils::Event& event, string collider_name) const
     {
+      // Common object selections are made at most once per event, by whichever analysis asks first
+      event_objects->reset(&event);
+      std::map<string,double>& seconds = analysis_seconds[collider_name];
       for (auto& analysis_pointer_pair : analyses_map.at(collider_name))
       {
-        analysis_pointer_pair.second->do_analysis(event);
+        const auto start = std::chrono::steady_clock::now();
+        analysis_pointer_pair.second->do_analysis(&event, event_objects.get());
+        seconds[analysis_pointer_pair.first] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
       }
     }
 
@@ -463,6 +467,29 @@ namespace Gambit
     }
 
 
+    /// Get the time spent in each analysis for the current collider, on this thread
+    const std::map<string,double>& HEPUtilsAnalysisContainer::get_analysis_timings() const
+    {
+      return analysis_seconds[current_collider];
+    }
+
+    /// Get the time spent in each analysis for the current collider, summed over all threads
+    std::map<string,double> HEPUtilsAnalysisContainer::collect_analysis_timings() const
+    {
+      std::map<string,double> total = get_analysis_timings();
+      if (instances_map.count(base_key) == 0) return total;
+      for (auto& thread_container_pair : instances_map.at(base_key))
+      {
+        if (thread_container_pair.second == this) continue;
+        for (auto& analysis_time_pair : thread_container_pair.second->analysis_seconds[current_collider])
+        {
+          total[analysis_time_pair.first] += analysis_time_pair.second;
+        }
+      }
+      return total;
+    }
+
+
     /// Scale results for specific analysis
     void HEPUtilsAnalysisContainer::scale(string collider_name, string analysis_name, double factor)
     {
@@ -5,6 +5,7 @@
 ///  Class function definitions and specialization init functions for SpecializablePythia.
 
 #include <stdexcept>
+#include <cstdlib>
 #include <sstream>
 #include "gambit/ColliderBit/colliders/SpecializablePythia.hpp"
 #include "gambit/ColliderBit/ColliderBit_macros.hpp"
@@ -84,6 +85,7 @@ namespace Gambit
     void SpecializablePythia::clear()
     {
       _pythiaSettings.clear();
+      _processXsecs.clear();
       if (_pythiaInstance)
       {
         delete _pythiaInstance;
@@ -118,7 +120,7 @@ namespace Gambit
       // Send along the SLHAea::Coll pointer, if it exists
       if (slhaea) _pythiaInstance->slhaInterface.slha.setSLHAea(slhaea);
 
-      if (!_pythiaInstance->init(os)) throw InitializationError();
+      _initInstance(os);
     }
 
     void SpecializablePythia::init(const std::string pythiaDocPath,
@@ -154,7 +156,46 @@ namespace Gambit
 
 	
 	
+      _initInstance(os);
+    }
+
+    void SpecializablePythia::_initInstance(std::ostream& os)
+    {
       if (!_pythiaInstance->init(os)) throw InitializationError();
+
+      // The GAMBIT patch to Pythia's ProcessLevel::init publishes the estimated maximum cross section (in mb)
+      // of each process in the settings, as "Gambit:sigmaMax<code>", with the codes in "Gambit:processCodes".
+      _processXsecs.clear();
+      Pythia8::Settings& settings = _pythiaInstance->settings;
+      if (!settings.isWord("Gambit:processCodes")) return;
+      std::istringstream codes(settings.word("Gambit:processCodes"));
+      ProcessXsec process;
+      while (codes >> process.code)
+      {
+        const std::string code = std::to_string(process.code);
+        if (!settings.isParm("Gambit:sigmaMax" + code)) continue;
+        process.name = settings.isWord("Gambit:processName" + code) ? settings.word("Gambit:processName" + code) : "";
+        process.xsecMax_pb = settings.parm("Gambit:sigmaMax" + code) * 1e9;
+        _processXsecs.push_back(process);
+      }
+    }
+
+    double SpecializablePythia::xsecEstimate_pb() const
+    {
+      double total = 0.;
+      for (const auto& process : _processXsecs) total += process.xsecMax_pb;
+      return total;
+    }
+
+    std::map<int, std::pair<double,long> > SpecializablePythia::processXsecs_pb() const
+    {
+      std::map<int, std::pair<double,long> > result;
+      if (!_pythiaInstance) return result;
+      for (int code : _pythiaInstance->info.codesHard())
+      {
+        result[code] = std::make_pair(_pythiaInstance->info.sigmaGen(code) * 1e9, _pythiaInstance->info.nTried(code));
+      }
+      return result;
     }
 
     void SpecializablePythia::resetSpecialization(const std::string& specName)
@@ -0,0 +1,210 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  ColliderBit Monte Carlo marginalisation of
+///  Poisson likelihoods over correlated signal
+///  region uncertainties.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <omp.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "gambit/ColliderBit/covariance_marginalisation.hpp"
+#include "gambit/Utils/threadsafe_rng.hpp"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// Constructor
+    logsumexp_accumulator::logsumexp_accumulator()
+     : shift(-std::numeric_limits<double>::infinity())
+     , sum(0)
+    {}
+
+    /// Add a set of log terms
+    void logsumexp_accumulator::add(const Eigen::Ref<const Eigen::ArrayXd>& x)
+    {
+      if (x.size() == 0) return;
+      const double xmax = x.maxCoeff();
+      if (xmax == -std::numeric_limits<double>::infinity()) return;
+      if (xmax > shift)
+      {
+        // Rescale what we have so far to the new reference shift
+        sum *= std::exp(shift - xmax);
+        shift = xmax;
+      }
+      sum += (x - shift).exp().sum();
+    }
+
+    /// Merge the terms accumulated by another accumulator into this one
+    void logsumexp_accumulator::add(const logsumexp_accumulator& other)
+    {
+      if (other.sum == 0) return;
+      if (other.shift > shift)
+      {
+        sum = sum * std::exp(shift - other.shift) + other.sum;
+        shift = other.shift;
+      }
+      else
+      {
+        sum += other.sum * std::exp(other.shift - shift);
+      }
+    }
+
+    /// Return log(sum_i exp(x_i)); -inf if no terms have been added
+    double logsumexp_accumulator::value() const
+    {
+      if (sum == 0) return -std::numeric_limits<double>::infinity();
+      return shift + std::log(sum);
+    }
+
+    /// Return log(<exp(x)>) = log(sum_i exp(x_i)) - log(n) for n terms
+    double logsumexp_accumulator::log_mean(std::size_t n) const
+    {
+      return value() - std::log((double)n);
+    }
+
+
+    /// Number of samples drawn per block by each thread
+    const std::size_t marg_poisson_sampler::block_size;
+
+    /// Constructor
+    marg_poisson_sampler::marg_poisson_sampler(const Eigen::ArrayXd& n_obs, const Eigen::ArrayXd& logfact_n_obs,
+                                               const Eigen::ArrayXd& n_pred, const Eigen::ArrayXd& sqrtE, const Eigen::MatrixXd& V)
+     : _n_obs(n_obs.matrix())
+     , _sum_logfact_n_obs(logfact_n_obs.sum())
+     , _n_pred(n_pred.matrix())
+     , _scaled_rotation(V * sqrtE.matrix().asDiagonal())
+    {}
+
+    /// Draw nsample samples (in parallel if OpenMP is active) and add their log-likelihoods to result
+    void marg_poisson_sampler::sample(std::size_t nsample, logsumexp_accumulator& result) const
+    {
+      const Eigen::Index nSR = _n_obs.size();
+      const std::size_t nblocks = (nsample + block_size - 1) / block_size;
+
+      #pragma omp parallel
+      {
+        // Per-thread work buffers, allocated once per call rather than once per sample
+        Eigen::MatrixXd unit_normals(nSR, block_size);
+        Eigen::MatrixXd rates(nSR, block_size);
+        Eigen::ArrayXd loglikes(block_size);
+        logsumexp_accumulator result_private;
+
+        #pragma omp for nowait
+        for (std::size_t block = 0; block < nblocks; ++block)
+        {
+          const Eigen::Index n = (Eigen::Index)std::min(block_size, nsample - block*block_size);
+
+          // Fill the whole block with unit normal deviates in one call
+          Random::fill_normal(unit_normals.data(), nSR*n);
+
+          // Rotate the rate deltas into the SR basis, shift by the SR mean rates and
+          // manually avoid <= 0 rates
+          auto lambda = rates.leftCols(n);
+          lambda.noalias() = _scaled_rotation * unit_normals.leftCols(n);
+          lambda.colwise() += _n_pred;
+          lambda = lambda.array().max(1e-3).matrix();
+
+          // Poisson log-likelihood of each sample, summed over SRs
+          loglikes.head(n) = (_n_obs.transpose() * lambda.array().log().matrix()).transpose().array()
+                           - lambda.colwise().sum().transpose().array() - _sum_logfact_n_obs;
+
+          result_private.add(loglikes.head(n));
+        }
+
+        #pragma omp critical
+        {
+          result.add(result_private);
+        }
+      } // End omp parallel
+    }
+
+    /// Constructor
+    bkg_covariance_cache::bkg_covariance_cache() : _hits(0), _misses(0) {}
+
+    /// Get the entry for an analysis, calling fill to compute it if this is the first time it is asked for
+    const bkg_covariance& bkg_covariance_cache::get(const std::string& analysis, const std::function<void(bkg_covariance&)>& fill)
+    {
+      const bkg_covariance* result;
+      #pragma omp critical (bkg_covariance_cache)
+      {
+        auto it = _entries.find(analysis);
+        if (it != _entries.end())
+        {
+          ++_hits;
+        }
+        else
+        {
+          ++_misses;
+          entry e;
+          fill(e.bkg);
+          it = _entries.emplace(analysis, std::move(e)).first;
+        }
+        result = &it->second.bkg;
+      }
+      return *result;
+    }
+
+    /// Get the background-only marginalised log-likelihood of an analysis, if it is known
+    bool bkg_covariance_cache::get_loglike_b(const std::string& analysis, double& loglike_b) const
+    {
+      bool found = false;
+      #pragma omp critical (bkg_covariance_cache)
+      {
+        auto it = _entries.find(analysis);
+        if (it != _entries.end() and it->second.have_loglike_b)
+        {
+          loglike_b = it->second.loglike_b;
+          found = true;
+        }
+      }
+      return found;
+    }
+
+    /// Keep the background-only marginalised log-likelihood of an analysis already in the cache (the first value given is kept)
+    void bkg_covariance_cache::set_loglike_b(const std::string& analysis, double loglike_b)
+    {
+      #pragma omp critical (bkg_covariance_cache)
+      {
+        auto it = _entries.find(analysis);
+        if (it != _entries.end() and not it->second.have_loglike_b)
+        {
+          it->second.loglike_b = loglike_b;
+          it->second.have_loglike_b = true;
+        }
+      }
+    }
+
+    /// Numbers of lookups that found an entry and that had to compute one
+    unsigned long long bkg_covariance_cache::hits() const
+    {
+      unsigned long long n;
+      #pragma omp critical (bkg_covariance_cache)
+      n = _hits;
+      return n;
+    }
+    unsigned long long bkg_covariance_cache::misses() const
+    {
+      unsigned long long n;
+      #pragma omp critical (bkg_covariance_cache)
+      n = _misses;
+      return n;
+    }
+
+  }
+}
@@ -14,6 +14,10 @@
 ///  \author Pat Scott
 ///  \author Martin White
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Elements/gambit_module_headers.hpp"
@@ -166,7 +170,7 @@ namespace Gambit {
     /// Convert a hadron-level Pythia8::Event into an unsmeared HEPUtils::Event
     /// @todo Overlap between jets and prompt containers: need some isolation in MET calculation
     void BuckFastBase::convertPythia8ParticleEvent(const Pythia8::Event& pevt, HEPUtils::Event& result) const {
-      result.clear();
+      _pool.recycle(result);
 
       std::vector<FJNS::PseudoJet> bhadrons; //< for input to FastJet b-tagging
       std::vector<HEPUtils::Particle> bpartons, cpartons, tauCandidates;
@@ -259,7 +263,7 @@ namespace Gambit {
 
         // Add prompt and invisible particles as individual particles
         if (prompt || !visible) {
-          HEPUtils::Particle* gp = new HEPUtils::Particle(mk_p4(p.p()), p.id());
+          HEPUtils::Particle* gp = _pool.particle(mk_p4(p.p()), p.id());
           gp->set_prompt();
           result.add_particle(gp);
         }
@@ -312,12 +316,12 @@ namespace Gambit {
 
         // Add to the event (use jet momentum for tau)
         if (isTau) {
-          HEPUtils::Particle* gp = new HEPUtils::Particle(HEPUtils::mk_p4(pj), MCUtils::PID::TAU);
+          HEPUtils::Particle* gp = _pool.particle(HEPUtils::mk_p4(pj), MCUtils::PID::TAU);
           gp->set_prompt();
           result.add_particle(gp);
         }
 
-        result.add_jet(new HEPUtils::Jet(HEPUtils::mk_p4(pj), isB, isC));
+        result.add_jet(_pool.jet(HEPUtils::mk_p4(pj), isB, isC));
       }
 
       /// Calculate missing momentum
@@ -342,7 +346,7 @@ namespace Gambit {
 
     /// Convert a partonic (no hadrons) Pythia8::Event into an unsmeared HEPUtils::Event
     void BuckFastBase::convertPythia8PartonEvent(const Pythia8::Event& pevt, HEPUtils::Event& result) const {
-      result.clear();
+      _pool.recycle(result);
 
       std::vector<HEPUtils::Particle> tauCandidates;
 
@@ -394,7 +398,7 @@ namespace Gambit {
         const bool prompt = isFinalPhoton(i, pevt) || (isFinalLepton(i, pevt)); // && std::abs(p.id()) != MCUtils::PID::TAU);
         const bool visible = MCUtils::PID::isStrongInteracting(p.id()) || MCUtils::PID::isEMInteracting(p.id());
         if (prompt || !visible) {
-          HEPUtils::Particle* gp = new HEPUtils::Particle(mk_p4(p.p()), p.id());
+          HEPUtils::Particle* gp = _pool.particle(mk_p4(p.p()), p.id());
           gp->set_prompt();
           result.add_particle(gp);
         }
@@ -423,7 +427,7 @@ namespace Gambit {
                  [](const FJNS::PseudoJet& c){ return c.user_index() == MCUtils::PID::BQUARK; });
         const bool isC = HEPUtils::any(pj.constituents(),
                  [](const FJNS::PseudoJet& c){ return c.user_index() == MCUtils::PID::CQUARK; });
-        result.add_jet(new HEPUtils::Jet(HEPUtils::mk_p4(pj), isB, isC));
+        result.add_jet(_pool.jet(HEPUtils::mk_p4(pj), isB, isC));
 
         bool isTau=false;
         for(auto& ptau : tauCandidates){
@@ -435,7 +439,7 @@ namespace Gambit {
         }
         // Add to the event (use jet momentum for tau)
         if (isTau) {
-          HEPUtils::Particle* gp = new HEPUtils::Particle(HEPUtils::mk_p4(pj), MCUtils::PID::TAU);
+          HEPUtils::Particle* gp = _pool.particle(HEPUtils::mk_p4(pj), MCUtils::PID::TAU);
           gp->set_prompt();
           result.add_particle(gp);
         }
@@ -16,6 +16,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2016 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *************************************
 
 #include "gambit/ColliderBit/limits/BaseLimitContainer.hpp"
@@ -25,6 +29,89 @@ namespace Gambit
   namespace ColliderBit
   {
 
+    void SegmentGrid::build(const std::vector<LineSegment>& segments)
+    {
+      _xmin = _ymin = std::numeric_limits<double>::infinity();
+      _xmax = _ymax = -std::numeric_limits<double>::infinity();
+      for (auto it = segments.begin(); it != segments.end(); ++it) {
+        _xmin = std::min(_xmin, std::min(it->getp1().getx(), it->getp2().getx()));
+        _xmax = std::max(_xmax, std::max(it->getp1().getx(), it->getp2().getx()));
+        _ymin = std::min(_ymin, std::min(it->getp1().gety(), it->getp2().gety()));
+        _ymax = std::max(_ymax, std::max(it->getp1().gety(), it->getp2().gety()));
+      }
+      if (segments.empty()) { _xmin = _ymin = 0.; _xmax = _ymax = 1.; }
+
+      // Roughly one segment per cell on average, within sensible bounds.
+      _nx = _ny = std::max(1, std::min(256, int(std::sqrt(double(segments.size())))));
+      _dx = std::max(_xmax - _xmin, 1e-10) / _nx;
+      _dy = std::max(_ymax - _ymin, 1e-10) / _ny;
+      _cells.assign(_nx * _ny, std::vector<unsigned>());
+
+      // Register each segment in every cell overlapped by its bounding box.
+      for (unsigned i = 0; i < segments.size(); ++i) {
+        const P2 p1 = segments[i].getp1(), p2 = segments[i].getp2();
+        const int c0 = column(std::min(p1.getx(), p2.getx())), c1 = column(std::max(p1.getx(), p2.getx()));
+        const int r0 = row(std::min(p1.gety(), p2.gety())), r1 = row(std::max(p1.gety(), p2.gety()));
+        for (int c = c0; c <= c1; ++c)
+          for (int r = r0; r <= r1; ++r)
+            _cells[c * _ny + r].push_back(i);
+      }
+    }
+
+    int SegmentGrid::column(double x) const
+    {
+      return std::max(0, std::min(_nx - 1, int(std::floor((x - _xmin) / _dx))));
+    }
+
+    int SegmentGrid::row(double y) const
+    {
+      return std::max(0, std::min(_ny - 1, int(std::floor((y - _ymin) / _dy))));
+    }
+
+    void SegmentGrid::candidates(const LineSegment& query, std::vector<unsigned>& result) const
+    {
+      result.clear();
+      const P2 q1 = query.getp1(), q2 = query.getp2();  // q1.x <= q2.x
+      // Slack absorbs rounding differences between this and LineSegment::intersectsAt.
+      const double xslack = 1e-6 * _dx, yslack = 1e-6 * _dy;
+      const double qxlo = std::max(q1.getx() - xslack, _xmin), qxhi = std::min(q2.getx() + xslack, _xmax);
+      if (qxlo > qxhi) return;
+      const bool vertical = (q1.getx() == q2.getx());
+      const double slope = vertical ? 0. : (q2.gety() - q1.gety()) / (q2.getx() - q1.getx());
+      const double qylo = std::min(q1.gety(), q2.gety()), qyhi = std::max(q1.gety(), q2.gety());
+
+      // Walk the grid columns spanned by the query, marking the rows that its y-range covers in each.
+      for (int c = column(qxlo), cend = column(qxhi); c <= cend; ++c) {
+        double ylo = qylo, yhi = qyhi;
+        if (!vertical) {
+          const double xa = std::max(qxlo, _xmin + c * _dx), xb = std::min(qxhi, _xmin + (c + 1) * _dx);
+          const double ya = q1.gety() + slope * (xa - q1.getx()), yb = q1.gety() + slope * (xb - q1.getx());
+          ylo = std::max(qylo, std::min(ya, yb));
+          yhi = std::min(qyhi, std::max(ya, yb));
+        }
+        ylo -= yslack;
+        yhi += yslack;
+        if (yhi < _ymin or ylo > _ymax) continue;
+        for (int r = row(ylo), rend = row(yhi); r <= rend; ++r) {
+          const std::vector<unsigned>& cell = _cells[c * _ny + r];
+          result.insert(result.end(), cell.begin(), cell.end());
+        }
+      }
+
+      std::sort(result.begin(), result.end());
+      result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+
+    void BaseLimitContainer::buildSegmentGrids() const
+    {
+      std::call_once(_segmentGridsBuilt, [this]()
+      {
+        _segmentGrids.resize(_limitValuesSorted.size());
+        for (unsigned index = 0; index < _limitValuesSorted.size(); ++index)
+          _segmentGrids[index].build(*_limitContours.at(index));
+      });
+    }
+
     BaseLimitContainer::~BaseLimitContainer()
     {
       // Clean up all the contours created when this object was constructed.
@@ -40,6 +127,30 @@ namespace Gambit
     }
   
     double BaseLimitContainer::limitAverage(double x, double y, double mZ) const
+    {
+      return interpolateLimit(x, y, mZ, true);
+    }
+
+    double BaseLimitContainer::limitAverageExact(double x, double y, double mZ) const
+    {
+      return interpolateLimit(x, y, mZ, false);
+    }
+
+    void BaseLimitContainer::segmentCandidates(unsigned index, const LineSegment& query,
+                                               bool useSegmentGrids, std::vector<unsigned>& result) const
+    {
+      if (useSegmentGrids)
+      {
+        _segmentGrids[index].candidates(query, result);
+      }
+      else
+      {
+        result.resize(_limitContours.at(index)->size());
+        for (unsigned i = 0; i < result.size(); ++i) result[i] = i;
+      }
+    }
+
+    double BaseLimitContainer::interpolateLimit(double x, double y, double mZ, bool useSegmentGrids) const
     {
       if (!isWithinExclusionRegion(x, y, mZ)) return specialLimit(x, y);
       const P2& point = P2(x, y);
@@ -49,14 +160,19 @@ namespace Gambit
       double r, rmin;
       double average, totalWeight, thisLimit, nextBestLimit;
       unsigned intersectCounter, index;
+      std::vector<unsigned> candidates;
+
+      // Only segments near each query line need to be tested; see SegmentGrid.
+      if (useSegmentGrids) buildSegmentGrids();
   
       // First, find the inner-most contour in which lies point.
       for (index=0; index<_limitValuesSorted.size(); index++) {
         intersectCounter = 0; 
         thisLimit = _limitValuesSorted[index];
-        for (auto segmentIter = _limitContours.at(index)->begin();
-                  segmentIter != _limitContours.at(index)->end(); ++segmentIter)
-          if (externalLine.intersectsAt(*segmentIter).r() < std::numeric_limits<double>::infinity())
+        const Contours& contour = *_limitContours.at(index);
+        segmentCandidates(index, externalLine, useSegmentGrids, candidates);
+        for (auto it = candidates.begin(); it != candidates.end(); ++it)
+          if (externalLine.intersectsAt(contour[*it]).r() < std::numeric_limits<double>::infinity())
             intersectCounter++;
         if (intersectCounter % 2) break;
         thisLimit = -1.;
@@ -82,9 +198,10 @@ namespace Gambit
   
         // For each ray, look for intersections with the next best limit.
         rmin = std::numeric_limits<double>::infinity();
-        for (auto segmentIter = _limitContours.at(index-1)->begin();
-                  segmentIter != _limitContours.at(index-1)->end(); ++segmentIter) {
-          intersectLine.init(point, ray.intersectsAt(*segmentIter));
+        const Contours& nextBestContour = *_limitContours.at(index-1);
+        segmentCandidates(index-1, ray, useSegmentGrids, candidates);
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+          intersectLine.init(point, ray.intersectsAt(nextBestContour[*it]));
           r = intersectLine.r();
           if (r <= rmin) rmin = r;
         }
@@ -99,9 +216,10 @@ namespace Gambit
   
         // For each ray, also look for intersections with the current limit.
         rmin = std::numeric_limits<double>::infinity();
-        for (auto segmentIter = _limitContours.at(index)->begin();
-                  segmentIter != _limitContours.at(index)->end(); ++segmentIter) {
-          intersectLine.init(point, ray.intersectsAt(*segmentIter));
+        const Contours& thisContour = *_limitContours.at(index);
+        segmentCandidates(index, ray, useSegmentGrids, candidates);
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+          intersectLine.init(point, ray.intersectsAt(thisContour[*it]));
           r = intersectLine.r();
           if (r <= rmin) rmin = r;
         }
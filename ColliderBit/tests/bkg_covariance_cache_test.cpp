@@ -0,0 +1,165 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the cache of background-only
+///  covariance matrix decompositions used by
+///  calc_LHC_LogLikes: a cached decomposition gives
+///  the same marginalised log-likelihood as a
+///  recomputed one, each analysis is decomposed
+///  once even when looked up from several threads
+///  at once, and the background-only likelihood
+///  is kept as first given.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <omp.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Eigen/Eigenvalues"
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/threadsafe_rng.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/ColliderBit/covariance_marginalisation.hpp"
+
+using namespace Gambit;
+using namespace Gambit::ColliderBit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// A toy analysis with three correlated signal regions
+  struct toy_analysis
+  {
+    Eigen::ArrayXd n_obs, n_pred;
+    Eigen::MatrixXd srcov;
+
+    toy_analysis() : n_obs(3), n_pred(3), srcov(3, 3)
+    {
+      n_obs << 12, 5, 30;
+      n_pred << 10.5, 6.2, 27.;
+      srcov << 4.0, 1.2, 0.8,
+               1.2, 2.5, 0.5,
+               0.8, 0.5, 9.0;
+    }
+
+    /// Decompose the background covariance matrix, as calc_LHC_LogLikes does
+    void fill(bkg_covariance& entry) const
+    {
+      entry.logfact_n_obs.resize(n_obs.size());
+      for (Eigen::Index SR = 0; SR < n_obs.size(); ++SR) entry.logfact_n_obs(SR) = std::lgamma(n_obs(SR) + 1.);
+      const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig_b(srcov);
+      entry.sqrtEb = eig_b.eigenvalues().array().sqrt();
+      entry.Vb = eig_b.eigenvectors();
+    }
+  };
+
+  /// Background-only marginalised log-likelihood from a decomposition, replaying the same random numbers every time
+  double loglike_b(const toy_analysis& ana, const bkg_covariance& bkg)
+  {
+    const std::size_t nsample = 20000;
+    Random::set_point(1);
+    const marg_poisson_sampler sampler(ana.n_obs, bkg.logfact_n_obs, ana.n_pred, bkg.sqrtEb, bkg.Vb);
+    logsumexp_accumulator lsum;
+    sampler.sample(nsample, lsum);
+    Random::end_point();
+    return lsum.log_mean(nsample);
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+  Random::create_rng_engine("philox4x32_10", 1234);
+  omp_set_num_threads(1);
+
+  const toy_analysis ana;
+
+  std::cout << "Cached and recomputed decompositions" << std::endl;
+  {
+    bkg_covariance_cache cache;
+    int fills = 0;
+    const auto fill = [&](bkg_covariance& entry) { ++fills; ana.fill(entry); };
+    const bkg_covariance& first = cache.get("toy", fill);
+    const double loglike_first = loglike_b(ana, first);
+    const bkg_covariance& cached = cache.get("toy", fill);
+    check(fills == 1 and &cached == &first, "the second lookup returns the stored entry without recomputing it");
+    check(cache.hits() == 1 and cache.misses() == 1, "hits and misses are counted");
+
+    bkg_covariance recomputed;
+    ana.fill(recomputed);
+    const double loglike_cached = loglike_b(ana, cached);
+    const double loglike_recomputed = loglike_b(ana, recomputed);
+    check(std::isfinite(loglike_cached), "the marginalised log-likelihood is finite");
+    check(loglike_cached == loglike_recomputed and loglike_cached == loglike_first,
+          "a cached decomposition gives the same log-likelihood as a recomputed one");
+
+    double stored = 0;
+    check(not cache.get_loglike_b("toy", stored), "the background-only log-likelihood is unknown until set");
+    cache.set_loglike_b("toy", loglike_cached);
+    cache.set_loglike_b("toy", 0.);
+    check(cache.get_loglike_b("toy", stored) and stored == loglike_cached, "the first background-only log-likelihood given is kept");
+    check(not cache.get_loglike_b("other", stored), "other analyses are unaffected");
+    cache.set_loglike_b("other", -1.);
+    check(not cache.get_loglike_b("other", stored) and cache.misses() == 1, "nothing is stored for analyses not yet in the cache");
+  }
+
+  std::cout << "Concurrent lookups" << std::endl;
+  {
+    bkg_covariance_cache cache;
+    std::atomic<int> fills[2];
+    fills[0] = 0;
+    fills[1] = 0;
+    const int nthreads = 8;
+    std::vector<const bkg_covariance*> found(nthreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthreads; ++i)
+    {
+      threads.emplace_back([&, i]()
+      {
+        const int a = i%2;
+        found[i] = &cache.get(a == 0 ? "toy_0" : "toy_1", [&](bkg_covariance& entry)
+        {
+          ++fills[a];
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          ana.fill(entry);
+        });
+        cache.set_loglike_b(a == 0 ? "toy_0" : "toy_1", -1.);
+      });
+    }
+    for (std::thread& t : threads) t.join();
+    check(fills[0] == 1 and fills[1] == 1, "each analysis is decomposed once");
+    bool same = true;
+    for (int i = 2; i < nthreads; ++i) same = same and found[i] == found[i%2];
+    check(same and found[0] != found[1], "all threads get the same entry for an analysis");
+    check(cache.hits() == nthreads - 2 and cache.misses() == 2, "hits and misses are counted across threads");
+    check(found[0]->Vb.rows() == 3 and found[1]->Vb.rows() == 3, "the entries are filled before they are handed out");
+  }
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,171 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the event counters of the parallel
+///  ColliderBit event loop: however many events
+///  fail, and in whatever order the threads get
+///  to them, the loop ends with exactly
+///  max_nEvents good events, and no event number
+///  is ever used twice.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <omp.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gambit/Utils/util_types.hpp"
+#include "gambit/ColliderBit/EventTickets.hpp"
+
+using namespace Gambit;
+using namespace Gambit::ColliderBit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// What a run of the event loop did
+  struct loop_result
+  {
+    int good;                  ///< Events generated successfully
+    int failed;                ///< Events that failed
+    std::vector<int> numbers;  ///< Event numbers used, good or failed
+  };
+
+  /// Run an event loop like operateLHCLoop's on nthreads threads, in which each event fails with the given
+  /// probability, and any event number listed in fail_always fails.
+  loop_result run_loop(EventTickets& tickets, int nthreads, double p_fail, const std::vector<int>& fail_always = {})
+  {
+    loop_result result = {0, 0, {}};
+    std::vector<std::vector<int>> numbers(nthreads);
+    std::vector<int> good(nthreads, 0), failed(nthreads, 0);
+    #pragma omp parallel num_threads(nthreads)
+    {
+      const int thread = omp_get_thread_num();
+      std::mt19937 gen(17 + thread);
+      std::uniform_real_distribution<double> uniform(0., 1.);
+      while (true)
+      {
+        int eventNumber;
+        const EventTickets::status ticket = tickets.claim(eventNumber);
+        if (ticket == EventTickets::finished) break;
+        if (ticket == EventTickets::wait)
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        numbers[thread].push_back(eventNumber);
+        // Let the threads overtake each other
+        if (uniform(gen) < 0.1) std::this_thread::yield();
+        const bool fails = uniform(gen) < p_fail or std::count(fail_always.begin(), fail_always.end(), eventNumber) > 0;
+        if (fails)
+        {
+          failed[thread]++;
+          tickets.failed();
+        }
+        else
+        {
+          good[thread]++;
+          tickets.succeeded();
+        }
+      }
+    }
+    for (int i = 0; i < nthreads; ++i)
+    {
+      result.good += good[i];
+      result.failed += failed[i];
+      result.numbers.insert(result.numbers.end(), numbers[i].begin(), numbers[i].end());
+    }
+    std::sort(result.numbers.begin(), result.numbers.end());
+    return result;
+  }
+
+  /// Are the event numbers used exactly 0, 1, ..., n-1, each once?
+  bool numbered_once(const loop_result& result)
+  {
+    for (std::size_t i = 0; i < result.numbers.size(); ++i)
+    {
+      if (result.numbers[i] != (int)i) return false;
+    }
+    return true;
+  }
+
+}
+
+int main()
+{
+  std::cout << "A single thread" << std::endl;
+  {
+    EventTickets tickets(2);
+    int first = -1, second = -1, third = -1, fourth = -1;
+    bool ok = tickets.claim(first) == EventTickets::granted and tickets.claim(second) == EventTickets::granted;
+    check(ok and first == 0 and second == 1, "events are numbered in turn");
+    check(tickets.claim(third) == EventTickets::wait, "a thread has to wait while every place is taken by events in progress");
+    tickets.failed();
+    check(tickets.claim(third) == EventTickets::granted and third == 2, "a failed event gives its place back, but not its number");
+    tickets.succeeded();
+    tickets.succeeded();
+    check(tickets.claim(fourth) == EventTickets::finished and tickets.n_done() == 2 and tickets.n_numbered() == 3,
+          "the loop is finished once max_nEvents events have succeeded");
+
+    EventTickets none(0);
+    check(none.claim(first) == EventTickets::finished and none.n_numbered() == 0, "no events are generated for max_nEvents = 0");
+  }
+
+  std::cout << "Several threads" << std::endl;
+  {
+    const std::vector<int> max_nEvents = {1, 3, 16, 1000};
+    const std::vector<double> p_fail = {0., 0.3, 0.9};
+    bool exact = true, once = true, accounted = true;
+    for (int nthreads : {2, 8})
+    {
+      for (int max : max_nEvents)
+      {
+        for (double p : p_fail)
+        {
+          for (int trial = 0; trial < 5; ++trial)
+          {
+            EventTickets tickets(max);
+            const loop_result result = run_loop(tickets, nthreads, p);
+            exact = exact and result.good == max and tickets.n_done() == max;
+            once = once and numbered_once(result);
+            accounted = accounted and (int)result.numbers.size() == result.good + result.failed
+                                  and tickets.n_numbered() == result.good + result.failed;
+          }
+        }
+      }
+    }
+    check(exact, "the loop ends with exactly max_nEvents good events, however many events fail");
+    check(once, "no event number is used twice or skipped");
+    check(accounted, "every event number handed out belongs to a good or a failed event");
+
+    // The last events all fail at first, while the other threads are waiting for the last places
+    EventTickets tickets(20);
+    const loop_result result = run_loop(tickets, 8, 0., {15, 16, 17, 18, 19, 20, 21, 22, 23});
+    check(result.good == 20 and result.failed == 9 and numbered_once(result),
+          "events failing at the end of the loop are replaced by new ones");
+  }
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,143 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark and agreement check of the segment
+///  grids used by BaseLimitContainer::limitAverage:
+///  every LEP limit container used by ColliderBit is
+///  evaluated over the grid of its dumpPlotData call
+///  in ColliderBit_LEP.cpp, both with the segment
+///  grids and by testing every contour segment
+///  (limitAverageExact).  Returns nonzero if the two
+///  differ anywhere.
+///
+///  Usage: lep_limit_grid_benchmark [ngrid]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/ColliderBit/limits/ALEPHSleptonLimits.hpp"
+#include "gambit/ColliderBit/limits/L3SleptonLimits.hpp"
+#include "gambit/ColliderBit/limits/L3GauginoLimits.hpp"
+#include "gambit/ColliderBit/limits/OPALGauginoLimits.hpp"
+#include "gambit/ColliderBit/limits/OPALDegenerateCharginoLimits.hpp"
+
+using namespace Gambit;
+using namespace Gambit::ColliderBit;
+
+namespace
+{
+
+  /// A limit container and the plane it is plotted over in ColliderBit_LEP.cpp
+  struct limit_plane
+  {
+    const char* name;
+    std::shared_ptr<BaseLimitContainer> limits;
+    double xlow, xhigh, ylow, yhigh;
+  };
+
+  template <typename T>
+  limit_plane plane(const char* name, double xlow, double xhigh, double ylow, double yhigh)
+  {
+    return limit_plane{name, std::make_shared<T>(), xlow, xhigh, ylow, yhigh};
+  }
+
+  /// Evaluate f over the (ngrid+1)^2 points of dumpPlotData, returning the wall time in ms
+  template <typename F>
+  double evaluate(const limit_plane& p, int ngrid, std::vector<double>& result, F f)
+  {
+    result.clear();
+    const auto start = std::chrono::steady_clock::now();
+    for (int xi = 0; xi <= ngrid; xi++)
+    {
+      const double x = p.xlow + (p.xhigh - p.xlow) * xi / ngrid;
+      for (int yi = 0; yi <= ngrid; yi++)
+      {
+        const double y = p.ylow + (p.yhigh - p.ylow) * yi / ngrid;
+        result.push_back(f(x, y));
+      }
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const int ngrid = (argc > 1 ? std::atoi(argv[1]) : 100);
+  const double mZ = 91.1876;
+
+  logger().disable();
+
+  const std::vector<limit_plane> planes =
+  {
+    plane<ALEPHSelectronLimitAt208GeV>("ALEPHSelectronLimitAt208GeV", 45., 115., 0., 100.),
+    plane<ALEPHSmuonLimitAt208GeV>("ALEPHSmuonLimitAt208GeV", 45., 115., 0., 100.),
+    plane<ALEPHStauLimitAt208GeV>("ALEPHStauLimitAt208GeV", 45., 115., 0., 100.),
+    plane<L3SelectronLimitAt205GeV>("L3SelectronLimitAt205GeV", 45., 104., 0., 100.),
+    plane<L3SmuonLimitAt205GeV>("L3SmuonLimitAt205GeV", 45., 115., 0., 100.),
+    plane<L3StauLimitAt205GeV>("L3StauLimitAt205GeV", 45., 115., 0., 100.),
+    plane<L3NeutralinoAllChannelsLimitAt188pt6GeV>("L3NeutralinoAllChannelsLimitAt188pt6GeV", 0., 200., 0., 100.),
+    plane<L3NeutralinoLeptonicLimitAt188pt6GeV>("L3NeutralinoLeptonicLimitAt188pt6GeV", 0., 200., 0., 100.),
+    plane<L3CharginoAllChannelsLimitAt188pt6GeV>("L3CharginoAllChannelsLimitAt188pt6GeV", 45., 100., 0., 100.),
+    plane<L3CharginoLeptonicLimitAt188pt6GeV>("L3CharginoLeptonicLimitAt188pt6GeV", 45., 100., 0., 100.),
+    plane<OPALCharginoHadronicLimitAt208GeV>("OPALCharginoHadronicLimitAt208GeV", 75., 105., 0., 105.),
+    plane<OPALCharginoSemiLeptonicLimitAt208GeV>("OPALCharginoSemiLeptonicLimitAt208GeV", 75., 105., 0., 105.),
+    plane<OPALCharginoLeptonicLimitAt208GeV>("OPALCharginoLeptonicLimitAt208GeV", 75., 105., 0., 105.),
+    plane<OPALCharginoAllChannelsLimitAt208GeV>("OPALCharginoAllChannelsLimitAt208GeV", 75., 105., 0., 105.),
+    plane<OPALDegenerateCharginoLimitAt208GeV>("OPALDegenerateCharginoLimitAt208GeV", 45., 95., 0.320, 5.),
+    plane<OPALNeutralinoHadronicLimitAt208GeV>("OPALNeutralinoHadronicLimitAt208GeV", 0., 200., 0., 100.),
+  };
+
+  Utils::benchmark_table table("LEP limit interpolation over " + std::to_string(ngrid+1) + "x" + std::to_string(ngrid+1)
+                                + " dumpPlotData grids",
+                                {{"container", 42, ""}, {"exact [ms]", 12, "%.1f"}, {"grid [ms]", 12, "%.1f"},
+                                 {"speedup", 9, "%.2f"}, {"mismatches", 10, ""}});
+  int total_mismatches = 0;
+  double total_exact = 0., total_grid = 0.;
+  std::vector<double> exact, grid;
+  for (const limit_plane& p : planes)
+  {
+    const BaseLimitContainer& limits = *p.limits;
+    // The first call builds the segment grids; keep that out of the timing.
+    limits.limitAverage(p.xlow, p.ylow, mZ);
+    const double t_exact = evaluate(p, ngrid, exact, [&](double x, double y) { return limits.limitAverageExact(x, y, mZ); });
+    const double t_grid = evaluate(p, ngrid, grid, [&](double x, double y) { return limits.limitAverage(x, y, mZ); });
+    int mismatches = 0;
+    for (size_t i = 0; i < exact.size(); ++i)
+    {
+      // The grids only skip segments that cannot intersect, so the results must be identical.
+      if (not (exact[i] == grid[i] or (exact[i] != exact[i] and grid[i] != grid[i]))) mismatches++;
+    }
+    table.row(p.name, t_exact, t_grid, t_exact/t_grid, mismatches);
+    total_mismatches += mismatches;
+    total_exact += t_exact;
+    total_grid += t_grid;
+  }
+  table.row("total", total_exact, total_grid, total_exact/total_grid, total_mismatches);
+
+  if (total_mismatches > 0)
+  {
+    std::printf("The segment grids change limitAverage at %d point(s).\n", total_mismatches);
+    return 1;
+  }
+  std::printf("The segment grids agree with the exact limitAverage everywhere.\n");
+  return 0;
+}
@@ -0,0 +1,141 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the per-point cost of
+///  initialising Pythia in getPythia: every
+///  thread initialising its own instance at
+///  START_SUBPROCESS (the original scheme), against
+///  one master instance initialised at
+///  COLLIDER_INIT, with the other threads only
+///  initialising theirs if events are generated.
+///  The costs are also given in units of the time
+///  taken to generate one event.  Also checks that
+///  the cross-section pre-screen's upper limit at
+///  a margin of 1 is not below Pythia's estimate.
+///
+///  Needs the BOSSed Pythia backend, so is built
+///  like the ColliderBit standalone.
+///
+///  Usage: pythia_init_benchmark <SLHA file> [nthreads] [nevents]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <omp.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Elements/standalone_module.hpp"
+#include "gambit/ColliderBit/ColliderBit_rollcall.hpp"
+#include "gambit/ColliderBit/colliders/SpecializablePythia.hpp"
+#include "gambit/ColliderBit/XsecPrescreen.hpp"
+
+using namespace Gambit::ColliderBit;
+
+namespace
+{
+
+  /// Initialise a Pythia instance for the 13 TeV LHC as getPythia does, with the given seed
+  void init(SpecializablePythia& pythia, const str& doc_path, const str& slha_file, int seed)
+  {
+    const std::vector<str> options = {"Print:quiet = on", "SLHA:verbose = 0",
+                                      "SLHA:file = " + slha_file, "Random:seed = " + std::to_string(seed)};
+    pythia.resetSpecialization("Pythia_SUSY_LHC_13TeV");
+    pythia.init(doc_path, options);
+  }
+
+  /// Wall time (s) since start
+  double since(const std::chrono::steady_clock::time_point& start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::printf("Usage: %s <SLHA file> [nthreads] [nevents]\n", argv[0]);
+    return 1;
+  }
+  const str slha_file = argv[1];
+  const int nthreads = (argc > 2 ? std::atoi(argv[2]) : omp_get_max_threads());
+  const int nevents = (argc > 3 ? std::atoi(argv[3]) : 1000);
+
+  logger().disable();
+
+  const str version = Backends::backendInfo().default_version("Pythia");
+  if (not Backends::backendInfo().works["Pythia" + version])
+  {
+    std::printf("Pythia %s is missing; nothing to benchmark.\n", version.c_str());
+    return 1;
+  }
+  const str doc_path = GAMBIT_DIR "/Backends/installed/Pythia/" + version + "/share/Pythia8/xmldoc/";
+
+  std::vector<SpecializablePythia> pythias(nthreads);
+
+  // Original scheme: every thread initialises its own instance
+  auto start = std::chrono::steady_clock::now();
+  #pragma omp parallel num_threads(nthreads)
+  init(pythias[omp_get_thread_num()], doc_path, slha_file, 1234 + omp_get_thread_num());
+  const double t_all_threads = since(start);
+
+  // Current scheme: the master instance alone (points that are vetoed, invalid or reuse cached yields)...
+  start = std::chrono::steady_clock::now();
+  init(pythias[0], doc_path, slha_file, 1234);
+  const double t_master = since(start);
+
+  // ...followed by the other threads, if events are generated
+  start = std::chrono::steady_clock::now();
+  #pragma omp parallel num_threads(nthreads)
+  if (omp_get_thread_num() != 0) init(pythias[omp_get_thread_num()], doc_path, slha_file, 1234 + omp_get_thread_num());
+  const double t_other_threads = since(start);
+
+  // Cost of one event on one thread, for comparison
+  SpecializablePythia::EventType event;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nevents; ++i)
+  {
+    try { pythias[0].nextEvent(event); }
+    catch (SpecializablePythia::EventGenerationError&) {}
+  }
+  const double t_event = since(start) / nevents;
+
+  std::ostringstream caption;
+  caption << "Pythia " << version << " initialisation per point, " << nthreads << " threads, cross-section estimate "
+          << std::setprecision(4) << pythias[0].xsecEstimate_pb() << " pb";
+  Gambit::Utils::benchmark_table table(caption.str(), {{"scheme", 44, ""}, {"wall [s]", 12, "%.3f"}, {"events", 12, "%.0f"}});
+  table.row("original: all threads", t_all_threads, t_all_threads/t_event);
+  table.row("master only (vetoed or cached points)", t_master, t_master/t_event);
+  table.row("master, then other threads (generating)", t_master + t_other_threads, (t_master + t_other_threads)/t_event);
+  std::printf("One event takes %.3g ms on one thread.\n", 1e3*t_event);
+
+  // The pre-screen must never veto a point that Pythia would keep
+  std::ifstream input(slha_file);
+  const SLHAea::Coll slha(input);
+  XsecPrescreen prescreen;
+  prescreen.configure(1.);
+  const double upper_limit_fb = prescreen.xsec_upper_limit_fb(slha, XsecPrescreen::collider_ecm("Pythia_SUSY_LHC_13TeV", {}));
+  const double pythia_fb = 1e3*pythias[0].xsecEstimate_pb();
+  std::printf("Pre-screen upper limit at margin 1: %.4g fb; Pythia estimate: %.4g fb.\n", upper_limit_fb, pythia_fb);
+  if (upper_limit_fb < pythia_fb)
+  {
+    std::printf("The pre-screen upper limit is below Pythia's estimate.\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,214 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Unit tests of the ColliderBit signal yield
+///  cache (SignalYieldCache): the spectrum read
+///  from the SLHA input, hits and misses with and
+///  without a tolerance, least-recently-used
+///  eviction, and the rescaling of reused yields
+///  with the process cross-sections.
+///
+///  Usage: signal_yield_cache_test [SLHA file]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/ColliderBit/SignalYieldCache.hpp"
+#include "gambit/ColliderBit/analyses/BaseAnalysis.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::ColliderBit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  bool close(double a, double b) { return std::abs(a-b) <= 1e-12*std::max(std::abs(a), std::abs(b)); }
+
+  /// An analysis with two signal regions, whose counts are only ever restored
+  class TestAnalysis : public HEPUtilsAnalysis
+  {
+    public:
+      TestAnalysis() { set_luminosity(10.); }
+      void analyze(const HEPUtils::Event* e) { HEPUtilsAnalysis::analyze(e); }
+      void collect_results()
+      {
+        add_result(SignalRegionData("SR1", 10., {0., 0.}, {9., 1.}));
+        add_result(SignalRegionData("SR2", 5., {0., 0.}, {4., 1.}));
+      }
+    protected:
+      void clear() {}
+  };
+
+  /// A key for the given spectrum
+  SignalYieldCache::Key make_key(const SLHAea::Coll& slha, const str& collider = "Pythia_SUSY_LHC_13TeV")
+  {
+    SignalYieldCache::Key key;
+    key.set_spectrum(slha);
+    key.new_collider(collider);
+    key.settings = {"Print:quiet = on", "max_nEvents = 1000"};
+    key.analyses["CMSAnalysisContainer"] = {"Test"};
+    return key;
+  }
+
+  /// Store an entry for a key, with the given counts and process cross-sections from two Pythia instances
+  void store(SignalYieldCache& cache, const SignalYieldCache::Key& key, double count)
+  {
+    SignalYieldCache::AnalysisYields yields;
+    yields.n_signal = {count, 2*count};
+    yields.num_events = 1000.;
+    yields.xsec = 4.5;
+    yields.xsec_err = 0.5;
+    cache.start(key);
+    cache.store("CMSAnalysisContainer", "Test", yields);
+    cache.add_process_xsecs({{1201, {2., 100}}, {1202, {1., 100}}});
+    cache.add_process_xsecs({{1201, {4., 300}}, {1202, {1., 300}}});
+    cache.commit(1000);
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  logger().disable();
+  const str slha_file = (argc > 1 ? argv[1] : "DarkBit/data/benchmarks/stau_coannihilation.slha1");
+  const double inf = std::numeric_limits<double>::infinity();
+
+  std::ifstream input(slha_file);
+  if (not input)
+  {
+    std::cout << "  FAILED: could not read " << slha_file << std::endl;
+    return 1;
+  }
+  const SLHAea::Coll slha(input);
+
+  std::cout << "Spectrum (" << slha_file << "):" << std::endl;
+  const SignalYieldCache::Key key = make_key(slha);
+  check(key.has_spectrum(), "the spectrum is read");
+  check(key.dimensionful.count("MASS 1000021") and close(key.dimensionful.at("MASS 1000021"), std::stod(slha.at("MASS").at("1000021").at(1))),
+        "masses are read, by PDG code");
+  check(key.dimensionful.count("DECAY 1000021") and close(key.dimensionful.at("DECAY 1000021"), 5.190942993972146e+02), "total widths are read");
+  check(key.dimensionless.count("DECAY 1000021 -> -2000006 6") and close(key.dimensionless.at("DECAY 1000021 -> -2000006 6"), 4.006207545448938e-02),
+        "branching fractions are read, by decay products");
+  check(key.dimensionless.count("NMIX 1 1") and key.dimensionless.count("STAUMIX 2 2") and key.dimensionless.count("ALPHA"),
+        "mixing matrices and the Higgs mixing angle are read, by indices");
+  check(key.dimensionful.count("AU 3 3") and key.dimensionless.count("YU 3 3"), "trilinear and Yukawa couplings are read");
+  check(not key.dimensionful.count("SMINPUTS 1") and not key.dimensionless.count("SMINPUTS 1") and not key.dimensionful.count("MSOFT 1")
+        and not key.dimensionless.count("MINPAR 3"), "other blocks are not read");
+  SLHAea::Coll reordered_decay(slha);
+  SLHAea::Block& gluino_decays = reordered_decay.at("1000021");
+  for (SLHAea::Line& line : gluino_decays)
+  {
+    if (line.is_data_line() and line[2] == "-2000006") { line[2] = "6"; line[3] = "-2000006"; }
+  }
+  check(make_key(reordered_decay).distance(key) == 0, "the order of decay products does not matter");
+
+  std::cout << "Key distances:" << std::endl;
+  check(key.distance(key) == 0, "a key has no distance to itself");
+  check(make_key(slha, "Pythia_SUSY_LHC_8TeV").distance(key) == inf, "keys for different colliders are infinitely far apart");
+  SignalYieldCache::Key other_settings = key;
+  other_settings.settings.push_back("PartonLevel:MPI = off");
+  check(other_settings.distance(key) == inf, "keys with different settings are infinitely far apart");
+  SignalYieldCache::Key other_analyses = key;
+  other_analyses.analyses["ATLASAnalysisContainer"] = {"Test"};
+  check(other_analyses.distance(key) == inf, "keys with different analyses are infinitely far apart");
+  SLHAea::Coll heavier(slha);
+  heavier["MASS"]["1000021"][1] = std::to_string(1.005*std::stod(slha.at("MASS").at("1000021").at(1)));
+  check(std::abs(make_key(heavier).distance(key) - 0.005/1.005) < 1e-6, "masses are compared relative to their size");
+  SLHAea::Coll mixed(slha);
+  const SLHAea::Block::key_type n11 = {"1", "1"};
+  mixed["NMIX"][n11][2] = std::to_string(std::stod(slha.at("NMIX").at(n11).at(2)) + 0.002);
+  check(std::abs(make_key(mixed).distance(key) - 0.002) < 1e-6, "mixing matrix entries are compared absolutely");
+  SLHAea::Coll no_gluino(slha);
+  no_gluino["MASS"].erase(no_gluino["MASS"].find(SLHAea::Block::key_type(1, "1000021")));
+  check(make_key(no_gluino).distance(key) == inf, "keys with different spectrum entries are infinitely far apart");
+  SLHAea::Coll other_blocks(slha);
+  other_blocks["MINPAR"]["3"][1] = "20.";
+  check(make_key(other_blocks).distance(key) == 0, "other blocks do not enter the distance");
+
+  std::cout << "Hits and misses:" << std::endl;
+  SignalYieldCache exact;
+  exact.configure(2);
+  check(exact.find(key) == NULL and exact.n_misses() == 1, "an empty cache misses");
+  store(exact, key, 10.);
+  check(exact.size() == 1 and exact.find(key) != NULL and exact.n_hits() == 1, "a stored entry is found with the same key");
+  const SignalYieldCache::Entry* entry = exact.find(key);
+  check(entry != NULL and entry->n_events == 1000, "the entry keeps its number of events");
+  check(entry != NULL and entry->process_xsecs.size() == 2 and close(entry->process_xsecs.at(1201), 3.5) and close(entry->process_xsecs.at(1202), 1.),
+        "process cross-sections of Pythia instances are combined weighting by tried events");
+  check(exact.find(make_key(heavier)) == NULL, "without a tolerance, a different spectrum misses");
+  check(exact.find(make_key(slha, "Pythia_SUSY_LHC_8TeV")) == NULL, "a different collider misses");
+  store(exact, make_key(slha, "Pythia_SUSY_LHC_8TeV"), 20.);
+  store(exact, make_key(mixed), 30.);
+  check(exact.size() == 2 and exact.find(key) == NULL, "the least recently used entry is evicted from a full cache");
+  check(exact.find(make_key(mixed)) != NULL and exact.find(make_key(slha, "Pythia_SUSY_LHC_8TeV")) != NULL, "the other entries are kept");
+  const unsigned long long hits = exact.n_hits(), misses = exact.n_misses();
+  exact.reject();
+  check(exact.n_hits() == hits - 1 and exact.n_misses() == misses + 1, "a rejected hit counts as a miss");
+
+  std::cout << "Hits within a tolerance:" << std::endl;
+  SignalYieldCache tolerant;
+  tolerant.configure(4, 0.01);
+  store(tolerant, key, 10.);
+  check(tolerant.find(make_key(heavier)) != NULL, "a spectrum within the tolerance hits");
+  check(tolerant.find(make_key(mixed)) != NULL, "a mixing matrix within the tolerance hits");
+  SLHAea::Coll much_heavier(slha);
+  much_heavier["MASS"]["1000021"][1] = std::to_string(1.05*std::stod(slha.at("MASS").at("1000021").at(1)));
+  check(tolerant.find(make_key(much_heavier)) == NULL, "a spectrum beyond the tolerance misses");
+  store(tolerant, make_key(heavier), 20.);
+  check(tolerant.find(make_key(heavier)) != NULL and tolerant.find(make_key(heavier))->key.distance(make_key(heavier)) == 0,
+        "an exact entry is found before a close one");
+  const SignalYieldCache::Entry* closest = tolerant.find(make_key(slha));
+  check(closest != NULL and closest->key.distance(key) == 0, "the closest entry is found, not the most recent one");
+
+  std::cout << "Rescaling:" << std::endl;
+  check(close(tolerant.xsec_scale(*closest, {{1201, 3.5}, {1202, 1.}}), 1.), "the same process cross-sections give no rescaling");
+  check(close(tolerant.xsec_scale(*closest, {{1201, 7.}, {1202, 2.}}), 2.), "the scale is the ratio of new to stored cross-sections");
+  check(close(tolerant.xsec_scale(*closest, {{1201, 3.5}}), 3.5/4.5), "processes that vanish at the new point lower the scale");
+  check(close(tolerant.xsec_scale(*closest, {{1201, 3.5}, {1202, 1.}, {1203, 0.04}}), 1.),
+        "new processes within the tolerance are ignored");
+  check(tolerant.xsec_scale(*closest, {{1201, 3.5}, {1202, 1.}, {1203, 1.}}) < 0, "new processes beyond the tolerance prevent reuse");
+  check(tolerant.xsec_scale(*closest, {}) < 0, "no cross-sections at the new point prevent reuse");
+  check(tolerant.xsec_scale(SignalYieldCache::Entry(), {{1201, 3.5}}) < 0, "no stored cross-sections prevent reuse");
+
+  TestAnalysis analysis;
+  const SignalYieldCache::AnalysisYields& yields = closest->yields.at("CMSAnalysisContainer").at("Test");
+  check(SignalYieldCache::restore(yields, analysis), "yields are restored into an analysis");
+  analysis.scale();
+  const double n_at_lumi = analysis.get_results()[1].n_signal_at_lumi;
+  check(close(analysis.get_results()[0].n_signal, 10.) and close(n_at_lumi, 20.*10.*4.5/1000.), "restored yields are scaled to the luminosity");
+  analysis.reset();
+  check(SignalYieldCache::restore(yields, analysis, 2.), "yields are restored into an analysis with a cross-section scale");
+  analysis.scale();
+  check(close(analysis.xsec(), 9.) and close(analysis.xsec_err(), 1.), "the cross-section and its error are rescaled");
+  check(close(analysis.get_results()[1].n_signal_at_lumi, 2.*n_at_lumi), "the yields at the luminosity are rescaled");
+  analysis.reset();
+  SignalYieldCache::AnalysisYields wrong = yields;
+  wrong.n_signal.push_back(1.);
+  check(not SignalYieldCache::restore(wrong, analysis), "yields for different signal regions are not restored");
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Unit tests of the ColliderBit cross-section
+///  pre-screen (XsecPrescreen): collider energies,
+///  table interpolation, and the upper limit for a
+///  benchmark MSSM spectrum.  The comparison of the
+///  limit with Pythia's own estimate is made by
+///  pythia_init_benchmark, as it needs Pythia.
+///
+///  Usage: xsec_prescreen_test [SLHA file]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/ColliderBit/XsecPrescreen.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::ColliderBit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  bool close(double a, double b) { return std::abs(a-b) <= 1e-12*std::max(std::abs(a), std::abs(b)); }
+
+  const double inf = std::numeric_limits<double>::infinity();
+
+}
+
+int main(int argc, char* argv[])
+{
+  logger().disable();
+  const str slha_file = (argc > 1 ? argv[1] : "DarkBit/data/benchmarks/stau_coannihilation.slha1");
+
+  std::cout << "Collider energies:" << std::endl;
+  check(XsecPrescreen::collider_ecm("LHC", {"Beams:eCM = 8000"}) == 8000., "Beams:eCM is read from the settings");
+  check(XsecPrescreen::collider_ecm("LHC", {" beams:ECM=7000. "}) == 7000., "settings are case- and whitespace-insensitive");
+  check(XsecPrescreen::collider_ecm("LHC", {"Beams:eCM = 8000", "Beams:eCM = 13000"}) == 13000., "the last setting wins");
+  check(XsecPrescreen::collider_ecm("Pythia_SUSY_LHC_13TeV", {"Beams:eCM = 8000"}) == 8000., "settings win over the collider name");
+  check(XsecPrescreen::collider_ecm("Pythia_SUSY_LHC_8TeV", {"SUSY:all = on"}) == 8000., "the energy is read from names ending in _8TeV");
+  check(XsecPrescreen::collider_ecm("Pythia_SUSY_LHC_13TeV", {}) == 13000., "the energy is read from names ending in _13TeV");
+  check(XsecPrescreen::collider_ecm("Pythia_SUSY_LHC", {}) < 0, "the energy is unknown for other names");
+  check(XsecPrescreen::collider_ecm("Pythia_SUSY_LHC_xTeV", {}) < 0, "the energy is unknown if the name has no number");
+  check(XsecPrescreen::collider_ecm("TeV", {}) < 0, "the energy is unknown for a bare unit");
+
+  std::cout << "Table interpolation:" << std::endl;
+  const XsecPrescreen::xsec_table table = {{100, 100.}, {200, 10.}, {300, 0.1}};
+  check(XsecPrescreen::interpolate(table, 50.) == inf, "masses below the table are not bounded");
+  check(close(XsecPrescreen::interpolate(table, 100.), 100.) and close(XsecPrescreen::interpolate(table, 200.), 10.)
+        and close(XsecPrescreen::interpolate(table, 300.), 0.1), "the table points are reproduced");
+  check(close(XsecPrescreen::interpolate(table, 150.), std::sqrt(1000.)), "interpolation is linear in log(sigma)");
+  check(close(XsecPrescreen::interpolate(table, 250.), 1.), "interpolation uses the enclosing pair of points");
+  check(close(XsecPrescreen::interpolate(table, 400.), 1e-3), "beyond the table, the last slope is extrapolated");
+
+  std::cout << "Benchmark spectrum (" << slha_file << "):" << std::endl;
+  std::ifstream input(slha_file);
+  if (not input)
+  {
+    std::cout << "  FAILED: could not read " << slha_file << std::endl;
+    return 1;
+  }
+  const SLHAea::Coll slha(input);
+  XsecPrescreen prescreen;
+  prescreen.configure(1.);
+  const double limit_13 = prescreen.xsec_upper_limit_fb(slha, 13000.);
+  check(limit_13 > 0 and limit_13 < inf, "the 13 TeV upper limit is finite and positive");
+  check(prescreen.xsec_upper_limit_fb(slha, 8000.) == limit_13, "the 13 TeV tables are used at lower energies");
+  check(prescreen.xsec_upper_limit_fb(slha, 14000.) == inf, "there is no limit above 13 TeV");
+  check(prescreen.xsec_upper_limit_fb(slha, -1.) == inf, "there is no limit at an unknown energy");
+  prescreen.configure(3.);
+  check(close(prescreen.xsec_upper_limit_fb(slha, 13000.), 3.*limit_13), "the limit scales with the margin");
+  SLHAea::Coll no_gluino(slha);
+  no_gluino["MASS"].erase(no_gluino["MASS"].find(SLHAea::Block::key_type(1, "1000021")));
+  check(prescreen.xsec_upper_limit_fb(no_gluino, 13000.) == inf, "there is no limit if a sparticle mass is missing");
+  SLHAea::Coll light_gluino(slha);
+  light_gluino["MASS"]["1000021"][1] = "150";
+  check(prescreen.xsec_upper_limit_fb(light_gluino, 13000.) == inf, "there is no limit for sparticles lighter than the tables");
+
+  std::cout << "Vetoes:" << std::endl;
+  check(not prescreen.vetoes(3.*limit_13, 3.*limit_13), "a limit equal to the veto does not veto");
+  check(prescreen.vetoes(3.*limit_13, 3.1*limit_13), "a limit below the veto vetoes");
+  check(not prescreen.vetoes(inf, 1e30), "an infinite limit never vetoes");
+  check(prescreen.n_colliders_screened() == 3 and prescreen.n_colliders_vetoed() == 1, "screened and vetoed colliders are counted");
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -28,10 +28,14 @@
 #include <vector>
 #include <map>
 #include <queue>
+#include <memory>
+#include <mutex>
 
 #include "gambit/Core/core.hpp"
 #include "gambit/Core/error_handlers.hpp"
 #include "gambit/Core/yaml_parser.hpp"
+#include "gambit/Core/task_graph.hpp"
+#include "gambit/Core/obslike_order.hpp"
 #include "gambit/Printers/baseprinter.hpp"
 #include "gambit/Elements/functors.hpp"
 #include "gambit/Elements/type_equivalency.hpp"
@@ -47,14 +51,6 @@ namespace Gambit
 
     using namespace boost;
 
-    /// Typedefs for central boost graph
-    /// @{
-    typedef adjacency_list<vecS, vecS, bidirectionalS, functor*, vecS> MasterGraphType;
-    typedef graph_traits<MasterGraphType>::vertex_descriptor VertexID;
-    typedef graph_traits<MasterGraphType>::edge_descriptor EdgeID;
-    typedef property_map<MasterGraphType,vertex_index_t>::type IndexMap;
-    /// @}
-
     /// Typedefs for communication channels with the master-likelihood
     /// @{
     typedef std::map<std::string, double *> inputMapType;
@@ -99,6 +95,17 @@ namespace Gambit
       bool printme;
     };
 
+    /// A single functor evaluation in the pre-computed execution plan of a target vertex
+    struct ExecutionStep
+    {
+      /// The functor to evaluate
+      functor* f;
+      /// Send the result to the printer? (false for functors returning void)
+      bool print;
+      /// Pre-built debug log message announcing the call (empty if debug messages are not logged)
+      str call_message;
+    };
+
     /// Check whether s1 (wildcard + regex allowed) matches s2
     bool stringComp(const str &s1, const str &s2, bool with_regex = true);
 
@@ -127,9 +134,24 @@ namespace Gambit
         /// Retrieve the order in which target vertices are to be evaluated.
         std::vector<VertexID> getObsLikeOrder();
 
+        /// Estimate the expected time needed to evaluate a list of target vertices in the given order.
+        double getExpectedRuntime(const std::vector<VertexID>&);
+
         /// Calculate a single target vertex.
         void calcObsLike(VertexID, const int);
 
+        /// Is concurrent evaluation of independent dependency-graph branches enabled?
+        bool parallelBranchesEnabled();
+
+        /// Build the task graph for concurrently evaluating a list of target vertices.
+        void prepareParallelBranches(const std::vector<VertexID>&);
+
+        /// Evaluate everything required by the prepared target vertices, running independent
+        /// branches concurrently.  Nothing is printed, and invalidations are left stored in the
+        /// functors; a subsequent calcObsLike call for each target prints the results and
+        /// rethrows any invalidation in the usual target order.
+        void precalcObsLikes();
+
         /// Getter for print_timing flag (used by LikelihoodContainer)
         bool printTiming();
 
@@ -248,8 +270,23 @@ namespace Gambit
         /// Saved calling order for functions
         std::list<VertexID> function_order;
 
-        /// Saved calling order for functions required to compute single ObsLike entries
-        std::map<VertexID, std::vector<VertexID>> SortedParentVertices;
+        /// Saved execution plans (functors in calling order) required to compute single ObsLike entries
+        std::map<VertexID, std::vector<ExecutionStep>> ExecutionPlans;
+
+        /// Log runtime averages after each functor evaluation?
+        bool log_runtime = false;
+
+        /// Number of worker threads for concurrent evaluation of independent branches (0 = sequential)
+        int parallel_branches = 0;
+
+        /// Backends (named as <backend>_<safe version>) used by each vertex
+        std::map<VertexID, std::set<str>> backendsUsed;
+
+        /// Mutexes serialising calls to the backends that are not declared thread-safe
+        std::map<str, std::mutex> backendMutexes;
+
+        /// Executor for concurrent evaluation of independent branches
+        std::unique_ptr<TaskGraphExecutor> executor;
 
         /// Temporary map for loop manager -> list of nested functions
         std::map<VertexID, std::set<VertexID>> loopManagerMap;
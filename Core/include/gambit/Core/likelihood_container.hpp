@@ -72,8 +72,14 @@ namespace Gambit
       /// Active value for the minimum log likelihood (one of the above two values, whichever is currently in-use)
       double active_min_valid_lnlike;
 
-      /// Map of return types of target functors
-      std::map<DRes::VertexID,str> return_types;
+      /// Kinds of result that target functors can return
+      enum return_kind { DOUBLE, VECTOR_DOUBLE, FLOAT, VECTOR_FLOAT };
+
+      /// Map of return kinds of target functors
+      std::map<DRes::VertexID,return_kind> return_types;
+
+      /// Map of pre-built log tags ("ikelihood contribution from module::function") of target functors
+      std::map<DRes::VertexID,str> likelihood_tags;
 
       /// Global record of time that last likelihood evaluation began, for computing true total iteration time.
       std::chrono::time_point<std::chrono::system_clock> previous_startL;
@@ -93,6 +99,15 @@ namespace Gambit
       /// Run in likelihood debug mode?
       bool debug;
 
+      /// When to re-derive the target vertex order from measured statistics (options reorder_interval and reorder_drift_threshold)
+      DRes::ReorderSchedule reorder_schedule;
+
+      /// Re-derive the order of the target vertices from their measured runtimes and invalidation rates
+      void reorderTargetVertices();
+
+      /// Functors of the target vertices, in their current order
+      std::vector<functor*> targetFunctors();
+
     public:
 
       /// Constructor
@@ -0,0 +1,110 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  The resolved dependency graph, the order in
+///  which its target (ObsLike) vertices are
+///  evaluated, and the schedule on which that
+///  order is re-derived during a scan.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __obslike_order_hpp__
+#define __obslike_order_hpp__
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "gambit/Elements/functors.hpp"
+
+#include <boost/graph/adjacency_list.hpp>
+
+namespace Gambit
+{
+
+  namespace DRes
+  {
+
+    using namespace boost;
+
+    /// Typedefs for central boost graph
+    /// @{
+    typedef adjacency_list<vecS, vecS, bidirectionalS, functor*, vecS> MasterGraphType;
+    typedef graph_traits<MasterGraphType>::vertex_descriptor VertexID;
+    typedef graph_traits<MasterGraphType>::edge_descriptor EdgeID;
+    typedef property_map<MasterGraphType,vertex_index_t>::type IndexMap;
+    /// @}
+
+    /// Collect parent vertices recursively (excluding root vertex)
+    void getParentVertices(const VertexID&, const MasterGraphType&, std::set<VertexID>&);
+
+    /// Sum of the runtime averages of a set of vertices
+    double getTimeEstimate(const std::set<VertexID>&, const MasterGraphType&);
+
+    /// Order in which to evaluate target vertices: at each step, the one with the smallest ratio of the runtime of
+    /// its not yet evaluated subgraph to its invalidation rate, so that cheap, often-invalidating ones come first.
+    std::vector<VertexID> getObsLikeOrder(const std::vector<VertexID>&, const MasterGraphType&);
+
+    /// Expected time to evaluate target vertices in the given order, allowing for early termination when one of
+    /// them invalidates the point.
+    double getExpectedRuntime(const std::vector<VertexID>&, const MasterGraphType&);
+
+    /// Decides when the order of the target vertices is re-derived from their measured statistics: every
+    /// interval points, and/or whenever the runtime average or invalidation rate of any of them has changed
+    /// by more than the fraction drift_threshold since the order was last derived (0 = never, for both).
+    class ReorderSchedule
+    {
+
+      public:
+
+        /// Constructor
+        ReorderSchedule(long long interval, double drift_threshold);
+
+        /// Is re-derivation of the order switched on at all?
+        bool enabled() const;
+
+        /// Should the order be re-derived before evaluating the next point?
+        bool due(const std::vector<functor*>&) const;
+
+        /// Have the statistics of any of the given functors drifted past the threshold?
+        bool haveDrifted(const std::vector<functor*>&) const;
+
+        /// Record the statistics on which the current order is based, and restart the point count
+        void restart(const std::vector<functor*>&);
+
+        /// Count a point evaluated with the current order
+        void countPoint();
+
+        /// Number of points evaluated since the order was last derived
+        long long pointsSinceRestart() const;
+
+      private:
+
+        /// Number of points after which the order is re-derived (0 = never)
+        const long long interval;
+
+        /// Fractional change in any runtime average or invalidation rate that triggers re-derivation (0 = never)
+        const double drift_threshold;
+
+        /// Number of points evaluated since the order was last derived
+        long long points;
+
+        /// Runtime averages and invalidation rates of the functors when the order was last derived
+        std::map<const functor*, std::pair<double,double> > reference;
+
+    };
+
+  }
+
+}
+
+#endif // defined __obslike_order_hpp__
@@ -0,0 +1,137 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Task-graph executor for evaluating
+///  independent branches of the dependency
+///  graph concurrently within a single
+///  parameter point.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __task_graph_hpp__
+#define __task_graph_hpp__
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "gambit/Elements/functors.hpp"
+
+namespace Gambit
+{
+
+  namespace DRes
+  {
+
+    /// Evaluates a fixed DAG of functors, running tasks whose parents have all
+    /// completed on a pool of worker threads as well as on the calling thread.
+    ///
+    /// Each worker runs as the master of its own one-thread OpenMP team (with its
+    /// own thread slot; see Utils::thread_slot), so functors behave on a worker as
+    /// they would on the main thread with OMP_NUM_THREADS=1.  Tasks flagged as
+    /// main-thread-only (loop managers and their nested functors) are only ever
+    /// run by the calling thread, so that they keep the full OpenMP team.
+    class TaskGraphExecutor
+    {
+
+      public:
+
+        /// Constructor; starts n_workers worker threads (in addition to the calling thread)
+        TaskGraphExecutor(int n_workers);
+
+        /// Destructor; stops and joins the worker threads
+        ~TaskGraphExecutor();
+
+        /// Add a functor evaluation to the graph and return its task index.
+        /// The mutexes in locks are held for the duration of the evaluation; they
+        /// must be supplied in a consistent global order to avoid deadlock.
+        std::size_t addTask(functor*, bool main_thread_only, const std::vector<std::mutex*>& locks);
+
+        /// Require the task with index parent to complete before the task with index child starts.
+        void addEdge(std::size_t parent, std::size_t child);
+
+        /// Evaluate all tasks.  Once any functor invalidates the point, no further
+        /// tasks are started; the invalidation itself remains stored in the functor.
+        /// Any other exception is rethrown in the calling thread once all running
+        /// tasks have finished.
+        void run();
+
+        /// Number of worker threads
+        int nWorkers() const;
+
+      private:
+
+        /// A single functor evaluation
+        struct Task
+        {
+          functor* f;
+          bool main_thread_only;
+          std::vector<std::mutex*> locks;
+          std::vector<std::size_t> children;
+          std::size_t n_parents;
+          std::size_t remaining_parents;
+        };
+
+        /// Take evaluation tasks until the current run is finished (lock must be held)
+        void participate(std::unique_lock<std::mutex>&, bool main_thread);
+
+        /// Pop a ready task that the calling thread may run (lock must be held)
+        bool takeTask(bool main_thread, std::size_t& index);
+
+        /// Evaluate a single task; returns false if the point was invalidated or an error occurred
+        bool execute(std::size_t index, std::exception_ptr& error);
+
+        /// Main loop of the worker threads
+        void workerLoop(int slot_offset);
+
+        /// Is the current run finished? (lock must be held)
+        bool finished() const { return n_left == 0 or (aborted and n_running == 0); }
+
+        /// The tasks
+        std::vector<Task> tasks;
+
+        /// The worker threads
+        std::vector<std::thread> workers;
+
+        /// Synchronisation of the scheduling state below
+        std::mutex mtx;
+        std::condition_variable cv;
+
+        /// Tasks whose parents have all completed
+        std::deque<std::size_t> ready;
+
+        /// Number of tasks being evaluated, and number not yet completed
+        std::size_t n_running;
+        std::size_t n_left;
+
+        /// Has the current run been aborted?
+        bool aborted;
+
+        /// Are the workers to shut down?
+        bool shutting_down;
+
+        /// Counter of runs, used to wake up the workers
+        unsigned long long generation;
+
+        /// First non-invalidation exception raised in the current run
+        std::exception_ptr error;
+
+    };
+
+  }
+
+}
+
+#endif /* defined(__task_graph_hpp__) */
@@ -76,23 +76,6 @@ namespace Gambit
     // Functions that act on a resolved dependency graph
     //
 
-    // Collect parent vertices recursively (excluding root vertex)
-    void getParentVertices(const VertexID & vertex, const
-        DRes::MasterGraphType & graph, std::set<VertexID> & myVertexList)
-    {
-      graph_traits<DRes::MasterGraphType>::in_edge_iterator it, iend;
-
-      for (boost::tie(it, iend) = in_edges(vertex, graph);
-          it != iend; ++it)
-      {
-        if ( std::find(myVertexList.begin(), myVertexList.end(), source(*it, graph)) == myVertexList.end() )
-        {
-          myVertexList.insert(source(*it, graph));
-          getParentVertices(source(*it, graph), graph, myVertexList);
-        }
-      }
-    }
-
     // Sort given list of vertices (according to topological sort result)
     std::vector<VertexID> sortVertices(const std::set<VertexID> & set,
         const std::list<VertexID> & topoOrder)
@@ -236,17 +219,6 @@ namespace Gambit
     /// Global flag for regex use
     bool use_regex;
 
-    // Return runtime estimate for a set of nodes
-    double getTimeEstimate(const std::set<VertexID> & vertexList, const DRes::MasterGraphType &graph)
-    {
-      double result = 0;
-      for (std::set<VertexID>::iterator it = vertexList.begin(); it != vertexList.end(); ++it)
-      {
-        result += graph[*it]->getRuntimeAverage();
-      }
-      return result;
-    }
-
     // Check whether s1 (wildcard + regex allowed) matches s2
     bool stringComp(const str & s1, const str & s2, bool with_regex)
     {
@@ -398,11 +370,70 @@ namespace Gambit
       }
 #endif
 
-      // Pre-compute the individually ordered vertex lists for each of the ObsLike entries.
+      // Pre-compute the execution plans (individually ordered functor lists) for each of the ObsLike entries,
+      // so that no yaml lookups, type comparisons or string building are needed when evaluating them.
+      log_runtime = boundIniFile->getValueOrDef<bool>(false, "dependency_resolution", "log_runtime");
+      parallel_branches = boundIniFile->getValueOrDef<int>(0, "dependency_resolution", "parallel_branches");
+      const bool log_calls = logger().get_log_debug_messages();
       std::vector<VertexID> order = getObsLikeOrder();
       for(auto it = order.begin(); it != order.end(); ++it)
       {
-        SortedParentVertices[*it] = getSortedParentVertices(*it, masterGraph, function_order);
+        std::vector<VertexID> sorted = getSortedParentVertices(*it, masterGraph, function_order);
+        std::vector<ExecutionStep>& plan = ExecutionPlans[*it];
+        plan.reserve(sorted.size());
+        for (auto jt = sorted.begin(); jt != sorted.end(); ++jt)
+        {
+          functor* f = masterGraph[*jt];
+          ExecutionStep step;
+          step.f = f;
+          step.print = not typeComp(f->type(), "void", *boundTEs, false);
+          if (log_calls) step.call_message = "Calling " + f->name() + " from " + f->origin() + "...";
+          plan.push_back(step);
+        }
+      }
+
+      // Set up caching of results across parameter points for functors that request it with the option point_cache_size.
+      // The cache is keyed on the values of all primary model parameters that the functor depends on.
+      std::set<VertexID> cache_candidates;
+      for (auto it = order.begin(); it != order.end(); ++it)
+      {
+        getParentVertices(*it, masterGraph, cache_candidates);
+        cache_candidates.insert(*it);
+      }
+      for (auto it = cache_candidates.begin(); it != cache_candidates.end(); ++it)
+      {
+        int capacity = masterGraph[*it]->getOptions()->getValueOrDef<int>(0, "point_cache_size");
+        if (capacity <= 0) continue;
+        module_functor_common* f = dynamic_cast<module_functor_common*>(masterGraph[*it]);
+        // Skipping a function on a cache hit also skips its side effects, so only pure module functions may be cached.
+        // Functions with backend requirements are assumed to change the state of their backends, unless the user
+        // declares otherwise with the option backend_side_effects: false.
+        str reason;
+        if (f == NULL or dynamic_cast<primary_model_functor*>(f) != NULL) reason = "it is not a module function";
+        else if (f->origin() == "BackendIniBit") reason = "it is a backend initialisation function";
+        else if (f->name().find("PointInit") != str::npos or f->capability().find("PointInit") != str::npos)
+         reason = "it initialises backends for the current point";
+        else if (not f->backendreqs().empty() and masterGraph[*it]->getOptions()->getValueOrDef<bool>(true, "backend_side_effects"))
+         reason = "it has backend requirements, which may change the state of the backends (set the option"
+                  " backend_side_effects: false if they do not)";
+        if (not reason.empty())
+        {
+          core_error().raise(LOCAL_INFO, "The option point_cache_size cannot be used with " + masterGraph[*it]->origin()
+                                         + "::" + masterGraph[*it]->name() + ", as " + reason + ".");
+        }
+        std::set<VertexID> ancestors;
+        getParentVertices(*it, masterGraph, ancestors);
+        std::vector<const ModelParameters*> sources;
+        for (auto jt = ancestors.begin(); jt != ancestors.end(); ++jt)
+        {
+          primary_model_functor* pf = dynamic_cast<primary_model_functor*>(masterGraph[*jt]);
+          if (pf != NULL) sources.push_back(pf->getcontentsPtr());
+        }
+        f->setPointCache(capacity, sources);
+        f->setPointCacheVertexID(Printers::get_param_id(f->pointCacheLabel()));
+        logger() << LogTags::dependency_resolver << LogTags::info << "Caching up to " << capacity << " results of "
+                 << f->origin() << "::" << f->name() << " across parameter points, keyed on the parameters of "
+                 << sources.size() << " primary model(s)." << EOM;
       }
 
       // Done
@@ -577,49 +608,19 @@ namespace Gambit
     std::vector<VertexID> DependencyResolver::getObsLikeOrder()
     {
       std::vector<VertexID> unsorted;
-      std::vector<VertexID> sorted;
-      std::set<VertexID> parents, colleages, colleages_min;
-      // Copy unsorted vertexIDs --> unsorted
       for (std::vector<OutputVertexInfo>::iterator it = outputVertexInfos.begin();
           it != outputVertexInfos.end(); it++)
       {
         unsorted.push_back(it->vertex);
       }
-      // Sort iteratively (unsorted --> sorted)
-      while (unsorted.size() > 0)
-      {
-        double t2p_now;
-        double t2p_min = -1;
-        std::vector<VertexID>::iterator it_min;
-        for (std::vector<VertexID>::iterator it = unsorted.begin(); it !=
-            unsorted.end(); ++it)
-        {
-          parents.clear();
-          getParentVertices(*it, masterGraph, parents);
-          parents.insert(*it);
-          // Remove vertices that were already calculated from the ist
-          for ( auto cit = colleages.begin(); cit != colleages.end(); cit++)
-          {
-            parents.erase(*cit);
-          }
-          t2p_now = (double) getTimeEstimate(parents, masterGraph);
-          t2p_now /= masterGraph[*it]->getInvalidationRate();
-          if (t2p_min < 0 or t2p_now < t2p_min)
-          {
-            t2p_min = t2p_now;
-            it_min = it;
-            colleages_min = parents;
-          }
-        }
-        // Extent list of calculated vertices
-        colleages.insert(colleages_min.begin(), colleages_min.end());
-        double prop = masterGraph[*it_min]->getInvalidationRate();
-        logger() << LogTags::dependency_resolver << "Estimated T [s]: " << t2p_min*prop << EOM;
-        logger() << LogTags::dependency_resolver << "Estimated p: " << prop << EOM;
-        sorted.push_back(*it_min);
-        unsorted.erase(it_min);
-      }
-      return sorted;
+      return DRes::getObsLikeOrder(unsorted, masterGraph);
+    }
+
+    // Returns the expected time to evaluate a list of ObsLike vertices in the given order,
+    // allowing for early termination when one of them invalidates the point
+    double DependencyResolver::getExpectedRuntime(const std::vector<VertexID>& order)
+    {
+      return DRes::getExpectedRuntime(order, masterGraph);
     }
 
     // Evaluates ObsLike vertex, and everything it depends on, and prints results
@@ -628,26 +629,27 @@ namespace Gambit
       // pointID is supplied by the scanner, and is used to tell the printer which model
       // point the results should be associated with.
 
-      if (SortedParentVertices.find(vertex) == SortedParentVertices.end())
+      auto plan_it = ExecutionPlans.find(vertex);
+      if (plan_it == ExecutionPlans.end())
         core_error().raise(LOCAL_INFO, "Tried to calculate a function not in or not at top of dependency graph.");
-      std::vector<VertexID> order = SortedParentVertices.at(vertex);
+      const std::vector<ExecutionStep>& plan = plan_it->second;
 
-      for (std::vector<VertexID>::iterator it = order.begin(); it != order.end(); ++it)
+      for (auto it = plan.begin(); it != plan.end(); ++it)
       {
-        std::ostringstream ss;
-        ss << "Calling " << masterGraph[*it]->name() << " from " << masterGraph[*it]->origin() << "...";
-        logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << ss.str() << EOM;
-        masterGraph[*it]->calculate();
-        if (boundIniFile->getValueOrDef<bool>(
-              false, "dependency_resolution", "log_runtime") )
+        if (not it->call_message.empty())
         {
-          double T = masterGraph[*it]->getRuntimeAverage();
+          logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << it->call_message << EOM;
+        }
+        it->f->calculate();
+        if (log_runtime)
+        {
+          double T = it->f->getRuntimeAverage();
           logger() << LogTags::dependency_resolver << LogTags::info <<
             "Runtime, averaged over multiple calls [s]: " << T << EOM;
         }
-        invalid_point_exception* e = masterGraph[*it]->retrieve_invalid_point_exception();
+        invalid_point_exception* e = it->f->retrieve_invalid_point_exception();
         if (e != NULL) throw(*e);
-        if (not typeComp(masterGraph[*it]->type(),  "void", *boundTEs, false))
+        if (it->print)
         {
           // Note that this prints from thread index 0 only, i.e. results created by
           // threads other than the main one need to be accessed with
@@ -656,13 +658,99 @@ namespace Gambit
           // At the moment GAMBIT only prints results of thread 0, under the expectation
           // that nested module functions are all designed to gather their results into
           // thread 0.
-          masterGraph[*it]->print(boundPrinter,pointID);
+          it->f->print(boundPrinter,pointID);
         }
       }
       // Reset the cout output precision, in case any backends have messed with it during the ObsLike evaluation.
       cout << std::setprecision(boundCore->get_outprec());
     }
 
+    /// Is concurrent evaluation of independent dependency-graph branches enabled?
+    bool DependencyResolver::parallelBranchesEnabled() { return parallel_branches > 0; }
+
+    // Build the task graph for concurrently evaluating a list of target vertices
+    void DependencyResolver::prepareParallelBranches(const std::vector<VertexID>& targets)
+    {
+      if (not parallelBranchesEnabled()) return;
+
+      // Backends that may be called from several threads at once; calls to all others are serialised.
+      std::vector<str> thread_safe_backends = boundIniFile->getValueOrDef<std::vector<str>>(std::vector<str>(), "dependency_resolution", "thread_safe_backends");
+      // Module functions (as <module>::<function>) declared thread-safe in the yaml file, in addition to those declared THREAD_SAFE in their rollcall headers.
+      std::vector<str> thread_safe_functions = boundIniFile->getValueOrDef<std::vector<str>>(std::vector<str>(), "dependency_resolution", "thread_safe_functions");
+
+      executor.reset(new TaskGraphExecutor(parallel_branches));
+
+      // Collect the union of all vertices required by the targets.
+      std::set<VertexID> required;
+      for (auto it = targets.begin(); it != targets.end(); ++it)
+      {
+        getParentVertices(*it, masterGraph, required);
+        required.insert(*it);
+      }
+
+      // Add one task per vertex, in calling order.
+      std::map<VertexID, std::size_t> task_index;
+      std::vector<VertexID> sorted = sortVertices(required, function_order);
+      for (auto it = sorted.begin(); it != sorted.end(); ++it)
+      {
+        functor* f = masterGraph[*it];
+
+        // Backends used by this vertex; backend initialisation functions use the backend they initialise.
+        std::set<str> backends = backendsUsed[*it];
+        if (f->origin() == "BackendIniBit")
+        {
+          const str suffix = "_init";
+          const str& name = f->name();
+          if (name.size() > suffix.size()) backends.insert(name.substr(0, name.size() - suffix.size()));
+        }
+
+        // Mutexes to hold while evaluating the vertex (the std::set keeps them in a consistent order).
+        std::vector<std::mutex*> locks;
+        for (auto jt = backends.begin(); jt != backends.end(); ++jt)
+        {
+          bool thread_safe = false;
+          for (auto kt = thread_safe_backends.begin(); kt != thread_safe_backends.end(); ++kt)
+          {
+            if (*jt == *kt or jt->compare(0, kt->size() + 1, *kt + "_") == 0) thread_safe = true;
+          }
+          if (not thread_safe) locks.push_back(&backendMutexes[*jt]);
+        }
+
+        // Module functions may share unprotected module-global state, so only those declared thread-safe run on
+        // the workers.  Loop managers and their nested functors rely on the full OpenMP team, so always keep
+        // them on the main thread.
+        bool function_thread_safe = f->isThreadSafe() or std::find(thread_safe_functions.begin(), thread_safe_functions.end(),
+                                                                   f->origin() + "::" + f->name()) != thread_safe_functions.end();
+        bool main_thread_only = not function_thread_safe or f->canBeLoopManager() or f->loopManagerCapability() != "none";
+
+        task_index[*it] = executor->addTask(f, main_thread_only, locks);
+      }
+
+      // Add the dependencies between them.
+      for (auto it = sorted.begin(); it != sorted.end(); ++it)
+      {
+        graph_traits<DRes::MasterGraphType>::in_edge_iterator jt, jend;
+        for (boost::tie(jt, jend) = in_edges(*it, masterGraph); jt != jend; ++jt)
+        {
+          executor->addEdge(task_index.at(source(*jt, masterGraph)), task_index.at(*it));
+        }
+      }
+
+      logger() << LogTags::dependency_resolver << LogTags::info << "Evaluating " << sorted.size()
+               << " functors for " << targets.size() << " target vertices concurrently, with "
+               << executor->nWorkers() << " worker threads in addition to the main thread." << EOM;
+    }
+
+    // Evaluate everything required by the prepared target vertices, running independent branches concurrently
+    void DependencyResolver::precalcObsLikes()
+    {
+      if (executor == nullptr)
+        core_error().raise(LOCAL_INFO, "Tried to evaluate dependency-graph branches concurrently without preparing the task graph first.");
+      executor->run();
+      // Reset the cout output precision, in case any backends have messed with it during the evaluation.
+      cout << std::setprecision(boundCore->get_outprec());
+    }
+
     /// Getter for print_timing flag (used by LikelihoodContainer)
     bool DependencyResolver::printTiming() { return print_timing; }
 
@@ -2088,6 +2176,7 @@ namespace Gambit
     void DependencyResolver::resolveRequirement(functor* func, VertexID vertex)
     {
       (*masterGraph[vertex]).resolveBackendReq(func);
+      backendsUsed[vertex].insert(func->origin() + "_" + func->safe_version());
       logger() << LogTags::dependency_resolver;
       logger() << "Resolved by: [" << func->name() << ", ";
       logger() << func->origin() << " (" << func->version() << ")]";
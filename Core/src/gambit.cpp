@@ -17,6 +17,7 @@
 
 #include "gambit/Core/gambit.hpp"
 #include "gambit/Utils/mpiwrapper.hpp"
+#include "gambit/Elements/backend_call_cache.hpp"
 
 
 using namespace Gambit;
@@ -130,7 +131,7 @@ int main(int argc, char* argv[])
       #endif
 
       // Initialise the random number generator, letting the RNG class choose its own default.
-      Random::create_rng_engine(iniFile.getValueOrDef<str>("default", "rng"));
+      Random::create_rng_engine(iniFile.getValueOrDef<str>("default", "rng"), iniFile.getValueOrDef<long long>(-1, "rng_seed"), rank);
 
       // Determine selected model(s)
       std::set<str> selectedmodels = iniFile.getModelNames();
@@ -141,6 +142,27 @@ int main(int argc, char* argv[])
       // Deactivate module functions reliant on classes from missing backends
       Core().accountForMissingClasses();
 
+      // Load extra copies of any backends that are to be called from several threads at once, e.g.
+      //   backend_instances:
+      //     DarkSUSY: {5.1.3: 4}
+      if (iniFile.hasKey("backend_instances"))
+      {
+        for (const auto& be : iniFile.getValue<YAML::Node>("backend_instances"))
+        {
+          for (const auto& ver : be.second)
+          {
+            Backends::backendInfo().loadInstances(be.first.as<str>(), ver.first.as<str>(), ver.second.as<int>());
+          }
+        }
+      }
+
+      // Optionally keep the results of memoised backend functions on disk for reuse in later runs, e.g.
+      //   backend_call_cache:
+      //     persistent: true
+      //     max_file_size_MB: 100
+      BackendCallCache::set_persistence(iniFile.getValueOrDef<bool>(false, "backend_call_cache", "persistent"),
+                                        std::size_t(1e6*iniFile.getValueOrDef<double>(100., "backend_call_cache", "max_file_size_MB")));
+
       // Set up the printer manager for redirection of scan output.
       Printers::PrinterManager printerManager(iniFile.getPrinterNode(),Core().resume);
 
@@ -191,6 +213,13 @@ int main(int argc, char* argv[])
         if (rank == 0) std::cerr << "Starting scan." << std::endl;
         scan.Run(); // Note: the likelihood container will unblock signals when it is safe to receive them.
         logger().enable(); // Turn logs back on (in case they were disabled for speed)
+        // Report the hit rates of any memoised backend functions.
+        str cache_report = BackendCallCache::report();
+        if (not cache_report.empty())
+        {
+          logger() << core << info << cache_report << EOM;
+          if (rank == 0) cout << cache_report << endl;
+        }
         // Check why we have exited the scanner; scan may have been terminated early by a signal.
         // We assume here that because the scanner has exited that it has already down whatever
         // cleanup it requires, including finalising the printers, i.e. the 'do_cleanup()' function will NOT run.
@@ -28,6 +28,7 @@
 #include "gambit/Utils/mpiwrapper.hpp"
 #include "gambit/Utils/signal_helpers.hpp"
 #include "gambit/Utils/signal_handling.hpp"
+#include "gambit/Utils/threadsafe_rng.hpp"
 
 //#define CORE_DEBUG
 
@@ -63,10 +64,12 @@ namespace Gambit
     interloopID(Printers::get_main_param_id(interlooptime_label)),
     totalloopID(Printers::get_main_param_id(totallooptime_label)),
     #ifdef CORE_DEBUG
-      debug            (true)
+      debug            (true),
     #else
-      debug            (iniFile.getValueOrDef<bool>(false, "debug") or iniFile.getValueOrDef<bool>(false, "likelihood", "debug"))
+      debug            (iniFile.getValueOrDef<bool>(false, "debug") or iniFile.getValueOrDef<bool>(false, "likelihood", "debug")),
     #endif
+    reorder_schedule        (iniFile.getValueOrDef<long long>(0, "likelihood", "reorder_interval"),
+                             iniFile.getValueOrDef<double>(0., "likelihood", "reorder_drift_threshold"))
   {
     // Set the list of valid return types of functions that can be used for 'purpose' by this container class.
     const std::vector<str> allowed_types_for_purpose = initVector<str>("double", "std::vector<double>", "float", "std::vector<float>");
@@ -76,7 +79,13 @@ namespace Gambit
     {
       if (dependencyResolver.getIniEntry(*it)->purpose == purpose)
       {
-        return_types[*it] = dependencyResolver.checkTypeMatch(*it, purpose, allowed_types_for_purpose);
+        const str rtype = dependencyResolver.checkTypeMatch(*it, purpose, allowed_types_for_purpose);
+        if      (rtype == "double")              return_types[*it] = DOUBLE;
+        else if (rtype == "std::vector<double>") return_types[*it] = VECTOR_DOUBLE;
+        else if (rtype == "float")               return_types[*it] = FLOAT;
+        else                                     return_types[*it] = VECTOR_FLOAT;
+        likelihood_tags[*it] = "ikelihood contribution from " + dependencyResolver.get_functor(*it)->origin()
+                               + "::" + dependencyResolver.get_functor(*it)->name();
         target_vertices.push_back(std::move(*it));
       }
       else
@@ -84,6 +93,57 @@ namespace Gambit
         aux_vertices.push_back(std::move(*it));
       }
     }
+
+    // Remember the statistics on which the initial order was based
+    reorder_schedule.restart(targetFunctors());
+
+    // Set up concurrent evaluation of independent branches of the dependency graph, if requested
+    dependencyResolver.prepareParallelBranches(target_vertices);
+  }
+
+  /// Re-derive the order of the target vertices from their measured runtimes and invalidation rates
+  void Likelihood_Container::reorderTargetVertices()
+  {
+    // The dependency resolver ranks all ObsLike vertices; keep only the ones contributing to the likelihood.
+    std::vector<DRes::VertexID> new_order;
+    auto all_vertices = dependencyResolver.getObsLikeOrder();
+    for (auto it = all_vertices.begin(); it != all_vertices.end(); ++it)
+    {
+      if (return_types.find(*it) != return_types.end()) new_order.push_back(*it);
+    }
+
+    if (new_order != target_vertices)
+    {
+      const double T_old = dependencyResolver.getExpectedRuntime(target_vertices);
+      const double T_new = dependencyResolver.getExpectedRuntime(new_order);
+      std::ostringstream ss;
+      ss << "Reordered likelihood evaluation after " << reorder_schedule.pointsSinceRestart() << " points. New order:" << endl;
+      for (auto it = new_order.begin(); it != new_order.end(); ++it)
+      {
+        functor* f = dependencyResolver.get_functor(*it);
+        ss << "  " << f->origin() << "::" << f->name() << "  (runtime average [s]: " << f->getRuntimeAverage()
+           << ", invalidation rate: " << f->getInvalidationRate() << ")" << endl;
+      }
+      ss << "Estimated time per point [s]: " << T_old << " -> " << T_new
+         << " (estimated saving: " << T_old - T_new << " s per point)";
+      logger() << LogTags::core << LogTags::info << ss.str() << EOM;
+      if (debug) cout << ss.str() << endl;
+      target_vertices = new_order;
+    }
+
+    // Reset the drift reference and the point counter
+    reorder_schedule.restart(targetFunctors());
+  }
+
+  /// Functors of the target vertices, in their current order
+  std::vector<functor*> Likelihood_Container::targetFunctors()
+  {
+    std::vector<functor*> result;
+    for (auto it = target_vertices.begin(); it != target_vertices.end(); ++it)
+    {
+      result.push_back(dependencyResolver.get_functor(*it));
+    }
+    return result;
   }
 
   /// Do the prior transformation and populate the parameter map
@@ -187,6 +247,17 @@ namespace Gambit
       // Set the values of the parameter point in the PrimaryParameters functor, and log them to cout and/or the logs if desired.
       setParameters(in);
 
+      // Move counter-based RNGs onto the stream for this point, so that its random draws are reproducible.
+      Random::set_point(getPtID());
+
+      // Re-derive the likelihood evaluation order from the measured runtimes and invalidation rates if requested,
+      // so that cheap, frequently-vetoing likelihoods are evaluated before expensive ones.
+      if (reorder_schedule.enabled())
+      {
+        if (reorder_schedule.due(targetFunctors())) reorderTargetVertices();
+        reorder_schedule.countPoint();
+      }
+
       // Logger debug output; things labelled 'LogTags::debug' only get logged if the logger::debug or master debug flags are true, not if only 'likelihood::debug' is true.
       logger() << LogTags::core << LogTags::debug << "Number of target vertices to calculate:    " << target_vertices.size() << endl
                                                   << "Number of auxiliary vertices to calculate: " << aux_vertices.size() << EOM;
@@ -197,12 +268,16 @@ namespace Gambit
       // Compute time since the previous likelihood evaluation ended
       std::chrono::duration<double> interloop_time = startL - previous_endL;
 
+      // If requested, evaluate all target functors and their dependencies up front, running independent
+      // branches of the dependency graph concurrently.  The loop below then just collects and prints the
+      // results, and picks up any invalidation in the usual order.
+      if (dependencyResolver.parallelBranchesEnabled()) dependencyResolver.precalcObsLikes();
+
       // First work through the target functors, i.e. the ones contributing to the likelihood.
       for (auto it = target_vertices.begin(), end = target_vertices.end(); it != end; ++it)
       {
         // Log the likelihood being tried.
-        str likelihood_tag = "ikelihood contribution from " + dependencyResolver.get_functor(*it)->origin()
-                             + "::" + dependencyResolver.get_functor(*it)->name();
+        const str& likelihood_tag = likelihood_tags.at(*it);
         if (debug) logger() << LogTags::core << "Calculating l" << likelihood_tag << "." << EOM;
 
         try
@@ -215,38 +290,44 @@ namespace Gambit
           dependencyResolver.calcObsLike(*it,getPtID());
 
           // Switch depending on whether the functor returns floats or doubles and a single likelihood or a vector of them.
-          str rtype = return_types[*it];
-          if (rtype == "double")
-          {
-            double result = dependencyResolver.getObsLike<double>(*it);
-            if (debug) debug_to_cout << result;
-            lnlike += result;
-          }
-          else if (rtype == "std::vector<double>")
+          switch (return_types.at(*it))
           {
-            std::vector<double> result = dependencyResolver.getObsLike<std::vector<double> >(*it);
-            for (auto jt = result.begin(); jt != result.end(); ++jt)
+            case DOUBLE:
             {
-              if (debug) debug_to_cout << *jt << " ";
-              lnlike += *jt;
+              double result = dependencyResolver.getObsLike<double>(*it);
+              if (debug) debug_to_cout << result;
+              lnlike += result;
+              break;
             }
-          }
-          else if (rtype == "float")
-          {
-            float result = dependencyResolver.getObsLike<float>(*it);
-            if (debug) debug_to_cout << result;
-            lnlike += result;
-          }
-          else if (rtype == "std::vector<float>")
-          {
-            std::vector<float> result = dependencyResolver.getObsLike<std::vector<float> >(*it);
-            for (auto jt = result.begin(); jt != result.end(); ++jt)
+            case VECTOR_DOUBLE:
+            {
+              std::vector<double> result = dependencyResolver.getObsLike<std::vector<double> >(*it);
+              for (auto jt = result.begin(); jt != result.end(); ++jt)
+              {
+                if (debug) debug_to_cout << *jt << " ";
+                lnlike += *jt;
+              }
+              break;
+            }
+            case FLOAT:
+            {
+              float result = dependencyResolver.getObsLike<float>(*it);
+              if (debug) debug_to_cout << result;
+              lnlike += result;
+              break;
+            }
+            case VECTOR_FLOAT:
             {
-              if (debug) debug_to_cout << *jt << " ";
-              lnlike += *jt;
+              std::vector<float> result = dependencyResolver.getObsLike<std::vector<float> >(*it);
+              for (auto jt = result.begin(); jt != result.end(); ++jt)
+              {
+                if (debug) debug_to_cout << *jt << " ";
+                lnlike += *jt;
+              }
+              break;
             }
+            default: core_error().raise(LOCAL_INFO, "Unexpected target functor type.");
           }
-          else core_error().raise(LOCAL_INFO, "Unexpected target functor type.");
 
           // Print debug info
           if (debug) cout << debug_to_cout.str() << endl;
@@ -285,9 +366,13 @@ namespace Gambit
         for (auto it = aux_vertices.begin(), end = aux_vertices.end(); it != end; ++it)
         {
           // Log the observables being tried.
-          str aux_tag = "dditional observable from " + dependencyResolver.get_functor(*it)->origin()
-                               + "::" + dependencyResolver.get_functor(*it)->name();
-          if (debug) logger() << LogTags::core <<  "Calculating a" << aux_tag << "." << EOM;
+          str aux_tag;
+          if (debug)
+          {
+            aux_tag = "dditional observable from " + dependencyResolver.get_functor(*it)->origin()
+                      + "::" + dependencyResolver.get_functor(*it)->name();
+            logger() << LogTags::core <<  "Calculating a" << aux_tag << "." << EOM;
+          }
 
           try
           {
@@ -329,6 +414,9 @@ namespace Gambit
         printer.print(d_total,     totallooptime_label, totalloopID, rank, getPtID());
       }
 
+      // Return counter-based RNGs to the scanner's own streams.
+      Random::end_point();
+
     }
 
     if (debug) cout << "Total log-likelihood: " << lnlike << endl << endl;
@@ -0,0 +1,179 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  The order in which the target (ObsLike)
+///  vertices of the resolved dependency graph are
+///  evaluated, and the schedule on which that
+///  order is re-derived during a scan.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <algorithm>
+#include <cmath>
+
+#include "gambit/Core/obslike_order.hpp"
+#include "gambit/Logs/logger.hpp"
+
+namespace Gambit
+{
+
+  namespace DRes
+  {
+
+    // Collect parent vertices recursively (excluding root vertex)
+    void getParentVertices(const VertexID & vertex, const
+        DRes::MasterGraphType & graph, std::set<VertexID> & myVertexList)
+    {
+      graph_traits<DRes::MasterGraphType>::in_edge_iterator it, iend;
+
+      for (boost::tie(it, iend) = in_edges(vertex, graph);
+          it != iend; ++it)
+      {
+        if ( std::find(myVertexList.begin(), myVertexList.end(), source(*it, graph)) == myVertexList.end() )
+        {
+          myVertexList.insert(source(*it, graph));
+          getParentVertices(source(*it, graph), graph, myVertexList);
+        }
+      }
+    }
+
+    // Return runtime estimate for a set of nodes
+    double getTimeEstimate(const std::set<VertexID> & vertexList, const DRes::MasterGraphType &graph)
+    {
+      double result = 0;
+      for (std::set<VertexID>::iterator it = vertexList.begin(); it != vertexList.end(); ++it)
+      {
+        result += graph[*it]->getRuntimeAverage();
+      }
+      return result;
+    }
+
+    // Returns list of ObsLike vertices in order of runtime
+    std::vector<VertexID> getObsLikeOrder(const std::vector<VertexID>& targets, const MasterGraphType& graph)
+    {
+      std::vector<VertexID> unsorted = targets;
+      std::vector<VertexID> sorted;
+      std::set<VertexID> parents, colleages, colleages_min;
+      // Sort iteratively (unsorted --> sorted)
+      while (unsorted.size() > 0)
+      {
+        double t2p_now;
+        double t2p_min = -1;
+        std::vector<VertexID>::iterator it_min;
+        for (std::vector<VertexID>::iterator it = unsorted.begin(); it !=
+            unsorted.end(); ++it)
+        {
+          parents.clear();
+          getParentVertices(*it, graph, parents);
+          parents.insert(*it);
+          // Remove vertices that were already calculated from the ist
+          for ( auto cit = colleages.begin(); cit != colleages.end(); cit++)
+          {
+            parents.erase(*cit);
+          }
+          t2p_now = (double) getTimeEstimate(parents, graph);
+          t2p_now /= graph[*it]->getInvalidationRate();
+          if (t2p_min < 0 or t2p_now < t2p_min)
+          {
+            t2p_min = t2p_now;
+            it_min = it;
+            colleages_min = parents;
+          }
+        }
+        // Extent list of calculated vertices
+        colleages.insert(colleages_min.begin(), colleages_min.end());
+        double prop = graph[*it_min]->getInvalidationRate();
+        logger() << LogTags::dependency_resolver << "Estimated T [s]: " << t2p_min*prop << EOM;
+        logger() << LogTags::dependency_resolver << "Estimated p: " << prop << EOM;
+        sorted.push_back(*it_min);
+        unsorted.erase(it_min);
+      }
+      return sorted;
+    }
+
+    // Returns the expected time to evaluate a list of ObsLike vertices in the given order,
+    // allowing for early termination when one of them invalidates the point
+    double getExpectedRuntime(const std::vector<VertexID>& order, const MasterGraphType& graph)
+    {
+      double result = 0;
+      double p_reach = 1;
+      std::set<VertexID> parents, colleages;
+      for (auto it = order.begin(); it != order.end(); ++it)
+      {
+        parents.clear();
+        getParentVertices(*it, graph, parents);
+        parents.insert(*it);
+        // Remove vertices that were already calculated from the list
+        for (auto cit = colleages.begin(); cit != colleages.end(); cit++)
+        {
+          parents.erase(*cit);
+        }
+        result += p_reach * getTimeEstimate(parents, graph);
+        p_reach *= 1 - graph[*it]->getInvalidationRate();
+        colleages.insert(parents.begin(), parents.end());
+      }
+      return result;
+    }
+
+    /// Constructor
+    ReorderSchedule::ReorderSchedule(long long interval, double drift_threshold)
+    : interval(interval), drift_threshold(drift_threshold), points(0)
+    {}
+
+    /// Is re-derivation of the order switched on at all?
+    bool ReorderSchedule::enabled() const
+    {
+      return interval > 0 or drift_threshold > 0;
+    }
+
+    /// Should the order be re-derived before evaluating the next point?
+    bool ReorderSchedule::due(const std::vector<functor*>& targets) const
+    {
+      return (interval > 0 and points >= interval) or
+             (drift_threshold > 0 and points > 0 and haveDrifted(targets));
+    }
+
+    /// Have the statistics of any of the given functors drifted past the threshold?
+    bool ReorderSchedule::haveDrifted(const std::vector<functor*>& targets) const
+    {
+      const auto drifted = [&](double now, double then)
+      {
+        return std::abs(now - then) > drift_threshold * std::abs(then);
+      };
+      for (auto it = targets.begin(); it != targets.end(); ++it)
+      {
+        const std::pair<double,double>& ref = reference.at(*it);
+        if (drifted((*it)->getRuntimeAverage(), ref.first) or drifted((*it)->getInvalidationRate(), ref.second)) return true;
+      }
+      return false;
+    }
+
+    /// Record the statistics on which the current order is based, and restart the point count
+    void ReorderSchedule::restart(const std::vector<functor*>& targets)
+    {
+      reference.clear();
+      for (auto it = targets.begin(); it != targets.end(); ++it)
+      {
+        reference[*it] = std::make_pair((*it)->getRuntimeAverage(), (*it)->getInvalidationRate());
+      }
+      points = 0;
+    }
+
+    /// Count a point evaluated with the current order
+    void ReorderSchedule::countPoint() { points++; }
+
+    /// Number of points evaluated since the order was last derived
+    long long ReorderSchedule::pointsSinceRestart() const { return points; }
+
+  }
+
+}
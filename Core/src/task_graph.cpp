@@ -0,0 +1,205 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Task-graph executor for evaluating
+///  independent branches of the dependency
+///  graph concurrently within a single
+///  parameter point.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <omp.h>
+
+#include "gambit/Core/task_graph.hpp"
+#include "gambit/Core/error_handlers.hpp"
+#include "gambit/Utils/thread_slots.hpp"
+#include "gambit/Logs/logger.hpp"
+
+namespace Gambit
+{
+
+  namespace DRes
+  {
+
+    /// Constructor; starts the worker threads
+    TaskGraphExecutor::TaskGraphExecutor(int n_workers)
+    : n_running(0), n_left(0), aborted(false), shutting_down(false), generation(0)
+    {
+      // Each worker needs its own thread slot beyond those of the main OpenMP team.
+      const int max_workers = Utils::max_thread_slots() - Utils::main_team_thread_slots();
+      if (n_workers > max_workers)
+      {
+        logger() << LogTags::core << LogTags::warn << "Requested " << n_workers << " task-graph workers, but only "
+                 << max_workers << " thread slots are available.  Using " << max_workers << " workers." << EOM;
+        n_workers = max_workers;
+      }
+      // Announce the workers before starting them, so that shared infrastructure (e.g. LogMaster) locks in time.
+      if (n_workers > 0) Utils::set_threads_outside_main_team(n_workers);
+      for (int i = 0; i < n_workers; ++i)
+      {
+        workers.emplace_back(&TaskGraphExecutor::workerLoop, this, Utils::main_team_thread_slots() + i);
+      }
+    }
+
+    /// Destructor; stops and joins the worker threads
+    TaskGraphExecutor::~TaskGraphExecutor()
+    {
+      {
+        std::lock_guard<std::mutex> lk(mtx);
+        shutting_down = true;
+      }
+      cv.notify_all();
+      for (auto it = workers.begin(); it != workers.end(); ++it) it->join();
+      if (not workers.empty()) Utils::set_threads_outside_main_team(0);
+    }
+
+    /// Add a functor evaluation to the graph and return its task index.
+    std::size_t TaskGraphExecutor::addTask(functor* f, bool main_thread_only, const std::vector<std::mutex*>& locks)
+    {
+      Task t;
+      t.f = f;
+      t.main_thread_only = main_thread_only;
+      t.locks = locks;
+      t.n_parents = 0;
+      t.remaining_parents = 0;
+      tasks.push_back(t);
+      return tasks.size() - 1;
+    }
+
+    /// Require the task with index parent to complete before the task with index child starts.
+    void TaskGraphExecutor::addEdge(std::size_t parent, std::size_t child)
+    {
+      tasks.at(parent).children.push_back(child);
+      tasks.at(child).n_parents++;
+    }
+
+    /// Number of worker threads
+    int TaskGraphExecutor::nWorkers() const { return workers.size(); }
+
+    /// Evaluate all tasks.
+    void TaskGraphExecutor::run()
+    {
+      std::unique_lock<std::mutex> lk(mtx);
+      ready.clear();
+      for (std::size_t i = 0; i < tasks.size(); ++i)
+      {
+        tasks[i].remaining_parents = tasks[i].n_parents;
+        if (tasks[i].n_parents == 0) ready.push_back(i);
+      }
+      n_running = 0;
+      n_left = tasks.size();
+      aborted = false;
+      error = nullptr;
+      generation++;
+      cv.notify_all();
+
+      participate(lk, true);
+
+      if (error) std::rethrow_exception(error);
+    }
+
+    /// Take evaluation tasks until the current run is finished
+    void TaskGraphExecutor::participate(std::unique_lock<std::mutex>& lk, bool main_thread)
+    {
+      while (not finished())
+      {
+        std::size_t index;
+        if (aborted or not takeTask(main_thread, index))
+        {
+          cv.wait(lk);
+          continue;
+        }
+        n_running++;
+        lk.unlock();
+        std::exception_ptr e;
+        bool ok = execute(index, e);
+        lk.lock();
+        n_running--;
+        n_left--;
+        if (ok)
+        {
+          const std::vector<std::size_t>& children = tasks[index].children;
+          for (auto it = children.begin(); it != children.end(); ++it)
+          {
+            if (--tasks[*it].remaining_parents == 0) ready.push_back(*it);
+          }
+        }
+        else
+        {
+          aborted = true;
+          if (e and not error) error = e;
+        }
+        cv.notify_all();
+      }
+    }
+
+    /// Pop a ready task that the calling thread may run
+    bool TaskGraphExecutor::takeTask(bool main_thread, std::size_t& index)
+    {
+      for (auto it = ready.begin(); it != ready.end(); ++it)
+      {
+        if (main_thread or not tasks[*it].main_thread_only)
+        {
+          index = *it;
+          ready.erase(it);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// Evaluate a single task
+    bool TaskGraphExecutor::execute(std::size_t index, std::exception_ptr& e)
+    {
+      Task& t = tasks[index];
+      std::vector<std::unique_lock<std::mutex>> held;
+      held.reserve(t.locks.size());
+      for (auto it = t.locks.begin(); it != t.locks.end(); ++it) held.emplace_back(**it);
+      try
+      {
+        t.f->calculate();
+      }
+      catch (invalid_point_exception&)
+      {
+        // The invalidation is stored in the functor; leave it to be picked up when the results are collected.
+        logger().leaving_module();
+        return false;
+      }
+      catch (...)
+      {
+        logger().leaving_module();
+        e = std::current_exception();
+        return false;
+      }
+      return t.f->retrieve_invalid_point_exception() == NULL;
+    }
+
+    /// Main loop of the worker threads
+    void TaskGraphExecutor::workerLoop(int slot_offset)
+    {
+      Utils::set_thread_slot_offset(slot_offset);
+      // Parallel blocks inside functors run with a single thread on the workers.
+      omp_set_num_threads(1);
+      unsigned long long seen = 0;
+      std::unique_lock<std::mutex> lk(mtx);
+      while (true)
+      {
+        cv.wait(lk, [&]{ return shutting_down or generation != seen; });
+        if (shutting_down) return;
+        seen = generation;
+        participate(lk, false);
+      }
+    }
+
+  }
+
+}
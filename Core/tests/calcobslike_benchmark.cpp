@@ -0,0 +1,187 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the per-point framework overhead
+///  of DependencyResolver::calcObsLike, for a toy
+///  objective as cheap as ScannerBit's 'gaussian'
+///  test function: a chain of module functors that
+///  each add one term of a unit Gaussian
+///  log-likelihood.  Compares the original
+///  per-vertex loop (log message, yaml lookup and
+///  type comparison for every vertex) against
+///  walking the pre-computed execution plan.
+///
+///  Usage: calcobslike_benchmark [nvertices] [npoints]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Utils/yaml_options.hpp"
+#include "gambit/Utils/util_functions.hpp"
+#include "gambit/Elements/functors.hpp"
+#include "gambit/Elements/functor_definitions.hpp"
+#include "gambit/Models/models.hpp"
+#include "gambit/Core/depresolver.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  /// Parameters of the current toy point
+  std::vector<double> parameters(5);
+
+  /// One term of a unit Gaussian log-likelihood in the toy parameters
+  void gaussian_term(double& result)
+  {
+    result = 0.;
+    for (double x : parameters) result -= 0.5*x*x;
+  }
+
+  /// The type comparison made for every vertex by the original calcObsLike (typeComp in depresolver.cpp,
+  /// with the BOSSed backends of a default build and no type equivalencies)
+  bool original_typeComp(str s1, str s2, const std::map<str, str>& default_safe_versions)
+  {
+    for (auto it = default_safe_versions.begin(); it != default_safe_versions.end(); ++it)
+    {
+      s1 = Utils::strip_leading_namespace(s1, it->first+"_"+it->second);
+      s2 = Utils::strip_leading_namespace(s2, it->first+"_"+it->second);
+    }
+    return (s1 == s2 or s1 == "" or s1 == "*");
+  }
+
+  /// The original calcObsLike loop over the sorted parent vertices of a target
+  void original_calcObsLike(std::vector<functor*> order, const Options& inifile,
+                            const std::map<str, str>& default_safe_versions, int& printed)
+  {
+    for (auto it = order.begin(); it != order.end(); ++it)
+    {
+      std::ostringstream ss;
+      ss << "Calling " << (*it)->name() << " from " << (*it)->origin() << "...";
+      logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << ss.str() << EOM;
+      (*it)->calculate();
+      if (inifile.getValueOrDef<bool>(false, "dependency_resolution", "log_runtime"))
+      {
+        double T = (*it)->getRuntimeAverage();
+        logger() << LogTags::dependency_resolver << LogTags::info <<
+          "Runtime, averaged over multiple calls [s]: " << T << EOM;
+      }
+      invalid_point_exception* e = (*it)->retrieve_invalid_point_exception();
+      if (e != NULL) throw(*e);
+      if (not original_typeComp((*it)->type(), "void", default_safe_versions)) printed++;
+    }
+  }
+
+  /// The current calcObsLike loop over the execution plan of a target
+  void planned_calcObsLike(const std::vector<DRes::ExecutionStep>& plan, bool log_runtime, int& printed)
+  {
+    for (auto it = plan.begin(); it != plan.end(); ++it)
+    {
+      if (not it->call_message.empty())
+      {
+        logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << it->call_message << EOM;
+      }
+      it->f->calculate();
+      if (log_runtime)
+      {
+        double T = it->f->getRuntimeAverage();
+        logger() << LogTags::dependency_resolver << LogTags::info <<
+          "Runtime, averaged over multiple calls [s]: " << T << EOM;
+      }
+      invalid_point_exception* e = it->f->retrieve_invalid_point_exception();
+      if (e != NULL) throw(*e);
+      if (it->print) printed++;
+    }
+  }
+
+  /// Time per point (us) of evaluating npoints toy points with the given loop
+  template <typename F>
+  double time_per_point_us(std::vector<functor*>& functors, int npoints, F loop)
+  {
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> normal;
+    const auto start = std::chrono::steady_clock::now();
+    for (int point = 0; point < npoints; ++point)
+    {
+      for (double& x : parameters) x = normal(gen);
+      for (functor* f : functors) f->reset();
+      loop();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / npoints;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const int nvertices = (argc > 1 ? std::atoi(argv[1]) : 50);
+  const int npoints = (argc > 2 ? std::atoi(argv[2]) : 20000);
+
+  logger().disable();
+
+  // A yaml file with the usual dependency resolution options
+  const Options inifile(YAML::Load("dependency_resolution:\n  prefer_model_specific_functions: true\n"));
+  const std::map<str, str> default_safe_versions = {{"gm2calc", "1_3_0"}, {"Pythia", "8_212"}};
+
+  // The toy likelihood: a chain of functors, in calling order
+  Models::ModelFunctorClaw claw;
+  std::vector<module_functor<double>*> chain;
+  std::vector<functor*> functors;
+  for (int i = 0; i < nvertices; ++i)
+  {
+    chain.push_back(new module_functor<double>(&gaussian_term, "gaussian_term_" + std::to_string(i),
+                                               "toy_loglike_" + std::to_string(i), "double", "ToyBit", claw));
+    functors.push_back(chain.back());
+  }
+
+  // The execution plan, as built at the end of DependencyResolver::doResolution
+  const bool log_runtime = inifile.getValueOrDef<bool>(false, "dependency_resolution", "log_runtime");
+  const bool log_calls = logger().get_log_debug_messages();
+  std::vector<DRes::ExecutionStep> plan;
+  for (functor* f : functors)
+  {
+    DRes::ExecutionStep step;
+    step.f = f;
+    step.print = not original_typeComp(f->type(), "void", default_safe_versions);
+    if (log_calls) step.call_message = "Calling " + f->name() + " from " + f->origin() + "...";
+    plan.push_back(step);
+  }
+
+  int printed_original = 0, printed_planned = 0;
+  const double t_original = time_per_point_us(functors, npoints, [&]{ original_calcObsLike(functors, inifile, default_safe_versions, printed_original); });
+  const double t_planned = time_per_point_us(functors, npoints, [&]{ planned_calcObsLike(plan, log_runtime, printed_planned); });
+
+  Utils::benchmark_table table("calcObsLike for a toy Gaussian objective, " + std::to_string(nvertices) + " vertices, "
+                                + std::to_string(npoints) + " points",
+                                {{"loop", 24, ""}, {"per point [us]", 16, "%.2f"}, {"per vertex [ns]", 16, "%.1f"}});
+  table.row("original", t_original, 1e3*t_original/nvertices);
+  table.row("execution plan", t_planned, 1e3*t_planned/nvertices);
+  table.row("speedup", t_original/t_planned);
+
+  for (module_functor<double>* f : chain) delete f;
+  if (printed_original != printed_planned)
+  {
+    std::printf("The two loops printed different numbers of results (%d and %d).\n", printed_original, printed_planned);
+    return 1;
+  }
+  return 0;
+}
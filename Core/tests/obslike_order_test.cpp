@@ -0,0 +1,227 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the ordering of target (ObsLike)
+///  vertices on a toy dependency graph: ordering
+///  by measured runtime and invalidation rate puts
+///  cheap, often-invalidating likelihoods first,
+///  reordering does not change the likelihood of
+///  any point, and the options reorder_interval
+///  and reorder_drift_threshold trigger
+///  re-derivation of the order as documented.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Elements/functors.hpp"
+#include "gambit/Elements/functor_definitions.hpp"
+#include "gambit/Models/models.hpp"
+#include "gambit/Core/obslike_order.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::DRes;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// The toy functions: a shared parent and four likelihoods
+  enum toy_id { PARENT, SHARED_A, SHARED_B, CHEAP, EXPENSIVE, ntoys };
+
+  /// Time each toy function takes (ms)
+  int sleep_ms[ntoys] = {3, 0, 0, 0, 4};
+
+  /// Index of the current toy point
+  int point = 0;
+
+  /// Does toy function N invalidate the current point?
+  bool invalidates(int N)
+  {
+    switch (N)
+    {
+      case SHARED_B: return point%3 == 0;
+      case CHEAP: return point%2 == 0;
+      case EXPENSIVE: return point%20 == 0;
+      default: return false;
+    }
+  }
+
+  /// Toy module function number N; returns an integer log-likelihood, so that sums are exact in any order
+  template <int N>
+  void toy(double& result)
+  {
+    if (sleep_ms[N] > 0) std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms[N]));
+    if (invalidates(N)) invalid_point().raise("Toy invalidation.");
+    result = -(N + point%7);
+  }
+
+  /// Result of evaluating the likelihood at a point
+  struct outcome
+  {
+    bool valid;
+    double lnlike;
+    bool operator==(const outcome& o) const { return valid == o.valid and (not valid or lnlike == o.lnlike); }
+  };
+
+  /// Evaluate the target vertices in the given order, each after its parents, stopping at the first invalidation
+  outcome evaluate(const std::vector<VertexID>& order, const MasterGraphType& graph, std::vector<module_functor<double>*>& functors)
+  {
+    for (functor* f : functors) f->reset();
+    outcome result = {true, 0.};
+    try
+    {
+      for (VertexID target : order)
+      {
+        std::set<VertexID> parents;
+        getParentVertices(target, graph, parents);
+        for (VertexID parent : parents) graph[parent]->calculate();
+        graph[target]->calculate();
+        result.lnlike += (*functors[target])(0);
+      }
+    }
+    catch (invalid_point_exception&)
+    {
+      result.valid = false;
+    }
+    return result;
+  }
+
+  /// Functors of the given vertices
+  std::vector<functor*> functors_of(const std::vector<VertexID>& vertices, const MasterGraphType& graph)
+  {
+    std::vector<functor*> result;
+    for (VertexID v : vertices) result.push_back(graph[v]);
+    return result;
+  }
+
+  /// Position of a vertex in an order
+  long position(const std::vector<VertexID>& order, VertexID v)
+  {
+    return std::find(order.begin(), order.end(), v) - order.begin();
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+
+  Models::ModelFunctorClaw claw;
+  void (*fns[ntoys])(double&) = {&toy<PARENT>, &toy<SHARED_A>, &toy<SHARED_B>, &toy<CHEAP>, &toy<EXPENSIVE>};
+  std::vector<module_functor<double>*> functors;
+  MasterGraphType graph;
+  for (int i = 0; i < ntoys; ++i)
+  {
+    functors.push_back(new module_functor<double>(fns[i], "toy_" + std::to_string(i), "toy_capability_" + std::to_string(i),
+                                                  "double", "ToyBit", claw));
+    functors.back()->setFadeRate(0.1);
+    add_vertex(functors.back(), graph);
+  }
+  add_edge(PARENT, SHARED_A, graph);
+  add_edge(PARENT, SHARED_B, graph);
+  const std::vector<VertexID> targets = {SHARED_A, SHARED_B, CHEAP, EXPENSIVE};
+
+  std::cout << "Ordering by runtime and invalidation rate" << std::endl;
+  const std::vector<VertexID> initial = getObsLikeOrder(targets, graph);
+  {
+    // Measure the runtimes and invalidation rates over a stretch of the scan, with the initial order.
+    for (point = 0; point < 150; ++point) evaluate(initial, graph, functors);
+    for (point = 0; point < 150; ++point) evaluate(targets, graph, functors);
+    check(functors[CHEAP]->getInvalidationRate() > functors[EXPENSIVE]->getInvalidationRate(), "invalidation rates are measured");
+    const std::vector<VertexID> reordered = getObsLikeOrder(targets, graph);
+    check(reordered.size() == targets.size() and std::is_permutation(reordered.begin(), reordered.end(), targets.begin()),
+          "the order contains every target vertex once");
+    check(reordered.front() == CHEAP, "the cheap, often-invalidating likelihood comes first");
+    check(position(reordered, SHARED_B) < position(reordered, EXPENSIVE),
+          "a likelihood with an often-invalidating but cheaper subgraph comes before an expensive, rarely invalidating one");
+    check(position(reordered, SHARED_B) < position(reordered, SHARED_A),
+          "of two likelihoods sharing a parent, the more often invalidating one comes first");
+    check(getExpectedRuntime(reordered, graph) <= getExpectedRuntime(targets, graph),
+          "the expected time per point of the derived order is no longer than that of the declared order");
+
+    // The likelihood of every point is the same in any order.
+    bool same = true;
+    for (point = 0; point < 60; ++point)
+    {
+      const outcome a = evaluate(targets, graph, functors);
+      const outcome b = evaluate(reordered, graph, functors);
+      std::vector<VertexID> reversed(reordered.rbegin(), reordered.rend());
+      const outcome c = evaluate(reversed, graph, functors);
+      same = same and a == b and a == c;
+    }
+    check(same, "reordering changes neither the log-likelihood nor the validity of any point");
+  }
+
+  std::cout << "Reorder schedule" << std::endl;
+  {
+    const std::vector<functor*> fs = functors_of(targets, graph);
+
+    ReorderSchedule never(0, 0.);
+    never.restart(fs);
+    for (int i = 0; i < 10; ++i) never.countPoint();
+    check(not never.enabled() and not never.due(fs), "with both options 0, the order is never re-derived");
+
+    ReorderSchedule every3(3, 0.);
+    every3.restart(fs);
+    bool ok = every3.enabled();
+    for (int i = 0; i < 3; ++i)
+    {
+      ok = ok and not every3.due(fs);
+      every3.countPoint();
+    }
+    check(ok and every3.due(fs), "reorder_interval: the order is re-derived once every reorder_interval points");
+    every3.restart(fs);
+    check(not every3.due(fs) and every3.pointsSinceRestart() == 0, "re-deriving the order restarts the count");
+
+    // Drift: the expensive likelihood's runtime average follows its latest runtime exactly.
+    functor* expensive = functors[EXPENSIVE];
+    expensive->setFadeRate(1.);
+    point = 1;
+    expensive->reset();
+    expensive->calculate();
+    ReorderSchedule drift(0, 0.5);
+    drift.restart(fs);
+    sleep_ms[EXPENSIVE] = 20;
+    expensive->reset();
+    expensive->calculate();
+    check(not drift.due(fs), "reorder_drift_threshold: never before any point has been evaluated with the current order");
+    drift.countPoint();
+    check(drift.haveDrifted(fs) and drift.due(fs), "reorder_drift_threshold: a runtime change beyond the threshold triggers reordering");
+    drift.restart(fs);
+    drift.countPoint();
+    expensive->reset();
+    expensive->calculate();
+    check(not drift.due(fs), "reorder_drift_threshold: not once the new statistics have become the reference");
+    for (int i = 0; i < 100; ++i) drift.countPoint();
+    check(not drift.due(fs), "reorder_drift_threshold alone does not reorder after a fixed number of points");
+  }
+
+  for (module_functor<double>* f : functors) delete f;
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
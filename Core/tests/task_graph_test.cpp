@@ -0,0 +1,274 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the task-graph executor used to
+///  evaluate independent branches of the
+///  dependency graph concurrently: ordering of
+///  dependent tasks, confinement of
+///  main-thread-only tasks to the calling thread,
+///  serialisation of tasks sharing a backend
+///  lock, abort on invalidation, rethrowing of
+///  errors, and the thread-safety flag of module
+///  functors (off unless declared THREAD_SAFE).
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Elements/functors.hpp"
+#include "gambit/Elements/functor_definitions.hpp"
+#include "gambit/Elements/ini_functions.hpp"
+#include "gambit/Models/models.hpp"
+#include "gambit/Core/task_graph.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// Maximum number of toy functions
+  const int ntoys = 8;
+
+  /// What each toy function does, and what happened when it ran
+  struct ToyRecord
+  {
+    int sleep_ms = 0;
+    bool invalidate = false;
+    bool fail = false;
+    int lock_group = -1;
+    int calls = 0;
+    int start = -1;
+    int end = -1;
+    std::thread::id thread;
+  };
+  ToyRecord toys[ntoys];
+
+  /// Global sequence counter for start and end events
+  std::atomic<int> sequence(0);
+
+  /// Number of toy functions running at once, overall and per lock group, and the maxima seen
+  std::atomic<int> in_flight(0), max_in_flight(0);
+  std::atomic<int> in_group[2], max_in_group[2];
+
+  void raise_to(std::atomic<int>& max, int value)
+  {
+    int old = max.load();
+    while (value > old and not max.compare_exchange_weak(old, value)) {}
+  }
+
+  /// Toy module function number N
+  template <int N>
+  void toy(double& result)
+  {
+    ToyRecord& r = toys[N];
+    r.calls++;
+    r.thread = std::this_thread::get_id();
+    r.start = sequence++;
+    raise_to(max_in_flight, ++in_flight);
+    if (r.lock_group >= 0) raise_to(max_in_group[r.lock_group], ++in_group[r.lock_group]);
+    if (r.sleep_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(r.sleep_ms));
+    if (r.lock_group >= 0) --in_group[r.lock_group];
+    --in_flight;
+    r.end = sequence++;
+    result = N;
+    if (r.invalidate) invalid_point().raise("Toy invalidation.");
+    if (r.fail) throw std::runtime_error("Toy failure.");
+  }
+
+  /// Reset the records and the functors before a run
+  void reset(std::vector<module_functor<double>*>& functors)
+  {
+    for (int i = 0; i < ntoys; ++i)
+    {
+      toys[i].calls = 0;
+      toys[i].start = -1;
+      toys[i].end = -1;
+      toys[i].thread = std::thread::id();
+    }
+    in_flight = 0;
+    max_in_flight = 0;
+    for (int i = 0; i < 2; ++i) { in_group[i] = 0; max_in_group[i] = 0; }
+    for (functor* f : functors) f->reset();
+  }
+
+  /// Reset the behaviour of all toy functions
+  void clear_behaviour()
+  {
+    for (int i = 0; i < ntoys; ++i)
+    {
+      toys[i].sleep_ms = 0;
+      toys[i].invalidate = false;
+      toys[i].fail = false;
+      toys[i].lock_group = -1;
+    }
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+  const std::thread::id main_thread = std::this_thread::get_id();
+
+  Models::ModelFunctorClaw claw;
+  void (*fns[ntoys])(double&) = {&toy<0>, &toy<1>, &toy<2>, &toy<3>, &toy<4>, &toy<5>, &toy<6>, &toy<7>};
+  std::vector<module_functor<double>*> functors;
+  for (int i = 0; i < ntoys; ++i)
+  {
+    functors.push_back(new module_functor<double>(fns[i], "toy_" + std::to_string(i), "toy_capability_" + std::to_string(i),
+                                                  "double", "ToyBit", claw));
+  }
+
+  std::cout << "Thread-safety flag of module functors" << std::endl;
+  {
+    check(not functors[0]->isThreadSafe(), "module functions are not thread-safe unless declared so");
+    set_thread_safe(*functors[0]);
+    check(functors[0]->isThreadSafe(), "THREAD_SAFE (set_thread_safe) marks a module function as thread-safe");
+    functors[0]->setThreadSafe(false);
+  }
+
+  std::cout << "Ordering of dependent tasks" << std::endl;
+  {
+    // A diamond 0 -> {1, 2} -> 3 -> 4, plus independent tasks 5 and 6; all may run on the workers.
+    clear_behaviour();
+    for (int i = 0; i < 7; ++i) toys[i].sleep_ms = 2*(i%3);
+    DRes::TaskGraphExecutor executor(2);
+    std::vector<std::size_t> t;
+    for (int i = 0; i < 7; ++i) t.push_back(executor.addTask(functors[i], false, {}));
+    executor.addEdge(t[0], t[1]);
+    executor.addEdge(t[0], t[2]);
+    executor.addEdge(t[1], t[3]);
+    executor.addEdge(t[2], t[3]);
+    executor.addEdge(t[3], t[4]);
+    const std::vector<std::pair<int,int>> edges = {{0,1}, {0,2}, {1,3}, {2,3}, {3,4}};
+    bool all_once = true, ordered = true;
+    for (int run = 0; run < 20; ++run)
+    {
+      reset(functors);
+      executor.run();
+      for (int i = 0; i < 7; ++i) all_once = all_once and toys[i].calls == 1;
+      for (const auto& e : edges) ordered = ordered and toys[e.first].end < toys[e.second].start;
+    }
+    check(all_once, "every task runs exactly once per run, over repeated runs");
+    check(ordered, "every task starts only after all of its parents have finished");
+  }
+
+  std::cout << "Main-thread-only tasks" << std::endl;
+  {
+    // Tasks 0-3 are main-thread-only, 4-7 may run anywhere; all are independent and ready at once.
+    clear_behaviour();
+    for (int i = 0; i < ntoys; ++i) toys[i].sleep_ms = 5;
+    DRes::TaskGraphExecutor executor(2);
+    for (int i = 0; i < ntoys; ++i) executor.addTask(functors[i], i < 4, {});
+    bool on_main = true, off_main = false;
+    for (int run = 0; run < 5; ++run)
+    {
+      reset(functors);
+      executor.run();
+      for (int i = 0; i < 4; ++i) on_main = on_main and toys[i].thread == main_thread;
+      for (int i = 4; i < ntoys; ++i) off_main = off_main or toys[i].thread != main_thread;
+    }
+    check(on_main, "main-thread-only tasks always run on the calling thread");
+    if (executor.nWorkers() > 0)
+    {
+      check(off_main, "other tasks are also run by the workers");
+      check(max_in_flight.load() > 1, "independent tasks run concurrently");
+    }
+  }
+
+  std::cout << "Backend locks" << std::endl;
+  {
+    // Tasks 0-3 share lock 0, tasks 4-7 share lock 1.
+    clear_behaviour();
+    std::mutex locks[2];
+    DRes::TaskGraphExecutor executor(3);
+    for (int i = 0; i < ntoys; ++i)
+    {
+      toys[i].sleep_ms = 3;
+      toys[i].lock_group = i/4;
+      executor.addTask(functors[i], false, {&locks[i/4]});
+    }
+    reset(functors);
+    executor.run();
+    check(max_in_group[0] == 1 and max_in_group[1] == 1, "tasks holding the same lock never overlap");
+  }
+
+  std::cout << "Invalidation" << std::endl;
+  {
+    // A chain 0 -> 1 -> 2 with 0 invalidating the point, plus an independent task 3 queued after it.
+    // All tasks are main-thread-only, so that the order in which they are taken is deterministic.
+    clear_behaviour();
+    toys[0].invalidate = true;
+    DRes::TaskGraphExecutor executor(2);
+    std::vector<std::size_t> t;
+    for (int i = 0; i < 4; ++i) t.push_back(executor.addTask(functors[i], true, {}));
+    executor.addEdge(t[0], t[1]);
+    executor.addEdge(t[1], t[2]);
+    reset(functors);
+    bool threw = false;
+    try { executor.run(); }
+    catch (...) { threw = true; }
+    check(not threw, "an invalidation is not rethrown by the executor");
+    check(functors[0]->retrieve_invalid_point_exception() != NULL, "the invalidation remains stored in the functor");
+    check(toys[1].calls == 0 and toys[2].calls == 0, "dependants of an invalidating task are not run");
+    check(toys[3].calls == 0, "no further tasks are started after an invalidation");
+
+    // The next point runs normally.
+    toys[0].invalidate = false;
+    reset(functors);
+    executor.run();
+    check(toys[1].calls == 1 and toys[2].calls == 1 and toys[3].calls == 1, "the following point is evaluated in full");
+  }
+
+  std::cout << "Errors" << std::endl;
+  {
+    clear_behaviour();
+    toys[1].fail = true;
+    DRes::TaskGraphExecutor executor(2);
+    std::vector<std::size_t> t;
+    for (int i = 0; i < 3; ++i) t.push_back(executor.addTask(functors[i], false, {}));
+    executor.addEdge(t[0], t[1]);
+    executor.addEdge(t[1], t[2]);
+    reset(functors);
+    bool rethrown = false;
+    try { executor.run(); }
+    catch (std::runtime_error&) { rethrown = true; }
+    check(rethrown, "other exceptions are rethrown in the calling thread");
+    check(toys[2].calls == 0, "dependants of a failed task are not run");
+
+    toys[1].fail = false;
+    reset(functors);
+    executor.run();
+    check(toys[2].calls == 1, "the executor can be run again after an error");
+  }
+
+  for (module_functor<double>* f : functors) delete f;
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -449,20 +449,17 @@ int main()
     nuyield_from_DS.reset_and_calculate();
 
     // Calculate number of events at IceCube
-    IC79WH_full.resolveDependency(&mwimp_generic);
-    IC79WH_full.resolveDependency(&annihilation_rate_Sun);
-    IC79WH_full.resolveDependency(&nuyield_from_DS);
-    IC79WH_full.resolveBackendReq(&Backends::nulike_1_0_7::Functown::nulike_bounds);
+    IC_full.setOption<std::vector<str> >("samples", std::vector<str>{"IC-79 WH", "IC-79 WL", "IC-79 SL"});
+    IC_full.resolveDependency(&mwimp_generic);
+    IC_full.resolveDependency(&annihilation_rate_Sun);
+    IC_full.resolveDependency(&nuyield_from_DS);
+    IC_full.resolveBackendReq(&Backends::nulike_1_0_7::Functown::nulike_bounds);
+    IC_full.reset_and_calculate();
+    IC79WH_full.resolveDependency(&IC_full);
     IC79WH_full.reset_and_calculate();
-    IC79WL_full.resolveDependency(&mwimp_generic);
-    IC79WL_full.resolveDependency(&annihilation_rate_Sun);
-    IC79WL_full.resolveDependency(&nuyield_from_DS);
-    IC79WL_full.resolveBackendReq(&Backends::nulike_1_0_7::Functown::nulike_bounds);
+    IC79WL_full.resolveDependency(&IC_full);
     IC79WL_full.reset_and_calculate();
-    IC79SL_full.resolveDependency(&mwimp_generic);
-    IC79SL_full.resolveDependency(&annihilation_rate_Sun);
-    IC79SL_full.resolveDependency(&nuyield_from_DS);
-    IC79SL_full.resolveBackendReq(&Backends::nulike_1_0_7::Functown::nulike_bounds);
+    IC79SL_full.resolveDependency(&IC_full);
     IC79SL_full.reset_and_calculate();
 
     // Calculate IceCube likelihood
@@ -921,10 +921,10 @@ START_MODULE
 
   // Neutrino telescope likelihoods ------------------------
 
-  #define CAPABILITY IC22_data
+  #define CAPABILITY IC_data
   START_CAPABILITY
-    #define FUNCTION IC22_full
-      START_FUNCTION(nudata)
+    #define FUNCTION IC_full
+      START_FUNCTION(nudata_samples)
       DEPENDENCY(mwimp, double)
       DEPENDENCY(annihilation_rate_Sun, double)
       DEPENDENCY(nuyield_ptr, nuyield_info)
@@ -936,6 +936,14 @@ START_MODULE
     #undef FUNCTION
   #undef CAPABILITY
 
+  #define CAPABILITY IC22_data
+  START_CAPABILITY
+    #define FUNCTION IC22_full
+      START_FUNCTION(nudata)
+      DEPENDENCY(IC_data, nudata_samples)
+    #undef FUNCTION
+  #undef CAPABILITY
+
   #define CAPABILITY IC22_signal
   START_CAPABILITY
     #define FUNCTION IC22_signal
@@ -988,14 +996,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION IC79WH_full
       START_FUNCTION(nudata)
-      DEPENDENCY(mwimp, double)
-      DEPENDENCY(annihilation_rate_Sun, double)
-      DEPENDENCY(nuyield_ptr, nuyield_info)
-      BACKEND_REQ(nubounds, (), void, (const char&, const double&, const double&,
-                                       nuyield_function_pointer, double&, double&, int&,
-                                       double&, double&, const int&, const double&,
-                                       const int&, const bool&, const double&,
-                                       const double&, void*&, const bool&))
+      DEPENDENCY(IC_data, nudata_samples)
     #undef FUNCTION
   #undef CAPABILITY
 
@@ -1051,14 +1052,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION IC79WL_full
       START_FUNCTION(nudata)
-      DEPENDENCY(mwimp, double)
-      DEPENDENCY(annihilation_rate_Sun, double)
-      DEPENDENCY(nuyield_ptr, nuyield_info)
-      BACKEND_REQ(nubounds, (), void, (const char&, const double&, const double&,
-                                       nuyield_function_pointer, double&, double&, int&,
-                                       double&, double&, const int&, const double&,
-                                       const int&, const bool&, const double&,
-                                       const double&, void*&, const bool&))
+      DEPENDENCY(IC_data, nudata_samples)
     #undef FUNCTION
   #undef CAPABILITY
 
@@ -1114,14 +1108,7 @@ START_MODULE
   START_CAPABILITY
     #define FUNCTION IC79SL_full
       START_FUNCTION(nudata)
-      DEPENDENCY(mwimp, double)
-      DEPENDENCY(annihilation_rate_Sun, double)
-      DEPENDENCY(nuyield_ptr, nuyield_info)
-      BACKEND_REQ(nubounds, (), void, (const char&, const double&, const double&,
-                                       nuyield_function_pointer, double&, double&, int&,
-                                       double&, double&, const int&, const double&,
-                                       const int&, const bool&, const double&,
-                                       const double&, void*&, const bool&))
+      DEPENDENCY(IC_data, nudata_samples)
     #undef FUNCTION
   #undef CAPABILITY
 
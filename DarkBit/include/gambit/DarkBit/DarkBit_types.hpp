@@ -135,6 +135,9 @@ namespace Gambit
         double pvalue;
     };
 
+    /// Neutrino telescope data for several event samples, keyed by the sample names used by nulike
+    typedef std::map<str, nudata> nudata_samples;
+
     /// Annihilation/decay channel
     struct SimYieldChannel
     {
@@ -21,8 +21,14 @@
 ///          (ankit.beniwal@adelaide.edu.au)
 ///  \date 2018 Jan, Aug
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
+#include <cstring>
+
 #include "gambit/Elements/gambit_module_headers.hpp"
 #include "gambit/DarkBit/DarkBit_rollcall.hpp"
 #include "gambit/DarkBit/DarkBit_utils.hpp"
@@ -465,133 +471,127 @@ namespace Gambit
     /// such that including any particular IC analysis adds just *one* additional degree of freedom to the fit.
     /// @{
 
-    /// \brief 22-string IceCube sample: predicted signal and background
-    /// counts, observed counts and likelihoods.
-    void IC22_full(nudata &result)
+    /// Neutrino yields shared between the IceCube event samples at a single point.  Each yield is
+    /// computed the first time that nulike asks for it, and then reused for all other samples.
+    class shared_nuyield
     {
-      using namespace Pipes::IC22_full;
-      static bool first = true;
-      const double bgloglike = -808.4581;
-      double sigpred, bgpred, lnLike, pval;
-      int totobs;
-      char experiment[300] = "IC-22";
-      void* context = NULL;
-      double theoryError = (*Dep::mwimp > 100.0 ? 0.05*sqrt(*Dep::mwimp*0.01) : 0.05);
-      /// Option nulike_speed<int>: Speed setting for nulike backend (default 3)
-      int speed = runOptions->getValueOrDef<int>(3,"nulike_speed");
-      BEreq::nubounds(experiment[0], *Dep::mwimp, *Dep::annihilation_rate_Sun,
-          byVal(Dep::nuyield_ptr->pointer), sigpred, bgpred, totobs, lnLike, pval, 4,
-          theoryError, speed, false, 0.0, 0.0, context, Dep::nuyield_ptr->threadsafe);
-      piped_invalid_point.check();
-      piped_errors.check(DarkBit_error());
-      piped_warnings.check(DarkBit_warning());
-      result.signal = sigpred;
-      result.bg = bgpred;
-      result.nobs = totobs;
-      result.loglike = lnLike;
-      result.pvalue = pval;
-      if (first)
-      {
-        result.bgloglike = bgloglike;
-        first = false;
-      }
-    }
+      public:
 
-    /// \brief 79-string IceCube WH sample: predicted signal and background
-    /// counts, observed counts and likelihoods.
-    void IC79WH_full(nudata &result)
+        shared_nuyield(nuyield_function_pointer f) : yield_function(f) {}
+
+        /// Yield function with the signature expected by nulike; the context must point to a shared_nuyield.
+        static double yield(const double& log10E, const int& ptype, void*& context)
+        {
+          shared_nuyield& self = *static_cast<shared_nuyield*>(context);
+          const std::pair<double,int> key(log10E, ptype);
+          bool found = false;
+          double result = 0;
+          #pragma omp critical (DarkBit_shared_nuyield)
+          {
+            auto it = self.table.find(key);
+            if (it != self.table.end())
+            {
+              found = true;
+              result = it->second;
+            }
+          }
+          if (found) return result;
+          void* yield_context = NULL;
+          result = self.yield_function(log10E, ptype, yield_context);
+          #pragma omp critical (DarkBit_shared_nuyield)
+          self.table[key] = result;
+          return result;
+        }
+
+      private:
+
+        nuyield_function_pointer yield_function;
+        std::map<std::pair<double,int>, double> table;
+    };
+
+    /// \brief Predicted signal and background counts, observed counts and likelihoods for
+    /// all requested IceCube event samples, computed together.
+    ///
+    /// The samples share the neutrino yields.  They are run one after the other, as nulike keeps its state in
+    /// Fortran COMMON blocks; nulike itself evaluates the yields concurrently if the yield function is threadsafe.
+    /// The background-only log-likelihood of each sample is included.
+    void IC_full(nudata_samples &result)
     {
-      static bool first = true;
-      using namespace Pipes::IC79WH_full;
-      const double bgloglike = -11874.8689;
-      double sigpred, bgpred, lnLike, pval;
-      int totobs;
-      char experiment[300] = "IC-79 WH";
-      void* context = NULL;
-      double theoryError = (*Dep::mwimp > 100.0 ? 0.05*sqrt(*Dep::mwimp*0.01) : 0.05);
-      /// Option nulike_speed<int>: Speed setting for nulike backend (default 3)
-      int speed = runOptions->getValueOrDef<int>(3,"nulike_speed");
-      BEreq::nubounds(experiment[0], *Dep::mwimp, *Dep::annihilation_rate_Sun,
-          byVal(Dep::nuyield_ptr->pointer), sigpred, bgpred, totobs, lnLike, pval, 4,
-          theoryError, speed, false, 0.0, 0.0, context, Dep::nuyield_ptr->threadsafe);
-      piped_invalid_point.check();
-      piped_errors.check(DarkBit_error());
-      piped_warnings.check(DarkBit_warning());
-      result.signal = sigpred;
-      result.bg = bgpred;
-      result.nobs = totobs;
-      result.loglike = lnLike;
-      result.pvalue = pval;
-      if (first)
+      using namespace Pipes::IC_full;
+      static const std::map<str, double> bgloglikes =
+      {
+        {"IC-22",    -808.4581},
+        {"IC-79 WH", -11874.8689},
+        {"IC-79 WL", -1813.4503},
+        {"IC-79 SL", -5015.6474},
+      };
+      /// Option samples<std::vector<str>>: IceCube event samples to compute (default: all of IC-22, IC-79 WH, IC-79 WL
+      /// and IC-79 SL; drop IC-22 to save one nulike call per point if nothing uses IC22_full)
+      static const std::vector<str> samples = runOptions->getValueOrDef<std::vector<str> >(
+       std::vector<str>{"IC-22", "IC-79 WH", "IC-79 WL", "IC-79 SL"}, "samples");
+      /// Option nulike_speed<int>: Speed setting for nulike backend, used for all samples (default 3)
+      const int speed = runOptions->getValueOrDef<int>(3,"nulike_speed");
+      const bool threadsafe = Dep::nuyield_ptr->threadsafe;
+      const double theoryError = (*Dep::mwimp > 100.0 ? 0.05*sqrt(*Dep::mwimp*0.01) : 0.05);
+
+      // Check all the samples before running any of them
+      for (const str& sample : samples)
       {
-        result.bgloglike = bgloglike;
-        first = false;
+        auto bg = bgloglikes.find(sample);
+        if (bg == bgloglikes.end()) DarkBit_error().raise(LOCAL_INFO, "Unknown IceCube sample " + sample + ".");
+        result[sample].bgloglike = bg->second;
       }
-    }
 
-    /// \brief 79-string IceCube WL sample: predicted signal and background
-    /// counts, observed counts and likelihoods.
-    void IC79WL_full(nudata &result)
-    {
-      static bool first = true;
-      using namespace Pipes::IC79WL_full;
-      const double bgloglike = -1813.4503;
-      double sigpred, bgpred, lnLike, pval;
-      int totobs;
-      char experiment[300] = "IC-79 WL";
-      void* context = NULL;
-      double theoryError = (*Dep::mwimp > 100.0 ? 0.05*sqrt(*Dep::mwimp*0.01) : 0.05);
-      /// Option nulike_speed<int>: Speed setting for nulike backend (default 3)
-      int speed = runOptions->getValueOrDef<int>(3,"nulike_speed");
-      BEreq::nubounds(experiment[0], *Dep::mwimp, *Dep::annihilation_rate_Sun,
-          byVal(Dep::nuyield_ptr->pointer), sigpred, bgpred, totobs, lnLike, pval, 4,
-          theoryError, speed, false, 0.0, 0.0, context, Dep::nuyield_ptr->threadsafe);
+      shared_nuyield yields(Dep::nuyield_ptr->pointer);
+      for (const str& sample : samples)
+      {
+        nudata& data = result.at(sample);
+        char experiment[300];
+        std::strncpy(experiment, sample.c_str(), sizeof(experiment)-1);
+        experiment[sizeof(experiment)-1] = '\0';
+        void* context = &yields;
+        BEreq::nubounds(experiment[0], *Dep::mwimp, *Dep::annihilation_rate_Sun,
+            byVal(&shared_nuyield::yield), data.signal, data.bg, data.nobs, data.loglike, data.pvalue, 4,
+            theoryError, speed, false, 0.0, 0.0, context, threadsafe);
+      }
       piped_invalid_point.check();
       piped_errors.check(DarkBit_error());
       piped_warnings.check(DarkBit_warning());
-      result.signal = sigpred;
-      result.bg = bgpred;
-      result.nobs = totobs;
-      result.loglike = lnLike;
-      result.pvalue = pval;
-      if (first)
-      {
-        result.bgloglike = bgloglike;
-        first = false;
-      }
     }
 
-    /// \brief 79-string IceCube SL sample: predicted signal and background
-    /// counts, observed counts and likelihoods.
-    void IC79SL_full(nudata &result)
+    /// Retrieve the results for one IceCube sample
+    const nudata& IC_sample(const nudata_samples& data, const str& sample, const safe_ptr<Options>& runOptions)
     {
-      static bool first = true;
-      using namespace Pipes::IC79SL_full;
-      const double bgloglike = -5015.6474;
-      double sigpred, bgpred, lnLike, pval;
-      int totobs;
-      char experiment[300] = "IC-79 SL";
-      void* context = NULL;
-      double theoryError = (*Dep::mwimp > 100.0 ? 0.05*sqrt(*Dep::mwimp*0.01) : 0.05);
-      /// Option nulike_speed<int>: Speed setting for nulike backend (default 3)
-      int speed = runOptions->getValueOrDef<int>(3,"nulike_speed");
-      BEreq::nubounds(experiment[0], *Dep::mwimp, *Dep::annihilation_rate_Sun,
-          byVal(Dep::nuyield_ptr->pointer), sigpred, bgpred, totobs, lnLike, pval, 4,
-          theoryError, speed, false, 0.0, 0.0, context, Dep::nuyield_ptr->threadsafe);
-      piped_invalid_point.check();
-      piped_errors.check(DarkBit_error());
-      piped_warnings.check(DarkBit_warning());
-      result.signal = sigpred;
-      result.bg = bgpred;
-      result.nobs = totobs;
-      result.loglike = lnLike;
-      result.pvalue = pval;
-      if (first)
+      // The samples are all computed by IC_full, so nulike settings for individual samples have no effect.
+      static std::set<str> warned;
+      if (runOptions->hasKey("nulike_speed"))
+      {
+        bool first = false;
+        #pragma omp critical (DarkBit_IC_sample_warning)
+        first = warned.insert(sample).second;
+        if (first)
+        {
+          DarkBit_warning().raise(LOCAL_INFO, "The option nulike_speed is ignored for IceCube sample " + sample + ", "
+                                              "as all samples are computed together by IC_full. Please set it for IC_full instead.");
+        }
+      }
+      auto it = data.find(sample);
+      if (it == data.end())
       {
-        result.bgloglike = bgloglike;
-        first = false;
+        DarkBit_error().raise(LOCAL_INFO, "IceCube sample " + sample + " has not been computed. "
+                                          "Please add it to the samples option of IC_full.");
       }
+      return it->second;
     }
+
+    /// \brief Individual IceCube samples: predicted signal and background
+    /// counts, observed counts and likelihoods.
+    /// @{
+    void IC22_full(nudata &result)   { result = IC_sample(*Pipes::IC22_full::Dep::IC_data, "IC-22", Pipes::IC22_full::runOptions); }
+    void IC79WH_full(nudata &result) { result = IC_sample(*Pipes::IC79WH_full::Dep::IC_data, "IC-79 WH", Pipes::IC79WH_full::runOptions); }
+    void IC79WL_full(nudata &result) { result = IC_sample(*Pipes::IC79WL_full::Dep::IC_data, "IC-79 WL", Pipes::IC79WL_full::runOptions); }
+    void IC79SL_full(nudata &result) { result = IC_sample(*Pipes::IC79SL_full::Dep::IC_data, "IC-79 SL", Pipes::IC79SL_full::runOptions); }
+    /// @}
     /// @}
 
     /// 22-string extractor module functions
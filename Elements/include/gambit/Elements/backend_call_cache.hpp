@@ -0,0 +1,181 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Memoisation of the results of backend
+///  function calls.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __backend_call_cache_hpp__
+#define __backend_call_cache_hpp__
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <type_traits>
+
+#include "gambit/Utils/util_types.hpp"
+
+namespace Gambit
+{
+
+  /// @brief Bounded least-recently-used cache of the results of one backend function.
+  ///
+  /// Inputs and results are stored as raw bytes.  Keys are compared exactly, so two calls only
+  /// ever share a result if all their inputs are bitwise identical.  If the persistent store is
+  /// switched on (see set_persistence), every cache also appends each new result to a file in the
+  /// GAMBIT scratch directory, and reloads that file on first use, so that results can be shared
+  /// between runs (and between processes, as the file is only ever touched under a file lock).
+  /// A file that would grow beyond the size limit is rewritten with only the results currently
+  /// held in memory, most recently used last, dropping the oldest ones if needed.
+  class BackendCallCache
+  {
+
+    public:
+
+      /// Constructor
+      BackendCallCache(const str& name, std::size_t capacity);
+
+      /// Copy the cached result for the given key into result, if there is one.
+      bool fetch(const str& key, void* result, std::size_t size);
+
+      /// Store the result for the given key.
+      void store(const str& key, const void* result, std::size_t size);
+
+      /// Name of the backend function
+      const str& name() const { return myName; }
+
+      /// Numbers of hits and misses so far
+      long long hits() const { return nHits; }
+      long long misses() const { return nMisses; }
+
+      /// Create a cache and register it for reporting.  The cache lives until the end of the run.
+      static BackendCallCache* create(const str& name, std::size_t capacity);
+
+      /// Switch the persistent store of all caches on or off (it is off by default), and set the maximum size of
+      /// each cache's file in bytes.  Only affects caches that have not been used yet.
+      static void set_persistence(bool enabled, std::size_t max_file_size);
+
+      /// Summary of the hit rates of all backend call caches (empty if there are none).
+      static str report();
+
+    private:
+
+      /// Insert an entry without touching the file
+      void insert(const str& key, const str& value);
+
+      /// Load the persistent store (on first use), if it is switched on
+      void load();
+
+      /// Append an entry to the persistent store, rewriting it if it would grow too large
+      void save(const str& key, const str& value);
+
+      /// Rewrite the persistent store with the entries held in memory
+      void rewrite();
+
+      /// Name of the backend function
+      str myName;
+
+      /// Maximum number of cached results
+      std::size_t myCapacity;
+
+      /// File backing the persistent store (empty if the persistent store is off)
+      str myFilename;
+
+      /// Has the persistent store been read yet?
+      bool loaded;
+
+      /// Cached results, most recently used first
+      std::list<std::pair<str,str> > entries;
+
+      /// Index of the cached results by key
+      std::map<str, std::list<std::pair<str,str> >::iterator> index;
+
+      /// Numbers of hits and misses so far
+      long long nHits, nMisses;
+
+      /// Backend functions may be called from several threads at once
+      std::mutex mutex;
+
+      /// All caches created so far
+      static std::vector<std::unique_ptr<BackendCallCache> >& all();
+
+  };
+
+
+  /// @name Traits deciding which backend functions can be memoised.
+  /// Arguments must be inputs that are fully described by their bytes: trivially copyable values, const references
+  /// to them, or pointers to const trivially copyable structs (which are taken to point to a single object).
+  /// Non-const pointers and references (i.e. possible outputs), and pointers to arrays or strings, are not allowed.
+  /// @{
+  template <typename T>
+  struct memoisable_backend_arg
+   : std::integral_constant<bool, std::is_trivially_copyable<T>::value and not std::is_pointer<T>::value> {};
+  template <typename T>
+  struct memoisable_backend_arg<T*> : std::false_type {};
+  template <typename T>
+  struct memoisable_backend_arg<const T*>
+   : std::integral_constant<bool, std::is_class<T>::value and memoisable_backend_arg<T>::value> {};
+  template <typename T>
+  struct memoisable_backend_arg<T&> : std::false_type {};
+  template <typename T>
+  struct memoisable_backend_arg<const T&> : memoisable_backend_arg<T> {};
+
+  template <bool...> struct backend_bool_pack;
+  template <bool... B>
+  using backend_all_true = std::is_same<backend_bool_pack<true, B...>, backend_bool_pack<B..., true> >;
+
+  template <typename TYPE, typename... ARGS>
+  struct memoisable_backend_function
+   : std::integral_constant<bool, not std::is_void<TYPE>::value and
+                                  std::is_trivially_copyable<TYPE>::value and
+                                  std::is_default_constructible<TYPE>::value and
+                                  backend_all_true<memoisable_backend_arg<ARGS>::value...>::value> {};
+  /// @}
+
+  /// @name Building cache keys from the arguments of backend function calls
+  /// Arguments are keyed on all their bytes, including any padding between the members of a struct.  Structs passed
+  /// to memoised functions should therefore be zeroed before they are filled (as FlavBit::SI_fill does for SuperIso's
+  /// parameters).  Padding that is not zeroed cannot give a wrong result, but can make identical inputs miss.
+  /// @{
+  template <typename T>
+  struct backend_call_key_part
+  {
+    static void append(str& key, const T& x) { key.append(reinterpret_cast<const char*>(&x), sizeof(T)); }
+  };
+  template <typename T>
+  struct backend_call_key_part<const T&> : backend_call_key_part<T> {};
+  template <typename T>
+  struct backend_call_key_part<const T*>
+  {
+    static void append(str& key, const T* x)
+    {
+      key.push_back(x == NULL ? 0 : 1);
+      if (x != NULL) backend_call_key_part<T>::append(key, *x);
+    }
+  };
+
+  template <typename... ARGS>
+  str make_backend_call_key(const typename std::remove_reference<ARGS>::type&... args)
+  {
+    str key;
+    int expand[] = {0, (backend_call_key_part<ARGS>::append(key, args), 0)...};
+    (void)expand;
+    return key;
+  }
+  /// @}
+
+}
+
+#endif // defined __backend_call_cache_hpp__
@@ -0,0 +1,227 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Compact storage of decay channels for the
+///  DecayTable class.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __decay_channels_hpp__
+#define __decay_channels_hpp__
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gambit/Utils/standalone_error_handlers.hpp"
+
+namespace Gambit
+{
+
+  /// The final state of a decay: a sorted, fixed-capacity array of (PDG code, context integer) pairs.
+  /// Behaves like the std::multiset it replaces (iteration in sorted order, size, comparison), and converts
+  /// to and from one.
+  class decay_channel
+  {
+    public:
+
+      typedef std::pair<int,int> particle;
+      typedef const particle* const_iterator;
+      typedef const_iterator iterator;
+
+      /// Maximum number of final state particles
+      static const size_t max_daughters = 6;
+
+      /// Constructors
+      /// @{
+      decay_channel() : n(0) {}
+      template <typename It>
+      decay_channel(It first, It last) : n(0) { for (; first != last; ++first) insert(*first); }
+      decay_channel(const std::multiset<particle>& s) : decay_channel(s.begin(), s.end()) {}
+      decay_channel(const std::vector<particle>& v) : decay_channel(v.begin(), v.end()) {}
+      /// @}
+
+      /// Add a particle to the final state, keeping it sorted
+      void insert(const particle& p)
+      {
+        if (n == max_daughters) utils_error().raise(LOCAL_INFO, "Too many final state particles in a DecayTable channel.");
+        size_t i = n++;
+        for (; i > 0 and p < daughters[i-1]; --i) daughters[i] = daughters[i-1];
+        daughters[i] = p;
+      }
+
+      /// Convert to a std::multiset
+      operator std::multiset<particle>() const { return std::multiset<particle>(begin(), end()); }
+
+      /// @name Container interface
+      /// @{
+      const_iterator begin() const { return daughters.data(); }
+      const_iterator end() const { return daughters.data() + n; }
+      size_t size() const { return n; }
+      bool empty() const { return n == 0; }
+      /// @}
+
+      /// Comparison, in the same (lexicographic) order as for std::multiset
+      /// @{
+      bool operator==(const decay_channel& other) const
+      {
+        if (n != other.n) return false;
+        for (size_t i = 0; i < n; ++i) if (daughters[i] != other.daughters[i]) return false;
+        return true;
+      }
+      bool operator!=(const decay_channel& other) const { return not (*this == other); }
+      bool operator<(const decay_channel& other) const
+      {
+        return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+      }
+      /// @}
+
+      /// Hash of the final state
+      size_t hash() const
+      {
+        size_t h = n;
+        for (size_t i = 0; i < n; ++i)
+        {
+          const size_t code = static_cast<size_t>(static_cast<unsigned int>(daughters[i].first)) * 31 + static_cast<unsigned int>(daughters[i].second);
+          h ^= code + 0x9e3779b9 + (h << 6) + (h >> 2);
+        }
+        return h;
+      }
+
+    private:
+
+      std::array<particle, max_daughters> daughters;
+      unsigned char n;
+
+  };
+
+  /// The decay channels of a particle and their (BF, error) pairs, stored contiguously in the order in which
+  /// they were first set.  Provides the subset of the std::map interface used on DecayTable::Entry::channels.
+  /// Lookups compare the precomputed hashes of the channels before comparing final states.  Beyond
+  /// index_threshold channels, they go through an open-addressing hash index (linear probing, kept at most
+  /// half full); below it, a scan over the hashes is faster.  Channels are never removed except by clear().
+  class decay_channel_map
+  {
+    public:
+
+      typedef decay_channel key_type;
+      typedef std::pair<double,double> mapped_type;
+      typedef std::pair<decay_channel, mapped_type> value_type;
+      typedef std::vector<value_type>::iterator iterator;
+      typedef std::vector<value_type>::const_iterator const_iterator;
+
+      /// @name Container interface
+      /// @{
+      iterator begin() { return entries.begin(); }
+      iterator end() { return entries.end(); }
+      const_iterator begin() const { return entries.begin(); }
+      const_iterator end() const { return entries.end(); }
+      size_t size() const { return entries.size(); }
+      bool empty() const { return entries.empty(); }
+      void clear() { entries.clear(); hashes.clear(); slots.clear(); }
+      /// @}
+
+      /// Find a channel, returning end() if it is absent
+      /// @{
+      iterator find(const decay_channel& key) { return entries.begin() + position(key); }
+      const_iterator find(const decay_channel& key) const { return entries.begin() + position(key); }
+      size_t count(const decay_channel& key) const { return position(key) == entries.size() ? 0 : 1; }
+      /// @}
+
+      /// Access a channel, throwing std::out_of_range if it is absent
+      /// @{
+      mapped_type& at(const decay_channel& key)
+      {
+        size_t i = position(key);
+        if (i == entries.size()) throw std::out_of_range("decay_channel_map::at");
+        return entries[i].second;
+      }
+      const mapped_type& at(const decay_channel& key) const
+      {
+        size_t i = position(key);
+        if (i == entries.size()) throw std::out_of_range("decay_channel_map::at");
+        return entries[i].second;
+      }
+      /// @}
+
+      /// Access a channel, adding it if it is absent
+      mapped_type& operator[](const decay_channel& key)
+      {
+        size_t h = key.hash();
+        size_t i = position(key, h);
+        if (i == entries.size())
+        {
+          entries.push_back(value_type(key, mapped_type(0.0, 0.0)));
+          hashes.push_back(h);
+          if (entries.size() <= index_threshold) {}
+          else if (2*entries.size() > slots.size()) rehash(std::max<size_t>(4*index_threshold, 2*slots.size()));
+          else slots[free_slot(h)] = entries.size();
+        }
+        return entries[i].second;
+      }
+
+    private:
+
+      /// Number of channels above which the hash index is built
+      static const size_t index_threshold = 16;
+
+      /// First slot to probe for a hash (mixing the bits, as the index only uses the lowest ones)
+      size_t first_slot(size_t h) const { return (h ^ (h >> 17) ^ (h >> 31)) * 0x9e3779b1u & (slots.size() - 1); }
+
+      /// First empty slot for a hash
+      size_t free_slot(size_t h) const
+      {
+        size_t s = first_slot(h);
+        while (slots[s] != 0) s = (s + 1) & (slots.size() - 1);
+        return s;
+      }
+
+      /// Rebuild the index with the given number of slots (a power of two)
+      void rehash(size_t nslots)
+      {
+        slots.assign(nslots, 0);
+        for (size_t i = 0; i < entries.size(); ++i) slots[free_slot(hashes[i])] = i + 1;
+      }
+
+      /// Index of a channel in entries, or entries.size() if it is absent
+      /// @{
+      size_t position(const decay_channel& key) const { return position(key, key.hash()); }
+      size_t position(const decay_channel& key, size_t h) const
+      {
+        if (slots.empty())
+        {
+          for (size_t i = 0; i < hashes.size(); ++i) if (hashes[i] == h and entries[i].first == key) return i;
+          return entries.size();
+        }
+        for (size_t s = first_slot(h); slots[s] != 0; s = (s + 1) & (slots.size() - 1))
+        {
+          const size_t i = slots[s] - 1;
+          if (hashes[i] == h and entries[i].first == key) return i;
+        }
+        return entries.size();
+      }
+      /// @}
+
+      std::vector<value_type> entries;
+      /// Hashes of the channels in entries
+      std::vector<size_t> hashes;
+      /// Hash index: each slot holds 1 + the index of a channel in entries, or 0 if it is empty (no slots below index_threshold)
+      std::vector<size_t> slots;
+
+  };
+
+}
+
+#endif //#defined __decay_channels_hpp__
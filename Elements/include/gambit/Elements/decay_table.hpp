@@ -12,6 +12,10 @@
 ///          (patscott@physics.mcgill.ca)
 ///  \date 2015 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __decay_table_hpp__
@@ -22,6 +26,7 @@
 #include <string>
 #include <sstream>
 
+#include "gambit/Elements/decay_channels.hpp"
 #include "gambit/Elements/slhaea_helpers.hpp"
 #include "gambit/Elements/mssm_slhahelp.hpp"
 #include "gambit/Utils/util_types.hpp"
@@ -101,25 +106,25 @@ namespace Gambit
           void init(const SLHAea::Block&, int, bool force_SM_fermion_gauge_eigenstates = false);
 
           /// Make sure all particles listed in a set are actually known to the GAMBIT particle database
-          void check_particles_exist(std::multiset< std::pair<int,int> >&) const;
+          void check_particles_exist(const decay_channel&) const;
 
           /// Make sure no NaNs have been passed to the DecayTable by nefarious backends
-          void check_BF_validity(double, double, std::multiset< std::pair<int,int> >&) const;
+          void check_BF_validity(double, double, const decay_channel&) const;
 
           /// Construct a set of particles from a variadic list of full names or short names and indices
           /// @{
           /// Base function version
-          static void construct_key(std::multiset< std::pair<int,int> >&) {}
+          static void construct_key(decay_channel&) {}
           /// Templated version for long names
           template <typename... Args>
-          static void construct_key(std::multiset< std::pair<int,int> >& key, str p1, Args... args)
+          static void construct_key(decay_channel& key, const str& p1, Args... args)
           {
             construct_key(key, args...);
             key.insert(Models::ParticleDB().pdg_pair(p1));
           }
           /// Templated version for short names and indices
           template <typename... Args>
-          static void construct_key(std::multiset< std::pair<int,int> >& key, str p1, int i1, Args... args)
+          static void construct_key(decay_channel& key, const str& p1, int i1, Args... args)
           {
             construct_key(key, args...);
             key.insert(Models::ParticleDB().pdg_pair(p1, i1));
@@ -154,7 +159,7 @@ namespace Gambit
           void set_BF(double BF, double error, std::pair<int,int> p1, Args... args)
           {
             std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
+            decay_channel key(particles, particles+sizeof...(Args)+1);
             check_particles_exist(key);
             check_BF_validity(BF, error, key);
             channels[key] = std::pair<double, double>(BF, error);
@@ -163,7 +168,7 @@ namespace Gambit
           template <typename... Args>
           void set_BF(double BF, double error, str p1, Args... args)
           {
-            std::multiset< std::pair<int,int> > key;
+            decay_channel key;
             construct_key(key, p1, args...);
             check_BF_validity(BF, error, key);
             channels[key] = std::pair<double, double>(BF, error);
@@ -186,7 +191,7 @@ namespace Gambit
           bool has_channel(std::pair<int,int> p1, Args... args) const
           {
             std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
+            decay_channel key(particles, particles+sizeof...(Args)+1);
             check_particles_exist(key);
             return channels.find(key) != channels.end();
           }
@@ -194,7 +199,7 @@ namespace Gambit
           template <typename... Args>
           bool has_channel(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
+            decay_channel key;
             construct_key(key, p1, args...);
             return channels.find(key) != channels.end();
           }
@@ -216,7 +221,7 @@ namespace Gambit
           double BF(std::pair<int,int> p1, Args... args) const
           {
             std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
+            decay_channel key(particles, particles+sizeof...(Args)+1);
             if (channels.find(key) == channels.end())
             {
               std::ostringstream err;
@@ -233,7 +238,7 @@ namespace Gambit
           template <typename... Args>
           double BF(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
+            decay_channel key;
             construct_key(key, p1, args...);
             if (channels.find(key) == channels.end())
             {
@@ -257,7 +262,7 @@ namespace Gambit
           double BF_error(std::pair<int,int> p1, Args... args) const
           {
             std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
+            decay_channel key(particles, particles+sizeof...(Args)+1);
             if (channels.find(key) == channels.end())
             {
               std::ostringstream err;
@@ -274,7 +279,7 @@ namespace Gambit
           template <typename... Args>
           double BF_error(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
+            decay_channel key;
             construct_key(key, p1, args...);
             if (channels.find(key) == channels.end())
             {
@@ -298,7 +303,7 @@ namespace Gambit
           std::pair<double, double> BF_with_error(std::pair<int,int> p1, Args... args) const
           {
             std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
+            decay_channel key(particles, particles+sizeof...(Args)+1);
             if (channels.find(key) == channels.end())
             {
               std::ostringstream err;
@@ -315,7 +320,7 @@ namespace Gambit
           template <typename... Args>
           std::pair<double, double> BF_with_error(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
+            decay_channel key;
             construct_key(key, p1, args...);
             if (channels.find(key) == channels.end())
             {
@@ -361,7 +366,9 @@ namespace Gambit
 
           /// The actual underlying map of channels to their BFs.
           /// Just iterate over this directly if you need to iterate over all decays of this particle.
-          std::map< std::multiset< std::pair<int,int> >, std::pair<double, double> > channels;
+          /// Channels are kept in the order in which they were first set; each key behaves like a sorted
+          /// std::multiset of (PDG code, context integer) pairs.
+          decay_channel_map channels;
 
       };
 
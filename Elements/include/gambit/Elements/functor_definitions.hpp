@@ -37,8 +37,11 @@
 #define __functor_definitions_hpp__
 
 #include <chrono>
+#include <iterator>
+#include <type_traits>
 
 #include "gambit/Elements/functors.hpp"
+#include "gambit/Backends/backend_instances.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Models/models.hpp"
 #include "gambit/Logs/logger.hpp"
@@ -104,6 +107,12 @@ namespace Gambit
       {
         logger().entering_module(myLogTag);
         this->startTiming(thread_num);             //Begin timing function evaluation
+        if (point_cache_capacity > 0 and point_cache_fetch()) // Reuse the result from an earlier point if possible
+        {
+          this->finishTiming(thread_num, false);   //Stop timing, keeping cache hits out of the runtime statistics
+          logger().leaving_module();
+          return;
+        }
         try
         {
           this->myFunction(myValue[thread_num]);   //Run and place result in the appropriate slot in myValue
@@ -118,10 +127,67 @@ namespace Gambit
           }
         }
         this->finishTiming(thread_num);            //Stop timing function evaluation
+        if (point_cache_capacity > 0 and not point_exception_raised) point_cache_store();
         logger().leaving_module();
       }
     }
 
+    /// Helper for copying results into and out of the point cache; only copy-assignable results can be cached.
+    template <typename TYPE, bool copyable = std::is_copy_assignable<TYPE>::value>
+    struct point_cache_copier
+    {
+      static void copy(const TYPE& from, TYPE& to) { to = from; }
+    };
+    template <typename TYPE>
+    struct point_cache_copier<TYPE, false>
+    {
+      static void copy(const TYPE&, TYPE&) { utils_error().raise(LOCAL_INFO, "Attempted to cache a result that cannot be copied."); }
+    };
+
+    /// Can results of this functor be cached across parameter points?
+    template <typename TYPE>
+    bool module_functor<TYPE>::supportsPointCache() const { return std::is_copy_assignable<TYPE>::value; }
+
+    /// Retrieve the result for the current point from the point cache, if it is there.
+    template <typename TYPE>
+    bool module_functor<TYPE>::point_cache_fetch()
+    {
+      makePointCacheKey();
+      auto it = point_cache_index.find(point_cache_key);
+      if (it == point_cache_index.end())
+      {
+        point_cache_misses++;
+        return false;
+      }
+      // Move the entry to the front of the list, i.e. mark it as most recently used.
+      point_cache.splice(point_cache.begin(), point_cache, it->second);
+      point_cache_copier<TYPE>::copy(it->second->second, myValue[0]);
+      point_cache_hit = true;
+      point_cache_hits++;
+      logger() << LogTags::debug << "Took result of " << myOrigin << "::" << myName << " from point cache ("
+               << point_cache_hits << " hits, " << point_cache_misses << " misses so far)." << EOM;
+      return true;
+    }
+
+    /// Store the result for the current point in the point cache.
+    template <typename TYPE>
+    void module_functor<TYPE>::point_cache_store()
+    {
+      if (point_cache.size() < point_cache_capacity)
+      {
+        point_cache.emplace_front();
+      }
+      else
+      {
+        // Recycle the least recently used entry.
+        point_cache_index.erase(point_cache.back().first);
+        point_cache.splice(point_cache.begin(), point_cache, std::prev(point_cache.end()));
+      }
+      point_cache.front().first = point_cache_key;
+      point_cache_copier<TYPE>::copy(myValue[0], point_cache.front().second);
+      point_cache_index[point_cache_key] = point_cache.begin();
+    }
+
     /// Initialise the memory of this functor.
     template <typename TYPE>
     void module_functor<TYPE>::init_memory()
@@ -184,6 +250,14 @@ namespace Gambit
           printer->print(runtime.count(),myTimingLabel,myTimingVertexID,rank,pointID);
           already_printed_timing[thread_num] = true;
         }
+
+        // Print whether the result was taken from the point cache, if the cache is in use
+        if(point_cache_capacity > 0 and not already_printed_point_cache)
+        {
+          int rank = printer->getRank();
+          printer->print(point_cache_hit,pointCacheLabel(),myPointCacheVertexID,rank,pointID);
+          already_printed_point_cache = true;
+        }
       }
 
       /// Printer function (no-thread-index short-circuit)
@@ -206,7 +280,8 @@ namespace Gambit
     : functor (func_name, func_capability, result_type, origin_name, claw),
       myFunction (inputFunction),
       myLogTag(-1),
-      inUse(false)
+      inUse(false),
+      myCallCache(NULL)
     {
       myVersion = origin_version;
       mySafeVersion = origin_safe_version;
@@ -237,7 +312,7 @@ namespace Gambit
     template <typename PTR_TYPE, typename TYPE, typename... ARGS>
     typename backend_functor_common<PTR_TYPE, TYPE, ARGS...>::funcPtrType backend_functor_common<PTR_TYPE, TYPE, ARGS...>::handoutFunctionPointer()
     {
-      return myFunction;
+      return threadFunction();
     }
 
     /// Getter for the 'safe' incarnation of the wrapped function's origin's version (module or backend)
@@ -255,6 +330,62 @@ namespace Gambit
       return safe_ptr<bool>(&inUse);
     }
 
+    /// Index of the copy of the backend library to be used by the calling thread
+    template <typename PTR_TYPE, typename TYPE, typename... ARGS>
+    std::size_t backend_functor_common<PTR_TYPE, TYPE, ARGS...>::instanceIndex(std::size_t ninstances) const
+    {
+      return Backends::backend_instance_index(ninstances, myName + " from " + myOrigin + " v" + myVersion);
+    }
+
+    /// The wrapped function in the copy of the backend library to be used by the calling thread
+    template <typename PTR_TYPE, typename TYPE, typename... ARGS>
+    typename backend_functor_common<PTR_TYPE, TYPE, ARGS...>::funcPtrType backend_functor_common<PTR_TYPE, TYPE, ARGS...>::threadFunction() const
+    {
+      if (myInstanceFunctions.empty()) return myFunction;
+      return myInstanceFunctions[instanceIndex(myInstanceFunctions.size())];
+    }
+
+    /// Address of the wrapped variable in the copy of the backend library to be used by the calling thread
+    template <typename PTR_TYPE, typename TYPE, typename... ARGS>
+    void* backend_functor_common<PTR_TYPE, TYPE, ARGS...>::threadVariable() const
+    {
+      if (myInstanceVariables.empty()) return NULL;
+      return myInstanceVariables[instanceIndex(myInstanceVariables.size())];
+    }
+
+    /// Set the addresses of the wrapped function or variable in each loaded copy of the backend library
+    template <typename PTR_TYPE, typename TYPE, typename... ARGS>
+    void backend_functor_common<PTR_TYPE, TYPE, ARGS...>::setBackendInstances(const std::vector<void*>& addresses, bool is_variable)
+    {
+      if (is_variable)
+      {
+        myInstanceVariables = addresses;
+        return;
+      }
+      // Go via a union to avoid warnings about casting between object and function pointers (cf. load_backend_symbol).
+      union { void* ptr; funcPtrType fptr; } address;
+      myInstanceFunctions.clear();
+      for (void* ptr : addresses)
+      {
+        address.ptr = ptr;
+        myInstanceFunctions.push_back(address.fptr);
+      }
+    }
+
+    /// Memoise up to capacity results of the wrapped function.
+    template <typename PTR_TYPE, typename TYPE, typename... ARGS>
+    void backend_functor_common<PTR_TYPE, TYPE, ARGS...>::setMemoisation(std::size_t capacity)
+    {
+      if (not std::is_same<PTR_TYPE, TYPE(*)(ARGS...)>::value or not memoisable_backend_function<TYPE, ARGS...>::value)
+      {
+        str errmsg = "Cannot memoise backend function " + myName + " from " + myOrigin + " v" + myVersion + ".";
+        errmsg += "\nOnly non-variadic functions with a trivially copyable return type, and with arguments that"
+                  "\nare all inputs (values, const references or pointers to const structs), can be memoised.";
+        utils_error().raise(LOCAL_INFO,errmsg);
+      }
+      if (myCallCache == NULL) myCallCache = BackendCallCache::create(myOrigin + "_" + mySafeVersion + "_" + myName, capacity);
+    }
+
 
     // Actual non-variadic backend functor class method definitions for TYPE != void
 
@@ -274,9 +405,37 @@ namespace Gambit
     /// Operation (execute function and return value)
     template <typename TYPE, typename... ARGS>
     TYPE backend_functor<TYPE(*)(ARGS...), TYPE, ARGS...>::operator()(ARGS&&... args)
+    {
+      if (this->myCallCache != NULL)
+      {
+        return memoised_call(std::integral_constant<bool, memoisable_backend_function<TYPE, ARGS...>::value>(), std::forward<ARGS>(args)...);
+      }
+      logger().entering_backend(this->myLogTag);
+      TYPE tmp = this->threadFunction()(std::forward<ARGS>(args)...);
+      logger().leaving_backend();
+      return tmp;
+    }
+
+    /// Execute the function via the cache of results
+    template <typename TYPE, typename... ARGS>
+    TYPE backend_functor<TYPE(*)(ARGS...), TYPE, ARGS...>::memoised_call(std::true_type, ARGS&&... args)
+    {
+      const str key = make_backend_call_key<ARGS...>(args...);
+      TYPE tmp;
+      if (this->myCallCache->fetch(key, &tmp, sizeof(TYPE))) return tmp;
+      logger().entering_backend(this->myLogTag);
+      tmp = this->threadFunction()(std::forward<ARGS>(args)...);
+      logger().leaving_backend();
+      this->myCallCache->store(key, &tmp, sizeof(TYPE));
+      return tmp;
+    }
+
+    /// Dummy for functions that cannot be memoised (never called, as setMemoisation refuses to create a cache for them)
+    template <typename TYPE, typename... ARGS>
+    TYPE backend_functor<TYPE(*)(ARGS...), TYPE, ARGS...>::memoised_call(std::false_type, ARGS&&... args)
     {
       logger().entering_backend(this->myLogTag);
-      TYPE tmp = this->myFunction(std::forward<ARGS>(args)...);
+      TYPE tmp = this->threadFunction()(std::forward<ARGS>(args)...);
       logger().leaving_backend();
       return tmp;
     }
@@ -302,7 +461,7 @@ namespace Gambit
     void backend_functor<void(*)(ARGS...), void, ARGS...>::operator()(ARGS&&... args)
     {
       logger().entering_backend(this->myLogTag);
-      this->myFunction(std::forward<ARGS>(args)...);
+      this->threadFunction()(std::forward<ARGS>(args)...);
       logger().leaving_backend();
     }
 
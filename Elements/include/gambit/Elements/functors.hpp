@@ -37,6 +37,7 @@
 #ifndef __functors_hpp__
 #define __functors_hpp__
 
+#include <list>
 #include <map>
 #include <set>
 #include <vector>
@@ -49,6 +50,7 @@
 #include "gambit/Utils/util_functions.hpp"
 #include "gambit/Utils/yaml_options.hpp"
 #include "gambit/Utils/model_parameters.hpp"
+#include "gambit/Elements/backend_call_cache.hpp"
 #include "gambit/Logs/logger.hpp"
 #include "gambit/Logs/logmaster.hpp" // Need full declaration of LogMaster class
 
@@ -146,6 +148,8 @@ namespace Gambit
       str version() const;
       /// Getter for the 'safe' incarnation of the version of the wrapped function's origin (module or backend)
       virtual str safe_version() const;
+      /// Set the addresses of the wrapped function or variable in each loaded copy of its backend library
+      virtual void setBackendInstances(const std::vector<void*>&, bool);
       /// Getter for the wrapped function current status:
       ///                    -4 = required backend absent (backend ini functions)
       ///                    -3 = required classes absent
@@ -188,6 +192,11 @@ namespace Gambit
       /// Getter for revealing whether this is permitted to be a manager functor
       virtual bool canBeLoopManager();
 
+      /// Setter for declaring that the wrapped function may run concurrently with other functions
+      virtual void setThreadSafe(bool);
+      /// Getter for revealing whether the wrapped function may run concurrently with other functions
+      virtual bool isThreadSafe();
+
       /// Getter for revealing the required capability of the wrapped function's loop manager
       virtual str loopManagerCapability();
       /// Getter for revealing the name of the wrapped function's assigned loop manager
@@ -422,6 +431,11 @@ namespace Gambit
       /// Getter for revealing whether this is permitted to be a manager functor
       virtual bool canBeLoopManager();
 
+      /// Setter for declaring that the wrapped function may run concurrently with other functions
+      virtual void setThreadSafe(bool);
+      /// Getter for revealing whether the wrapped function may run concurrently with other functions
+      virtual bool isThreadSafe();
+
       /// Setter for specifying the capability required of a manager functor, if it is to run this functor nested in a loop.
       virtual void setLoopManagerCapability (str cap);
       /// Getter for revealing the required capability of the wrapped function's loop manager
@@ -531,20 +545,60 @@ namespace Gambit
       /// Retrieve the previously saved exception generated when this functor invalidated the current point in model space.
       virtual invalid_point_exception* retrieve_invalid_point_exception();
 
+      /// Can results of this functor be cached across parameter points?
+      virtual bool supportsPointCache() const;
+
+      /// Cache up to capacity results across parameter points, keyed on the values of the given model parameters.
+      void setPointCache(std::size_t capacity, const std::vector<const ModelParameters*>& sources);
+
+      /// Getter for the number of results cached across parameter points (0 if the point cache is disabled)
+      std::size_t pointCacheCapacity() const;
+
+      /// Getter for the label used when printing whether the result of this functor was taken from the point cache
+      str pointCacheLabel() const;
+
+      /// Setter for the printer ID used when printing whether the result of this functor was taken from the point cache
+      void setPointCacheVertexID(int);
+
 
     protected:
 
       /// Reset functor for one thread only
       void reset(int);
 
+      /// Fill point_cache_key with the values of the model parameters the result of this functor depends on.
+      void makePointCacheKey();
+
+      /// Maximum number of results cached across parameter points (0 = point cache disabled)
+      std::size_t point_cache_capacity;
+
+      /// Model parameters whose values determine the result of this functor
+      std::vector<const ModelParameters*> point_cache_sources;
+
+      /// Values of point_cache_sources at the current point
+      std::vector<double> point_cache_key;
+
+      /// Was the result at the current point taken from the point cache?
+      bool point_cache_hit;
+
+      /// Has the point cache hit flag already been sent to the printer?
+      bool already_printed_point_cache;
+
+      /// Numbers of point cache hits and misses so far
+      long long point_cache_hits, point_cache_misses;
+
+      /// Printer ID for the point cache hit flag
+      int myPointCacheVertexID;
+
       /// Acknowledge that this functor invalidated the current point in model space.
       virtual void acknowledgeInvalidation(invalid_point_exception&, functor* f = NULL);
 
       /// Do pre-calculate timing things
       virtual void startTiming(int);
 
-      /// Do post-calculate timing things
-      virtual void finishTiming(int);
+      /// Do post-calculate timing things; update_statistics = false leaves the runtime average and
+      /// invalidation rate untouched (e.g. when the result was taken from the point cache)
+      virtual void finishTiming(int, bool update_statistics = true);
 
       /// Flag to select whether or not the timing data for this function's execution should be printed;
       bool myTimingPrintFlag;
@@ -588,6 +642,9 @@ namespace Gambit
       /// Flag indicating whether this function is ready to finish its loop (only relevant if iCanManageLoops = true)
       bool myLoopIsDone;
 
+      /// Flag indicating whether this function may run concurrently with other functions (declared with THREAD_SAFE)
+      bool iAmThreadSafe;
+
       /// Flag indicating whether this function can run nested in a loop over functions
       bool iRunNested;
 
@@ -729,6 +786,9 @@ namespace Gambit
         virtual void print(Printers::BasePrinter* printer, const int pointID);
       #endif
 
+      /// Can results of this functor be cached across parameter points?
+      virtual bool supportsPointCache() const;
+
 
     protected:
 
@@ -741,9 +801,21 @@ namespace Gambit
       /// Flag to select whether or not the results of this functor should be sent to the printer object.
       bool myPrintFlag;
 
+      /// Results cached across parameter points, most recently used first
+      std::list<std::pair<std::vector<double>, TYPE> > point_cache;
+
+      /// Index of the point cache by model parameter values
+      std::map<std::vector<double>, typename std::list<std::pair<std::vector<double>, TYPE> >::iterator> point_cache_index;
+
       /// Initialise the memory of this functor.
       virtual void init_memory();
 
+      /// Retrieve the result for the current point from the point cache, if it is there.
+      bool point_cache_fetch();
+
+      /// Store the result for the current point in the point cache.
+      void point_cache_store();
+
   };
 
 
@@ -806,6 +878,21 @@ namespace Gambit
       /// Flag indicating if this backend functor is actually in use in a given scan
       bool inUse;
 
+      /// Cache of the results of calls to the wrapped function (NULL unless memoisation is switched on)
+      BackendCallCache* myCallCache;
+
+      /// The wrapped function in each loaded copy of the backend library, indexed by thread (empty if there is only one copy)
+      std::vector<funcPtrType> myInstanceFunctions;
+
+      /// The address of the wrapped variable in each loaded copy of the backend library, indexed by thread
+      std::vector<void*> myInstanceVariables;
+
+      /// Index of the copy of the backend library to be used by the calling thread
+      std::size_t instanceIndex(std::size_t) const;
+
+      /// The wrapped function in the copy of the backend library to be used by the calling thread
+      funcPtrType threadFunction() const;
+
     public:
 
       /// Constructor
@@ -823,6 +910,16 @@ namespace Gambit
       /// Hand out a safe pointer to this backend functor's inUse flag.
       safe_ptr<bool> inUsePtr();
 
+      /// Memoise up to capacity results of the wrapped function.
+      void setMemoisation(std::size_t capacity);
+
+      /// Set the addresses of the wrapped function or variable in each loaded copy of the backend library
+      virtual void setBackendInstances(const std::vector<void*>&, bool);
+
+      /// Address of the wrapped variable in the copy of the backend library to be used by the calling thread
+      /// (NULL if there is only one copy).
+      void* threadVariable() const;
+
       /// Getter for the 'safe' incarnation of the version of the wrapped function's origin (module or backend)
       virtual str safe_version() const;
 
@@ -848,6 +945,13 @@ namespace Gambit
       /// Operation (execute function and return value)
       TYPE operator()(ARGS&&... args);
 
+    private:
+
+      /// Execute the function via the cache of results
+      TYPE memoised_call(std::true_type, ARGS&&... args);
+      /// Dummy for functions that cannot be memoised (never called)
+      TYPE memoised_call(std::false_type, ARGS&&... args);
+
   };
 
 
@@ -888,7 +992,7 @@ namespace Gambit
       TYPE operator()(VARARGS&&... varargs)
       {
         logger().entering_backend(this->myLogTag);
-        TYPE tmp = this->myFunction(std::forward<VARARGS>(varargs)...);
+        TYPE tmp = this->threadFunction()(std::forward<VARARGS>(varargs)...);
         logger().leaving_backend();
         return tmp;
       }
@@ -914,7 +1018,7 @@ namespace Gambit
       void operator()(VARARGS&&... varargs)
       {
         logger().entering_backend(this->myLogTag);
-        this->myFunction(std::forward<VARARGS>(varargs)...);
+        this->threadFunction()(std::forward<VARARGS>(varargs)...);
         logger().leaving_backend();
       }
 
@@ -66,6 +66,9 @@ namespace Gambit
   /// Register a function with a module.
   int register_function(module_functor_common&, bool, safe_ptr<bool>*, std::map<str,str>&, std::map<str, bool(*)()>&, bool(&)(), safe_ptr<Options>&);
 
+  /// Declare that a module function may run concurrently with other module functions.
+  int set_thread_safe(module_functor_common&);
+
   namespace slhahelp
   {
 
@@ -114,6 +114,12 @@
 /// provide capability \em LOOPMAN.
 #define NEEDS_MANAGER_WITH_CAPABILITY(LOOPMAN)            CORE_NEEDS_MANAGER_WITH_CAPABILITY(LOOPMAN)
 
+/// Indicates that the current \link FUNCTION() FUNCTION\endlink of the current
+/// \link MODULE() MODULE\endlink may be evaluated by a worker thread, concurrently
+/// with other module functions, when dependency_resolution:parallel_branches is set.
+/// Functions without this declaration always run on the main thread.
+#define THREAD_SAFE                                       CORE_THREAD_SAFE(MODULE, FUNCTION)
+
 /// Indicate that the current \link FUNCTION() FUNCTION\endlink depends on the
 /// presence of another module function that can supply capability \em DEP, with
 /// return type \em TYPE.
@@ -680,6 +686,28 @@
   }                                                                            \
 
 
+/// Main redirection of THREAD_SAFE when invoked from within the core.
+#define CORE_THREAD_SAFE(MODULE, FUNCTION)                                     \
+                                                                               \
+  IF_TOKEN_UNDEFINED(MODULE,FAIL("You must define MODULE before calling "      \
+   "THREAD_SAFE."))                                                            \
+  IF_TOKEN_UNDEFINED(FUNCTION,FAIL("You must define FUNCTION before calling "  \
+   "THREAD_SAFE. Please check the rollcall header for "                        \
+   STRINGIFY(MODULE) "."))                                                     \
+                                                                               \
+  namespace Gambit                                                             \
+  {                                                                            \
+    namespace MODULE                                                           \
+    {                                                                          \
+      namespace Ini                                                            \
+      {                                                                        \
+        const int CAT(FUNCTION,_thread_safe) =                                 \
+         set_thread_safe(Functown::FUNCTION);                                  \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+
+
 /// First common component of CORE_DEPENDENCY(DEP, TYPE, MODULE, FUNCTION) and
 /// CORE_START_CONDITIONAL_DEPENDENCY(TYPE).
 #define DEPENDENCY_COMMON_1(DEP, TYPE, MODULE, FUNCTION)                       \
@@ -30,6 +30,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -58,9 +62,13 @@ namespace Gambit
       /// Add a disclaimer about the absence of a MODSEL block in a generated SLHAea object
       void add_MODSEL_disclaimer(SLHAstruct& slha, const str& object);
 
-      /// Simple helper function for adding missing SLHA1 2x2 family mixing matrices to an SLHAea object.
+      /// Simple helper functions for adding missing SLHA1 2x2 family mixing matrices to an SLHAea or SLHAview object.
+      /// @{
       void attempt_to_add_SLHA1_mixing(const str& block, SLHAstruct& slha, const str& type,
                                        const SubSpectrum& spec, double tol, str& s1, str& s2, bool pterror);
+      void attempt_to_add_SLHA1_mixing(const str& block, SLHAview& slha, const str& type,
+                                       const SubSpectrum& spec, double tol, str& s1, str& s2, bool pterror);
+      /// @}
 
       /// ***************** Gauge <-> Mass Eigenstate Helpers ****************
       /// @{
@@ -185,6 +193,9 @@ namespace Gambit
       /// Add an entire MSSM spectrum to an SLHAea object
       void add_MSSM_spectrum_to_SLHAea(const SubSpectrum& mssmspec, SLHAstruct& slha, int slha_version);
 
+      /// Add an entire MSSM spectrum to an SLHAview object, straight from the SubSpectrum getters
+      void add_MSSM_spectrum_to_SLHAview(const SubSpectrum& mssmspec, SLHAview& slha, int slha_version);
+
    }  // namespace slhahelp
 
 
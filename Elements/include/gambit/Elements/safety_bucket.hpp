@@ -238,29 +238,41 @@ namespace Gambit
       TYPE& operator *()
       {
         if (not _initialized) dieGracefully();
-        return *_svptr;
+        TYPE* instance = threadInstance();
+        return instance == NULL ? *_svptr : *instance;
       }
 
       /// Access member functions
       TYPE* operator->()
       {
-        return _svptr.operator->();
+        TYPE* instance = threadInstance();
+        return instance == NULL ? _svptr.operator->() : instance;
       }
 
       /// Get the underlying variable pointer.
       TYPE * pointer()
       {
         if (not _initialized) dieGracefully();
-        return _svptr.get();
+        TYPE* instance = threadInstance();
+        return instance == NULL ? _svptr.get() : instance;
       }
 
       /// Get the safe_variable_ptr.
+      /// @note Always refers to the variable in the first copy of the backend, even if several copies are loaded.
       safe_variable_ptr<TYPE>& safe_pointer()
       {
         if (not _initialized) dieGracefully();
         return _svptr;
       }
 
+    private:
+
+      /// The variable in the copy of the backend used by the calling thread, if several copies are loaded (NULL otherwise).
+      TYPE* threadInstance()
+      {
+        return _functor_ptr == NULL ? NULL : static_cast<TYPE*>(_functor_ptr->threadVariable());
+      }
+
   };
 
 
@@ -0,0 +1,188 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Typed view of the numerical contents of an
+///  SLHA file, for passing SLHA information
+///  between modules without repeated string
+///  lookups and conversions.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __slha_view_hpp__
+#define __slha_view_hpp__
+
+#include <vector>
+
+#include "gambit/Utils/util_types.hpp"
+#include "gambit/Elements/slhaea_helpers.hpp"
+
+namespace Gambit
+{
+
+  /// @brief The numerical contents of an SLHA file, held in flat arrays of doubles.
+  ///
+  /// Each data line of each block is stored as a row of numbers: all but the last are the indices of the
+  /// entry, and the last is its value.  Lines containing any non-numeric field (e.g. the strings in SPINFO)
+  /// are not included.  Block names are case-insensitive, as in SLHAea.  A view can be parsed from an SLHAea
+  /// object, or filled directly with the SLHAea_add* overloads below (see Spectrum::getSLHAview).
+  class SLHAview
+  {
+
+    public:
+
+      /// A single block
+      class Block
+      {
+
+        public:
+
+          /// Constructor
+          Block(const str& name, double scale) : block_name(name), block_scale(scale), row_start(1, 0) {}
+
+          /// Name of the block (in upper case)
+          const str& name() const { return block_name; }
+
+          /// Renormalisation scale given by "Q=" in the block definition
+          /// @{
+          bool has_scale() const { return block_scale >= 0; }
+          double scale() const { return block_scale; }
+          /// @}
+
+          /// Append a row (indices followed by the value)
+          void add(const std::vector<double>&);
+
+          /// Overwrite the first row with the same indices as the given row, or append the row if there is none
+          void set(const std::vector<double>&);
+
+          /// Set entries with zero, one or two indices, overwriting the first existing entry
+          /// @{
+          void set(double value) { set_value(0, 0, 0, value); }
+          void set(int i, double value) { set_value(1, i, 0, value); }
+          void set(int i, int j, double value) { set_value(2, i, j, value); }
+          /// @}
+
+          /// Check for and retrieve entries with zero, one or two indices.  If an entry appears more than once,
+          /// the first one is used, as for lookups in SLHAea.  The getters raise an error if there is no entry.
+          /// @{
+          bool has() const { return find(0, 0, 0) != nrows(); }
+          bool has(int i) const { return find(1, i, 0) != nrows(); }
+          bool has(int i, int j) const { return find(2, i, j) != nrows(); }
+          double get() const { return value(find(0, 0, 0)); }
+          double get(int i) const { return value(find(1, i, 0)); }
+          double get(int i, int j) const { return value(find(2, i, j)); }
+          /// @}
+
+          /// Number of rows
+          size_t nrows() const { return row_start.size() - 1; }
+
+          /// Row access
+          /// @{
+          size_t row_size(size_t r) const { return row_start[r+1] - row_start[r]; }
+          const double* row(size_t r) const { return fields.data() + row_start[r]; }
+          /// @}
+
+        private:
+
+          /// Index of the first row with n indices matching i and j, or nrows() if there is none
+          size_t find(size_t n, int i, int j) const;
+
+          /// Value of a row found by find(), raising an error if no row was found
+          double value(size_t r) const;
+
+          /// Set an entry with n indices i and j
+          void set_value(size_t n, int i, int j, double value);
+
+          str block_name;
+          double block_scale;
+          /// The numbers in all rows, concatenated
+          std::vector<double> fields;
+          /// Row r is fields[row_start[r]] to fields[row_start[r+1]-1]
+          std::vector<size_t> row_start;
+
+      };
+
+      /// Constructors
+      /// @{
+      SLHAview() {}
+      SLHAview(const SLHAstruct&);
+      /// @}
+
+      /// Add the numerical contents of an SLHAea object.  Entries in blocks that already exist are overwritten.
+      void add(const SLHAstruct&);
+
+      /// Find a block, returning a null pointer if it is absent
+      /// @{
+      const Block* find(const str&) const;
+      Block* find(const str&);
+      /// @}
+
+      /// Check if a block exists
+      bool has_block(const str& name) const { return find(name) != NULL; }
+
+      /// Retrieve a block, raising an error if it is absent
+      const Block& at(const str&) const;
+
+      /// Add a new block with an optional scale, returning it for filling
+      Block& add_block(const str& name, double scale = -1);
+
+      /// Delete a block, if it exists
+      void erase(const str& name);
+
+      /// All blocks, in the order of the original SLHAea object
+      const std::vector<Block>& blocks() const { return contents; }
+
+      /// Convert to an SLHAea object (numerical contents only), e.g. for writing a file
+      SLHAstruct getSLHAea() const;
+
+    private:
+
+      std::vector<Block> contents;
+
+  };
+
+  /// @name Overloads of the SLHAea helpers (slhaea_helpers.hpp) for SLHAview, so that the same code can write
+  /// either.  Comments and string entries are dropped, as SLHAview holds only numbers.
+  /// @{
+  void SLHAea_add_block(SLHAview&, const str& name, const double scale = -1);
+  void SLHAea_delete_block(SLHAview&, const str& block);
+  bool SLHAea_block_exists(SLHAview&, const str& block);
+  bool SLHAea_check_block(SLHAview&, const str& block);
+  void SLHAea_add(SLHAview&, const str& block, const int index, const double value,
+   const str& comment="", const bool overwrite=false);
+  void SLHAea_add(SLHAview&, const str& block, const int index, const int value,
+   const str& comment="", const bool overwrite=false);
+  void SLHAea_add(SLHAview&, const str& block, const int index1, const int index2,
+   const double& value, const str& comment, const bool overwrite=false);
+  void SLHAea_add_from_subspec(SLHAview&, const str local_info, const SubSpectrum& subspec,
+   const Par::Tags partype, const std::pair<int, int>& pdg_pair, const str& block, const str& comment,
+   const bool error_if_missing = true, const double rescale = 1.0);
+  void SLHAea_add_from_subspec(SLHAview&, const str local_info, const SubSpectrum& subspec,
+   const Par::Tags partype, const str& name, const str& block, const int slha_index,
+   const str& comment, const bool error_if_missing = true, const double rescale = 1.0);
+  void SLHAea_add_from_subspec(SLHAview&, const str local_info, const SubSpectrum& subspec,
+   const Par::Tags partype, const str& name, const int index1, const int index2, const str& block,
+   const int slha_index1, const int slha_index2, const str& comment, const bool error_if_missing = true, const double rescale = 1.0);
+
+  template<typename T>
+  void SLHAea_add_matrix(SLHAview& slha, const str& block, const std::vector<T>& matrix,
+                 const int rows, const int cols, const str& /*comment*/="", const bool overwrite=false)
+  {
+    SLHAea_check_block(slha, block);
+    SLHAview::Block& b = *slha.find(block);
+    if (b.nrows() > 0 and not overwrite) return;
+    for (int i = 0; i < rows; i++) for (int j = 0; j < cols; j++) b.set(i+1, j+1, matrix.at(i*rows + j));
+  }
+  /// @}
+
+}
+
+#endif //#defined __slha_view_hpp__
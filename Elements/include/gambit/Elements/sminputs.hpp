@@ -14,12 +14,17 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///  \date 2015 Mar
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __SMInputs_hpp__
 #define __SMInputs_hpp__
 
 #include "gambit/Elements/slhaea_helpers.hpp"
+#include "gambit/Elements/slha_view.hpp"
 #include "gambit/Utils/numerical_constants.hpp"
 
 namespace Gambit
@@ -101,6 +106,15 @@ namespace Gambit
       // Add the contents of this object to an existing SLHAea object
       void add_to_SLHAea(SLHAstruct& slha /*modify*/) const;
 
+      // Add the contents of this object to an existing SLHAview object
+      void add_to_SLHAview(SLHAview& slha /*modify*/) const;
+
+   private:
+
+      // Add the contents of this object to an SLHAea or SLHAview object
+      template <class SLHA>
+      void add_to(SLHA& data /*modify*/) const;
+
    };
 
 } // end namespace Gambit
@@ -32,6 +32,10 @@
 ///          (a.m.b.krislock@fys.uio.no)
 ///  \date 2016 Feb
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __Spectrum_hpp__
@@ -44,6 +48,7 @@
 #include "gambit/Elements/sminputs.hpp"
 #include "gambit/Elements/subspectrum.hpp"
 #include "gambit/Elements/slhaea_helpers.hpp"
+#include "gambit/Elements/slha_view.hpp"
 #include "gambit/Models/partmap.hpp"
 
 
@@ -230,6 +235,10 @@ namespace Gambit
          /// over SMINPUTS.
          SLHAstruct getSLHAea(int) const;
 
+         /// SLHAview getter.  Holds the numerical contents of getSLHAea, filled in the same order straight
+         /// from the getters of SMINPUTS and the subspectra, for consumers that read many entries.
+         SLHAview getSLHAview(int) const;
+
          /// Output spectrum contents as an SLHA file, using getSLHAea.
          void writeSLHAfile(int, const str&) const;
 
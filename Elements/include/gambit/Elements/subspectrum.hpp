@@ -21,6 +21,10 @@
 ///          (a.m.b.krislock@fys.uio.no)
 ///  \date 2016 Feb
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __subspectrum_hpp__
@@ -36,6 +40,7 @@
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Utils/util_functions.hpp"
 #include "gambit/Elements/slhaea_helpers.hpp"
+#include "gambit/Elements/slha_view.hpp"
 #include "gambit/Elements/spectrum_helpers.hpp"
 #include "gambit/Models/partmap.hpp"
 
@@ -110,6 +115,10 @@ namespace Gambit
          /// Add spectrum information to an SLHAea object (if possible)
          virtual void add_to_SLHAea(int, SLHAstruct&) const {}
 
+         /// Add spectrum information to an SLHAview object (if possible).  By default this goes through
+         /// add_to_SLHAea; override it to fill the view straight from the getters.
+         virtual void add_to_SLHAview(int, SLHAview&) const;
+
          /// There may be more than one *new* stable particle
          ///  this method will tell you how many.
          /// If more than zero you probbaly *need* to know what model
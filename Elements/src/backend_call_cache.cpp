@@ -0,0 +1,239 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Memoisation of the results of backend
+///  function calls.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "gambit/Elements/backend_call_cache.hpp"
+#include "gambit/Utils/file_lock.hpp"
+#include "gambit/Utils/util_functions.hpp"
+#include "gambit/cmake/cmake_variables.hpp"
+
+namespace Gambit
+{
+
+  namespace
+  {
+
+    /// Settings of the persistent store, shared by all caches
+    struct persistence_settings
+    {
+      bool enabled;
+      std::size_t max_file_size;
+      persistence_settings() : enabled(false), max_file_size(0) {}
+    };
+
+    persistence_settings& persistence()
+    {
+      static persistence_settings settings;
+      return settings;
+    }
+
+    /// Size of a record in the persistent store: key length, key, value length, value
+    std::size_t record_size(const str& key, const str& value)
+    {
+      return 2*sizeof(std::uint32_t) + key.size() + value.size();
+    }
+
+    /// Write a record to the persistent store
+    void write_record(std::ofstream& out, const str& key, const str& value)
+    {
+      const std::uint32_t key_size = key.size(), value_size = value.size();
+      out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+      out.write(key.data(), key_size);
+      out.write(reinterpret_cast<const char*>(&value_size), sizeof(value_size));
+      out.write(value.data(), value_size);
+    }
+
+  }
+
+  /// Constructor
+  BackendCallCache::BackendCallCache(const str& name, std::size_t capacity)
+   : myName(name)
+   , myCapacity(capacity)
+   , loaded(false)
+   , nHits(0)
+   , nMisses(0)
+  {}
+
+  /// Copy the cached result for the given key into result, if there is one.
+  bool BackendCallCache::fetch(const str& key, void* result, std::size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Caches are created during static initialisation, so the persistent store is only read on first use.
+    if (not loaded) load();
+    auto it = index.find(key);
+    if (it == index.end() or it->second->second.size() != size)
+    {
+      nMisses++;
+      return false;
+    }
+    // Move the entry to the front of the list, i.e. mark it as most recently used.
+    entries.splice(entries.begin(), entries, it->second);
+    std::memcpy(result, it->second->second.data(), size);
+    nHits++;
+    return true;
+  }
+
+  /// Store the result for the given key.
+  void BackendCallCache::store(const str& key, const void* result, std::size_t size)
+  {
+    const str value(static_cast<const char*>(result), size);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not loaded) load();
+    insert(key, value);
+    if (not myFilename.empty()) save(key, value);
+  }
+
+  /// Append an entry to the persistent store, rewriting it if it would grow too large
+  void BackendCallCache::save(const str& key, const str& value)
+  {
+    Utils::FileLock flock("backend_cache_" + myName);
+    flock.get_lock();
+    std::ifstream in(myFilename, std::ios::binary | std::ios::ate);
+    const std::size_t file_size = (in ? std::size_t(in.tellg()) : 0);
+    in.close();
+    if (file_size + record_size(key, value) <= persistence().max_file_size)
+    {
+      std::ofstream out(myFilename, std::ios::binary | std::ios::app);
+      write_record(out, key, value);
+    }
+    else
+    {
+      rewrite();
+    }
+    flock.release_lock();
+  }
+
+  /// Rewrite the persistent store with the most recently used entries held in memory that fit within the size limit,
+  /// oldest first so that they are read back in the same order.  Must be called with the file lock held.
+  void BackendCallCache::rewrite()
+  {
+    std::size_t total = 0;
+    auto first = entries.begin();
+    while (first != entries.end() and total + record_size(first->first, first->second) <= persistence().max_file_size)
+    {
+      total += record_size(first->first, first->second);
+      ++first;
+    }
+    std::ofstream out(myFilename, std::ios::binary | std::ios::trunc);
+    for (std::list<std::pair<str,str> >::reverse_iterator it(first); it != entries.rend(); ++it) write_record(out, it->first, it->second);
+  }
+
+  /// Insert an entry without touching the file
+  void BackendCallCache::insert(const str& key, const str& value)
+  {
+    if (myCapacity == 0) return;
+    auto it = index.find(key);
+    if (it != index.end())
+    {
+      it->second->second = value;
+      entries.splice(entries.begin(), entries, it->second);
+      return;
+    }
+    if (entries.size() < myCapacity)
+    {
+      entries.emplace_front();
+    }
+    else
+    {
+      // Recycle the least recently used entry.
+      index.erase(entries.back().first);
+      entries.splice(entries.begin(), entries, std::prev(entries.end()));
+    }
+    entries.front().first = key;
+    entries.front().second = value;
+    index[key] = entries.begin();
+  }
+
+  /// Load the persistent store, if it is switched on.  Later entries in the file take precedence, and only the last
+  /// myCapacity are kept.
+  void BackendCallCache::load()
+  {
+    loaded = true;
+    if (not persistence().enabled) return;
+    myFilename = GAMBIT_DIR "/scratch/backend_cache/" + myName + ".dat";
+    Utils::ensure_path_exists(myFilename);
+    Utils::FileLock flock("backend_cache_" + myName);
+    flock.get_lock();
+    std::ifstream in(myFilename, std::ios::binary | std::ios::ate);
+    const std::size_t file_size = (in ? std::size_t(in.tellg()) : 0);
+    in.seekg(0);
+    std::size_t complete = 0;
+    std::uint32_t key_size, value_size;
+    str key, value;
+    while (complete < file_size and in.read(reinterpret_cast<char*>(&key_size), sizeof(key_size)))
+    {
+      // Check the sizes against what is left of the file before reading, so that a damaged record cannot make us
+      // allocate an absurd amount of memory.
+      if (key_size > file_size - complete - 2*sizeof(std::uint32_t)) break;
+      key.resize(key_size);
+      if (not in.read(&key[0], key_size)) break;
+      if (not in.read(reinterpret_cast<char*>(&value_size), sizeof(value_size))) break;
+      if (value_size > file_size - complete - record_size(key, "")) break;
+      value.resize(value_size);
+      if (not in.read(&value[0], value_size)) break;
+      insert(key, value);
+      complete += record_size(key, value);
+    }
+    in.close();
+    // A record cut short (e.g. by a crash while it was being written) would garble every record appended after it,
+    // so drop it now by rewriting the file with the complete records.
+    if (complete < file_size) rewrite();
+    flock.release_lock();
+  }
+
+  /// All caches created so far
+  std::vector<std::unique_ptr<BackendCallCache> >& BackendCallCache::all()
+  {
+    static std::vector<std::unique_ptr<BackendCallCache> > caches;
+    return caches;
+  }
+
+  /// Create a cache and register it for reporting.
+  BackendCallCache* BackendCallCache::create(const str& name, std::size_t capacity)
+  {
+    all().emplace_back(new BackendCallCache(name, capacity));
+    return all().back().get();
+  }
+
+  /// Switch the persistent store of all caches on or off, and set the maximum size of each cache's file.
+  void BackendCallCache::set_persistence(bool enabled, std::size_t max_file_size)
+  {
+    persistence().enabled = enabled;
+    persistence().max_file_size = max_file_size;
+  }
+
+  /// Summary of the hit rates of all backend call caches.
+  str BackendCallCache::report()
+  {
+    std::ostringstream ss;
+    for (const auto& cache : all())
+    {
+      const long long calls = cache->hits() + cache->misses();
+      if (calls == 0) continue;
+      if (ss.tellp() == 0) ss << "Backend call caches (hits / calls):";
+      ss << std::endl << "  " << cache->name() << ": " << cache->hits() << " / " << calls << " ("
+         << std::fixed << std::setprecision(1) << 100.0 * cache->hits() / calls << "%)";
+    }
+    return ss.str();
+  }
+
+}
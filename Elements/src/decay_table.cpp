@@ -12,8 +12,13 @@
 ///          (patscott@physics.mcgill.ca)
 ///  \date 2015 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
+#include <algorithm>
 #include <fstream>
 
 #include "gambit/Elements/decay_table.hpp"
@@ -285,7 +290,7 @@ namespace Gambit
   }
 
   /// Make sure all particles listed in a set are actually known to the GAMBIT particle database
-  void DecayTable::Entry::check_particles_exist(std::multiset< std::pair<int,int> >& particles) const
+  void DecayTable::Entry::check_particles_exist(const decay_channel& particles) const
   {
     for (auto final_state = particles.begin(); final_state != particles.end(); ++final_state)
     {
@@ -301,7 +306,7 @@ namespace Gambit
   }
 
   /// Make sure no NaNs have been passed to the DecayTable by nefarious backends
-  void DecayTable::Entry::check_BF_validity(double BF, double error, std::multiset< std::pair<int,int> >& key) const
+  void DecayTable::Entry::check_BF_validity(double BF, double error, const decay_channel& key) const
   {
     if (Utils::isnan(BF) or Utils::isnan(error))
     {
@@ -322,7 +327,7 @@ namespace Gambit
   /// Set branching fraction for decay to a given final state. 1. PDG-context integer pairs (vector)
   void DecayTable::Entry::set_BF(double BF, double error, const std::vector<std::pair<int,int> >& daughters)
   {
-    std::multiset< std::pair<int,int> > key(daughters.begin(), daughters.end());
+    decay_channel key(daughters.begin(), daughters.end());
     check_particles_exist(key);
     check_BF_validity(BF, error, key);
     channels[key] = std::pair<double, double>(BF, error);
@@ -331,7 +336,7 @@ namespace Gambit
   /// Set branching fraction for decay to a given final state. 2. full particle names (vector)
   void DecayTable::Entry::set_BF(double BF, double error, const std::vector<str>& daughters)
   {
-    std::multiset< std::pair<int,int> > key;
+    decay_channel key;
     for (auto p = daughters.begin(); p != daughters.end(); ++p) key.insert(Models::ParticleDB().pdg_pair(*p));
     check_particles_exist(key);
     check_BF_validity(BF, error, key);
@@ -341,7 +346,7 @@ namespace Gambit
   /// Check if a given final state exists in this DecayTable::Entry. 1. PDG-context integer pairs (vector)
   bool DecayTable::Entry::has_channel(const std::vector<std::pair<int,int> >& daughters) const
   {
-    std::multiset< std::pair<int,int> > key(daughters.begin(), daughters.end());
+    decay_channel key(daughters.begin(), daughters.end());
     check_particles_exist(key);
     return channels.find(key) != channels.end();
   }
@@ -349,7 +354,7 @@ namespace Gambit
   /// Check if a given final state exists in this DecayTable::Entry. 2. full particle names (vector)
   bool DecayTable::Entry::has_channel(const std::vector<str>& daughters) const
   {
-    std::multiset< std::pair<int,int> > key;
+    decay_channel key;
     for (auto p = daughters.begin(); p != daughters.end(); ++p) key.insert(Models::ParticleDB().pdg_pair(*p));
     check_particles_exist(key);
     return channels.find(key) != channels.end();
@@ -358,7 +363,7 @@ namespace Gambit
   /// Retrieve branching fraction for decay to a given final state. 1. PDG-context integer pairs (vector)
   double DecayTable::Entry::BF(const std::vector<std::pair<int, int> >& daughters) const
   {
-    std::multiset< std::pair<int,int> > key(daughters.begin(), daughters.end());
+    decay_channel key(daughters.begin(), daughters.end());
     check_particles_exist(key);
     return channels.at(key).first;
   }
@@ -366,7 +371,7 @@ namespace Gambit
   /// Retrieve branching fraction for decay to a given final state. 2. full particle names (vector)
   double DecayTable::Entry::BF(const std::vector<str>& daughters) const
   {
-    std::multiset< std::pair<int,int> > key;
+    decay_channel key;
     for (auto p = daughters.begin(); p != daughters.end(); ++p) key.insert(Models::ParticleDB().pdg_pair(*p));
     check_particles_exist(key);
     return channels.at(key).first;
@@ -454,8 +459,15 @@ namespace Gambit
     block.insert(block.begin(),SLHAea::Line("#     PDG         Width (GeV)"));
     block.push_back("#          BF              NDA Daughter PDG codes");
 
+    // Write the channels in the order of their final states, independent of the order in which they were set
+    std::vector<const decay_channel_map::value_type*> sorted_channels;
+    sorted_channels.reserve(channels.size());
+    for (const auto& channel : channels) sorted_channels.push_back(&channel);
+    std::sort(sorted_channels.begin(), sorted_channels.end(),
+     [](const decay_channel_map::value_type* a, const decay_channel_map::value_type* b) { return a->first < b->first; });
+
     // Add the branching fraction and daughter particle PDG codes for each decay channel
-    for (auto channel = channels.begin(); channel != channels.end(); ++channel)
+    for (const decay_channel_map::value_type* channel : sorted_channels)
     {
       // Skip this channel if its BF is NaN (undefined) or zero (on request)
       double BF = (channel->second).first;
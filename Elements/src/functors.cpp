@@ -123,6 +123,11 @@ namespace Gambit
     str functor::version()     const { return myVersion; }
     /// Getter for the 'safe' incarnation of the version of the wrapped function's origin (module or backend)
     str functor::safe_version()const { utils_error().raise(LOCAL_INFO,"The safe_version method is only defined for backend functors."); return ""; }
+    /// Set the addresses of the wrapped function or variable in each loaded copy of its backend library
+    void functor::setBackendInstances(const std::vector<void*>&, bool)
+    {
+      utils_error().raise(LOCAL_INFO,"The setBackendInstances method is only defined for backend functors.");
+    }
     /// Getter for the wrapped function current status:
     ///                    -4 = required backend absent (backend ini functions)
     ///                    -3 = required classes absent
@@ -186,6 +191,19 @@ namespace Gambit
       return false;
     }
 
+    /// Setter for declaring that the wrapped function may run concurrently with other functions
+    void functor::setThreadSafe(bool)
+    {
+      utils_error().raise(LOCAL_INFO,"The setThreadSafe method has not been defined in this class.");
+    }
+
+    /// Getter for revealing whether the wrapped function may run concurrently with other functions
+    bool functor::isThreadSafe()
+    {
+      utils_error().raise(LOCAL_INFO,"The isThreadSafe method has not been defined in this class.");
+      return false;
+    }
+
     /// Getter for revealing the required capability of the wrapped function's loop manager
     str functor::loopManagerCapability()
     {
@@ -587,6 +605,12 @@ namespace Gambit
                                                  str origin_name,
                                                  Models::ModelFunctorClaw &claw)
     : functor                  (func_name, func_capability, result_type, origin_name, claw),
+      point_cache_capacity     (0),
+      point_cache_hit          (false),
+      already_printed_point_cache(false),
+      point_cache_hits         (0),
+      point_cache_misses       (0),
+      myPointCacheVertexID     (-1),       // Not actually a graph vertex; ID assigned by "get_param_id" function.
       myTimingPrintFlag        (false),
       start                    (NULL),
       end                      (NULL),
@@ -598,6 +622,7 @@ namespace Gambit
       already_printed          (NULL),
       already_printed_timing   (NULL),
       iCanManageLoops          (false),
+      iAmThreadSafe            (false),
       iRunNested               (false),
       myLoopManagerCapability  ("none"),
       myLoopManager            (NULL),
@@ -664,6 +689,8 @@ namespace Gambit
       std::fill(already_printed_timing, already_printed_timing+n, false);
       if (iCanManageLoops) resetLoop();
       point_exception_raised = false;
+      point_cache_hit = false;
+      already_printed_point_cache = false;
     }
 
     /// Reset functor for one thread only
@@ -676,6 +703,44 @@ namespace Gambit
       if (iCanManageLoops) resetLoop();
     }
 
+    /// Can results of this functor be cached across parameter points?
+    bool module_functor_common::supportsPointCache() const { return false; }
+
+    /// Cache up to capacity results across parameter points, keyed on the values of the given model parameters.
+    void module_functor_common::setPointCache(std::size_t capacity, const std::vector<const ModelParameters*>& sources)
+    {
+      if (capacity > 0 and not supportsPointCache())
+      {
+        utils_error().raise(LOCAL_INFO,"Results of "+myOrigin+"::"+myName+" cannot be cached across parameter points.");
+      }
+      if (capacity > 0 and (iRunNested or iCanManageLoops))
+      {
+        utils_error().raise(LOCAL_INFO,"Results of "+myOrigin+"::"+myName+" cannot be cached across parameter points, "
+                                       "as it manages or runs inside a loop.");
+      }
+      point_cache_capacity = capacity;
+      point_cache_sources = sources;
+    }
+
+    /// Getter for the number of results cached across parameter points (0 if the point cache is disabled)
+    std::size_t module_functor_common::pointCacheCapacity() const { return point_cache_capacity; }
+
+    /// Getter for the label used when printing whether the result of this functor was taken from the point cache
+    str module_functor_common::pointCacheLabel() const { return "Point cache hit for "+myLabel; }
+
+    /// Setter for the printer ID used when printing whether the result of this functor was taken from the point cache
+    void module_functor_common::setPointCacheVertexID(int ID) { myPointCacheVertexID = ID; }
+
+    /// Fill point_cache_key with the values of the model parameters the result of this functor depends on.
+    void module_functor_common::makePointCacheKey()
+    {
+      point_cache_key.clear();
+      for (auto it = point_cache_sources.begin(); it != point_cache_sources.end(); ++it)
+      {
+        for (auto jt = (*it)->begin(); jt != (*it)->end(); ++jt) point_cache_key.push_back(jt->second);
+      }
+    }
+
     /// Tell the functor that it invalidated the current point in model space, pass a message explaining why, and throw an exception.
     void module_functor_common::notifyOfInvalidation(const str& msg)
     {
@@ -845,6 +910,11 @@ namespace Gambit
     /// Getter for revealing whether this is permitted to be a manager functor
     bool module_functor_common::canBeLoopManager() { return iCanManageLoops; }
 
+    /// Setter for declaring that the wrapped function may run concurrently with other functions
+    void module_functor_common::setThreadSafe(bool safe) { iAmThreadSafe = safe; }
+    /// Getter for revealing whether the wrapped function may run concurrently with other functions
+    bool module_functor_common::isThreadSafe() { return iAmThreadSafe; }
+
     /// Setter for specifying the capability required of a manager functor, if it is to run this functor nested in a loop.
     void module_functor_common::setLoopManagerCapability (str cap) { iRunNested = true; myLoopManagerCapability = cap; }
     /// Getter for revealing the required capability of the wrapped function's loop manager
@@ -1555,14 +1625,17 @@ namespace Gambit
     }
 
     /// Do post-calculate timing things
-    void module_functor_common::finishTiming(int thread_num)
+    void module_functor_common::finishTiming(int thread_num, bool update_statistics)
     {
       end[thread_num] = std::chrono::system_clock::now();
       std::chrono::duration<double> runtime = end[thread_num] - start[thread_num];
-      #pragma omp critical(module_functor_common_finishTiming)
+      if (update_statistics)
       {
-        runtime_average = runtime_average*(1-fadeRate) + fadeRate*runtime.count();
-        pInvalidation = pInvalidation*(1-fadeRate) + fadeRate*FUNCTORS_BASE_INVALIDATION_RATE;
+        #pragma omp critical(module_functor_common_finishTiming)
+        {
+          runtime_average = runtime_average*(1-fadeRate) + fadeRate*runtime.count();
+          pInvalidation = pInvalidation*(1-fadeRate) + fadeRate*FUNCTORS_BASE_INVALIDATION_RATE;
+        }
       }
       needs_recalculating[thread_num] = false;
     }
@@ -153,6 +153,17 @@ namespace Gambit
     return 0;
   }
 
+  /// Declare that a module function may run concurrently with other module functions.
+  int set_thread_safe(module_functor_common& f)
+  {
+    try
+    {
+      f.setThreadSafe(true);
+    }
+    catch (std::exception& e) { ini_catch(e); }
+    return 0;
+  }
+
   namespace slhahelp
   {
 
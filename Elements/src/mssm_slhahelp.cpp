@@ -19,6 +19,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015 Jul
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Elements/mssm_slhahelp.hpp"
@@ -79,25 +83,45 @@ namespace Gambit
         slha.push_front("# This SLHA(ea) object was created from a GAMBIT "+object+" object.");
       }
 
-      /// Simple helper function for for adding missing SLHA1 2x2 family mixing matrices to an SLHAea object.
-      void attempt_to_add_SLHA1_mixing(const str& block, SLHAstruct& slha, const str& type,
-                                       const SubSpectrum& spec, double tol, str& s1, str& s2, bool pterror)
+      namespace
       {
-        if (slha.find(block) == slha.end())
-        {
-          std::vector<double> matmix = slhahelp::family_state_mix_matrix(type, 3, s1, s2, spec, tol, LOCAL_INFO, pterror);
-          SLHAea_add_matrix(slha, block, matmix, 2, 2);
-        }
-        else
+
+        /// Add a missing SLHA1 2x2 family mixing matrix to an SLHAea or SLHAview object
+        template <class SLHA>
+        void add_SLHA1_mixing(const str& block, SLHA& slha, const str& type,
+                              const SubSpectrum& spec, double tol, str& s1, str& s2, bool pterror)
         {
-          std::map<str,str> family_to_3gen; // TODO: make const or something
-          family_to_3gen["~u"] = "~t";
-          family_to_3gen["~d"] = "~b";
-          family_to_3gen["~e-"] = "~tau";
-          s1 = slhahelp::mass_es_closest_to_family(family_to_3gen.at(type)+"_1", spec, tol, LOCAL_INFO, pterror);
-          s2 = slhahelp::mass_es_closest_to_family(family_to_3gen.at(type)+"_2", spec, tol, LOCAL_INFO, pterror);
+          if (not SLHAea_block_exists(slha, block))
+          {
+            std::vector<double> matmix = slhahelp::family_state_mix_matrix(type, 3, s1, s2, spec, tol, LOCAL_INFO, pterror);
+            SLHAea_add_matrix(slha, block, matmix, 2, 2);
+          }
+          else
+          {
+            std::map<str,str> family_to_3gen; // TODO: make const or something
+            family_to_3gen["~u"] = "~t";
+            family_to_3gen["~d"] = "~b";
+            family_to_3gen["~e-"] = "~tau";
+            s1 = slhahelp::mass_es_closest_to_family(family_to_3gen.at(type)+"_1", spec, tol, LOCAL_INFO, pterror);
+            s2 = slhahelp::mass_es_closest_to_family(family_to_3gen.at(type)+"_2", spec, tol, LOCAL_INFO, pterror);
+          }
         }
+
+      }
+
+      /// Simple helper functions for adding missing SLHA1 2x2 family mixing matrices to an SLHAea or SLHAview object.
+      /// @{
+      void attempt_to_add_SLHA1_mixing(const str& block, SLHAstruct& slha, const str& type,
+                                       const SubSpectrum& spec, double tol, str& s1, str& s2, bool pterror)
+      {
+        add_SLHA1_mixing(block, slha, type, spec, tol, s1, s2, pterror);
+      }
+      void attempt_to_add_SLHA1_mixing(const str& block, SLHAview& slha, const str& type,
+                                       const SubSpectrum& spec, double tol, str& s1, str& s2, bool pterror)
+      {
+        add_SLHA1_mixing(block, slha, type, spec, tol, s1, s2, pterror);
       }
+      /// @}
 
       /// returns vector representing composition of requested gauge state
       /// in terms of the slha2 mass eigenstates (~u_1 ...~u_6 etc)
@@ -756,7 +780,16 @@ namespace Gambit
          return fs;
       }
 
-      /// Add an entire MSSM spectrum to an SLHAea object
+      namespace
+      {
+
+        /// Add the (unindexed) entry of the ALPHA block
+        /// @{
+        void add_ALPHA(SLHAstruct& slha, double alpha) { slha["ALPHA"][""] << alpha << "# sin^-1(SCALARMIX(2,2))"; }
+        void add_ALPHA(SLHAview& slha, double alpha) { slha.find("ALPHA")->set(alpha); }
+        /// @}
+
+      /// Add an entire MSSM spectrum to an SLHAea or SLHAview object
       // Here we assume that all SM input info comes from the SMINPUT object,
       // and all low-E stuff (quark pole masses and the like) come from the LE subspectrum.
       // In other words all those things should be added to the SLHAea object via
@@ -769,7 +802,11 @@ namespace Gambit
       //
       // slha_version - should be 1 or 2. Specifies whether to output closest-matching SLHA1 format
       // entries, or to maintain SLHA2 as is used internally.
-      void add_MSSM_spectrum_to_SLHAea(const SubSpectrum& mssmspec, SLHAstruct& slha, int slha_version)
+      //
+      // The same code fills either an SLHAea object or an SLHAview (through the SLHAview overloads of the
+      // SLHAea helpers), so that a view can be made straight from the SubSpectrum getters.
+      template <class SLHA>
+      void add_MSSM_spectrum(const SubSpectrum& mssmspec, SLHA& slha, int slha_version)
       {
          std::ostringstream comment;
 
@@ -952,11 +989,10 @@ namespace Gambit
 
          // ALPHA block
          // if this exists already, delete it entirely
-         auto it = slha.find("ALPHA");
-         if(it!=slha.end()) slha.erase(it); // TODO: format of this call is confusing, perhaps write a wrapper for it.
+         SLHAea_delete_block(slha, "ALPHA");
          // ...and now add it back
          SLHAea_add_block(slha, "ALPHA", mssmspec.GetScale());
-         slha["ALPHA"][""] << asin(mssmspec.get(Par::Pole_Mixing, "h0", 2, 2)) << "# sin^-1(SCALARMIX(2,2))";
+         add_ALPHA(slha, asin(mssmspec.get(Par::Pole_Mixing, "h0", 2, 2)));
 
          // UMIX and VMIX blocks, plus some FlexibleSUSY-only extensions: PSEUDOSCALARMIX, SCALARMIX and CHARGEMIX.
          sspair U[5] = {sspair("UMIX","~chi-"), sspair("VMIX","~chi+"), sspair("PSEUDOSCALARMIX","A0"), sspair("SCALARMIX","h0"), sspair("CHARGEMIX","H+")};
@@ -982,6 +1018,20 @@ namespace Gambit
          }
        }
 
+      }
+
+      /// Add an entire MSSM spectrum to an SLHAea object
+      void add_MSSM_spectrum_to_SLHAea(const SubSpectrum& mssmspec, SLHAstruct& slha, int slha_version)
+      {
+        add_MSSM_spectrum(mssmspec, slha, slha_version);
+      }
+
+      /// Add an entire MSSM spectrum to an SLHAview object
+      void add_MSSM_spectrum_to_SLHAview(const SubSpectrum& mssmspec, SLHAview& slha, int slha_version)
+      {
+        add_MSSM_spectrum(mssmspec, slha, slha_version);
+      }
+
    }  // namespace slhahelp
 
 
@@ -0,0 +1,334 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Typed view of the numerical contents of an
+///  SLHA file, for passing SLHA information
+///  between modules without repeated string
+///  lookups and conversions.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+#include "gambit/Utils/standalone_error_handlers.hpp"
+#include "gambit/Elements/slha_view.hpp"
+#include "gambit/Elements/subspectrum.hpp"
+
+namespace Gambit
+{
+
+  namespace
+  {
+
+    /// Upper-case copy of a string
+    str to_upper(const str& s)
+    {
+      str result(s);
+      for (char& c : result) c = std::toupper(static_cast<unsigned char>(c));
+      return result;
+    }
+
+    /// Case-insensitive comparison of a block name with an upper-case name
+    bool same_name(const str& upper, const str& name)
+    {
+      if (upper.size() != name.size()) return false;
+      for (size_t i = 0; i < name.size(); ++i) if (upper[i] != std::toupper(static_cast<unsigned char>(name[i]))) return false;
+      return true;
+    }
+
+    /// Convert a whole field to a double, returning false if it is not a number
+    bool to_double(const str& field, double& result)
+    {
+      if (field.empty()) return false;
+      char* end;
+      result = std::strtod(field.c_str(), &end);
+      return *end == '\0';
+    }
+
+    /// Convert a data line to a row of numbers, returning false if any field is not a number
+    bool to_row(const SLHAea::Line& line, std::vector<double>& row)
+    {
+      row.resize(line.data_size());
+      for (size_t i = 0; i < row.size(); ++i) if (not to_double(line[i], row[i])) return false;
+      return true;
+    }
+
+    /// Error for an entry missing from a SubSpectrum
+    void missing_entry_error(const str& local_info, const str& entry)
+    {
+      utils_error().raise(local_info, "Error creating SLHAview from SubSpectrum object! Required entry not found (" + entry + ")");
+    }
+
+    /// Scale given by "Q=" in a block definition line, or -1 if there is none
+    double block_def_scale(const SLHAea::Line& line)
+    {
+      for (size_t i = 2; i < line.data_size(); ++i)
+      {
+        const str field = to_upper(line[i]);
+        if (field.compare(0, 2, "Q=") != 0) continue;
+        double scale;
+        if (field.size() > 2) return to_double(field.substr(2), scale) ? scale : -1;
+        if (i + 1 < line.data_size() and to_double(line[i+1], scale)) return scale;
+        return -1;
+      }
+      return -1;
+    }
+
+  }
+
+  /// Append a row (indices followed by the value)
+  void SLHAview::Block::add(const std::vector<double>& row)
+  {
+    fields.insert(fields.end(), row.begin(), row.end());
+    row_start.push_back(fields.size());
+  }
+
+  /// Overwrite the first row with the same indices as the given row, or append the row if there is none
+  void SLHAview::Block::set(const std::vector<double>& row)
+  {
+    for (size_t r = 0; r < nrows(); ++r)
+    {
+      if (row_size(r) != row.size()) continue;
+      double* x = fields.data() + row_start[r];
+      if (not std::equal(row.begin(), row.end() - 1, x)) continue;
+      x[row.size() - 1] = row.back();
+      return;
+    }
+    add(row);
+  }
+
+  /// Set an entry with n indices i and j
+  void SLHAview::Block::set_value(size_t n, int i, int j, double value)
+  {
+    const size_t r = find(n, i, j);
+    if (r != nrows())
+    {
+      fields[row_start[r] + n] = value;
+      return;
+    }
+    const double indices[2] = {double(i), double(j)};
+    fields.insert(fields.end(), indices, indices + n);
+    fields.push_back(value);
+    row_start.push_back(fields.size());
+  }
+
+  /// Index of the first row with n indices matching i and j
+  size_t SLHAview::Block::find(size_t n, int i, int j) const
+  {
+    for (size_t r = 0; r < nrows(); ++r)
+    {
+      if (row_size(r) != n + 1) continue;
+      const double* x = row(r);
+      if (n > 0 and x[0] != i) continue;
+      if (n > 1 and x[1] != j) continue;
+      return r;
+    }
+    return nrows();
+  }
+
+  /// Value of a row found by find()
+  double SLHAview::Block::value(size_t r) const
+  {
+    if (r == nrows())
+    {
+      utils_error().raise(LOCAL_INFO, "Requested entry does not exist in SLHA block " + block_name + ".");
+    }
+    return row(r)[row_size(r) - 1];
+  }
+
+  /// Construct from an SLHAea object, converting every numerical data line once
+  SLHAview::SLHAview(const SLHAstruct& slha)
+  {
+    contents.reserve(slha.size());
+    add(slha);
+  }
+
+  /// Add the numerical contents of an SLHAea object
+  void SLHAview::add(const SLHAstruct& slha)
+  {
+    std::vector<double> row;
+    for (const SLHAea::Block& slha_block : slha)
+    {
+      double scale = -1;
+      if (not slha_block.empty() and slha_block.front().is_block_def()) scale = block_def_scale(slha_block.front());
+      // New blocks keep repeated entries, as SLHAea does; entries in existing blocks are overwritten
+      const bool overwrite = has_block(slha_block.name());
+      Block& block = (overwrite ? *find(slha_block.name()) : add_block(slha_block.name(), scale));
+      for (const SLHAea::Line& line : slha_block)
+      {
+        if (not line.is_data_line() or not to_row(line, row)) continue;
+        if (overwrite) block.set(row);
+        else block.add(row);
+      }
+    }
+  }
+
+  /// Find a block
+  /// @{
+  const SLHAview::Block* SLHAview::find(const str& name) const
+  {
+    for (const Block& block : contents) if (same_name(block.name(), name)) return &block;
+    return NULL;
+  }
+  SLHAview::Block* SLHAview::find(const str& name)
+  {
+    for (Block& block : contents) if (same_name(block.name(), name)) return &block;
+    return NULL;
+  }
+  /// @}
+
+  /// Retrieve a block, raising an error if it is absent
+  const SLHAview::Block& SLHAview::at(const str& name) const
+  {
+    const Block* block = find(name);
+    if (block == NULL) utils_error().raise(LOCAL_INFO, "SLHA block " + name + " does not exist.");
+    return *block;
+  }
+
+  /// Add a new block
+  SLHAview::Block& SLHAview::add_block(const str& name, double scale)
+  {
+    contents.push_back(Block(to_upper(name), scale));
+    return contents.back();
+  }
+
+  /// Delete a block, if it exists
+  void SLHAview::erase(const str& name)
+  {
+    for (auto it = contents.begin(); it != contents.end(); ++it)
+    {
+      if (not same_name(it->name(), name)) continue;
+      contents.erase(it);
+      return;
+    }
+  }
+
+  /// Convert to an SLHAea object
+  SLHAstruct SLHAview::getSLHAea() const
+  {
+    SLHAstruct slha;
+    for (const Block& block : contents)
+    {
+      SLHAea_add_block(slha, block.name(), block.has_scale() ? block.scale() : -1);
+      SLHAea::Block& slha_block = slha.back();
+      for (size_t r = 0; r < block.nrows(); ++r)
+      {
+        SLHAea::Line line;
+        const double* x = block.row(r);
+        for (size_t i = 0; i + 1 < block.row_size(r); ++i) line << int(x[i]);
+        std::ostringstream value;
+        value.precision(8);
+        value << std::scientific << x[block.row_size(r) - 1];
+        line << value.str();
+        slha_block.push_back(line);
+      }
+    }
+    return slha;
+  }
+
+  /// Overloads of the SLHAea helpers for SLHAview
+  /// @{
+
+  void SLHAea_add_block(SLHAview& slha, const str& name, const double scale)
+  {
+    if (not slha.has_block(name)) slha.add_block(name, scale);
+  }
+
+  void SLHAea_delete_block(SLHAview& slha, const str& block)
+  {
+    slha.erase(block);
+  }
+
+  bool SLHAea_block_exists(SLHAview& slha, const str& block)
+  {
+    return slha.has_block(block);
+  }
+
+  bool SLHAea_check_block(SLHAview& slha, const str& block)
+  {
+    if (slha.has_block(block)) return true;
+    slha.add_block(block);
+    return false;
+  }
+
+  void SLHAea_add(SLHAview& slha, const str& block, const int index, const double value, const str&, const bool overwrite)
+  {
+    SLHAea_check_block(slha, block);
+    SLHAview::Block& b = *slha.find(block);
+    if (overwrite or not b.has(index)) b.set(index, value);
+  }
+
+  void SLHAea_add(SLHAview& slha, const str& block, const int index, const int value, const str& comment, const bool overwrite)
+  {
+    SLHAea_add(slha, block, index, double(value), comment, overwrite);
+  }
+
+  void SLHAea_add(SLHAview& slha, const str& block, const int index1, const int index2, const double& value, const str&,
+   const bool overwrite)
+  {
+    SLHAea_check_block(slha, block);
+    SLHAview::Block& b = *slha.find(block);
+    if (overwrite or not b.has(index1, index2)) b.set(index1, index2, value);
+  }
+
+  void SLHAea_add_from_subspec(SLHAview& slha, const str local_info, const SubSpectrum& subspec,
+   const Par::Tags partype, const std::pair<int, int>& pdg_pair, const str& block, const str& comment,
+   const bool error_if_missing, const double rescale)
+  {
+    if (subspec.has(partype, pdg_pair))
+    {
+      SLHAea_add(slha, block, pdg_pair.first, subspec.get(partype, pdg_pair)*rescale, comment, true);
+    }
+    else if (error_if_missing)
+    {
+      std::ostringstream entry;
+      entry << "paramtype=" << Par::toString.at(partype) << ", pdg:context=" << pdg_pair.first << ":" << pdg_pair.second;
+      missing_entry_error(local_info, entry.str());
+    }
+  }
+
+  void SLHAea_add_from_subspec(SLHAview& slha, const str local_info, const SubSpectrum& subspec,
+   const Par::Tags partype, const str& name, const str& block, const int slha_index,
+   const str& comment, const bool error_if_missing, const double rescale)
+  {
+    if (subspec.has(partype, name))
+    {
+      SLHAea_add(slha, block, slha_index, subspec.get(partype, name)*rescale, comment, true);
+    }
+    else if (error_if_missing)
+    {
+      missing_entry_error(local_info, "paramtype=" + Par::toString.at(partype) + ", name=" + name);
+    }
+  }
+
+  void SLHAea_add_from_subspec(SLHAview& slha, const str local_info, const SubSpectrum& subspec,
+   const Par::Tags partype, const str& name, const int index1, const int index2, const str& block,
+   const int slha_index1, const int slha_index2, const str& comment, const bool error_if_missing, const double rescale)
+  {
+    if (subspec.has(partype, name, index1, index2))
+    {
+      SLHAea_add(slha, block, slha_index1, slha_index2, subspec.get(partype, name, index1, index2)*rescale, comment, true);
+    }
+    else if (error_if_missing)
+    {
+      std::ostringstream entry;
+      entry << "paramtype=" << Par::toString.at(partype) << ", name=" << name << ", index1=" << index1 << ", index2=" << index2;
+      missing_entry_error(local_info, entry.str());
+    }
+  }
+
+  /// @}
+
+}
@@ -13,6 +13,10 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///  \date 2015 Mar
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Utils/standalone_error_handlers.hpp"
@@ -94,6 +98,19 @@ namespace Gambit
 
    // Add the contents of this object to an existing SLHAea object.
    void SMInputs::add_to_SLHAea(SLHAea::Coll& data) const
+   {
+      add_to(data);
+   }
+
+   // Add the contents of this object to an existing SLHAview object.
+   void SMInputs::add_to_SLHAview(SLHAview& data) const
+   {
+      add_to(data);
+   }
+
+   // Add the contents of this object to an SLHAea or SLHAview object.
+   template <class SLHA>
+   void SMInputs::add_to(SLHA& data) const
    {
       // SMINPUTS block
       SLHAea_add(data,"SMINPUTS",1 , alphainv, "alpha^{-1}(mZ)^MSbar");
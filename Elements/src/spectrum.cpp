@@ -32,6 +32,10 @@
 ///          (a.m.b.krislock@fys.uio.no)
 ///  \date 2016 Feb
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Elements/spectrum.hpp"
@@ -414,6 +418,17 @@ namespace Gambit
       return slha;
    }
 
+   /// SLHAview getter
+   /// Fills the view in the same order as getSLHAea (SMINPUTS, then LE, then HE), without making an SLHAea object.
+   SLHAview Spectrum::getSLHAview(int slha_version) const
+   {
+      SLHAview view;
+      SMINPUTS.add_to_SLHAview(view);
+      LE->add_to_SLHAview(slha_version, view);
+      HE->add_to_SLHAview(slha_version, view);
+      return view;
+   }
+
    /// Output spectrum contents as an SLHA file, using getSLHAea.
    void Spectrum::writeSLHAfile(int slha_version, const str& filename) const
    {
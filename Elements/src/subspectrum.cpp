@@ -21,6 +21,10 @@
 ///          (a.m.b.krislock@fys.uio.no)
 ///  \date 2016 Feb
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include <fstream>
@@ -61,6 +65,14 @@ namespace Gambit
      return slha;
    }
 
+   /// Add spectrum information to an SLHAview object, via an SLHAea object
+   void SubSpectrum::add_to_SLHAview(int slha_version, SLHAview& view) const
+   {
+     SLHAstruct slha;
+     this->add_to_SLHAea(slha_version, slha);
+     view.add(slha);
+   }
+
    /// Initialiser function for empty map of override maps
    std::map<Par::Tags,OverrideMaps> SubSpectrum::create_override_maps()
    {
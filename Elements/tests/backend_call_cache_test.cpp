@@ -0,0 +1,227 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Unit tests of the memoisation of backend
+///  function results (BackendCallCache and the
+///  cache key builders), including the size cap,
+///  key collisions and stores written by other
+///  backend versions or damaged by a crash.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Elements/backend_call_cache.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/cmake/cmake_variables.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  /// A struct with padding after its leading ints, like SuperIso's parameters
+  struct padded
+  {
+    int a, b, c;
+    double x;
+  };
+  static_assert(sizeof(padded) > 3*sizeof(int) + sizeof(double), "padded has no padding on this platform");
+
+  /// Fill a padded struct, first zeroing it or filling it with garbage
+  void fill(padded& p, bool zero, double x)
+  {
+    std::memset(&p, zero ? 0 : 0xab, sizeof(padded));
+    p.a = 1; p.b = 2; p.c = 3; p.x = x;
+  }
+
+  /// Make a key for a call f(const padded*, double)
+  str key(const padded* p, double y) { return make_backend_call_key<const padded*, double>(p, y); }
+
+  /// Size of a file in bytes (0 if it does not exist)
+  std::size_t file_size(const str& filename)
+  {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    return in ? std::size_t(in.tellg()) : 0;
+  }
+
+  /// Size of a record in the persistent store
+  std::size_t record_size(const str& key, std::size_t value_size) { return 2*sizeof(std::uint32_t) + key.size() + value_size; }
+
+  const str test_cache_name = "backend_call_cache_test";
+  const str test_cache_file = GAMBIT_DIR "/scratch/backend_cache/" + test_cache_name + ".dat";
+
+}
+
+// Only input arguments can be memoised
+static_assert(memoisable_backend_function<double, const padded*, double, const int&>::value, "inputs should be memoisable");
+static_assert(not memoisable_backend_function<double, padded*>::value, "non-const pointers should not be memoisable");
+static_assert(not memoisable_backend_function<double, double&>::value, "non-const references should not be memoisable");
+static_assert(not memoisable_backend_function<double, const char*>::value, "strings should not be memoisable");
+static_assert(not memoisable_backend_function<void, double>::value, "void functions should not be memoisable");
+
+int main()
+{
+  logger().disable();
+  double result;
+
+  std::cout << "Cache keys:" << std::endl;
+  padded p1, p2;
+  fill(p1, true, 0.5);
+  fill(p2, true, 0.5);
+  check(key(&p1, 1.) == key(&p2, 1.), "zeroed structs with equal members give equal keys");
+  fill(p2, true, 0.25);
+  check(key(&p1, 1.) != key(&p2, 1.), "structs with different members give different keys");
+  check(key(&p1, 1.) != key(&p1, 2.), "different values give different keys");
+  check(key(&p1, 1.) != key(NULL, 1.), "a null pointer has its own key");
+  fill(p2, false, 0.5);
+  check(key(&p1, 1.) != key(&p2, 1.), "padding that is not zeroed changes the key (so structs must be zeroed)");
+
+  std::cout << "In-memory cache:" << std::endl;
+  BackendCallCache::set_persistence(false, 0);
+  std::remove(test_cache_file.c_str());
+  BackendCallCache cache(test_cache_name, 2);
+  check(not cache.fetch("a", &result, sizeof(result)) and cache.misses() == 1, "empty cache misses");
+  for (double v : {1., 2., 3.}) cache.store(str(1, char('a' + int(v) - 1)), &v, sizeof(v));
+  check(not cache.fetch("a", &result, sizeof(result)), "least recently used entry is evicted");
+  check(cache.fetch("b", &result, sizeof(result)) and result == 2., "cached result is returned");
+  check(cache.fetch("c", &result, sizeof(result)) and result == 3., "most recent result is kept");
+  check(not cache.fetch("c", &result, sizeof(float)), "result of a different size misses");
+  check(cache.hits() == 2 and cache.misses() == 3, "hits and misses are counted");
+  check(file_size(test_cache_file) == 0, "nothing is written to disk unless the persistent store is on");
+
+  std::cout << "Persistent cache:" << std::endl;
+  const std::size_t record = 2*sizeof(std::uint32_t) + 8 + sizeof(double);
+  const std::size_t max_file_size = 10*record;
+  BackendCallCache::set_persistence(true, max_file_size);
+  {
+    BackendCallCache writer(test_cache_name, 100);
+    for (int i = 0; i < 25; ++i)
+    {
+      const double v = i;
+      char k[9];
+      std::snprintf(k, sizeof(k), "key%05d", i);
+      writer.store(k, &v, sizeof(v));
+      if (file_size(test_cache_file) > max_file_size) break;
+    }
+  }
+  check(file_size(test_cache_file) > 0, "results are written to disk when the persistent store is on");
+  check(file_size(test_cache_file) <= max_file_size, "the file never exceeds its maximum size");
+  BackendCallCache reader(test_cache_name, 100);
+  check(reader.fetch("key00024", &result, sizeof(result)) and result == 24., "the newest result is read back in a later run");
+  check(not reader.fetch("key00000", &result, sizeof(result)), "the oldest results are dropped to keep within the size limit");
+  std::remove(test_cache_file.c_str());
+  {
+    BackendCallCache writer(test_cache_name, 100);
+    std::vector<char> big(max_file_size);
+    writer.store("big", big.data(), big.size());
+    check(file_size(test_cache_file) == 0, "a result larger than the maximum file size is not written to disk");
+    writer.store("small", &result, sizeof(result));
+    check(file_size(test_cache_file) == record_size("small", sizeof(result)), "smaller results are written after it");
+  }
+  std::remove(test_cache_file.c_str());
+
+  std::cout << "Key collisions:" << std::endl;
+  {
+    // Keys that are prefixes of each other, or differ only in embedded null bytes, must stay distinct, both in
+    // memory and when read back from disk (the records are length-prefixed, so the key boundaries are never lost).
+    const std::vector<str> keys = {"", str(1, '\0'), str(2, '\0'), "k", str("k\0", 2), "kk", str("k\0k", 3)};
+    {
+      BackendCallCache writer(test_cache_name, 100);
+      for (std::size_t i = 0; i < keys.size(); ++i)
+      {
+        const double v = i;
+        writer.store(keys[i], &v, sizeof(v));
+      }
+      bool distinct = true;
+      for (std::size_t i = 0; i < keys.size(); ++i) distinct = distinct and writer.fetch(keys[i], &result, sizeof(result)) and result == i;
+      check(distinct, "keys that are prefixes of each other give distinct entries in memory");
+    }
+    BackendCallCache reader(test_cache_name, 100);
+    bool distinct = true;
+    for (std::size_t i = 0; i < keys.size(); ++i) distinct = distinct and reader.fetch(keys[i], &result, sizeof(result)) and result == i;
+    check(distinct, "keys that are prefixes of each other give distinct entries when read back");
+    std::remove(test_cache_file.c_str());
+
+    // Keys built from the arguments of one function all have the same length, and pointers carry a flag byte.
+    padded p;
+    fill(p, true, 0.);
+    check(make_backend_call_key<double, double>(1., 2.) != make_backend_call_key<double, double>(2., 1.),
+          "the order of the arguments is part of the key");
+    str null_key = key(NULL, 1.), zero_key = key(&p, 1.);
+    check(null_key != zero_key and null_key.size() != zero_key.size(), "a null pointer cannot collide with a zeroed struct");
+  }
+
+  std::cout << "Stores written by other backend versions or damaged:" << std::endl;
+  {
+    // Caches are named <backend>_<safe version>_<function>, so each backend version has a store of its own.
+    const str old_name = "ToyBackend_1_0_function", new_name = "ToyBackend_1_1_function";
+    const str old_file = GAMBIT_DIR "/scratch/backend_cache/" + old_name + ".dat";
+    const str new_file = GAMBIT_DIR "/scratch/backend_cache/" + new_name + ".dat";
+    std::remove(old_file.c_str());
+    std::remove(new_file.c_str());
+    {
+      BackendCallCache writer(old_name, 100);
+      const double v = 1.;
+      writer.store("x", &v, sizeof(v));
+    }
+    BackendCallCache new_version(new_name, 100);
+    check(not new_version.fetch("x", &result, sizeof(result)), "results of another backend version are not read");
+    BackendCallCache old_version(old_name, 100);
+    check(old_version.fetch("x", &result, sizeof(result)) and result == 1., "results of the same backend version are read");
+    float f;
+    check(not old_version.fetch("x", &f, sizeof(f)), "a stored result of a different type (size) is not returned");
+    std::remove(old_file.c_str());
+    std::remove(new_file.c_str());
+
+    // A record cut short, e.g. by a crash while writing, is dropped; records appended later can still be read.
+    {
+      BackendCallCache writer(test_cache_name, 100);
+      for (double v : {1., 2.}) writer.store(v == 1. ? "one" : "two", &v, sizeof(v));
+    }
+    const std::size_t complete = file_size(test_cache_file);
+    {
+      std::ofstream out(test_cache_file, std::ios::binary | std::ios::app);
+      const std::uint32_t key_size = 1000000;
+      out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+      out.write("thr", 3);
+    }
+    {
+      BackendCallCache damaged(test_cache_name, 100);
+      check(damaged.fetch("two", &result, sizeof(result)) and result == 2., "complete records before a damaged one are read");
+      check(file_size(test_cache_file) == complete, "the damaged record is removed from the file");
+      const double v = 4.;
+      damaged.store("four", &v, sizeof(v));
+    }
+    BackendCallCache repaired(test_cache_name, 100);
+    check(repaired.fetch("one", &result, sizeof(result)) and result == 1. and
+          repaired.fetch("four", &result, sizeof(result)) and result == 4., "records appended after the repair are read");
+    std::remove(test_cache_file.c_str());
+  }
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the storage of DecayTable
+///  channels: the original std::map keyed on
+///  std::multiset final states, a linear scan over
+///  hashed flat channels, and decay_channel_map.
+///  Builds and queries the decay channels of all
+///  particles in an MSSM benchmark SLHA file,
+///  and of one particle with many channels (as in
+///  decay tables with 3-body and loop decays).
+///
+///  Usage: decay_table_benchmark [slha file] [repetitions]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "SLHAea/slhaea.h"
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Elements/decay_channels.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/cmake/cmake_variables.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  typedef std::pair<int,int> particle;
+
+  /// The decay channels of one particle, as read from SLHA
+  struct slha_decays
+  {
+    std::vector<std::vector<particle> > final_states;
+    std::vector<double> BFs;
+  };
+
+  /// The original DecayTable::Entry::channels
+  typedef std::map<std::multiset<particle>, std::pair<double,double> > map_channels;
+
+  /// Flat channels found by a linear scan over their hashes (the first version of decay_channel_map)
+  class linear_channels
+  {
+    public:
+      std::pair<double,double>& operator[](const decay_channel& key)
+      {
+        const size_t h = key.hash();
+        size_t i = position(key, h);
+        if (i == entries.size())
+        {
+          entries.push_back(std::make_pair(key, std::make_pair(0., 0.)));
+          hashes.push_back(h);
+        }
+        return entries[i].second;
+      }
+      const std::pair<double,double>* find(const decay_channel& key) const
+      {
+        size_t i = position(key, key.hash());
+        return i == entries.size() ? NULL : &entries[i].second;
+      }
+    private:
+      size_t position(const decay_channel& key, size_t h) const
+      {
+        for (size_t i = 0; i < hashes.size(); ++i) if (hashes[i] == h and entries[i].first == key) return i;
+        return entries.size();
+      }
+      std::vector<std::pair<decay_channel, std::pair<double,double> > > entries;
+      std::vector<size_t> hashes;
+  };
+
+  /// @name Setting and getting a BF from a list of particles, as DecayTable::Entry does
+  /// @{
+  void set_BF(map_channels& c, const std::vector<particle>& fs, double BF) { c[std::multiset<particle>(fs.begin(), fs.end())] = std::make_pair(BF, 0.); }
+  void set_BF(linear_channels& c, const std::vector<particle>& fs, double BF) { c[decay_channel(fs)] = std::make_pair(BF, 0.); }
+  void set_BF(decay_channel_map& c, const std::vector<particle>& fs, double BF) { c[decay_channel(fs)] = std::make_pair(BF, 0.); }
+  double BF(const map_channels& c, const std::vector<particle>& fs)
+  {
+    auto it = c.find(std::multiset<particle>(fs.begin(), fs.end()));
+    return it == c.end() ? 0. : it->second.first;
+  }
+  double BF(const linear_channels& c, const std::vector<particle>& fs)
+  {
+    const std::pair<double,double>* x = c.find(decay_channel(fs));
+    return x == NULL ? 0. : x->first;
+  }
+  double BF(const decay_channel_map& c, const std::vector<particle>& fs)
+  {
+    auto it = c.find(decay_channel(fs));
+    return it == c.end() ? 0. : it->second.first;
+  }
+  /// @}
+
+  /// Build the channels of all particles, then look up every channel (in reverse order) and one absent channel each.
+  /// Returns the time in ms and the sum of all BFs found.
+  template <typename CHANNELS>
+  double build_and_query(const std::vector<slha_decays>& decays, int repetitions, double& BF_sum)
+  {
+    const std::vector<particle> absent = {particle(1000022, 0), particle(1000022, 0), particle(1000022, 0)};
+    BF_sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+      std::vector<CHANNELS> table(decays.size());
+      for (size_t p = 0; p < decays.size(); ++p)
+      {
+        for (size_t c = 0; c < decays[p].BFs.size(); ++c) set_BF(table[p], decays[p].final_states[c], decays[p].BFs[c]);
+      }
+      for (size_t p = 0; p < decays.size(); ++p)
+      {
+        for (size_t c = decays[p].BFs.size(); c-- > 0;) BF_sum += BF(table[p], decays[p].final_states[c]);
+        BF_sum += BF(table[p], absent);
+      }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  /// Time the three ways of storing channels and print the results under the given caption; returns whether they
+  /// find the same BFs
+  bool compare(const str& caption, const std::vector<slha_decays>& decays, int repetitions)
+  {
+    double sum_map, sum_linear, sum_hashed;
+    const double t_map = build_and_query<map_channels>(decays, repetitions, sum_map);
+    const double t_linear = build_and_query<linear_channels>(decays, repetitions, sum_linear);
+    const double t_hashed = build_and_query<decay_channel_map>(decays, repetitions, sum_hashed);
+    Utils::benchmark_table table(caption, {{"", 36, ""}, {"[us/table]", 12, "%.2f"}, {"speedup", 12, "%.2f"}});
+    table.row("std::map<std::multiset> (original)", 1e3*t_map/repetitions, 1.);
+    table.row("flat channels, linear scan", 1e3*t_linear/repetitions, t_map/t_linear);
+    table.row("decay_channel_map (hash index)", 1e3*t_hashed/repetitions, t_map/t_hashed);
+    return sum_map == sum_linear and sum_map == sum_hashed;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const str filename = (argc > 1 ? argv[1] : GAMBIT_DIR "/DarkBit/data/benchmarks/hZ_funnel.slha2");
+  const int repetitions = (argc > 2 ? std::atoi(argv[2]) : 1000);
+  logger().disable();
+
+  std::ifstream in(filename);
+  if (not in)
+  {
+    std::printf("Cannot read %s\n", filename.c_str());
+    return 1;
+  }
+  const SLHAea::Coll slha(in);
+  std::vector<slha_decays> decays;
+  size_t nchannels = 0, max_channels = 0;
+  for (const SLHAea::Block& block : slha)
+  {
+    // SLHAea names DECAY blocks by the PDG code of the decaying particle
+    if (block.empty() or block.front().size() == 0 or block.front()[0] != "DECAY") continue;
+    decays.push_back(slha_decays());
+    for (const SLHAea::Line& line : block)
+    {
+      if (not line.is_data_line()) continue;
+      std::vector<particle> fs;
+      for (int i = 0; i < SLHAea::to<int>(line[1]); ++i) fs.push_back(particle(SLHAea::to<int>(line[2+i]), 0));
+      decays.back().final_states.push_back(fs);
+      decays.back().BFs.push_back(SLHAea::to<double>(line[0]));
+    }
+    nchannels += decays.back().BFs.size();
+    max_channels = std::max(max_channels, decays.back().BFs.size());
+  }
+
+  bool agree = compare(filename + ": " + std::to_string(decays.size()) + " particles, " + std::to_string(nchannels)
+                       + " channels (at most " + std::to_string(max_channels) + " per particle), "
+                       + std::to_string(repetitions) + " repetitions", decays, repetitions);
+
+  // One particle decaying to every 3-body final state of 12 sparticles
+  std::vector<slha_decays> many(1);
+  const std::vector<int> ids = {1000001, 1000002, 1000011, 1000012, 1000022, 1000023, 1000024, 1000025, 1000035, 1000037, 2000001, 2000011};
+  for (size_t i = 0; i < ids.size(); ++i) for (size_t j = i; j < ids.size(); ++j) for (size_t k = j; k < ids.size(); ++k)
+  {
+    many[0].final_states.push_back({particle(ids[i], 0), particle(-ids[j], 0), particle(ids[k], 0)});
+    many[0].BFs.push_back(1e-3*(i + 1) + 1e-5*(j + 1) + 1e-7*(k + 1));
+  }
+  const int few_repetitions = std::max(1, repetitions/10);
+  agree = compare("1 particle with " + std::to_string(many[0].BFs.size()) + " channels, " + std::to_string(few_repetitions)
+                  + " repetitions", many, few_repetitions) and agree;
+
+  if (not agree)
+  {
+    std::printf("The three ways give different BFs!\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,189 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the point cache of module functors:
+///  results are keyed on the values of all the
+///  model parameters the functor depends on,
+///  entries are evicted least recently used first,
+///  invalidated points are never stored, and cache
+///  hits are kept out of the runtime and
+///  invalidation statistics.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/model_parameters.hpp"
+#include "gambit/Elements/functors.hpp"
+#include "gambit/Elements/functor_definitions.hpp"
+#include "gambit/Models/models.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// Parameters of two models the toy function depends on, and of one it does not
+  ModelParameters A, B, C;
+
+  /// Number of times the toy function has run
+  int calls = 0;
+
+  /// Time the toy function takes (ms)
+  int sleep_ms = 0;
+
+  /// Toy module function: depends on A and B, and invalidates the point if A's a is negative
+  void toy(double& result)
+  {
+    calls++;
+    if (sleep_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+    if (A.getValue("a") < 0) invalid_point().raise("Toy invalidation.");
+    result = 10*A.getValue("a") + B.getValue("b") + 100*A.getValue("c");
+  }
+
+  /// Set the model parameters of a point
+  void set_point(double a, double c, double b, double x)
+  {
+    A.setValue("a", a);
+    A.setValue("c", c);
+    B.setValue("b", b);
+    C.setValue("x", x);
+  }
+
+  /// Evaluate the functor at the current point; returns whether the toy function had to run
+  bool evaluate(module_functor<double>& f, double& result)
+  {
+    const int before = calls;
+    f.reset();
+    f.calculate();
+    result = f(0);
+    return calls != before;
+  }
+
+  bool evaluate(module_functor<double>& f)
+  {
+    double result;
+    return evaluate(f, result);
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+
+  A._definePars({"a", "c"});
+  B._definePar("b");
+  C._definePar("x");
+
+  Models::ModelFunctorClaw claw;
+
+  std::cout << "Cache keys" << std::endl;
+  {
+    module_functor<double> f(&toy, "toy", "toy_capability", "double", "ToyBit", claw);
+    f.setPointCache(10, {&A, &B});
+    double r1, r2;
+    set_point(1, 0, 2, 0);
+    check(evaluate(f, r1), "the first point is computed");
+    set_point(1, 0, 2, 5);
+    check(not evaluate(f, r2) and r2 == r1, "changing only parameters of other models reuses the cached result");
+    set_point(1, 0, 3, 5);
+    check(evaluate(f), "changing a parameter of the second model the functor depends on is a miss");
+    set_point(1, 2, 3, 5);
+    check(evaluate(f), "changing any parameter of the first model is a miss");
+    set_point(2, 0, 1, 5);
+    check(evaluate(f), "swapping values between models is a miss");
+    set_point(1, 0, 2, 7);
+    check(not evaluate(f, r2) and r2 == r1, "an earlier point is found again, with its own result");
+  }
+
+  std::cout << "Eviction" << std::endl;
+  {
+    module_functor<double> f(&toy, "toy", "toy_capability", "double", "ToyBit", claw);
+    f.setPointCache(2, {&A, &B});
+    double r;
+    set_point(1, 0, 0, 0); evaluate(f);
+    set_point(2, 0, 0, 0); evaluate(f);
+    set_point(1, 0, 0, 0);
+    check(not evaluate(f), "a point within the capacity is a hit");
+    set_point(3, 0, 0, 0);
+    check(evaluate(f), "a new point is a miss, and evicts the least recently used point");
+    set_point(1, 0, 0, 0);
+    check(not evaluate(f, r) and r == 10, "the recently used point is kept");
+    set_point(2, 0, 0, 0);
+    check(evaluate(f, r) and r == 20, "the least recently used point was evicted");
+    set_point(1, 0, 0, 0);
+    check(not evaluate(f, r) and r == 10, "refetching a point keeps it in the cache");
+  }
+
+  std::cout << "Invalidated points" << std::endl;
+  {
+    module_functor<double> f(&toy, "toy", "toy_capability", "double", "ToyBit", claw);
+    f.setPointCache(10, {&A, &B});
+    set_point(-1, 0, 0, 0);
+    bool invalidated = true;
+    for (int i = 0; i < 2; ++i)
+    {
+      const int before = calls;
+      bool threw = false;
+      f.reset();
+      try { f.calculate(); }
+      catch (invalid_point_exception&) { threw = true; }
+      invalidated = invalidated and threw and calls == before + 1;
+    }
+    check(invalidated, "an invalidated point is recomputed (and invalidated again) every time");
+    set_point(1, 0, 0, 0);
+    check(evaluate(f), "the next valid point is computed");
+    check(not evaluate(f), "and then cached");
+  }
+
+  std::cout << "Runtime statistics" << std::endl;
+  {
+    module_functor<double> f(&toy, "toy", "toy_capability", "double", "ToyBit", claw);
+    f.setPointCache(10, {&A, &B});
+    f.setFadeRate(1.);
+    sleep_ms = 20;
+    set_point(1, 0, 0, 0);
+    evaluate(f);
+    const double runtime = f.getRuntimeAverage();
+    const double invalidation = f.getInvalidationRate();
+    check(runtime >= 0.02, "a miss updates the runtime average");
+    check(not evaluate(f), "the point is cached");
+    check(f.getRuntimeAverage() == runtime and f.getInvalidationRate() == invalidation,
+          "a hit leaves the runtime average and invalidation rate untouched");
+    sleep_ms = 0;
+  }
+
+  std::cout << "Disabled cache" << std::endl;
+  {
+    module_functor<double> f(&toy, "toy", "toy_capability", "double", "ToyBit", claw);
+    set_point(1, 0, 0, 0);
+    evaluate(f);
+    check(f.pointCacheCapacity() == 0 and evaluate(f), "without a point cache every point is computed");
+  }
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
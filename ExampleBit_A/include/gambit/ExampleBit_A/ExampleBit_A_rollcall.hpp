@@ -59,6 +59,7 @@ START_MODULE
     START_FUNCTION(double)                  // Function calculates the nevents_like likelihood as a double precision variable
     DEPENDENCY(nevents, double)             // Dependency: Likelihood calculation requires number of events
     DEPENDENCY(eventAccumulation, int)      // Depends on the accumulated events that pass the make-believe cuts in the make-believe event loop
+    THREAD_SAFE                             // Only reads its dependencies, so may run concurrently with other functions (see parallel_branches)
     #undef FUNCTION
 
   #undef CAPABILITY
@@ -108,6 +109,7 @@ START_MODULE
 
     #define FUNCTION particle_identity      // Observable: particle ID
     START_FUNCTION(std::string)             // Function returns the identity of the particle as a string
+    THREAD_SAFE                             // Touches no shared state, so may run concurrently with other functions
     #undef FUNCTION
 
   #undef CAPABILITY
@@ -0,0 +1,38 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Filling of the SuperIso model parameters
+///  from the SLHA blocks of a spectrum.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __SuperIso_parameters_hpp__
+#define __SuperIso_parameters_hpp__
+
+#include "gambit/Elements/slha_view.hpp"
+#include "gambit/Backends/backend_types/SuperIso.hpp"
+
+namespace Gambit
+{
+
+  namespace FlavBit
+  {
+
+    /// Fill the SuperIso parameters read from the SLHA blocks of a spectrum (on top of those set by
+    /// Init_param).  The SUSY blocks are only read if SUSY is true.
+    void fill_SI_parameters(parameters &result, const SLHAview& view, bool SUSY);
+
+  }
+
+}
+
+#endif //#defined __SuperIso_parameters_hpp__
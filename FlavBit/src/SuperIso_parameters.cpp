@@ -0,0 +1,376 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Filling of the SuperIso model parameters
+///  from the SLHA blocks of a spectrum.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author Nazila Mahmoudi
+///  \date 2013 Oct
+///
+///  \author Marcin Chrzaszcz
+///  \date 2015 May
+///
+///  \author Pat Scott
+///          (p.scott@imperial.ac.uk)
+///  \date 2015 May, June
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include "gambit/FlavBit/SuperIso_parameters.hpp"
+
+namespace Gambit
+{
+
+  namespace FlavBit
+  {
+
+    /// Fill the SuperIso parameters read from SLHA blocks
+    void fill_SI_parameters(parameters &result, const SLHAview& view, bool SUSY)
+    {
+      int ie,je;
+
+      if (const SLHAview::Block* block = view.find("MODSEL"))
+      {
+        if (block->has(1)) result.model=int(block->get(1));
+        if (block->has(3)) result.NMSSM=int(block->get(3));
+        if (block->has(4)) result.RV=int(block->get(4));
+        if (block->has(5)) result.CPV=int(block->get(5));
+        if (block->has(6)) result.FV=int(block->get(6));
+        if (block->has(12)) result.Q=block->get(12);
+      }
+
+      if (result.NMSSM != 0) result.model=result.NMSSM;
+      if (result.RV != 0) result.model=-2;
+      if (result.CPV != 0) result.model=-2;
+
+      if (const SLHAview::Block* block = view.find("SMINPUTS"))
+      {
+        if (block->has(1)) result.inv_alpha_em=block->get(1);
+        if (block->has(2)) result.Gfermi=block->get(2);
+        if (block->has(3)) result.alphas_MZ=block->get(3);
+        if (block->has(4)) result.mass_Z=block->get(4);
+        if (block->has(5)) result.mass_b=block->get(5);
+        if (block->has(6)) result.mass_top_pole=block->get(6);
+        if (block->has(7)) result.mass_tau=block->get(7);
+        if (block->has(8)) result.mass_nutau2=block->get(8);
+        if (block->has(11)) result.mass_e2=block->get(11);
+        if (block->has(12)) result.mass_nue2=block->get(12);
+        if (block->has(13)) result.mass_mu2=block->get(13);
+        if (block->has(14)) result.mass_numu2=block->get(14);
+        if (block->has(21)) result.mass_d2=block->get(21);
+        if (block->has(22)) result.mass_u2=block->get(22);
+        if (block->has(23)) result.mass_s2=block->get(23);
+        if (block->has(24)) result.mass_c2=block->get(24);
+      }
+
+      if (const SLHAview::Block* block = view.find("VCKMIN"))
+      {
+        if (block->has(1)) result.CKM_lambda=block->get(1);
+        if (block->has(2)) result.CKM_A=block->get(2);
+        if (block->has(3)) result.CKM_rhobar=block->get(3);
+        if (block->has(4)) result.CKM_etabar=block->get(4);
+      }
+
+      if (const SLHAview::Block* block = view.find("UPMNSIN"))
+      {
+        if (block->has(1)) result.PMNS_theta12=block->get(1);
+        if (block->has(2)) result.PMNS_theta23=block->get(2);
+        if (block->has(3)) result.PMNS_theta13=block->get(3);
+        if (block->has(4)) result.PMNS_delta13=block->get(4);
+        if (block->has(5)) result.PMNS_alpha1=block->get(5);
+        if (block->has(6)) result.PMNS_alpha2=block->get(6);
+      }
+
+      if (const SLHAview::Block* block = view.find("MINPAR"))
+      {
+        switch(result.model)
+        {
+          case 1:
+          {
+            if (block->has(1)) result.m0=block->get(1);
+            if (block->has(2)) result.m12=block->get(2);
+            if (block->has(3)) result.tan_beta=block->get(3);
+            if (block->has(4)) result.sign_mu=block->get(4);
+            if (block->has(5)) result.A0=block->get(5);
+          }
+          case 2:
+          {
+            if (block->has(1)) result.Lambda=block->get(1);
+            if (block->has(2)) result.Mmess=block->get(2);
+            if (block->has(3)) result.tan_beta=block->get(3);
+            if (block->has(4)) result.sign_mu=block->get(4);
+            if (block->has(5)) result.N5=block->get(5);
+            if (block->has(6)) result.cgrav=block->get(6);
+          }
+          case 3:
+          {
+            if (block->has(1)) result.m32=block->get(1);
+            if (block->has(2)) result.m0=block->get(2);
+            if (block->has(3)) result.tan_beta=block->get(3);
+            if (block->has(4)) result.sign_mu=block->get(4);
+          }
+          default:
+          {
+            if (block->has(3)) result.tan_beta=block->get(3);
+          }
+        }
+      }
+
+      if (const SLHAview::Block* block = view.find("EXTPAR"))
+      {
+        if (block->has(0)) result.Min=block->get(0);
+        if (block->has(1)) result.M1_Min=block->get(1);
+        if (block->has(2)) result.M2_Min=block->get(2);
+        if (block->has(3)) result.M3_Min=block->get(3);
+        if (block->has(11)) result.At_Min=block->get(11);
+        if (block->has(12)) result.Ab_Min=block->get(12);
+        if (block->has(13)) result.Atau_Min=block->get(13);
+        if (block->has(21)) result.M2H1_Min=block->get(21);
+        if (block->has(22)) result.M2H2_Min=block->get(22);
+        if (block->has(23)) result.mu_Min=block->get(23);
+        if (block->has(24)) result.M2A_Min=block->get(24);
+        if (block->has(25)) result.tb_Min=block->get(25);
+        if (block->has(26)) result.mA_Min=block->get(26);
+        if (block->has(31)) result.MeL_Min=block->get(31);
+        if (block->has(32)) result.MmuL_Min=block->get(32);
+        if (block->has(33)) result.MtauL_Min=block->get(33);
+        if (block->has(34)) result.MeR_Min=block->get(34);
+        if (block->has(35)) result.MmuR_Min=block->get(35);
+        if (block->has(36)) result.MtauR_Min=block->get(36);
+        if (block->has(41)) result.MqL1_Min=block->get(41);
+        if (block->has(42)) result.MqL2_Min=block->get(42);
+        if (block->has(43)) result.MqL3_Min=block->get(43);
+        if (block->has(44)) result.MuR_Min=block->get(44);
+        if (block->has(45)) result.McR_Min=block->get(45);
+        if (block->has(46)) result.MtR_Min=block->get(46);
+        if (block->has(47)) result.MdR_Min=block->get(47);
+        if (block->has(48)) result.MsR_Min=block->get(48);
+        if (block->has(49)) result.MbR_Min=block->get(49);
+        if (block->has(51)) result.N51=block->get(51);
+        if (block->has(52)) result.N52=block->get(52);
+        if (block->has(53)) result.N53=block->get(53);
+        if (block->has(61)) result.lambdaNMSSM_Min=block->get(61);
+        if (block->has(62)) result.kappaNMSSM_Min=block->get(62);
+        if (block->has(63)) result.AlambdaNMSSM_Min=block->get(63);
+        if (block->has(64)) result.AkappaNMSSM_Min=block->get(64);
+        if (block->has(65)) result.lambdaSNMSSM_Min=block->get(65);
+        if (block->has(66)) result.xiFNMSSM_Min=block->get(66);
+        if (block->has(67)) result.xiSNMSSM_Min=block->get(67);
+        if (block->has(68)) result.mupNMSSM_Min=block->get(68);
+        if (block->has(69)) result.mSp2NMSSM_Min=block->get(69);
+        if (block->has(70)) result.mS2NMSSM_Min=block->get(70);
+      }
+
+      if (const SLHAview::Block* block = view.find("MASS"))
+      {
+        if (block->has(1)) result.mass_d=block->get(1);
+        if (block->has(2)) result.mass_u=block->get(2);
+        if (block->has(3)) result.mass_s=block->get(3);
+        if (block->has(4)) result.mass_c=block->get(4);
+        if (block->has(6)) result.mass_t=block->get(6);
+        if (block->has(11)) result.mass_e=block->get(11);
+        if (block->has(12)) result.mass_nue=block->get(12);
+        if (block->has(13)) result.mass_mu=block->get(13);
+        if (block->has(14)) result.mass_num=block->get(14);
+        if (block->has(15)) result.mass_tau=result.mass_tau_pole=block->get(15);
+        if (block->has(16)) result.mass_nut=block->get(16);
+        if (block->has(21)) result.mass_gluon=block->get(21);
+        if (block->has(22)) result.mass_photon=block->get(22);
+        if (block->has(23)) result.mass_Z0=block->get(23);
+        if (block->has(24)) result.mass_W=block->get(24);
+        if (block->has(25)) result.mass_h0=block->get(25);
+        if (block->has(35)) result.mass_H0=block->get(35);
+        if (block->has(36)) result.mass_A0=block->get(36);
+        if (block->has(37)) result.mass_H=block->get(37);
+        if (block->has(39)) result.mass_graviton=block->get(39);
+        if (block->has(45)) result.mass_H03=block->get(45);
+        if (block->has(46)) result.mass_A02=block->get(46);
+        if (block->has(1000001)) result.mass_dnl=block->get(1000001);
+        if (block->has(1000002)) result.mass_upl=block->get(1000002);
+        if (block->has(1000003)) result.mass_stl=block->get(1000003);
+        if (block->has(1000004)) result.mass_chl=block->get(1000004);
+        if (block->has(1000005)) result.mass_b1=block->get(1000005);
+        if (block->has(1000006)) result.mass_t1=block->get(1000006);
+        if (block->has(1000011)) result.mass_el=block->get(1000011);
+        if (block->has(1000012)) result.mass_nuel=block->get(1000012);
+        if (block->has(1000013)) result.mass_mul=block->get(1000013);
+        if (block->has(1000014)) result.mass_numl=block->get(1000014);
+        if (block->has(1000015)) result.mass_tau1=block->get(1000015);
+        if (block->has(1000016)) result.mass_nutl=block->get(1000016);
+        if (block->has(1000021)) result.mass_gluino=block->get(1000021);
+        if (block->has(1000022)) result.mass_neut[1]=block->get(1000022);
+        if (block->has(1000023)) result.mass_neut[2]=block->get(1000023);
+        if (block->has(1000024)) result.mass_cha1=block->get(1000024);
+        if (block->has(1000025)) result.mass_neut[3]=block->get(1000025);
+        if (block->has(1000035)) result.mass_neut[4]=block->get(1000035);
+        if (block->has(1000037)) result.mass_cha2=block->get(1000037);
+        if (block->has(1000039)) result.mass_gravitino=block->get(1000039);
+        if (block->has(1000045)) result.mass_neut[5]=block->get(1000045);
+        if (block->has(2000001)) result.mass_dnr=block->get(2000001);
+        if (block->has(2000002)) result.mass_upr=block->get(2000002);
+        if (block->has(2000003)) result.mass_str=block->get(2000003);
+        if (block->has(2000004)) result.mass_chr=block->get(2000004);
+        if (block->has(2000005)) result.mass_b2=block->get(2000005);
+        if (block->has(2000006)) result.mass_t2=block->get(2000006);
+        if (block->has(2000011)) result.mass_er=block->get(2000011);
+        if (block->has(2000012)) result.mass_nuer=block->get(2000012);
+        if (block->has(2000013)) result.mass_mur=block->get(2000013);
+        if (block->has(2000014)) result.mass_numr=block->get(2000014);
+        if (block->has(2000015)) result.mass_tau2=block->get(2000015);
+        if (block->has(2000016)) result.mass_nutr=block->get(2000016);
+      }
+
+      // The following blocks will only appear for SUSY models so let's not waste time checking them if we're not scanning one of those.
+      if (SUSY)
+      {
+        if (const SLHAview::Block* block = view.find("ALPHA")) if (block->has()) result.alpha=block->get();
+
+        if (const SLHAview::Block* block = view.find("STOPMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (block->has(ie,je)) result.stop_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("SBOTMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (block->has(ie,je)) result.sbot_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("STAUMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (block->has(ie,je)) result.stau_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("NMIX")) for (ie=1;ie<=4;ie++) for (je=1;je<=4;je++)
+         if (block->has(ie,je)) result.neut_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("NMNMIX")) for (ie=1;ie<=5;ie++) for (je=1;je<=5;je++)
+         if (block->has(ie,je)) result.neut_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("UMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (block->has(ie,je)) result.charg_Umix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("VMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (block->has(ie,je)) result.charg_Vmix[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("GAUGE"))
+        {
+          if (block->has(1)) result.gp_Q=block->get(1);
+          if (block->has(2)) result.g2_Q=block->get(2);
+          if (block->has(3)) result.g3_Q=block->get(3);
+        }
+
+        if (const SLHAview::Block* block = view.find("YU")) for (ie=1;ie<=3;ie++) if (block->has(ie,ie)) result.yut[ie]=block->get(ie,ie);
+        if (const SLHAview::Block* block = view.find("YD")) for (ie=1;ie<=3;ie++) if (block->has(ie,ie)) result.yub[ie]=block->get(ie,ie);
+        if (const SLHAview::Block* block = view.find("YE")) for (ie=1;ie<=3;ie++) if (block->has(ie,ie)) result.yutau[ie]=block->get(ie,ie);
+
+        if (const SLHAview::Block* block = view.find("HMIX"))
+        {
+          if (block->has(1)) result.mu_Q=block->get(1);
+          if (block->has(2)) result.tanb_GUT=block->get(2);
+          if (block->has(3)) result.Higgs_VEV=block->get(3);
+          if (block->has(4)) result.mA2_Q=block->get(4);
+        }
+
+        if (const SLHAview::Block* block = view.find("NMHMIX")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.H0_mix[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("NMAMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (block->has(ie,je)) result.A0_mix[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("MSOFT"))
+        {
+          if (block->has_scale()) result.MSOFT_Q=block->scale();
+          if (block->has(1)) result.M1_Q=block->get(1);
+          if (block->has(2)) result.M2_Q=block->get(2);
+          if (block->has(3)) result.M3_Q=block->get(3);
+          if (block->has(21)) result.M2H1_Q=block->get(21);
+          if (block->has(22)) result.M2H2_Q=block->get(22);
+          if (block->has(31)) result.MeL_Q=block->get(31);
+          if (block->has(32)) result.MmuL_Q=block->get(32);
+          if (block->has(33)) result.MtauL_Q=block->get(33);
+          if (block->has(34)) result.MeR_Q=block->get(34);
+          if (block->has(35)) result.MmuR_Q=block->get(35);
+          if (block->has(36)) result.MtauR_Q=block->get(36);
+          if (block->has(41)) result.MqL1_Q=block->get(41);
+          if (block->has(42)) result.MqL2_Q=block->get(42);
+          if (block->has(43)) result.MqL3_Q=block->get(43);
+          if (block->has(44)) result.MuR_Q=block->get(44);
+          if (block->has(45)) result.McR_Q=block->get(45);
+          if (block->has(46)) result.MtR_Q=block->get(46);
+          if (block->has(47)) result.MdR_Q=block->get(47);
+          if (block->has(48)) result.MsR_Q=block->get(48);
+          if (block->has(49)) result.MbR_Q=block->get(49);
+        }
+
+        if (const SLHAview::Block* block = view.find("AU"))
+        {
+          if (block->has(1,1)) result.A_u=block->get(1,1);
+          if (block->has(2,2)) result.A_c=block->get(2,2);
+          if (block->has(3,3)) result.A_t=block->get(3,3);
+        }
+
+        if (const SLHAview::Block* block = view.find("AD"))
+        {
+          if (block->has(1,1)) result.A_d=block->get(1,1);
+          if (block->has(2,2)) result.A_s=block->get(2,2);
+          if (block->has(3,3)) result.A_b=block->get(3,3);
+        }
+
+        if (const SLHAview::Block* block = view.find("AE"))
+        {
+          if (block->has(1,1)) result.A_e=block->get(1,1);
+          if (block->has(2,2)) result.A_mu=block->get(2,2);
+          if (block->has(3,3)) result.A_tau=block->get(3,3);
+        }
+
+        if (const SLHAview::Block* block = view.find("NMSSMRUN"))
+        {
+          if (block->has(1)) result.lambdaNMSSM=block->get(1);
+          if (block->has(2)) result.kappaNMSSM=block->get(2);
+          if (block->has(3)) result.AlambdaNMSSM=block->get(3);
+          if (block->has(4)) result.AkappaNMSSM=block->get(4);
+          if (block->has(5)) result.lambdaSNMSSM=block->get(5);
+          if (block->has(6)) result.xiFNMSSM=block->get(6);
+          if (block->has(7)) result.xiSNMSSM=block->get(7);
+          if (block->has(8)) result.mupNMSSM=block->get(8);
+          if (block->has(9)) result.mSp2NMSSM=block->get(9);
+          if (block->has(10)) result.mS2NMSSM=block->get(10);
+        }
+
+        if (const SLHAview::Block* block = view.find("USQMIX")) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
+         if (block->has(ie,je)) result.sU_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("DSQMIX")) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
+         if (block->has(ie,je)) result.sD_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("SELMIX")) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
+         if (block->has(ie,je)) result.sE_mix[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("SNUMIX")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.sNU_mix[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("MSQ2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.sCKM_msq2[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("MSL2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.sCKM_msl2[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("MSD2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.sCKM_msd2[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("MSU2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.sCKM_msu2[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("MSE2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.sCKM_mse2[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("IMVCKM")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.IMCKM[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("IMVCKM")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.IMCKM[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("UPMNS")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.PMNS_U[ie][je]=block->get(ie,je);
+
+        if (const SLHAview::Block* block = view.find("TU")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.TU[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("TD")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.TD[ie][je]=block->get(ie,je);
+        if (const SLHAview::Block* block = view.find("TE")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (block->has(ie,je)) result.TE[ie][je]=block->get(ie,je);
+      }
+    }
+
+  }
+
+}
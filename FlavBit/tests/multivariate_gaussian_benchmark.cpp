@@ -0,0 +1,165 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the FlavBit multivariate Gaussian
+///  likelihoods: the original explicit inverse
+///  (ublas LU) of the total covariance at every
+///  point against Stats::MultivariateGaussian, for
+///  a constant theory covariance (b2sll, LUV), one
+///  or two varying diagonal entries (i.e. two or
+///  four changed entries between points; rank-one
+///  updates for large enough matrices, a new
+///  factorisation otherwise) and a fully changed
+///  theory covariance.
+///
+///  Usage: multivariate_gaussian_benchmark [npoints]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix.hpp>
+namespace ublas = boost::numeric::ublas;
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Utils/statistics.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/FlavBit/flav_utils.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  typedef ublas::matrix<double> matrix;
+
+  /// A random symmetric positive definite matrix with entries of order scale
+  matrix random_covariance(size_t n, double scale, std::mt19937_64& gen)
+  {
+    std::normal_distribution<double> normal(0., 1.);
+    matrix A(n, n), cov(n, n);
+    for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < n; ++j) A(i,j) = normal(gen);
+    cov = scale * ublas::prod(A, ublas::trans(A)) / double(n);
+    for (size_t i = 0; i < n; ++i) cov(i,i) += scale;
+    return cov;
+  }
+
+  /// The original FlavBit likelihood: invert the total covariance, then contract with the differences
+  double original_loglike(const matrix& cov_exp, const matrix& cov_th, const std::vector<double>& diff)
+  {
+    const size_t n = diff.size();
+    matrix cov = cov_exp;
+    cov += cov_th;
+    matrix cov_inv(n, n);
+    FlavBit::InvertMatrix(cov, cov_inv);
+    double Chi2 = 0;
+    for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < n; ++j) Chi2 += diff[i] * cov_inv(i,j) * diff[j];
+    return -0.5*Chi2;
+  }
+
+  /// Ways in which the theory covariance changes from one point to the next
+  enum change { CONSTANT, ONE_DIAGONAL, TWO_DIAGONAL, ALL };
+  const char* change_name[] = {"constant", "1 diagonal", "2 diagonal", "all"};
+
+  /// The theory covariance at point p
+  matrix theory_covariance(const matrix& base, change c, int p, std::mt19937_64& gen)
+  {
+    matrix cov_th = base;
+    if (c == CONSTANT) return cov_th;
+    if (c == ONE_DIAGONAL or c == TWO_DIAGONAL)
+    {
+      const size_t n = base.size1();
+      cov_th((p*7) % n, (p*7) % n) *= 1. + 0.1*(p % 3);
+      if (c == TWO_DIAGONAL) cov_th((p*13 + 1) % n, (p*13 + 1) % n) *= 1. + 0.05*(p % 5);
+      return cov_th;
+    }
+    std::uniform_real_distribution<double> factor(0.8, 1.2);
+    return cov_th * factor(gen);
+  }
+
+  double elapsed_ms(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const int npoints = (argc > 1 ? std::atoi(argv[1]) : 2000);
+  logger().disable();
+
+  Utils::benchmark_table table("Multivariate Gaussian likelihoods, " + std::to_string(npoints) + " points",
+                                {{"dim", 5, ""}, {"cov_th", 12, ""}, {"original [us]", 15, "%.2f"}, {"Cholesky [us]", 15, "%.2f"},
+                                 {"speedup", 9, "%.2f"}, {"max |dlnL|", 12, "%.2e"}});
+  for (size_t n : {6, 12, 24, 48})
+  {
+    std::mt19937_64 gen(n);
+    const matrix cov_exp = random_covariance(n, 1., gen);
+    const matrix cov_th_base = random_covariance(n, 0.3, gen);
+    std::normal_distribution<double> normal(0., 1.);
+
+    for (change c : {CONSTANT, ONE_DIAGONAL, TWO_DIAGONAL, ALL})
+    {
+      // Pre-generate the points, so that only the likelihoods are timed
+      std::vector<matrix> cov_th;
+      std::vector<std::vector<double> > diff(npoints, std::vector<double>(n));
+      for (int p = 0; p < npoints; ++p)
+      {
+        cov_th.push_back(theory_covariance(cov_th_base, c, p, gen));
+        for (double& d : diff[p]) d = normal(gen);
+      }
+
+      std::vector<double> lnL_original(npoints), lnL_cholesky(npoints);
+      auto start = std::chrono::steady_clock::now();
+      for (int p = 0; p < npoints; ++p) lnL_original[p] = original_loglike(cov_exp, cov_th[p], diff[p]);
+      const double t_original = elapsed_ms(start);
+
+      start = std::chrono::steady_clock::now();
+      Stats::MultivariateGaussian gaussian;
+      gaussian.set_experimental_covariance(cov_exp, n);
+      for (int p = 0; p < npoints; ++p)
+      {
+        gaussian.set_theory_covariance(cov_th[p]);
+        lnL_cholesky[p] = gaussian.loglikelihood(diff[p]);
+      }
+      const double t_cholesky = elapsed_ms(start);
+
+      double max_diff = 0;
+      for (int p = 0; p < npoints; ++p) max_diff = std::max(max_diff, std::abs(lnL_original[p] - lnL_cholesky[p]));
+      table.row(n, change_name[c], 1e3*t_original/npoints, 1e3*t_cholesky/npoints, t_original/t_cholesky, max_diff);
+    }
+  }
+
+  // A covariance that is not positive definite only invalidates the point
+  Stats::MultivariateGaussian gaussian;
+  matrix bad(2, 2);
+  bad(0,0) = 1; bad(0,1) = 2; bad(1,0) = 2; bad(1,1) = 1;
+  gaussian.set_experimental_covariance(bad, 2);
+  try
+  {
+    gaussian.loglikelihood(std::vector<double>(2, 1.));
+    std::printf("Non-positive-definite covariance: no exception raised.\n");
+    return 1;
+  }
+  catch (invalid_point_exception& e)
+  {
+    std::printf("Non-positive-definite covariance: invalid_point raised.\n");
+  }
+  return 0;
+}
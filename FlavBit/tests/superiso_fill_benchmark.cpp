@@ -0,0 +1,121 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of filling the SuperIso parameters
+///  from an MSSM spectrum: through an SLHAea object
+///  (getSLHAea, then parsed into an SLHAview),
+///  against an SLHAview filled straight from the
+///  spectrum getters (getSLHAview).  Also checks
+///  that both give the same numbers.
+///
+///  Usage: superiso_fill_benchmark [slha file] [repetitions]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Elements/spectrum.hpp"
+#include "gambit/Elements/spectrum_factories.hpp"
+#include "gambit/Models/SimpleSpectra/MSSMSimpleSpec.hpp"
+#include "gambit/FlavBit/SuperIso_parameters.hpp"
+#include "gambit/Logs/logmaster.hpp"
+#include "gambit/cmake/cmake_variables.hpp"
+
+using namespace Gambit;
+
+namespace
+{
+
+  /// Time per repetition (us) of a function
+  template <typename F>
+  double time_us(F f, int repetitions)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep) f();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+  }
+
+  /// Fill the SuperIso parameters from a view, as SI_fill does before calling SuperIso
+  void fill(parameters& result, SLHAview& view)
+  {
+    SLHAea_add(view, "MODSEL", 1, 0, "General MSSM", false);
+    std::memset(&result, 0, sizeof(parameters));
+    FlavBit::fill_SI_parameters(result, view, true);
+  }
+
+  /// Largest relative difference between the entries of two views, or 1 if an entry of a is missing from b
+  double max_difference(const SLHAview& a, const SLHAview& b)
+  {
+    double max_diff = 0;
+    for (const SLHAview::Block& block : a.blocks())
+    {
+      const SLHAview::Block* other = b.find(block.name());
+      for (size_t r = 0; r < block.nrows(); ++r)
+      {
+        const size_t n = block.row_size(r) - 1;
+        const double* x = block.row(r);
+        if (n > 2) continue;
+        const int i = (n > 0 ? int(x[0]) : 0), j = (n > 1 ? int(x[1]) : 0);
+        const bool found = (other != NULL and (n == 0 ? other->has() : n == 1 ? other->has(i) : other->has(i, j)));
+        if (not found) return 1;
+        const double y = (n == 0 ? other->get() : n == 1 ? other->get(i) : other->get(i, j));
+        if (x[n] != y) max_diff = std::max(max_diff, std::abs(x[n] - y) / std::max(std::abs(x[n]), std::abs(y)));
+      }
+    }
+    return max_diff;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const str filename = (argc > 1 ? argv[1] : GAMBIT_DIR "/DarkBit/data/benchmarks/hZ_funnel.slha2");
+  const int repetitions = (argc > 2 ? std::atoi(argv[2]) : 2000);
+  logger().disable();
+
+  const SLHAstruct slha = read_SLHA(filename);
+  const Spectrum spectrum = spectrum_from_SLHAea<MSSMSimpleSpec, SLHAstruct>(slha, slha, Spectrum::mc_info(), Spectrum::mr_info());
+  parameters result;
+
+  const double t_slhaea = time_us([&]{ SLHAstruct s = spectrum.getSLHAea(2); }, repetitions);
+  const double t_parsed = time_us([&]{ SLHAview view(spectrum.getSLHAea(2)); fill(result, view); }, repetitions);
+  const double t_direct = time_us([&]{ SLHAview view = spectrum.getSLHAview(2); fill(result, view); }, repetitions);
+  Utils::benchmark_table table("SuperIso parameters from " + filename + ", " + std::to_string(repetitions) + " repetitions",
+                                {{"", 44, ""}, {"[us/point]", 12, "%.1f"}, {"speedup", 10, "%.2f"}});
+  table.row("getSLHAea(2) alone", t_slhaea);
+  table.row("getSLHAea(2), parse to SLHAview, fill", t_parsed, 1.);
+  table.row("getSLHAview(2), fill", t_direct, t_parsed/t_direct);
+
+  // Both ways must give the same numbers (up to the 8 digits written to SLHAea)
+  const SLHAview parsed(spectrum.getSLHAea(2)), direct = spectrum.getSLHAview(2);
+  const double diff = std::max(max_difference(parsed, direct), max_difference(direct, parsed));
+  parameters from_parsed, from_direct;
+  SLHAview parsed_copy(parsed), direct_copy(direct);
+  fill(from_parsed, parsed_copy);
+  fill(from_direct, direct_copy);
+  const bool same_model = (from_parsed.model == from_direct.model and from_parsed.mass_h0 != 0 and
+                           std::abs(from_parsed.mass_h0 - from_direct.mass_h0) <= 1e-7*from_parsed.mass_h0 and
+                           std::abs(from_parsed.A_t - from_direct.A_t) <= 1e-7*std::abs(from_parsed.A_t));
+  std::printf("Largest relative difference between the two views: %.1e\n", diff);
+  if (diff > 1e-7 or not same_model)
+  {
+    std::printf("The two ways give different SuperIso parameters!\n");
+    return 1;
+  }
+  return 0;
+}
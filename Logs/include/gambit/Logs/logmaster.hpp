@@ -137,6 +137,9 @@ namespace Gambit
         /// Choose whether "Debug" tagged log messages will be ignored (i.e. not logged)
         void set_log_debug_messages(bool flag) {log_debug_messages=flag;}
 
+        /// Check whether "Debug" tagged log messages will be logged
+        bool get_log_debug_messages() const {return log_debug_messages;}
+
         /// @}
 
       private:
@@ -165,7 +168,7 @@ namespace Gambit
         int MPIrank;
         int MPIsize;
 
-        /// Max number of threads that could potentially be running
+        /// Max number of threads that could potentially be running (number of thread slots)
         int globlMaxThreads;
 
         /// @{ Variables that need to be threadsafe
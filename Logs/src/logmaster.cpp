@@ -16,6 +16,10 @@
 ///          (patscott@physics.mcgill.ca)
 ///  \date 2014 Mar, May
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -34,6 +38,7 @@
 #include "gambit/Logs/logging.hpp"
 #include "gambit/Utils/signal_helpers.hpp"
 #include "gambit/Utils/util_functions.hpp"
+#include "gambit/Utils/thread_slots.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Utils/mpiwrapper.hpp"
 #include "gambit/cmake/cmake_variables.hpp"
@@ -59,7 +64,7 @@ namespace Gambit
       , log_debug_messages(false)
       , MPIrank        (0)
       , MPIsize        (1)
-      , globlMaxThreads(omp_get_max_threads())
+      , globlMaxThreads(Utils::max_thread_slots())
       , current_module (NULL)
       , current_backend(NULL)
       , stream         (NULL)
@@ -79,7 +84,7 @@ namespace Gambit
       , log_debug_messages(false)
       , MPIrank        (0)
       , MPIsize        (1)
-      , globlMaxThreads(omp_get_max_threads())
+      , globlMaxThreads(Utils::max_thread_slots())
       , current_module (NULL)
       , current_backend(NULL)
       , stream         (NULL)
@@ -93,7 +98,8 @@ namespace Gambit
     void LogMaster::init_memory()
     {
       int n = globlMaxThreads;
-      // Reserve enough space to hold as many variables as there are slots (threads) allowed
+      // Reserve enough space to hold as many variables as there are slots (threads) allowed,
+      // including those of threads running outside the main OpenMP team (see Utils::thread_slot)
       if(stream==NULL)
       {
         #pragma omp critical(logmaster_common_init_memory_stream)
@@ -536,8 +542,8 @@ namespace Gambit
 
        // Preliminary stuff
 
-       // Get thread number
-       int i = omp_get_thread_num();
+       // Get thread slot
+       int i = Utils::thread_slot();
 
        // Automatically add the "def" (Default) tag so that the message definitely tries to go somewhere
        tags.insert(def);
@@ -554,16 +560,29 @@ namespace Gambit
          tags.insert(current_backend[i]);
        }
 
-       // If the loggers have not yet been initialised, buffer the message
-       if(omp_get_level()!=0 or not loggers_readyQ)
+       // If the loggers have not yet been initialised, buffer the message.
+       auto deliver = [&]()
        {
-         backlog[i].emplace_back(message,tags); //time stamp automatically added NOW
-       }
-       else
+         if(omp_get_level()!=0 or not loggers_readyQ)
+         {
+           backlog[i].emplace_back(message,tags); //time stamp automatically added NOW
+         }
+         else
+         {
+           empty_backlog();
+           finalsend(Message(message,tags)); //time stamp automatically added NOW
+         }
+       };
+
+       // Only one thread can be outside of a parallel block at a time, unless the dependency resolver's
+       // task-graph executor is running worker threads.  Those can empty the backlogs and write to the
+       // loggers at the same time as other threads, so then (and only then) delivery is serialised.
+       if (Utils::threads_outside_main_team() > 0)
        {
-         if(omp_get_level()==0) empty_backlog();
-         finalsend(Message(message,tags)); //time stamp automatically added NOW
+         #pragma omp critical(logmaster_send)
+         deliver();
        }
+       else deliver();
     } // end LogHub::send
 
     /// Version of send function used by buffer dump; skips all the tag modification stuff
@@ -616,20 +635,20 @@ namespace Gambit
     void LogMaster::entering_module(int i)
     {
        init_memory();
-       current_module[omp_get_thread_num()] = i;
+       current_module[Utils::thread_slot()] = i;
     }
 
     void LogMaster::leaving_module()
     {
        init_memory();
-       current_module[omp_get_thread_num()] = -1;
+       current_module[Utils::thread_slot()] = -1;
        leaving_backend();
     }
 
     void LogMaster::entering_backend(int i)
     {
        init_memory();
-       current_backend[omp_get_thread_num()] = i;
+       current_backend[Utils::thread_slot()] = i;
        *this<<"Setting current_backend="<<i;
        *this<<logs<<debug<<EOM;
     }
@@ -637,9 +656,9 @@ namespace Gambit
     {
        init_memory();
        int cb_test;
-       cb_test = current_backend[omp_get_thread_num()];
+       cb_test = current_backend[Utils::thread_slot()];
        if (cb_test == -1) return;
-       current_backend[omp_get_thread_num()] = -1;
+       current_backend[Utils::thread_slot()] = -1;
        *this<<"Restoring current_backend="<<-1;
        *this<<logs<<debug<<EOM;
     }
@@ -648,14 +667,14 @@ namespace Gambit
     void LogMaster::input(const LogTag& tag)
     {
        init_memory();
-       streamtags[omp_get_thread_num()].insert(tag);
+       streamtags[Utils::thread_slot()].insert(tag);
     }
 
     /// Handle end of message character
     void LogMaster::input(const endofmessage&)
     {
        init_memory();
-       size_t i = omp_get_thread_num();
+       size_t i = Utils::thread_slot();
        // Collect the stream and tags, then send the message
        send(stream[i].str(), streamtags[i]);
        // Clear stream and tags for next message;
@@ -667,26 +686,26 @@ namespace Gambit
     void LogMaster::input(const std::string& in)
     {
        init_memory();
-       stream[omp_get_thread_num()] << in;
+       stream[Utils::thread_slot()] << in;
     }
 
     /// Handle various stream manipulators
     void LogMaster::input(const manip1 fp)
     {
        init_memory();
-       stream[omp_get_thread_num()] << fp;
+       stream[Utils::thread_slot()] << fp;
     }
 
     void LogMaster::input(const manip2 fp)
     {
        init_memory();
-       stream[omp_get_thread_num()] << fp;
+       stream[Utils::thread_slot()] << fp;
     }
 
     void LogMaster::input(const manip3 fp)
     {
        init_memory();
-       stream[omp_get_thread_num()] << fp;
+       stream[Utils::thread_slot()] << fp;
     }
 
     /// @}
@@ -16,6 +16,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2016 Oct
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __MSSMSimpleSpec_hpp__
@@ -135,6 +139,7 @@ namespace Gambit
             virtual int get_index_offset() const;
             //virtual SLHAstruct getSLHAea(int) const; // Using SubSpectrum bass class version
             virtual void add_to_SLHAea(int, SLHAea::Coll&) const;
+            virtual void add_to_SLHAview(int, SLHAview&) const;
             virtual const std::map<int, int>& PDG_translator() const;
 
             /// Map fillers
@@ -13,6 +13,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -20,6 +24,7 @@
 #define __partmaps_hpp__
 
 #include <map>
+#include <unordered_map>
 
 #include "gambit/Utils/util_types.hpp"
 
@@ -143,6 +148,8 @@ namespace Gambit
         std::vector<std::pair<int, int> > generic;
         /// Map from long name to PDG code and context integer
         std::map<str, std::pair<int, int> > long_name_to_pdg_pair;
+        /// Hashed copy of long_name_to_pdg_pair, for fast name lookups (e.g. when filling DecayTables)
+        std::unordered_map<str, std::pair<int, int> > long_name_index;
         /// Map from PDG code and context integer to long name
         std::map<std::pair<int, int>, str> pdg_pair_to_long_name;
         /// Map from short name and index to PDG code and context integer
@@ -16,6 +16,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2016 Oct
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Models/SimpleSpectra/MSSMSimpleSpec.hpp"
@@ -418,6 +422,12 @@ namespace Gambit
         slhahelp::add_MSSM_spectrum_to_SLHAea(*this, slha, slha_version);
       }
 
+      /// Add spectrum information to an SLHAview object (without SPINFO, which holds only strings)
+      void MSSMSimpleSpec::add_to_SLHAview(int slha_version, SLHAview& slha) const
+      {
+        slhahelp::add_MSSM_spectrum_to_SLHAview(*this, slha, slha_version);
+      }
+
       /// Retrieve the PDG translation map
       const std::map<int, int>& MSSMSimpleSpec::PDG_translator() const { return slhawrap.PDG_translator(); }
 
@@ -13,6 +13,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -49,6 +53,7 @@ namespace Gambit
         model_error().raise(LOCAL_INFO,"Particle "+long_name+" is multiply defined.");
       }
       long_name_to_pdg_pair[long_name] = pdgpr;
+      long_name_index[long_name] = pdgpr;
       pdg_pair_to_long_name[pdgpr] = long_name;
     }
 
@@ -86,11 +91,12 @@ namespace Gambit
     /// Retrieve the PDG code and context integer, from the long name
     std::pair<int, int> partmap::pdg_pair(str long_name) const
     {
-      if (not has_particle(long_name))
+      auto it = long_name_index.find(long_name);
+      if (it == long_name_index.end())
       {
         model_error().raise(LOCAL_INFO,"Particle long name "+long_name+" is not in the particle database.");
       }
-      return long_name_to_pdg_pair.at(long_name);
+      return it->second;
     }
 
     /// Retrieve the PDG code and context integer, from the short name and index pair
@@ -102,14 +108,14 @@ namespace Gambit
     /// Retrieve the PDG code and context integer, from the short name and index
     std::pair<int, int> partmap::pdg_pair(str short_name, int i) const
     {
-      std::pair<str, int> shortpr(short_name, i);
-      if (not has_particle(shortpr))
+      auto it = short_name_pair_to_pdg_pair.find(std::pair<str, int>(short_name, i));
+      if (it == short_name_pair_to_pdg_pair.end())
       {
         std::ostringstream ss;
         ss << "Short name " << short_name << " and index " << i << " are not in the particle database.";
         model_error().raise(LOCAL_INFO,ss.str());
       }
-      return short_name_pair_to_pdg_pair.at(shortpr);
+      return it->second;
     }
 
     /// Retrieve the long name, from the short name and index
@@ -196,7 +202,7 @@ namespace Gambit
     /// Check if a particle is in the database, using the long name
     bool partmap::has_particle(str long_name) const
     {
-      return (long_name_to_pdg_pair.find(long_name) != long_name_to_pdg_pair.end());
+      return (long_name_index.find(long_name) != long_name_index.end());
     }
 
     /// Check if a particle is in the database, using the short name and index
@@ -14,6 +14,9 @@
 ///          (gregory.david.martinez@gmail.com)
 ///  \date ???
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
 ///
 ///  *********************************************
  
@@ -22,6 +25,7 @@
 
 #include <vector>
 #include <sstream>
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map> 
 #include <hdf5.h>
@@ -58,282 +62,167 @@ namespace Gambit
                 }
             };
 
-            struct copy_hdf5
+            /// Number of dataset entries moved per HDF5 read/write call while combining.
+            /// Bounds the memory footprint of the combine step independently of the
+            /// number and size of the temporary files.
+            static const unsigned long long COMBINE_BLOCK_LENGTH = 1048576;
+
+            /// Copy 'length' entries starting at 'in_offset' of one dataset into another
+            /// dataset starting at 'out_offset', in blocks of COMBINE_BLOCK_LENGTH.
+            struct block_copy_hdf5
             {
                 template <typename U>
-                static void run(U, hid_t &dataset_out, std::vector<hid_t> &datasets, unsigned long long &size_tot, std::vector<unsigned long long> &sizes, hid_t &old_dataset, size_t offset)
+                static void run(U, hid_t &dataset_in, hid_t &dataset_out, const unsigned long long in_offset, const unsigned long long length, const unsigned long long out_offset, unsigned long long &bytes)
                 {
-                    std::vector<U> data(size_tot);
-                    unsigned long long j = 0;
-                    
-                    if (old_dataset >= 0)
-                    {
-                        hid_t space = H5Dget_space(old_dataset);
-                        hsize_t dim_t = H5Sget_simple_extent_npoints(space);
-                        H5Sclose(space);
-                        data.resize(dim_t + size_tot);
-                        H5Dread(old_dataset, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
-                        j = dim_t;
-                        //std::cout <<"Read "<<dim_t<<" points from old dataset (into position 0)!"<<std::endl;
-                        //for(unsigned long long i=0; i<dim_t; i++) // debug
-                        //{
-                        //   std::cout<<"  "<<data[i]<<std::endl;
-                        //}
-                    }
-                    else
+                    std::vector<U> buffer(std::min(length, COMBINE_BLOCK_LENGTH));
+                    for (unsigned long long done = 0; done < length; )
                     {
-                        //std::cout << "No old dataset found!" << std::endl;
-                    }
-                    
-                    for (int i = 0, end = datasets.size(); i < end; i++)
-                    {
-                        hsize_t dim_t;
-                        if(datasets[i] >= 0)
-                        {
-                           // Check that we allocated enough space for this dataset!
-                           hid_t space = H5Dget_space(datasets[i]);
-                           dim_t = H5Sget_simple_extent_npoints(space);
-                           H5Sclose(space);
-                           if(j+dim_t > data.size())
-                           {
-                              if( (data.size() - j) < sizes[i]) // was !=, but I think it is fine so long as there isn't too *little* space. TODO: might be an odds measuring bug though since I think these should indeed be == if everything has happened correctly.
-                              {
-                                 // This is how much space we expect to have left in the buffer
-                                 // at the end. If not, something bad has happened!
-                                 std::ostringstream errmsg;
-                                 errmsg << "Error copying parameter.  Dataset in input file " << i 
-                                     << " was larger than previously measured and doesn't fit in the allocated buffer! " 
-                                     << "This is a bug in the combination tools, please report it." <<std::endl;
-                                 errmsg << "(j="<<j<<", dim_t="<<dim_t<<", data.size()="<<data.size()<<", sizes["<<i<<"]="<<sizes[i]<<")"<<std::endl;
-                                 printer_error().raise(LOCAL_INFO, errmsg.str()); 
-                              }
-                              // Just some junk buffer points at the end of the last data set.
-                              // Need to do a more careful dataset selection to chop these out so
-                              // that the data fits in our buffer (and in the space already allocated
-                              // in the output file)
-                              hid_t memspace_id, dspace_id; 
-                              std::pair<hid_t,hid_t> chunk_ids = HDF5::selectChunk(datasets[i], 0, sizes[i]);
-                              memspace_id = chunk_ids.first;
-                              dspace_id = chunk_ids.second;
-   
-                              H5Dread(datasets[i], get_hdf5_data_type<U>::type(), memspace_id, dspace_id, H5P_DEFAULT, (void *)&data[j]);                           
-                              H5Sclose(memspace_id);
-                              H5Sclose(dspace_id);
-                              //std::cout <<"Read "<<sizes[i]<<" points from dataset "<<i<<" into position "<<j<<std::endl;
-                              //std::ostringstream errmsg;
-                              //errmsg << "Error copying parameter.  Dataset in input file " << i 
-                              //    << " was larger than previously measured and doesn't fit in the allocated buffer! " 
-                              //    << "This is a bug in the combination tools, please report it." <<std::endl;
-                              //errmsg << "(j="<<j<<", dim_t="<<dim_t<<", data.size()="<<data.size()<<")"<<std::endl;
-                              //printer_error().raise(LOCAL_INFO, errmsg.str()); 
-                           }
-                           else
-                           { 
-                              // Read the whole dataset in to buffer (faster than selecting, I should think)
-                              H5Dread(datasets[i], get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[j]);                           
-                              //std::cout <<"Read "<<dim_t<<" points from dataset "<<i<<" into position "<<j<<std::endl;
-                              //for(unsigned long long k=j; k<j+dim_t; k++) // debug
-                              //{
-                              //   std::cout<<"  "<<data[k]<<std::endl;
-                              //}
-                            }
-                        }
-                        else
-                        {
-                           // dataset didn't exist for this file, skip it.
-                           dim_t = 0;
-                        }
-                       
-                        // Check size consistency
-                        if (dim_t >= sizes[i])
-                        {
-                            // Data had expected size, no problem
-                            // NOTE: Why can dim_t be larger than expected? Possible padding at end or something?
-                            j += sizes[i];
-                        }
-                        else if(dim_t==0)
+                        const unsigned long long n = std::min(length - done, COMBINE_BLOCK_LENGTH);
+
+                        std::pair<hid_t,hid_t> in_ids = HDF5::selectChunk(dataset_in, in_offset + done, n);
+                        herr_t err_read = H5Dread(dataset_in, get_hdf5_data_type<U>::type(), in_ids.first, in_ids.second, H5P_DEFAULT, (void *)&buffer[0]);
+                        H5Sclose(in_ids.first);
+                        H5Sclose(in_ids.second);
+                        if(err_read<0)
                         {
-                            // Data was missing, but also probably fine, just skip it
-                            j += sizes[i];
+                            std::ostringstream errmsg;
+                            errmsg << "Error copying parameter. H5Dread failed (offset="<<in_offset+done<<", length="<<n<<")." <<std::endl;
+                            printer_error().raise(LOCAL_INFO, errmsg.str());
                         }
-                        else
+
+                        std::pair<hid_t,hid_t> out_ids = HDF5::selectChunk(dataset_out, out_offset + done, n);
+                        herr_t err_write = H5Dwrite(dataset_out, get_hdf5_data_type<U>::type(), out_ids.first, out_ids.second, H5P_DEFAULT, (void *)&buffer[0]);
+                        H5Sclose(out_ids.first);
+                        H5Sclose(out_ids.second);
+                        if(err_write<0)
                         {
-                            // Data has some other unexpected size, error!
                             std::ostringstream errmsg;
-                            errmsg << "Error copying parameter "".  Dataset in input file " << i << " did not have the expected size" <<std::endl;
-                            errmsg << "(sizes["<<i<<"] = "<<sizes[i]<<" was less than dim_t = "<<dim_t<<")";
+                            errmsg << "Error copying parameter. H5Dwrite failed (offset="<<out_offset+done<<", length="<<n<<")." <<std::endl;
                             printer_error().raise(LOCAL_INFO, errmsg.str());
                         }
+
+                        done += n;
+                        bytes += n * sizeof(U);
                     }
-                    // Select dataspace for writing in the output file. Partial write now possible, so we
-                    // have to select the hyperslab that we want to write into
-                    hid_t memspace_id, dspace_id; 
-                    std::pair<hid_t,hid_t> chunk_ids = HDF5::selectChunk(dataset_out, offset, data.size());
-                    memspace_id = chunk_ids.first;
-                    dspace_id = chunk_ids.second;
-                    herr_t err = H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), memspace_id, dspace_id, H5P_DEFAULT, (void *)&data[0]);
-                    if(err<0)
+                }
+            };
+
+            /// Write scattered (index, value) entries into a dataset using point selections.
+            /// Entries are sorted by target index; if an index occurs more than once, the
+            /// entry supplied last wins.
+            template <typename U>
+            void write_points(hid_t dataset_out, std::vector<std::pair<unsigned long long, U> > &entries, unsigned long long &bytes)
+            {
+                std::stable_sort(entries.begin(), entries.end(),
+                  [](const std::pair<unsigned long long, U>& a, const std::pair<unsigned long long, U>& b) { return a.first < b.first; });
+
+                std::vector<hsize_t> coords;
+                std::vector<U> values;
+                coords.reserve(entries.size());
+                values.reserve(entries.size());
+                for (std::size_t k = 0; k < entries.size(); ++k)
+                {
+                    if (k+1 < entries.size() and entries[k+1].first == entries[k].first) continue;
+                    coords.push_back(entries[k].first);
+                    values.push_back(entries[k].second);
+                }
+
+                for (std::size_t done = 0; done < coords.size(); )
+                {
+                    const std::size_t n = std::min<std::size_t>(coords.size() - done, COMBINE_BLOCK_LENGTH);
+                    hid_t dspace_id = HDF5::getSpace(dataset_out);
+                    herr_t err_sel = H5Sselect_elements(dspace_id, H5S_SELECT_SET, n, &coords[done]);
+                    hsize_t dims[1] = {n};
+                    hid_t memspace_id = H5Screate_simple(1, dims, NULL);
+                    herr_t err_write = -1;
+                    if(err_sel>=0) err_write = H5Dwrite(dataset_out, get_hdf5_data_type<U>::type(), memspace_id, dspace_id, H5P_DEFAULT, (void *)&values[done]);
+                    H5Sclose(memspace_id);
+                    HDF5::closeSpace(dspace_id);
+                    if(err_sel<0 or err_write<0)
                     {
                         std::ostringstream errmsg;
-                        errmsg << "Error copying parameter. HD5write failed." <<std::endl;  
+                        errmsg << "Error copying random access parameter. Failed to write "<<n<<" scattered points into the output dataset.";
                         printer_error().raise(LOCAL_INFO, errmsg.str());
                     }
-                    //std::cout<<"Wrote "<<data.size()<<" points into output dataset at position "<<offset<<std::endl;
-                    H5Sclose(memspace_id);
-                    H5Sclose(dspace_id);
- 
-                    // Was:
-                    //H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
+                    done += n;
+                    bytes += n * sizeof(U);
                 }
-            };
+            }
 
-            struct ra_copy_hdf5
+            /// Merge the random access (RA) entries of one temporary file into the combined output.
+            /// Each valid RA entry is matched to its target row via RA_write_hash (a hash join on
+            /// the (MPIrank, pointID) pair), and the replacements are written straight to disk.
+            struct ra_scatter_hdf5
             {
                 template <typename U>
-                static void run (U, hid_t &dataset_out, hid_t &dataset2_out, std::vector<hid_t> &datasets, std::vector<hid_t> &datasets2, const unsigned long long size, const std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>& RA_write_hash, const std::vector<std::vector <unsigned long long> > &pointid, const std::vector<std::vector <unsigned long long> > &rank, const std::vector<unsigned long long> &aux_sizes, hid_t &/*old_dataset*/, hid_t &/*old_dataset2*/)
+                static void run (U, hid_t &dataset, hid_t &dataset2, hid_t &dataset_out, hid_t &dataset2_out, const unsigned long long size, const std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>& RA_write_hash, const std::vector<unsigned long long> &pointid, const std::vector<unsigned long long> &rank, const unsigned long long out_size, unsigned long long &bytes)
                 {
-                    std::vector<U> output(size, 0);
-                    std::vector<int> valids(size, 0);
-
-                    // Should no longer need the old datasets, they should have already been copied during "copy_hdf5"
-                    // if (old_dataset >= 0 && old_dataset2 >= 0)
-                    // {
-                    //     hid_t space  = HDF5::getSpace(old_dataset);
-                    //     hid_t space2 = HDF5::getSpace(old_dataset2);
-                    //     hsize_t old_size  = H5Sget_simple_extent_npoints(space);
-                    //     hsize_t old_size2 = H5Sget_simple_extent_npoints(space2);
-                    //     HDF5::closeSpace(space);
-                    //     HDF5::closeSpace(space2);
-                    //     if(old_size > size or old_size2 > size)
-                    //     {
-                    //        std::ostringstream errmsg;
-                    //        errmsg << "Error copying old dataset into buffer! The old dataset has a larger size than has been allocated for new data! (old_size="<<old_size<<", old_size2="<<old_size2<<", new_size="<<size<<")";
-                    //        printer_error().raise(LOCAL_INFO, errmsg.str());
-                    //     }
-                    //     H5Dread(old_dataset,  get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                    //     H5Dread(old_dataset2, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
-                    // }
-
-                    // Instead we just need to read in the recently-copied primary points and replace
-                    // entries as needed (TODO: would use much less memory if we just write individual replacements
-                    // straight to disk)
-                    if (dataset_out >= 0 && dataset2_out >= 0)
-                    {
-                        hid_t space  = HDF5::getSpace(dataset_out);
-                        hid_t space2 = HDF5::getSpace(dataset2_out);
-                        hsize_t out_size  = HDF5::getSimpleExtentNpoints(space);
-                        hsize_t out_size2 = HDF5::getSimpleExtentNpoints(space2);
-                        HDF5::closeSpace(space);
-                        HDF5::closeSpace(space2);
-                        if(out_size > size or out_size2 > size)
-                        {
-                           std::ostringstream errmsg;
-                           errmsg << "Error copying dataset into buffer for RA replacements! The dataset has a larger size than has been allocated for new data! (out_size="<<out_size<<", out_size2="<<out_size2<<", expected_size="<<size<<")";
-                           printer_error().raise(LOCAL_INFO, errmsg.str());
-                        }
-                        H5Dread(dataset_out,  get_hdf5_data_type<U>::type(),   H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                        H5Dread(dataset2_out, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
-                    }
-                    else
+                    hid_t space = HDF5::getSpace(dataset);
+                    unsigned long long dim_t = HDF5::getSimpleExtentNpoints(space);
+                    HDF5::closeSpace(space);
+                    if(dim_t < size or pointid.size() < size or rank.size() < size)
                     {
                         std::ostringstream errmsg;
-                        errmsg << "Error copying datasets into buffer for RA replacements! Could not open datasets (were they created properly during 'copy_hdf5' operation?).";
+                        errmsg << "Error copying aux parameter.  Input file smaller than required.";
                         printer_error().raise(LOCAL_INFO, errmsg.str());
-                    } 
-
-                    // Check that all the input given is consistent in length
-                    size_t ndsets = datasets.size();
-                    #define DSET_SIZE_CHECK(VEC) \
-                    if(VEC.size()!=ndsets) \
-                    { \
-                       std::ostringstream errmsg; \
-                       errmsg << STRINGIFY(VEC) << " vector has inconsistent size! ("<<VEC.size()<<", should be "<<ndsets<<"). This is a bug, please report it."; \
-                       printer_error().raise(LOCAL_INFO, errmsg.str()); \
                     }
-                    DSET_SIZE_CHECK(datasets2)
-                    DSET_SIZE_CHECK(aux_sizes)
-                    DSET_SIZE_CHECK(pointid)
-                    DSET_SIZE_CHECK(rank)
-                    #undef DSET_SIZE_CHECK
- 
-                    // Additional iterators to be iterated in sync with dataset iteration
-                    // We are actually only copying over one 'parameter' in this function,
-                    // but are looping over matching datasets from the temp files from
-                    // each rank. So each iteration goes to the next file, but remains
-                    // targeting the same parameter.
-                    auto st = aux_sizes.begin();
-                    auto pt = pointid.begin(); 
-                    auto ra = rank.begin();
-                    auto itv = datasets2.begin();
-                    for (auto it = datasets.begin(); it != datasets.end(); 
-                         ++it, ++itv, ++pt, ++ra, ++st)
+
+                    std::vector<std::pair<unsigned long long, U> > entries;
+                    std::vector<std::pair<unsigned long long, int> > valid_entries;
+                    std::vector<U> data;
+                    std::vector<int> valid;
+                    for (unsigned long long done = 0; done < size; )
                     {
-                       if(*it < 0)
-                       {
-                          // Dataset wasn't opened, probably some RA parameter just happened to not 
-                          // exist in a certain temporary file. Skip this dataset. Though check that
-                          // Dataset2 also wasn't opened.
-                          if(*itv >= 0)
-                          {
-                              std::ostringstream errmsg;
-                              errmsg << "dataset2 iterator ('isvalid') points to an open dataset, while dataset iterator (main dataset) does not. This is inconsistent and indicates either a bug in this combine code, or in the code which generated the datasets, please report it.";
-                              printer_error().raise(LOCAL_INFO, errmsg.str());
-                          }
-                       }
-                       else
-                       {
-                          hid_t space = H5Dget_space(*it);
-                          hssize_t dim_t = H5Sget_simple_extent_npoints(space);
-                          std::vector<U> data(dim_t);
-                          std::vector<bool> valid;
-                          Enter_HDF5<read_hdf5> (*itv, valid);
-                          H5Dread(*it, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
-                          
-                          if((unsigned long long)dim_t < *st)
-                          {
-                              std::ostringstream errmsg;
-                              errmsg << "Error copying aux parameter.  Input file smaller than required.";
-                              printer_error().raise(LOCAL_INFO, errmsg.str());
-                          }
+                        const unsigned long long n = std::min(size - done, COMBINE_BLOCK_LENGTH);
+                        data.resize(n);
+                        valid.resize(n);
+
+                        std::pair<hid_t,hid_t> ids = HDF5::selectChunk(dataset, done, n);
+                        herr_t err_read = H5Dread(dataset, get_hdf5_data_type<U>::type(), ids.first, ids.second, H5P_DEFAULT, (void *)&data[0]);
+                        H5Sclose(ids.first);
+                        H5Sclose(ids.second);
+                        std::pair<hid_t,hid_t> ids2 = HDF5::selectChunk(dataset2, done, n);
+                        herr_t err_read2 = H5Dread(dataset2, get_hdf5_data_type<int>::type(), ids2.first, ids2.second, H5P_DEFAULT, (void *)&valid[0]);
+                        H5Sclose(ids2.first);
+                        H5Sclose(ids2.second);
+                        if(err_read<0 or err_read2<0)
+                        {
+                            std::ostringstream errmsg;
+                            errmsg << "Error copying random access parameter. H5Dread failed (offset="<<done<<", length="<<n<<").";
+                            printer_error().raise(LOCAL_INFO, errmsg.str());
+                        }
 
-                          for (int i = 0, end = *st; i < end; i++)
-                          {
-                              if (valid[i])
-                              {
-                                  // Look up target for write in hash map
-                                  std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>::const_iterator ihash = RA_write_hash.find(PPIDpair((*pt)[i],(*ra)[i]));
-                                  if(ihash != RA_write_hash.end())
-                                  {
-                                      // found hash key, copy data
-                                      unsigned long long temp = ihash->second;
-                                      if(temp > size)
-                                      {
-                                          std::ostringstream errmsg;
-                                          errmsg << "Error copying random access parameter. The hash entry for "
-                                          << "pt number " << (*pt)[i] << " of rank " << (*ra)[i]  
-                                          << " targets the point outside the size of the output dataset ("<<temp<<" > "<<size<<")." 
-                                          << "This indicates"
-                                          << " a bug in the hash generation, please report it."; 
-                                          printer_error().raise(LOCAL_INFO, errmsg.str());
-                                      }
-                                      output[temp] = data[i];
-                                      valids[temp] = 1;
-                                  }
-                                  else
-                                  {
-                                     std::ostringstream errmsg;
-                                     errmsg << "Error copying random access parameter. Could not find "
-                                     << "pt number " << (*pt)[i] << " of rank " << (*ra)[i]  
-                                     << " in the output dataset (hash entry was not found).";
-                                     printer_error().raise(LOCAL_INFO, errmsg.str());
-                                  }
-                              }
-                          }
-                       } // end if
+                        for (unsigned long long i = 0; i < n; i++)
+                        {
+                            if (not valid[i]) continue;
+                            const unsigned long long row = done + i;
+                            // Look up target for write in hash map
+                            auto ihash = RA_write_hash.find(PPIDpair(pointid[row],rank[row]));
+                            if(ihash == RA_write_hash.end())
+                            {
+                                std::ostringstream errmsg;
+                                errmsg << "Error copying random access parameter. Could not find "
+                                << "pt number " << pointid[row] << " of rank " << rank[row]
+                                << " in the output dataset (hash entry was not found).";
+                                printer_error().raise(LOCAL_INFO, errmsg.str());
+                            }
+                            if(ihash->second >= out_size)
+                            {
+                                std::ostringstream errmsg;
+                                errmsg << "Error copying random access parameter. The hash entry for "
+                                << "pt number " << pointid[row] << " of rank " << rank[row]
+                                << " targets the point outside the size of the output dataset ("<<ihash->second<<" >= "<<out_size<<")."
+                                << "This indicates a bug in the hash generation, please report it.";
+                                printer_error().raise(LOCAL_INFO, errmsg.str());
+                            }
+                            entries.push_back(std::make_pair(ihash->second, data[i]));
+                            valid_entries.push_back(std::make_pair(ihash->second, 1));
+                        }
+                        done += n;
                     }
-                    
-                    H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                    H5Dwrite( dataset2_out, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
+
+                    write_points(dataset_out, entries, bytes);
+                    write_points(dataset2_out, valid_entries, bytes);
                 }
             };
 
@@ -423,6 +312,7 @@ namespace Gambit
                     printer_error().raise(LOCAL_INFO, errmsg.str());
                 }
                 
+                H5Tclose(type);
                 H5Tclose(dtype);
             }
 
@@ -15,6 +15,10 @@
 ///          (benjamin.farmer@monash.edu.au)
 ///  \date 2017 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Printers/baseprinter.hpp"
@@ -145,6 +149,27 @@ namespace Gambit
         // Search for the PPID supplied in the input data and return the index of the first match
         ulong get_index_from_PPID(const PPIDpair);
 
+        /// Entry in the (MPIrank, pointID) -> dataset index lookup table
+        struct PPIDindex
+        {
+          uint  rank;
+          ulong pointID;
+          ulong index;
+          bool operator<(const PPIDindex& r) const
+          {
+            if(rank!=r.rank) return rank < r.rank;
+            if(pointID!=r.pointID) return pointID < r.pointID;
+            return index < r.index;
+          }
+        };
+
+        /// Sorted lookup table for random access to points, built on first use
+        std::vector<PPIDindex> ppid_index;
+        bool ppid_index_built;
+
+        /// Scan the pointID and MPIrank datasets and build the sorted lookup table
+        void build_ppid_index();
+
         template<class T>
         H5P_LocalReadBufferManager<T>& get_mybuffermanager();
 
@@ -22,6 +22,10 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///  \date 2017 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Printers/printers/hdf5printer/hdf5_combine_tools.hpp"
@@ -29,6 +33,9 @@
 #include "gambit/Printers/printers/hdf5printer/DataSetInterfaceScalar.hpp"
 #include "gambit/Utils/util_functions.hpp"
 
+#include <chrono>
+#include <cstdio>
+
 // flag to trigger debug output
 //#define COMBINE_DEBUG
 
@@ -505,10 +512,16 @@ namespace Gambit
             void hdf5_stuff::Enter_Aux_Parameters(const std::string &file, bool resume)
             {
                 std::vector<std::vector<unsigned long long>> ranks, ptids;
+                std::vector<std::vector<bool>> ra_valids;
                 std::vector<unsigned long long> aux_sizes;
 
+                // Throughput monitoring
+                const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+                unsigned long long bytes_copied = 0;
+
                 hid_t old_file = -1;
                 hid_t old_group = -1;
+                unsigned long long old_size = 0; // Length of the previous combined datasets (written to the start of the output)
                 //std::cout << "resume? " << resume <<std::endl;
                 if (resume)
                 {
@@ -516,9 +529,13 @@ namespace Gambit
                     if(Utils::file_exists(file))
                     {
                        std::string filebak = file + ".temp.bak";
-                       std::system(("mv " + file + " " + filebak).c_str());
-                       //old_file = H5Fopen((file + ".temp.bak").c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
-                       old_file = HDF5::openFile(file + ".temp.bak", false, 'r');
+                       if(std::rename(file.c_str(), filebak.c_str()) != 0)
+                       {
+                           std::ostringstream errmsg;
+                           errmsg << "Error combining HDF5 temporary data! Failed to move the previous combined output file ("<<file<<") to "<<filebak<<"." << std::endl;
+                           printer_error().raise(LOCAL_INFO, errmsg.str());
+                       }
+                       old_file = HDF5::openFile(filebak, false, 'r');
                        if(old_file<0)
                        {
                            std::ostringstream errmsg;
@@ -542,16 +559,13 @@ namespace Gambit
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
                        hid_t space = HDF5::getSpace(old_dataset);
-                       hsize_t extra = HDF5::getSimpleExtentNpoints(space);
+                       old_size = HDF5::getSimpleExtentNpoints(space);
                        HDF5::closeSpace(space);
                        HDF5::closeDataset(old_dataset);
-                       size_tot += extra;
+                       size_tot += old_size;
 
                        // Check for parameters not found in the newer temporary files.
                        // (should not be any aux parameters in here, so don't check for them)
-                       //std::vector<std::string> names;
-                       //H5Literate (old_group, H5_INDEX_NAME, H5_ITER_NATIVE, NULL, op_func, (void *) &names);
-
                        std::vector<std::string> names = get_dset_names(old_group);
 
                        for (auto it = names.begin(), end = names.end(); it != end; ++it)
@@ -593,7 +607,6 @@ namespace Gambit
                 }
                 // else everything is cool
 
-                //hid_t new_file = H5Fcreate(file.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
                 hid_t new_file = HDF5::openFile(file,false,'w'); // No overwrite allowed, this file shouldn't exist
                 if(new_file<0)
                 {
@@ -606,19 +619,18 @@ namespace Gambit
 
                 if (aux_param_names.size() > 0) for (unsigned long i=0; i<aux_groups.size(); ++i)
                 {
-                     std::vector<unsigned long long> rank, ptid;
+                    std::vector<unsigned long long> rank, ptid;
 
                     // Reopen temp files and reaquire group IDs
-                    std::string fname = get_fname(i);
-                    hid_t file_id = HDF5::openFile(fname);
-                    files[i] = file_id; // keep file ID up to date
-                    hid_t aux_group_id = HDF5::openGroup(file_id, group_name+"/RA", true); // final argument prevents group from being created
-                    hid_t dataset;
-                    if(aux_group_id < 0)
+                    hid_t file_id = -1;
+                    hid_t aux_group_id = -1;
+                    hid_t dataset = -1;
+                    if(files[i]>=0)
                     {
-                       dataset = -1; // If group doesn't exist, dataset doesn't either
+                       file_id = HDF5::openFile(get_fname(i));
+                       aux_group_id = HDF5::openGroup(file_id, group_name+"/RA", true); // final argument prevents group from being created
                     }
-                    else
+                    if(aux_group_id >= 0)
                     {
                        HDF5::errorsOff();
                        dataset = HDF5::openDataset(aux_group_id, "RA_MPIrank", true);
@@ -627,9 +639,10 @@ namespace Gambit
 
                     if(dataset < 0) // If key dataset doesn't exist, set aux size to zero for this rank
                     {
-                       // Need to push back empty entries, because they need to remain synced with the datasets vectors
+                       // Need to push back empty entries, because they need to remain synced with the files vector
                        ranks.push_back(rank);
                        ptids.push_back(ptid);
+                       ra_valids.push_back(std::vector<bool>());
                        aux_sizes.push_back(0);
                     }
                     else
@@ -643,270 +656,179 @@ namespace Gambit
                        if(rank.size() != ptid.size())
                        {
                            std::ostringstream errmsg;
-                           errmsg << "Extracted RA_MPIrank and RA_pointID are not the same size! ("<<ranks.size()<<"!="<<ptid.size()<<")";
+                           errmsg << "Extracted RA_MPIrank and RA_pointID are not the same size! ("<<rank.size()<<"!="<<ptid.size()<<")";
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
 
-                       hid_t dataspace = H5Dget_space(dataset2);
-                       hid_t dataspace2 = H5Dget_space(dataset3);
-                       hssize_t size = H5Sget_simple_extent_npoints(dataspace);
-                       hssize_t size2 = H5Sget_simple_extent_npoints(dataspace2);
-
                        std::vector<bool> valids;
                        Enter_HDF5<read_hdf5>(dataset3, valids);
 
-                       if (size != size2)
+                       if (valids.size() != ptid.size())
                        {
                            std::ostringstream errmsg;
                            errmsg << "RA_pointID and RA_pointID_isvalid are not the same size.";
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
 
-                       // Make sure to only add the isvalid points!
-                       std::vector<unsigned long long> valid_rank;
-                       std::vector<unsigned long long> valid_ptid;
-                       for(size_t vi=0; vi<valids.size(); vi++)
-                       {
-                          if(valids[vi])
-                          {
-                             valid_rank.push_back(rank[vi]);
-                             valid_ptid.push_back(ptid[vi]);
-                          }
-                       }
-                       ranks.push_back(valid_rank);
-                       ptids.push_back(valid_ptid);
+                       // Trim trailing invalid entries
+                       unsigned long long size = valids.size();
+                       while (size > 0 and not valids[size-1]) --size;
+                       rank.resize(size);
+                       ptid.resize(size);
+                       valids.resize(size);
 
-                       for (auto it = valids.end()-1; size > 0; --it)
-                       {
-                           if (*it)
-                               break;
-                           else
-                               --size;
-                       }
+                       // Keep the IDs row-aligned with the RA datasets; invalid rows are skipped
+                       // by checking the per-parameter validity flags during the merge.
+                       ranks.push_back(rank);
+                       ptids.push_back(ptid);
+                       ra_valids.push_back(valids);
                        aux_sizes.push_back(size);
 
-                       HDF5::closeSpace(dataspace);
-                       HDF5::closeSpace(dataspace2);
                        HDF5::closeDataset(dataset);
                        HDF5::closeDataset(dataset2);
                        HDF5::closeDataset(dataset3);
                     }
                     // Close resources
-                    HDF5::closeGroup(aux_group_id);
-                    HDF5::closeFile(file_id);
+                    if(aux_group_id>=0) HDF5::closeGroup(aux_group_id);
+                    if(file_id>=0)      HDF5::closeFile(file_id);
                 }
 
-                // TODO: Ack, getting a "too many open files" error. I guess we need
-                // to do this in batches, but that's quite a pain to arrange.
-                const size_t BATCH_SIZE = 50;
+                // Primary datasets are combined as a streaming concatenation: previous combined
+                // output (if any) goes first, followed by each temporary file in rank order. Only
+                // one input file is open at any time, and data is moved in fixed-size hyperslab
+                // blocks (see block_copy_hdf5), so neither open file handles nor memory grow with
+                // the number of ranks. Output datasets are created the first time a parameter is
+                // encountered.
+                std::unordered_set<std::string> created;
 
-                // Compute number of batches required
-                size_t N_BATCHES = files.size() / BATCH_SIZE;
-                size_t remainder = files.size() % BATCH_SIZE;
-                if(remainder > 0)
+                if(old_group>=0)
                 {
-                   N_BATCHES += 1;
+                    std::cout << "  Copying previous combined output...             \r"<<std::flush;
+                    for (auto it = param_names.begin(), end = param_names.end(); it != end; ++it)
+                    {
+                        HDF5::errorsOff();
+                        hid_t old_dataset  = HDF5::openDataset(old_group, *it, true); // Allow fail; may be no previous combined output
+                        hid_t old_dataset2 = HDF5::openDataset(old_group, *it + "_isvalid", true);
+                        HDF5::errorsOn();
+                        if(old_dataset>=0 and old_dataset2>=0)
+                        {
+                            hid_t type  = H5Dget_type(old_dataset);
+                            hid_t type2 = H5Dget_type(old_dataset2);
+                            setup_hdf5_points(new_group, type, type2, size_tot, *it);
+                            H5Tclose(type);
+                            H5Tclose(type2);
+                            created.insert(*it);
+
+                            hid_t space = HDF5::getSpace(old_dataset);
+                            unsigned long long dim_t = HDF5::getSimpleExtentNpoints(space);
+                            HDF5::closeSpace(space);
+                            const unsigned long long length = std::min(dim_t, old_size);
+                            const unsigned long long start = 0;
+
+                            hid_t dataset_out  = HDF5::openDataset(new_group, *it);
+                            hid_t dataset2_out = HDF5::openDataset(new_group, (*it)+"_isvalid");
+                            Enter_HDF5<block_copy_hdf5>(old_dataset,  dataset_out,  start, length, start, bytes_copied);
+                            Enter_HDF5<block_copy_hdf5>(old_dataset2, dataset2_out, start, length, start, bytes_copied);
+                            HDF5::closeDataset(dataset_out);
+                            HDF5::closeDataset(dataset2_out);
+                        }
+                        else
+                        {
+                            std::cout << "Failed to open previous combined dataset for parameter "<<*it<<std::endl;
+                        }
+                        if(old_dataset>=0)  HDF5::closeDataset(old_dataset);
+                        if(old_dataset2>=0) HDF5::closeDataset(old_dataset2);
+                    }
                 }
 
-                int counter = 1;
-                for (auto it = param_names.begin(), end = param_names.end(); it != end; ++it, ++counter)
+                for (size_t i = 0, nfiles = files.size(); i < nfiles; i++)
                 {
                     // Simple Progress monitor
-                    std::cout << "  Combining primary datasets... "<<int(100*counter/param_names.size())<<"%   (copied "<<counter<<" parameters of "<<param_names.size()<<")        \r"<<std::flush;
+                    std::cout << "  Combining primary datasets... "<<int(100*(i+1)/nfiles)<<"%   (copied "<<i+1<<" files of "<<nfiles<<")        \r"<<std::flush;
 
-                    //std::vector<hid_t> file_ids(files.size(),-1);
-                    //std::vector<hid_t> group_ids(files.size(),-1);
-                    //std::vector<hid_t> datasets(files.size(),-1);
-                    //std::vector<hid_t> datasets2(files.size(),-1);
+                    // Skip this file if it wasn't successfully opened earlier
+                    if(files[i]<0) continue;
 
-                    size_t offset = 0; // where to begin writing the next batch in output datasets
-                    for(size_t batch_i = 0, end = N_BATCHES; batch_i < end; batch_i++)
+                    std::string fname = get_fname(i);
+                    hid_t file_id  = HDF5::openFile(fname);
+                    hid_t group_id = HDF5::openGroup(file_id, group_name, true); // final argument prevents group from being created
+                    if(group_id>=0)
                     {
-                        size_t pc_offset = 0; // possible extra offset due to previous combined datasets. Only batch 0 will use this.
-                        long long valid_dset = -1; // index of a validly opened dataset (-1 if none)
-                        size_t THIS_BATCH_SIZE = BATCH_SIZE;
-                        std::vector<unsigned long long> batch_sizes(BATCH_SIZE,0);
-                         // IDs for this batch
-                        std::vector<hid_t> file_ids (THIS_BATCH_SIZE,-1);
-                        std::vector<hid_t> group_ids(THIS_BATCH_SIZE,-1);
-                        std::vector<hid_t> datasets (THIS_BATCH_SIZE,-1);
-                        std::vector<hid_t> datasets2(THIS_BATCH_SIZE,-1);
-
-                        // Collect all the HDF5 ids need to combine this parameter for this batch of files
-                        if(remainder>0 and batch_i==N_BATCHES-1) THIS_BATCH_SIZE = remainder; // Last batch is incomplete
-                        //std::cout << "   Processing temp files "<<batch_i*BATCH_SIZE<<" to "<<batch_i*BATCH_SIZE+THIS_BATCH_SIZE<<std::endl;
-                        //std::cout << "BATCH "<< batch_i << std::endl;
-                        for (size_t file_i = 0, end = THIS_BATCH_SIZE; file_i < end; file_i++)
-                        {
-                            size_t i = file_i + batch_i * BATCH_SIZE;
-
-                            //std::cout << i << " ("<<(files[i]>=0)<<"), ";
-
-                            hid_t file_id  = -1;
-                            hid_t group_id = -1;
-                            hid_t dataset = -1;
-                            hid_t dataset2 = -1;
-                            batch_sizes[file_i] = sizes[i]; // Collect pre-measured dataset sizes for this batch
-
-                            // Skip this file if it wasn't successfully opened earlier
-                            if(files[i]>=0)
-                            {
-                                // Reopen files
-                                // NOTE: RAM problems largely solved, but footprint could be lowered even more if we only open one file at a time.
-                                std::string fname = get_fname(i);
-                                if(not HDF5::checkFileReadable(fname))
-                                {
-                                  std::cout <<"files["<<i<<"] = "<<files[i]<<std::endl;
-                                  std::cerr<<"WARNING! "<<fname<<" was not readable! This should have been caught earlier!"<<std::endl;
-                                }
-                                file_id = HDF5::openFile(fname);
-                                files[i] = file_id;
-                                group_id = HDF5::openGroup(file_id, group_name, true); // final argument prevents group from being created
-                                if(group_id>=0)
-                                {
-                                   HDF5::errorsOff();
-                                   dataset  = HDF5::openDataset(group_id, *it, true); // Allow fail; not all parameters must exist in all temp files
-                                   dataset2 = HDF5::openDataset(group_id, *it + "_isvalid", true);
-                                   HDF5::errorsOn();
-                                }
-
-                                if(dataset>=0)
-                                {
-                                   if(dataset2>=0) valid_dset = file_i; // Use this one to determine dataset types for this batch (TODO: will be bad if it doesn't match other batches! could make this more robust)
-                                   else
-                                   {
-                                      std::ostringstream errmsg;
-                                      errmsg << "Error opening dataset '"<<*it<<"_isvalid' from temp file "<<i<<"! Main dataset was opened, but 'isvalid' dataset failed to open! It may be corrupted.";
-                                      printer_error().raise(LOCAL_INFO, errmsg.str());
-                                   }
-                                }
-                            }
-
-                            datasets [file_i] = dataset;
-                            datasets2[file_i] = dataset2;
-                            file_ids [file_i] = file_id;
-                            group_ids[file_i] = group_id;
-                        }
-
-                        // Get id for old combined output for this parameter
-                        hid_t old_dataset = -1, old_dataset2 = -1;
-                        if (resume and batch_i==0) // Only copy old dataset once, during first batch of files
+                        const unsigned long long in_offset = 0;
+                        const unsigned long long out_offset = old_size + cum_sizes[i];
+                        for (auto it = param_names.begin(), end = param_names.end(); it != end; ++it)
                         {
-                            //std::cout << "Opening previous combined dataset for parameter "<<*it<<std::endl;
                             HDF5::errorsOff();
-                            old_dataset  = HDF5::openDataset(old_group, *it, true); // Allow fail; may be no previous combined output
-                            old_dataset2 = HDF5::openDataset(old_group, *it + "_isvalid", true);
+                            hid_t dataset  = HDF5::openDataset(group_id, *it, true); // Allow fail; not all parameters must exist in all temp files
+                            hid_t dataset2 = HDF5::openDataset(group_id, *it + "_isvalid", true);
                             HDF5::errorsOn();
-                            if(old_dataset<0) std::cout << "Failed to open previous combined dataset for parameter "<<*it<<std::endl; // debugging
-                            if(old_dataset>0)
-                            {
-                                hid_t space = H5Dget_space(old_dataset);
-                                hsize_t dim_t = H5Sget_simple_extent_npoints(space);
-                                H5Sclose(space);
-                                pc_offset = dim_t; // Record size of old combined dataset, needed to get correct offset for next batch
-                            }
-                        }
 
-                        // With new batching system, could get a batch with no data for this parameter. This is ok,
-                        // so we just skip it.
-                        // TODO: Could put in a check to make sure that SOME batch copies data.
-                        // This should happen though, since the parameter name must have been retrieved from *some*
-                        // file or other, so it would just be double-checking that this worked correctly.
-                        if(valid_dset>=0 or old_dataset>=0)
-                        {
-                            hid_t type, type2;
-                            if(valid_dset<0)
+                            if(dataset<0)
                             {
-                               // Parameter not in any of the new temp files, must only be in the old combined output, get type from there.
-                               type  = H5Dget_type(old_dataset);
-                               type2 = H5Dget_type(old_dataset2);
+                                if(dataset2>=0) HDF5::closeDataset(dataset2);
+                                continue;
                             }
-                            else
+                            if(dataset2<0)
                             {
-                               // Get the type from a validly opened dataset in temp file
-                               type  = H5Dget_type(datasets[valid_dset]);
-                               type2 = H5Dget_type(datasets2[valid_dset]);
+                                std::ostringstream errmsg;
+                                errmsg << "Error opening dataset '"<<*it<<"_isvalid' from temp file "<<i<<"! Main dataset was opened, but 'isvalid' dataset failed to open! It may be corrupted.";
+                                printer_error().raise(LOCAL_INFO, errmsg.str());
                             }
-                            if(type<0 or type2<0)
+
+                            if(created.find(*it) == created.end())
                             {
-                               std::ostringstream errmsg;
-                               errmsg << "Failed to detect type for dataset '"<<*it<<"'! The dataset is supposedly valid, so this does not make sense. It must be a bug, please report it. (valid_dset="<<valid_dset<<")";
-                               printer_error().raise(LOCAL_INFO, errmsg.str());
+                                hid_t type  = H5Dget_type(dataset);
+                                hid_t type2 = H5Dget_type(dataset2);
+                                if(type<0 or type2<0)
+                                {
+                                   std::ostringstream errmsg;
+                                   errmsg << "Failed to detect type for dataset '"<<*it<<"'! The dataset is supposedly valid, so this does not make sense. It must be a bug, please report it. (file "<<i<<")";
+                                   printer_error().raise(LOCAL_INFO, errmsg.str());
+                                }
+                                setup_hdf5_points(new_group, type, type2, size_tot, *it);
+                                H5Tclose(type);
+                                H5Tclose(type2);
+                                created.insert(*it);
                             }
 
-                            if(batch_i==0) // Only want to create the output dataset once!
+                            // Check size consistency
+                            hid_t space = HDF5::getSpace(dataset);
+                            unsigned long long dim_t = HDF5::getSimpleExtentNpoints(space);
+                            HDF5::closeSpace(space);
+                            if(dim_t != 0 and dim_t < sizes[i])
                             {
-                               // Create datasets
-                               //std::cout<<"Creating dataset '"<<*it<<"' in file:group "<<file<<":"<<group_name<<std::endl;
-                               setup_hdf5_points(new_group, type, type2, size_tot, *it);
+                                // Data has some unexpected size, error!
+                                // (Larger is fine; the excess is unused buffer space at the end of the dataset.)
+                                std::ostringstream errmsg;
+                                errmsg << "Error copying parameter '"<<*it<<"'.  Dataset in input file " << i << " did not have the expected size" <<std::endl;
+                                errmsg << "(dim_t = "<<dim_t<<" was less than sizes["<<i<<"] = "<<sizes[i]<<")";
+                                printer_error().raise(LOCAL_INFO, errmsg.str());
                             }
 
-                            // Reopen dataset for writing
-                            hid_t dataset_out   = HDF5::openDataset(new_group, *it);
-                            hid_t dataset2_out  = HDF5::openDataset(new_group, (*it)+"_isvalid");
-                            //std::cout << "Copying parameter "<<*it<<std::endl; // debug
-
-                            // Measure total size of datasets for this batch of files
-                            // (not counting previous combined output, which will be copied in batch 0)
-                            unsigned long long batch_size_tot = 0;
-                            for(auto it = batch_sizes.begin(); it != batch_sizes.end(); ++it)
+                            if(dim_t != 0 and sizes[i] > 0)
                             {
-                               batch_size_tot += *it;
+                                hid_t dataset_out  = HDF5::openDataset(new_group, *it);
+                                hid_t dataset2_out = HDF5::openDataset(new_group, (*it)+"_isvalid");
+                                Enter_HDF5<block_copy_hdf5>(dataset,  dataset_out,  in_offset, sizes[i], out_offset, bytes_copied);
+                                Enter_HDF5<block_copy_hdf5>(dataset2, dataset2_out, in_offset, sizes[i], out_offset, bytes_copied);
+                                HDF5::closeDataset(dataset_out);
+                                HDF5::closeDataset(dataset2_out);
                             }
 
-                            //Enter_HDF5<copy_hdf5>(dataset_out, datasets, size_tot_l, sizes, old_dataset);
-                            //Enter_HDF5<copy_hdf5>(dataset2_out, datasets2, size_tot_l, sizes, old_dataset2);
-
-                            // Do the copy!!!
-                            Enter_HDF5<copy_hdf5>(dataset_out, datasets, batch_size_tot, batch_sizes, old_dataset, offset);
-                            Enter_HDF5<copy_hdf5>(dataset2_out, datasets2, batch_size_tot, batch_sizes, old_dataset2, offset);
-
-                            // Close resources
-                            HDF5::closeDataset(dataset_out);
-                            HDF5::closeDataset(dataset2_out);
-
-                            // Move offset so that next batch is written to correct place in output file
-                            offset += batch_size_tot + pc_offset;
-                        }
-                        else
-                        {
-                            std::cout << "No datasets found for parameter "<<*it<<" in file batch "<<batch_i<<". Moving on to next batch since there seems to be nothing to copy in this one." << std::endl;
-                        }
-
-                        // Close files etc. associated with this batch
-                        for (size_t file_i = 0, end = file_ids.size(); file_i < end; file_i++)
-                        {
-                            if(datasets[file_i]>=0)  HDF5::closeDataset(datasets[file_i]);
-                            if(datasets2[file_i]>=0) HDF5::closeDataset(datasets2[file_i]);
-                            if(group_ids[file_i]>=0) HDF5::closeGroup(group_ids[file_i]);
-                            if(file_ids[file_i]>=0)  HDF5::closeFile(file_ids[file_i]);
+                            HDF5::closeDataset(dataset);
+                            HDF5::closeDataset(dataset2);
                         }
-
-                    } // end batch, begin processing next batch of files.
+                        HDF5::closeGroup(group_id);
+                    }
+                    HDF5::closeFile(file_id);
                 }
                 std::cout << "  Combining primary datasets... Done.                                 "<<std::endl;
 
-                // Debug: early exit to check what primary combined output looks like
-                // Flush and close output file
-                // H5Fflush(new_file, H5F_SCOPE_GLOBAL);
-                // HDF5::closeGroup(new_group);
-                // HDF5::closeFile(new_file);
-                // exit(0);
-
-                // TODO! I have not yet implemented batch copying for the RA datasets!
-
-                // Ben: NEW. Before copying RA points, we need to figure out a map between them
-                // and their targets in the output dataset. That means we need to read through
-                // the output dataset and read in all the pointID/MPI pairs.
-                // We only need to do this once and create a big hash table to use while copying.
-                // It would be better to do all the copying in chunks, and then we would also
-                // only need chunks of this hash table at a time, but Greg didn't write this
-                // code with chunked writing in mind. TODO: Should modify the code to do this.
-
-                // We already know all the RA rank/ptID pairs, so just need to scan the output
-                // datasets for the matching pairs, and record their indices.
-
-                // Start with a list of ID pairs to be matched
+                // Before copying RA points, we need to figure out a map between them and their
+                // targets in the output dataset. We already know all the RA rank/ptID pairs, so
+                // just need to scan the output datasets (in chunks) for the matching pairs, and
+                // record their indices. The RA entries are then hash-joined against this table
+                // one temporary file at a time and written straight to disk.
                 if(not custom_mode)
                 {  // ranks and pointIDs not guaranteed to be unique in custom mode! RA datasets to be ignored, should be done prior to custom combining.
                    std::unordered_set<PPIDpair,PPIDHash,PPIDEqual> left_to_match;
@@ -914,11 +836,7 @@ namespace Gambit
                    {
                       for(std::size_t j=0; j<ranks[i].size(); ++j)
                       {
-                         //if(ranks[i][j]==0 and ptids[i][j]==0)
-                         //{
-                         //   std::cout<<"Added r="<<ranks[i][j]<<", p="<<ptids[i][j]<<" to hash search requests"<<std::endl;
-                         //}
-                         left_to_match.insert(PPIDpair(ptids[i][j],ranks[i][j]));
+                         if(ra_valids[i][j]) left_to_match.insert(PPIDpair(ptids[i][j],ranks[i][j]));
                       }
                    }
 
@@ -926,119 +844,78 @@ namespace Gambit
                    {
                       std::unordered_map<PPIDpair, unsigned long long, PPIDHash,PPIDEqual> RA_write_hash(get_RA_write_hash(new_group, left_to_match));
 
-                      /// Now copy the RA datasets
-                      counter = 1; //reset counter
-                      for (auto it = aux_param_names.begin(), end = aux_param_names.end(); it != end; ++it, ++counter)
+                      // Merge the RA datasets, one temporary file at a time
+                      for (size_t i = 0, nfiles = aux_groups.size(); i < nfiles; i++)
                       {
-                          std::cout << "  Combining auxilliary datasets... "<<int(100*counter/aux_param_names.size())<<"%    (merged "<<counter<<" parameters of "<<aux_param_names.size()<<")         \r"<<std::flush;
-                          std::vector<hid_t> file_ids, group_ids, datasets, datasets2;
-                          int valid_dset  = -1; // index of a validly opened dataset (-1 if none)
+                          std::cout << "  Combining auxilliary datasets... "<<int(100*(i+1)/nfiles)<<"%    (merged "<<i+1<<" files of "<<nfiles<<")         \r"<<std::flush;
 
-                          #ifdef COMBINE_DEBUG
-                          std::cerr << "  Preparing to copy dataset '"<<*it<<"'" << std::endl;
-                          #endif
+                          if(files[i]<0 or aux_sizes[i]==0) continue;
 
-                          for (int i = 0, end = aux_groups.size(); i < end; i++)
+                          hid_t file_id  = HDF5::openFile(get_fname(i));
+                          hid_t group_id = HDF5::openGroup(file_id, group_name+"/RA", true); // final argument prevents group from being created
+                          if(group_id>=0)
                           {
-                              hid_t file_id  = -1;
-                              hid_t group_id = -1;
-                              hid_t dataset = -1;
-                              hid_t dataset2 = -1;
-
-                              // Skip this file if it wasn't successfully opened earlier
-                              if(files[i]>-1)
+                              for (auto it = aux_param_names.begin(), end = aux_param_names.end(); it != end; ++it)
                               {
-                                  // Reopen files
-                                  std::string fname = get_fname(i);
-                                  file_id = HDF5::openFile(fname);
-                                  files[i] = file_id;
-                                  group_id = HDF5::openGroup(file_id, group_name+"/RA", true); // final argument prevents group from being created
-
-                                  // Dataset may not exist, and thus fail to open. We will check its status
-                                  // later on and ignore it where needed.
-                                  if(group_id>=0)
+                                  #ifdef COMBINE_DEBUG
+                                  std::cerr << "  Preparing to copy dataset '"<<*it<<"' from file "<<i << std::endl;
+                                  #endif
+
+                                  // Dataset may not exist, and thus fail to open.
+                                  HDF5::errorsOff();
+                                  hid_t dataset  = HDF5::openDataset(group_id, *it, true); // Allow fail; not all parameters must exist in all temp files
+                                  hid_t dataset2 = HDF5::openDataset(group_id, *it + "_isvalid", true);
+                                  HDF5::errorsOn();
+
+                                  if(dataset<0)
                                   {
-                                     HDF5::errorsOff();
-                                     dataset  = HDF5::openDataset(group_id, *it, true); // Allow fail; not all parameters must exist in all temp files
-                                     dataset2 = HDF5::openDataset(group_id, *it + "_isvalid", true);
-                                     HDF5::errorsOn();
+                                      if(dataset2>=0)
+                                      {
+                                          std::ostringstream errmsg;
+                                          errmsg << "dataset2 ('isvalid') is open, while the main dataset is not. This is inconsistent and indicates either a bug in this combine code, or in the code which generated the datasets, please report it.";
+                                          printer_error().raise(LOCAL_INFO, errmsg.str());
+                                      }
+                                      continue;
                                   }
-
-                                  if(dataset>=0)
+                                  if(dataset2<0)
                                   {
-                                     if(dataset2>=0) valid_dset = i;
-                                     else
-                                     {
-                                        std::ostringstream errmsg;
-                                        errmsg << "Error opening dataset '"<<*it<<"_isvalid' from temp file "<<i<<"! Main dataset was opened, but 'isvalid' dataset failed to open! It may be corrupted.";
-                                        printer_error().raise(LOCAL_INFO, errmsg.str());
-                                     }
+                                      std::ostringstream errmsg;
+                                      errmsg << "Error opening dataset '"<<*it<<"_isvalid' from temp file "<<i<<"! Main dataset was opened, but 'isvalid' dataset failed to open! It may be corrupted.";
+                                      printer_error().raise(LOCAL_INFO, errmsg.str());
                                   }
-                              }
-                              datasets.push_back(dataset);
-                              datasets2.push_back(dataset2);
-                              file_ids.push_back(file_id);
-                              group_ids.push_back(group_id);
-                          }
 
-                          hid_t old_dataset = -1, old_dataset2 = -1;
-                          // Actually, I think there is now no need to copy the old data here. It should
-                          // already be copied as part of the primary dataset copying.
-                          // if (resume)
-                          // {
-                          //     // Dataset may not exist, and thus fail to open. We will check its status
-                          //     // later on and ignore it where needed.
-                          //     HDF5::errorsOff();
-                          //     old_dataset  = HDF5::openDataset(old_group, *it, true);
-                          //     old_dataset2 = HDF5::openDataset(old_group, *it + "_isvalid", true);
-                          //     HDF5::errorsOn();
-                          // }
-
-                          // If the aux parameter was not also copied as a primary parameter then we need to create a new
-                          // dataset for it here. Otherwise one should already exist.
-                          if(param_set.find(*it) == param_set.end())
-                          {
-                             #ifdef COMBINE_DEBUG
-                             std::cerr << "  No output dataset for '"<<*it<<"' found amongst those created during copying of primary parameters, preparing to create it." << std::endl;
-                             #endif
-
-                             hid_t type, type2;
-                             if(valid_dset<0)
-                             {
-                                // No valid dset open, but we are supposed to copy something? Error.
-                                std::ostringstream errmsg;
-                                errmsg << "Error copying RA points for dataset '"<<*it<<"'. No valid datasets could be opened, though they were detected in the temp files. They may be corrupted.";
-                                printer_error().raise(LOCAL_INFO, errmsg.str());
-                             }
-                             else
-                             {
-                                // Get the type from a validly opened dataset in temp file
-                                type  = H5Dget_type(datasets[valid_dset]);
-                                type2 = H5Dget_type(datasets2[valid_dset]);
-                                if(type<0 or type2<0)
-                                {
-                                   std::ostringstream errmsg;
-                                   errmsg << "Failed to detect type for RA dataset '"<<*it<<"'! The dataset is supposedly valid, so this does not make sense. It must be a bug, please report it.";
-                                   printer_error().raise(LOCAL_INFO, errmsg.str());
-                                }
-                             }
-                             // Create new dataset
-                             setup_hdf5_points(new_group, type, type2, size_tot, *it);
-                          }
-                          // Reopen output datasets for copying
-                          hid_t dataset_out  = HDF5::openDataset(new_group, *it);
-                          hid_t dataset2_out = HDF5::openDataset(new_group, (*it)+"_isvalid");
-                          Enter_HDF5<ra_copy_hdf5>(dataset_out, dataset2_out, datasets, datasets2, size_tot, RA_write_hash, ptids, ranks, aux_sizes, old_dataset, old_dataset2);
+                                  // If the aux parameter was not also copied as a primary parameter then we need to create a new
+                                  // dataset for it here. Otherwise one should already exist.
+                                  if(created.find(*it) == created.end())
+                                  {
+                                      #ifdef COMBINE_DEBUG
+                                      std::cerr << "  No output dataset for '"<<*it<<"' found amongst those created during copying of primary parameters, preparing to create it." << std::endl;
+                                      #endif
+                                      hid_t type  = H5Dget_type(dataset);
+                                      hid_t type2 = H5Dget_type(dataset2);
+                                      if(type<0 or type2<0)
+                                      {
+                                         std::ostringstream errmsg;
+                                         errmsg << "Failed to detect type for RA dataset '"<<*it<<"'! The dataset is supposedly valid, so this does not make sense. It must be a bug, please report it.";
+                                         printer_error().raise(LOCAL_INFO, errmsg.str());
+                                      }
+                                      setup_hdf5_points(new_group, type, type2, size_tot, *it);
+                                      H5Tclose(type);
+                                      H5Tclose(type2);
+                                      created.insert(*it);
+                                  }
 
-                          // Close resources
-                          for (int i = 0, end = datasets.size(); i < end; i++)
-                          {
-                              // Some datasets may never have been opened, so check this before trying to close them.
-                              if(datasets[i]>=0)  HDF5::closeDataset(datasets[i]);
-                              if(datasets2[i]>=0) HDF5::closeDataset(datasets2[i]);
-                              if(group_ids[i]>=0) HDF5::closeGroup(group_ids[i]);
-                              if(file_ids[i]>=0)  HDF5::closeFile(file_ids[i]);
+                                  hid_t dataset_out  = HDF5::openDataset(new_group, *it);
+                                  hid_t dataset2_out = HDF5::openDataset(new_group, (*it)+"_isvalid");
+                                  Enter_HDF5<ra_scatter_hdf5>(dataset, dataset2, dataset_out, dataset2_out, aux_sizes[i], RA_write_hash, ptids[i], ranks[i], size_tot, bytes_copied);
+                                  HDF5::closeDataset(dataset_out);
+                                  HDF5::closeDataset(dataset2_out);
+                                  HDF5::closeDataset(dataset);
+                                  HDF5::closeDataset(dataset2);
+                              }
+                              HDF5::closeGroup(group_id);
                           }
+                          HDF5::closeFile(file_id);
                       }
                       std::cout << "  Combining auxilliary datasets... Done.                 "<<std::endl;
                    }
@@ -1057,18 +934,21 @@ namespace Gambit
                 HDF5::closeGroup(new_group);
                 HDF5::closeFile(new_file);
 
+                // Report throughput
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+                const double MB = bytes_copied / 1048576.;
+                std::cout << "  Combined " << MB << " MB of data in " << elapsed << " s (" << (elapsed > 0 ? MB/elapsed : 0.) << " MB/s)." << std::endl;
+
                 if (do_cleanup and not custom_mode) // Cleanup disabled for custom mode. This is only for "routine" combination during scan resuming.
                 {
                     if (resume)
                     {
-                        std::system(("rm -f " + file + ".temp.bak").c_str());
+                        std::remove((file + ".temp.bak").c_str());
                     }
 
                     for (int i = 0, end = files.size(); i < end; i++)
                     {
-                        std::stringstream ss;
-                        ss << i;
-                        std::system(("rm -f " + root_file_name + "_temp_" + ss.str()).c_str());
+                        std::remove(get_fname(i).c_str());
                     }
                 }
             }
@@ -1084,12 +964,13 @@ namespace Gambit
 
                // Interfaces for the datasets
                // Make sure the types used here don't get out of sync with the types used to write the original datasets
-               // We open the datasets in "resume" mode to access existing dataset, and make "const" to disable writing of new data. i.e. "Read-only" mode.
+               // We open the datasets in "resume" mode to access existing dataset, in "Read-only" mode. They are
+               // closed explicitly below, since the interfaces do not release their datasets on destruction.
                // TODO: this can probably be streamlined once I write the HDF5 reader, can consolidate some reading routines.
-               const DataSetInterfaceScalar<unsigned long, CHUNKLENGTH> pointIDs(group_id, "pointID", true,'r');
-               const DataSetInterfaceScalar<int, CHUNKLENGTH> pointIDs_isvalid  (group_id, "pointID_isvalid", true,'r');
-               const DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks          (group_id, "MPIrank", true,'r');
-               const DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks_isvalid  (group_id, "MPIrank_isvalid", true,'r');
+               DataSetInterfaceScalar<unsigned long, CHUNKLENGTH> pointIDs(group_id, "pointID", true,'r');
+               DataSetInterfaceScalar<int, CHUNKLENGTH> pointIDs_isvalid  (group_id, "pointID_isvalid", true,'r');
+               DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks          (group_id, "MPIrank", true,'r');
+               DataSetInterfaceScalar<int, CHUNKLENGTH> mpiranks_isvalid  (group_id, "MPIrank_isvalid", true,'r');
 
                // Error check lengths. This should already have been done for all datasets in the group, but
                // we will double-check these four here.
@@ -1201,6 +1082,12 @@ namespace Gambit
                   }
                }
 
+               // Release the datasets, so that the output file is really closed once the combination is done
+               pointIDs.closeDataSet();
+               pointIDs_isvalid.closeDataSet();
+               mpiranks.closeDataSet();
+               mpiranks_isvalid.closeDataSet();
+
                // Check that all the matches were found!
                if( left_to_match.size() > 0 )
                {
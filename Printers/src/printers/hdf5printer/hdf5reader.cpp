@@ -15,6 +15,10 @@
 ///          (benjamin.farmer@monash.edu.au)
 ///  \date 2017 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include "gambit/Printers/printers/hdf5reader.hpp"
@@ -23,6 +27,8 @@
 #include "gambit/Utils/util_functions.hpp"
 #include "gambit/Logs/logger.hpp"
 
+#include <algorithm>
+
 namespace Gambit
 {
   namespace Printers
@@ -70,6 +76,8 @@ namespace Gambit
       , mpiranks_isvalid(location_id, "MPIrank_isvalid", true, 'r')
       , current_dataset_index(0)
       , current_point(nullpoint)
+      , ppid_index()
+      , ppid_index_built(false)
      {
        if(all_datasets.size()<2)
        {
@@ -245,15 +253,58 @@ namespace Gambit
         else
         {
            // Gotta search for it.
-           std::ostringstream errmsg;
-           errmsg << "Arbitrary point access has not yet been implemented for the HDF5Reader! Currently only iterated access through a dataset works.";
-           printer_error().raise(LOCAL_INFO, errmsg.str());
+           if(not ppid_index_built) build_ppid_index();
+           PPIDindex target;
+           target.rank = ppid.rank;
+           target.pointID = ppid.pointID;
+           target.index = 0;
+           auto it = std::lower_bound(ppid_index.begin(), ppid_index.end(), target);
+           if(it==ppid_index.end() or it->rank!=ppid.rank or it->pointID!=ppid.pointID)
+           {
+              std::ostringstream errmsg;
+              errmsg << "Could not find the point "<<ppid<<" in the input HDF5 datasets (file="<<file<<", group="<<group<<")!";
+              printer_error().raise(LOCAL_INFO, errmsg.str());
+           }
+           out_index = it->index;
         }
         mem_point = ppid;
         mem_index = out_index;
         return out_index;
      }
 
+     /// Build the (MPIrank, pointID) -> dataset index lookup table.
+     /// The ID datasets are read in large blocks rather than through the
+     /// CHUNKLENGTH-sized read buffers, and invalid entries are skipped.
+     void HDF5Reader::build_ppid_index()
+     {
+        const std::size_t dset_length = get_dataset_length();
+        const std::size_t BLOCKLENGTH = 1000000;
+        ppid_index.clear();
+        ppid_index.reserve(dset_length);
+        for(std::size_t offset=0; offset<dset_length; offset+=BLOCKLENGTH)
+        {
+           const std::size_t length = std::min(BLOCKLENGTH, dset_length-offset);
+           const std::vector<unsigned long> pIDs   = pointIDs.get_chunk(offset,length);
+           const std::vector<int>           pIDs_v = pointIDs_isvalid.get_chunk(offset,length);
+           const std::vector<int>           ranks  = mpiranks.get_chunk(offset,length);
+           const std::vector<int>           ranks_v= mpiranks_isvalid.get_chunk(offset,length);
+           for(std::size_t i=0; i<length; i++)
+           {
+              if(pIDs_v[i] and ranks_v[i])
+              {
+                 PPIDindex entry;
+                 entry.rank = ranks[i];
+                 entry.pointID = pIDs[i];
+                 entry.index = offset+i;
+                 ppid_index.push_back(entry);
+              }
+           }
+        }
+        std::sort(ppid_index.begin(), ppid_index.end());
+        ppid_index_built = true;
+        logger() << LogTags::printers << LogTags::info << "HDF5Reader: built random-access index of "<<ppid_index.size()<<" points (file="<<file<<", group="<<group<<")." << EOM;
+     }
+
      /// @}
 
   }
@@ -0,0 +1,409 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Round-trip tests of the combination of
+///  temporary HDF5 printer output: temporary
+///  files are written by hand, combined with
+///  combine_hdf5_files, and the result compared
+///  with a straightforward in-memory combination
+///  of the same data (the semantics of the
+///  original, fully buffered implementation).
+///  Covers primary and random-access (RA)
+///  datasets, resuming onto a previous combined
+///  file, and missing or corrupt temporary files.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <unistd.h>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/util_functions.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_combine_tools.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::Printers;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  const str group = "/data";
+
+  /// A dataset and its validity flags
+  struct Column
+  {
+    std::vector<double> values;
+    std::vector<bool> valid;
+  };
+
+  /// The contents of one group: datasets by name
+  typedef std::map<str, Column> Contents;
+
+  /// The contents of one temporary file
+  struct TempFile
+  {
+    Contents primary;
+    Contents RA;
+  };
+
+  /// Add one point to the primary datasets of a temporary file
+  void add_point(TempFile& temp, int rank, unsigned long long ptid, bool valid, const std::map<str, double>& values)
+  {
+    const std::size_t n = temp.primary["pointID"].values.size();
+    temp.primary["pointID"].values.push_back(ptid);
+    temp.primary["pointID"].valid.push_back(valid);
+    temp.primary["MPIrank"].values.push_back(rank);
+    temp.primary["MPIrank"].valid.push_back(valid);
+    for (const auto& value : values)
+    {
+      Column& column = temp.primary[value.first];
+      column.values.resize(n, 0.);
+      column.valid.resize(n, false);
+      column.values.push_back(value.second);
+      column.valid.push_back(valid);
+    }
+    for (auto& column : temp.primary)
+    {
+      column.second.values.resize(n+1, 0.);
+      column.second.valid.resize(n+1, false);
+    }
+  }
+
+  /// Add one auxiliary (random-access) entry to a temporary file
+  void add_RA(TempFile& temp, int rank, unsigned long long ptid, bool valid, const std::map<str, double>& values)
+  {
+    const std::size_t n = temp.RA["RA_pointID"].values.size();
+    temp.RA["RA_pointID"].values.push_back(ptid);
+    temp.RA["RA_pointID"].valid.push_back(valid);
+    temp.RA["RA_MPIrank"].values.push_back(rank);
+    temp.RA["RA_MPIrank"].valid.push_back(valid);
+    for (const auto& value : values)
+    {
+      Column& column = temp.RA[value.first];
+      column.values.resize(n, 0.);
+      column.valid.resize(n, false);
+      column.values.push_back(value.second);
+      column.valid.push_back(valid);
+    }
+    for (auto& column : temp.RA)
+    {
+      column.second.values.resize(n+1, 0.);
+      column.second.valid.resize(n+1, false);
+    }
+  }
+
+  /// The type a dataset is written with, as the printer does
+  hid_t file_type(const str& name)
+  {
+    if (name == "pointID" or name == "RA_pointID") return H5T_NATIVE_ULLONG;
+    if (name == "MPIrank" or name == "RA_MPIrank") return H5T_NATIVE_INT;
+    return H5T_NATIVE_DOUBLE;
+  }
+
+  /// Write the datasets of a group, with their validity flags
+  void write_contents(hid_t file_id, const str& group_name, const Contents& contents)
+  {
+    hid_t group_id = HDF5::openGroup(file_id, group_name);
+    for (const auto& column : contents)
+    {
+      hsize_t dims[1] = {column.second.values.size()};
+      const hid_t type = file_type(column.first);
+      std::vector<unsigned long long> ull(column.second.values.begin(), column.second.values.end());
+      std::vector<int> ints(column.second.values.begin(), column.second.values.end());
+      std::vector<unsigned char> flags(column.second.valid.begin(), column.second.valid.end());
+      const void* data = (type == H5T_NATIVE_ULLONG ? (const void*)ull.data() : type == H5T_NATIVE_INT ? (const void*)ints.data()
+                                                    : (const void*)column.second.values.data());
+      hid_t space = H5Screate_simple(1, dims, NULL);
+      hid_t dset = H5Dcreate2(group_id, column.first.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      H5Dwrite(dset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+      H5Dclose(dset);
+      dset = H5Dcreate2(group_id, (column.first + "_isvalid").c_str(), H5T_NATIVE_UINT8, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      H5Dwrite(dset, H5T_NATIVE_UINT8, H5S_ALL, H5S_ALL, H5P_DEFAULT, flags.data());
+      H5Dclose(dset);
+      H5Sclose(space);
+    }
+    HDF5::closeGroup(group_id);
+  }
+
+  /// Write a temporary file (the printer always creates the RA group)
+  void write_temp_file(const str& fname, const TempFile& temp)
+  {
+    hid_t file_id = HDF5::openFile(fname, true, 'w');
+    write_contents(file_id, group, temp.primary);
+    write_contents(file_id, group + "/RA", temp.RA);
+    HDF5::closeFile(file_id);
+  }
+
+  /// Read back all datasets of a group
+  Contents read_contents(const str& fname)
+  {
+    Contents contents;
+    hid_t file_id = HDF5::openFile(fname);
+    hid_t group_id = HDF5::openGroup(file_id, group, true);
+    H5G_info_t info;
+    H5Gget_info(group_id, &info);
+    std::vector<str> names;
+    for (hsize_t i = 0; i < info.nlinks; ++i)
+    {
+      char name[1000];
+      H5Lget_name_by_idx(group_id, ".", H5_INDEX_NAME, H5_ITER_INC, i, name, 1000, H5P_DEFAULT);
+      names.push_back(name);
+    }
+    for (const str& name : names)
+    {
+      if (name.size() > 8 and name.substr(name.size()-8) == "_isvalid") continue;
+      hid_t dset = HDF5::openDataset(group_id, name);
+      hid_t dset2 = HDF5::openDataset(group_id, name + "_isvalid");
+      Column& column = contents[name];
+      HDF5::Enter_HDF5<HDF5::read_hdf5>(dset, column.values);
+      HDF5::Enter_HDF5<HDF5::read_hdf5>(dset2, column.valid);
+      HDF5::closeDataset(dset);
+      HDF5::closeDataset(dset2);
+    }
+    HDF5::closeGroup(group_id);
+    HDF5::closeFile(file_id);
+    return contents;
+  }
+
+  /// Combine in memory: previous combined output first, then each readable temporary file
+  /// with trailing invalid points trimmed, then every valid RA entry written over the
+  /// matching (pointID, MPIrank) row.
+  Contents reference(const std::vector<const TempFile*>& temps, const Contents& previous = Contents())
+  {
+    std::vector<const Contents*> parts;
+    std::vector<std::size_t> lengths;
+    if (not previous.empty())
+    {
+      parts.push_back(&previous);
+      lengths.push_back(previous.at("pointID").values.size());
+    }
+    for (const TempFile* temp : temps)
+    {
+      if (temp == NULL) continue;
+      std::size_t n = temp->primary.at("pointID").valid.size();
+      while (n > 0 and not temp->primary.at("pointID").valid[n-1]) --n;
+      parts.push_back(&temp->primary);
+      lengths.push_back(n);
+    }
+
+    Contents out;
+    std::size_t total = 0;
+    for (std::size_t length : lengths) total += length;
+    for (const Contents* part : parts)
+      for (const auto& column : *part) out[column.first];
+    for (const TempFile* temp : temps)
+      if (temp != NULL)
+        for (const auto& column : temp->RA)
+          if (column.first != "RA_pointID" and column.first != "RA_MPIrank") out[column.first];
+    for (auto& column : out)
+    {
+      std::size_t offset = 0;
+      column.second.values.assign(total, 0.);
+      column.second.valid.assign(total, false);
+      for (std::size_t p = 0; p < parts.size(); ++p)
+      {
+        auto it = parts[p]->find(column.first);
+        if (it != parts[p]->end())
+        {
+          std::copy(it->second.values.begin(), it->second.values.begin() + lengths[p], column.second.values.begin() + offset);
+          std::copy(it->second.valid.begin(), it->second.valid.begin() + lengths[p], column.second.valid.begin() + offset);
+        }
+        offset += lengths[p];
+      }
+    }
+
+    for (const TempFile* temp : temps)
+    {
+      if (temp == NULL or temp->RA.empty()) continue;
+      const Column& ptids = temp->RA.at("RA_pointID");
+      const Column& ranks = temp->RA.at("RA_MPIrank");
+      for (std::size_t j = 0; j < ptids.values.size(); ++j)
+      {
+        if (not ptids.valid[j]) continue;
+        for (std::size_t row = 0; row < total; ++row)
+        {
+          if (out["pointID"].valid[row] and out["pointID"].values[row] == ptids.values[j] and out["MPIrank"].values[row] == ranks.values[j])
+          {
+            for (const auto& column : temp->RA)
+            {
+              if (column.first == "RA_pointID" or column.first == "RA_MPIrank" or not column.second.valid[j]) continue;
+              out[column.first].values[row] = column.second.values[j];
+              out[column.first].valid[row] = true;
+            }
+          }
+        }
+      }
+    }
+    return out;
+  }
+
+  /// Whether a combined file holds exactly the expected datasets
+  bool same(const Contents& a, const Contents& b)
+  {
+    if (a.size() != b.size()) return false;
+    for (const auto& column : a)
+    {
+      auto it = b.find(column.first);
+      if (it == b.end() or it->second.values != column.second.values or it->second.valid != column.second.valid) return false;
+    }
+    return true;
+  }
+
+  /// Whether combining raises an error
+  bool combine_fails(const str& output, const str& base, std::size_t num, bool resume, bool cleanup, bool skip)
+  {
+    try { HDF5::combine_hdf5_files(output, base, group, num, resume, cleanup, skip); }
+    catch (std::exception&) { return true; }
+    return false;
+  }
+
+  str temp_name(const str& base, int i) { return base + "_temp_" + std::to_string(i); }
+
+}
+
+int main()
+{
+  logger().disable();
+  HDF5::errorsOff();
+  char dir_template[] = "/tmp/hdf5_combine_test_XXXXXX";
+  const str dir = mkdtemp(dir_template);
+  const str base = dir + "/samples.hdf5";
+  const str output = base;
+
+  // Three ranks. Rank 1 writes an extra parameter, rank 0 has an invalid point in the middle
+  // and trailing invalid points, rank 2 writes no primary points at all. RA entries for
+  // rank 0 points come from rank 0 itself; rank 2 sends one for a rank 1 point, and an
+  // invalid one that must be ignored.
+  std::vector<TempFile> temps(3);
+  add_point(temps[0], 0, 1, true, {{"LogLike", -1.5}, {"m0", 100.}});
+  add_point(temps[0], 0, 2, false, {{"LogLike", 0.}, {"m0", 0.}});
+  add_point(temps[0], 0, 3, true, {{"LogLike", -2.5}, {"m0", 300.}});
+  add_point(temps[0], 0, 4, false, {{"LogLike", 0.}, {"m0", 0.}});
+  add_point(temps[0], 0, 5, false, {{"LogLike", 0.}, {"m0", 0.}});
+  add_point(temps[1], 1, 1, true, {{"LogLike", -0.5}, {"m0", 150.}, {"mHiggs", 125.1}});
+  add_point(temps[1], 1, 2, true, {{"LogLike", -0.7}, {"m0", 250.}, {"mHiggs", 124.9}});
+  add_point(temps[2], 2, 1, false, {{"LogLike", 0.}, {"m0", 0.}});
+  add_RA(temps[0], 0, 3, true, {{"Runtime", 0.25}});
+  add_RA(temps[0], 0, 1, true, {{"Runtime", 0.5}});
+  add_RA(temps[2], 1, 2, true, {{"Runtime", 0.75}, {"Weight", 2.}});
+  add_RA(temps[2], 2, 8, false, {{"Runtime", 0.}, {"Weight", 0.}});
+  for (int i = 0; i < 3; ++i) write_temp_file(temp_name(base, i), temps[i]);
+
+  std::cout << "Combining primary and RA datasets:" << std::endl;
+  HDF5::combine_hdf5_files(output, base, group, 3, false, false, false);
+  check(H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_ALL) == 0, "no HDF5 files, datasets or types are left open");
+  const Contents first = read_contents(output);
+  const Contents first_expected = reference({&temps[0], &temps[1], &temps[2]});
+  check(same(first, first_expected), "the combined output matches the in-memory combination");
+  check(first.at("pointID").values.size() == 5, "trailing invalid points are trimmed from each temporary file");
+  check(first.count("mHiggs") and not first.at("mHiggs").valid[0] and first.at("mHiggs").valid[3],
+        "a parameter missing from some temporary files is invalid for their points");
+  check(first.count("Weight") and first.at("Weight").valid[4] and first.at("Weight").values[4] == 2.,
+        "RA entries are merged into the points of other ranks");
+  check(first.at("Runtime").valid[0] and first.at("Runtime").values[0] == 0.5 and first.at("Runtime").values[2] == 0.25,
+        "RA entries are merged by (pointID, MPIrank), not by position");
+  check(Utils::file_exists(temp_name(base, 0)) and Utils::file_exists(temp_name(base, 2)), "temporary files are kept without cleanup");
+  const str unmatched_base = dir + "/unmatched.hdf5";
+  TempFile unmatched = temps[2];
+  add_RA(unmatched, 2, 7, true, {{"Runtime", 1.}, {"Weight", 3.}});
+  write_temp_file(temp_name(unmatched_base, 0), temps[0]);
+  write_temp_file(temp_name(unmatched_base, 1), unmatched);
+  check(combine_fails(unmatched_base, unmatched_base, 2, false, true, false), "an RA entry without a matching point is an error");
+  check(Utils::file_exists(temp_name(unmatched_base, 0)) and Utils::file_exists(temp_name(unmatched_base, 1)),
+        "temporary files are kept after the error");
+  for (int i = 0; i < 2; ++i) std::remove(temp_name(unmatched_base, i).c_str());
+  std::remove(unmatched_base.c_str());
+
+  std::cout << "Resuming onto a previous combined file:" << std::endl;
+  std::vector<TempFile> resumed(3);
+  add_point(resumed[0], 0, 6, true, {{"LogLike", -3.}, {"m0", 600.}});
+  add_point(resumed[1], 1, 3, true, {{"LogLike", -4.}, {"m0", 350.}, {"mHiggs", 125.3}});
+  add_point(resumed[2], 2, 2, true, {{"LogLike", -5.}, {"m0", 450.}});
+  add_RA(resumed[1], 0, 3, true, {{"Weight", 5.}});
+  add_RA(resumed[2], 2, 2, true, {{"Runtime", 2.}});
+  for (int i = 0; i < 3; ++i) write_temp_file(temp_name(base, i), resumed[i]);
+  HDF5::combine_hdf5_files(output, base, group, 3, true, true, false);
+  check(same(read_contents(output), reference({&resumed[0], &resumed[1], &resumed[2]}, first)),
+        "the previous combined output comes first, followed by the new points");
+  check(read_contents(output).at("Weight").values[2] == 5., "RA entries are merged into points of the previous combined output");
+  check(not Utils::file_exists(output + ".temp.bak"), "the backup of the previous combined file is removed with cleanup");
+  check(not Utils::file_exists(temp_name(base, 0)) and not Utils::file_exists(temp_name(base, 2)), "temporary files are removed with cleanup");
+  const Contents second = read_contents(output);
+
+  // New points for each of the following stages, so that no point is combined twice
+  std::vector<TempFile> later(3), latest(3);
+  for (int i = 0; i < 3; ++i)
+  {
+    add_point(later[i], i, 10, true, {{"LogLike", -10.-i}, {"m0", 1000.+i}});
+    add_point(latest[i], i, 20, true, {{"LogLike", -20.-i}, {"m0", 2000.+i}});
+    add_RA(later[i], i, 10, true, {{"Runtime", 10.+i}});
+    add_RA(latest[i], i, 20, true, {{"Weight", 20.+i}});
+  }
+
+  std::cout << "Missing temporary files:" << std::endl;
+  write_temp_file(temp_name(base, 0), later[0]);
+  write_temp_file(temp_name(base, 2), later[2]);
+  check(combine_fails(output, base, 3, true, true, false), "a missing temporary file is an error unless skipped");
+  check(same(read_contents(output), second) and not Utils::file_exists(output + ".temp.bak"), "the previous combined file is untouched after the error");
+  check(Utils::file_exists(temp_name(base, 0)) and Utils::file_exists(temp_name(base, 2)), "temporary files are kept after the error");
+  HDF5::combine_hdf5_files(output, base, group, 3, true, true, true);
+  check(same(read_contents(output), reference({&later[0], NULL, &later[2]}, second)), "a missing temporary file is skipped if requested");
+  const Contents third = read_contents(output);
+
+  std::cout << "Corrupt temporary files:" << std::endl;
+  write_temp_file(temp_name(base, 0), latest[0]);
+  write_temp_file(temp_name(base, 2), latest[2]);
+  {
+    std::ofstream corrupt(temp_name(base, 1));
+    corrupt << "not an HDF5 file";
+  }
+  check(combine_fails(output, base, 3, true, true, false), "a corrupt temporary file is an error unless skipped");
+  check(same(read_contents(output), third) and not Utils::file_exists(output + ".temp.bak"), "the previous combined file is untouched after the error");
+  check(Utils::file_exists(temp_name(base, 0)) and Utils::file_exists(temp_name(base, 1)) and Utils::file_exists(temp_name(base, 2)),
+        "temporary files are kept after the error");
+  HDF5::combine_hdf5_files(output, base, group, 3, true, false, true);
+  check(same(read_contents(output), reference({&latest[0], NULL, &latest[2]}, third)), "a corrupt temporary file is skipped if requested");
+  std::remove((output + ".temp.bak").c_str());
+
+  std::cout << "Corrupt previous combined file:" << std::endl;
+  {
+    std::ofstream corrupt(output, std::ios::trunc);
+    corrupt << "not an HDF5 file";
+  }
+  check(combine_fails(output, base, 3, true, true, true), "a corrupt previous combined file is an error");
+  check(Utils::file_exists(output) and not Utils::file_exists(output + ".temp.bak") and Utils::file_exists(temp_name(base, 0)),
+        "neither the previous combined file nor the temporary files are moved or removed after the error");
+
+  for (int i = 0; i < 3; ++i) std::remove(temp_name(base, i).c_str());
+  std::remove(output.c_str());
+  std::remove((output + ".temp.bak").c_str());
+  rmdir(dir.c_str());
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
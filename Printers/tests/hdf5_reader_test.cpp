@@ -0,0 +1,211 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of random access to points by
+///  (MPIrank, pointID) in the HDF5Reader: points
+///  are found wherever they are in the datasets,
+///  rows with invalid IDs are never matched, a
+///  repeated ID resolves to its first row, and
+///  looking up a missing point is an error.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Printers/printers/hdf5reader.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::Printers;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  const str group = "/data";
+
+  /// One row of the primary datasets
+  struct Row
+  {
+    int rank;
+    unsigned long pointID;
+    bool ID_valid;
+    double LogLike;
+    bool LogLike_valid;
+  };
+
+  /// Value stored for a point
+  double value(int rank, unsigned long pointID) { return 1000.*rank + pointID + 0.5; }
+
+  /// Write a dataset and its validity flags, with the types used by the HDF5 printer
+  template<class T>
+  void write_dataset(hid_t group_id, const str& name, hid_t type, const std::vector<T>& values, const std::vector<int>& valid)
+  {
+    hsize_t dims[1] = {values.size()};
+    hid_t space = H5Screate_simple(1, dims, NULL);
+    hid_t dset = H5Dcreate2(group_id, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Dwrite(dset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Dclose(dset);
+    dset = H5Dcreate2(group_id, (name + "_isvalid").c_str(), H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, valid.data());
+    H5Dclose(dset);
+    H5Sclose(space);
+  }
+
+  /// Write the pointID, MPIrank and LogLike datasets of the rows
+  void write_file(const str& fname, const std::vector<Row>& rows)
+  {
+    std::vector<unsigned long> pointIDs;
+    std::vector<int> ranks, ID_valid, LogLike_valid;
+    std::vector<double> LogLike;
+    for (const Row& row : rows)
+    {
+      pointIDs.push_back(row.pointID);
+      ranks.push_back(row.rank);
+      ID_valid.push_back(row.ID_valid);
+      LogLike.push_back(row.LogLike);
+      LogLike_valid.push_back(row.LogLike_valid);
+    }
+    hid_t file_id = HDF5::openFile(fname, true, 'w');
+    hid_t group_id = HDF5::openGroup(file_id, group);
+    write_dataset(group_id, "pointID", H5T_NATIVE_ULONG, pointIDs, ID_valid);
+    write_dataset(group_id, "MPIrank", H5T_NATIVE_INT, ranks, ID_valid);
+    write_dataset(group_id, "LogLike", H5T_NATIVE_DOUBLE, LogLike, LogLike_valid);
+    HDF5::closeGroup(group_id);
+    HDF5::closeFile(file_id);
+  }
+
+  /// Whether retrieving the LogLike of a point raises an error
+  bool retrieve_fails(HDF5Reader& reader, int rank, unsigned long pointID)
+  {
+    double out;
+    try { reader.retrieve(out, "LogLike", rank, pointID); }
+    catch (std::exception&) { return true; }
+    return false;
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+  HDF5::errorsOff();
+  char dir_template[] = "/tmp/hdf5_reader_test_XXXXXX";
+  const str dir = mkdtemp(dir_template);
+  const str fname = dir + "/samples.hdf5";
+
+  // Three ranks, with their points interleaved in shuffled blocks as in a combined file. Rank 1
+  // skips every tenth pointID, rank 2 has rows with invalid IDs, every 7th LogLike is invalid,
+  // and (rank 0, pointID 5) appears a second time near the end with a different value.
+  const unsigned long npoints = 400;
+  std::vector<Row> rows;
+  for (unsigned long pointID = 0; pointID < npoints; ++pointID)
+  {
+    for (int rank = 0; rank < 3; ++rank)
+    {
+      if (rank == 1 and pointID%10 == 9) continue;
+      const bool ID_valid = not (rank == 2 and pointID%13 == 4);
+      rows.push_back({rank, pointID, ID_valid, value(rank, pointID), pointID%7 != 3});
+    }
+  }
+  std::mt19937 gen(3);
+  for (std::size_t start = 0; start + 50 <= rows.size(); start += 50) std::shuffle(rows.begin() + start, rows.begin() + start + 50, gen);
+  rows.insert(rows.end() - 10, {0, 5, true, -1., true});
+  write_file(fname, rows);
+
+  YAML::Node node;
+  node["file"] = fname;
+  node["group"] = group;
+  const Options options(node);
+
+  std::cout << "Random access" << std::endl;
+  {
+    HDF5Reader reader(options);
+    check(reader.get_dataset_length() == rows.size(), "the reader sees every row");
+
+    // Look the points up in random order, so that none is the current or last retrieved point
+    std::vector<std::pair<int, unsigned long>> points;
+    for (unsigned long pointID = 0; pointID < npoints; ++pointID)
+    {
+      for (int rank = 0; rank < 3; ++rank) points.push_back({rank, pointID});
+    }
+    std::shuffle(points.begin(), points.end(), gen);
+    bool found = true, values = true, validity = true, missing = true;
+    for (const auto& point : points)
+    {
+      const int rank = point.first;
+      const unsigned long pointID = point.second;
+      const bool present = not (rank == 1 and pointID%10 == 9) and not (rank == 2 and pointID%13 == 4);
+      if (not present)
+      {
+        missing = missing and retrieve_fails(reader, rank, pointID);
+        continue;
+      }
+      double out = 0;
+      bool valid = false;
+      try { valid = reader.retrieve(out, "LogLike", rank, pointID); }
+      catch (std::exception&) { found = false; continue; }
+      validity = validity and valid == (pointID%7 != 3);
+      if (valid) values = values and out == value(rank, pointID);
+    }
+    check(found, "every point present in the datasets is found");
+    check(values, "the values retrieved belong to the requested points");
+    check(validity, "validity flags are retrieved with the values");
+    check(missing, "points skipped by their rank or written with invalid IDs are reported missing");
+
+    double out = 0;
+    reader.retrieve(out, "LogLike", 1, 0);
+    reader.retrieve(out, "LogLike", 0, 5);
+    check(out == value(0, 5), "a repeated point resolves to its first row");
+    check(retrieve_fails(reader, 0, npoints) and retrieve_fails(reader, 3, 0) and retrieve_fails(reader, 0, npoints + 1000),
+          "pointIDs past the last one and unknown ranks are reported missing");
+    reader.retrieve(out, "LogLike", 2, 11);
+    check(out == value(2, 11), "lookups still work after a missing point");
+  }
+
+  std::cout << "Iterated access" << std::endl;
+  {
+    HDF5Reader reader(options);
+    bool same = true;
+    std::size_t n = 0;
+    for (PPIDpair point = reader.get_current_point(); not reader.eoi(); point = reader.get_next_point(), ++n)
+    {
+      const Row& row = rows[n];
+      if (not row.ID_valid) continue;
+      double out = 0;
+      const bool valid = reader.retrieve(out, "LogLike", point.rank, point.pointID);
+      same = same and point.rank == (uint)row.rank and point.pointID == row.pointID and valid == row.LogLike_valid
+                  and (not valid or out == row.LogLike);
+    }
+    check(same and n == rows.size(), "iterating through the datasets visits every row in order, duplicates included");
+  }
+
+  std::remove(fname.c_str());
+  rmdir(dir.c_str());
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
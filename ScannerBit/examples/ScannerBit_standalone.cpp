@@ -274,7 +274,7 @@ int main(int argc, char **argv)
                 #endif
 
                 // Initialise the random number generator, letting the RNG class choose its own default.
-                Random::create_rng_engine(iniFile.getValueOrDef<std::string>("default", "rng"));
+                Random::create_rng_engine(iniFile.getValueOrDef<std::string>("default", "rng"), iniFile.getValueOrDef<long long>(-1, "rng_seed"));
 
                 // Set up the printer (redirection of scan output)
                 Printers::PrinterManager printerManager(iniFile.getPrinterNode(),resume);
@@ -35,6 +35,9 @@ namespace Gambit
 
       /// Answer queries as to whether a given dataset index has been postprocessed in a previous run or not
       bool point_done(const ChunkSet done_chunks, size_t index);
+
+      /// Answer the same query for chunks simplified by merge_chunks, by binary search
+      bool point_done_merged(const ChunkSet& merged_chunks, std::size_t index);
       
       /// Get 'effective' start and end positions for a processing batch
       /// i.e. simply divides up an integer into the most even parts possible
@@ -84,9 +87,13 @@ namespace Gambit
          unsigned int numtasks;
          unsigned int rank;
          std::size_t chunksize;
+         bool guided_scheduling;
+         std::size_t min_chunksize;
          #ifdef WITH_MPI
          GMPI::Comm* comm;
-         PPOptions() : comm(NULL) {}
+         PPOptions() : guided_scheduling(false), min_chunksize(1), comm(NULL) {}
+         #else
+         PPOptions() : guided_scheduling(false), min_chunksize(1) {}
          #endif
       };
  
@@ -113,6 +120,12 @@ namespace Gambit
             Printers::BaseBasePrinter& getPrinter();
             Scanner::like_ptr getLogLike();
 
+            /// Check whether a given dataset index has been processed in a previous run (binary search in done_chunks)
+            bool is_done(std::size_t index) const;
+
+            /// Number of unprocessed points to put into the next chunk
+            std::size_t next_chunksize() const;
+
             /// The reader object in use for the scan
             Printers::BaseBaseReader* reader;
 
@@ -137,9 +150,15 @@ namespace Gambit
             /// Next point scheduled to be distributed for processing
             unsigned long long next_point;
 
-            /// Size of chunks to distribute to worker processes
+            /// Size of chunks to distribute to worker processes (maximum size if using guided scheduling)
             unsigned long long chunksize;
 
+            /// Shrink chunks as the end of the dataset approaches, so that all workers finish at about the same time?
+            bool guided_scheduling;
+
+            /// Minimum size of chunks to distribute to worker processes when using guided scheduling
+            unsigned long long min_chunksize;
+
             /// Chunks describing the points that can be auto-skipped (because they have been processed previously)
             ChunkSet done_chunks;
 
@@ -0,0 +1,110 @@
+//  GAMBIT: Global and Modular BSM Inference Tool
+//  *********************************************
+///  \file
+///
+///  Helper functions for the chunks of points
+///  done by the postprocessor
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+//
+///  \author Ben Farmer
+///          (b.farmer@imperial.ac.uk)
+///  \date 2018 Sep
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include "gambit/ScannerBit/scanners/postprocessor_2.0.0/postprocessor.hpp"
+
+namespace Gambit
+{
+   namespace PostProcessor
+   {
+
+      /// Answer queries as to whether a given dataset index has been postprocessed in a previous run or not
+      bool point_done(const ChunkSet done_chunks, size_t index)
+      {
+        bool answer = false;
+        for(ChunkSet::const_iterator it=done_chunks.begin();
+             it!=done_chunks.end(); ++it)
+        {
+           if(it->iContain(index))
+           {
+              answer = true;
+              break;
+           }
+        }
+        return answer;
+      }
+
+      /// Answer the same query for chunks simplified by merge_chunks, by binary search
+      bool point_done_merged(const ChunkSet& merged_chunks, std::size_t index)
+      {
+         // Find the last done chunk starting at or before index (chunks are sorted by start index and do not overlap)
+         ChunkSet::const_iterator donechunk = merged_chunks.upper_bound(Chunk(index,index));
+         if(donechunk==merged_chunks.begin()) return false;
+         --donechunk;
+         return donechunk->iContain(index);
+      }
+
+      /// Simplify a ChunkSet by merging chunks which overlap (or are directly adjacent).
+      ChunkSet merge_chunks(const ChunkSet& input_chunks)
+      {
+        ChunkSet merged_chunks;
+        if(input_chunks.size()>0)
+        {
+           Chunk new_chunk;
+           std::size_t prev_chunk_end = input_chunks.begin()->end;
+           new_chunk.start = input_chunks.begin()->start; // Start of first chunk
+           for(ChunkSet::const_iterator it=input_chunks.begin();
+                it!=input_chunks.end(); ++it)
+           {
+              if(it->start > prev_chunk_end and it->start - prev_chunk_end > 1)
+              {
+                 // Gap detected; close the existing chunk and start a new one.
+                 new_chunk.end = prev_chunk_end;
+                 merged_chunks.insert(new_chunk);
+                 new_chunk.start = it->start;
+              }
+
+              if(it->end > prev_chunk_end)
+              {
+                prev_chunk_end = it->end;
+              }
+           }
+           // No more chunks, close the last open chunk
+           new_chunk.end = prev_chunk_end;
+           merged_chunks.insert(new_chunk);
+           // Sanity check; Starts and ends of merged chunks should match some start/end in the input chunks
+           for(ChunkSet::const_iterator it=merged_chunks.begin();
+                it!=merged_chunks.end(); ++it)
+           {
+              bool found_start = false;
+              bool found_end = false;
+              for(ChunkSet::const_iterator jt=input_chunks.begin();
+                   jt!=input_chunks.end(); ++jt)
+              {
+                if(it->start==jt->start) found_start = true;
+                if(it->end==jt->end) found_end = true;
+              }
+              if(not found_start or not found_end)
+              {
+                 std::ostringstream err;
+                 err << "Error, merged 'done_chunks' are not consistent with the originally input done_chunks! This indicates a bug in the merge_chunks routine of the postprocessor, please report it. Debug output:" << endl;
+                 err << "Problem merged chunk was ["<<it->start<<","<<it->end<<"]"<<endl;
+                 Scanner::scan_error().raise(LOCAL_INFO,err.str());
+              }
+              // else fine, move to next merged chunk
+           }
+        }
+        // else there are no input chunks, just return an empty ChunkSet
+        return merged_chunks;
+      }
+
+   }
+}
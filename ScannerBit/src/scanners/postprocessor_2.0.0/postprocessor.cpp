@@ -27,6 +27,10 @@
 ///          (b.farmer@imperial.ac.uk)
 ///  \date 2018, Sep
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 // STL
@@ -37,6 +41,8 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <chrono>
 
 // GAMBIT
 #include "gambit/Utils/mpiwrapper.hpp"
@@ -183,6 +189,18 @@ scanner_plugin(postprocessor, version(2, 0, 0))
     // Size of chunks to be distributed to worker processes
     settings.chunksize = get_inifile_value<std::size_t>("batch_size",1);
 
+    // Shrink the chunks towards min_batch_size as the end of the dataset approaches, so that workers
+    // finish at about the same time ("guided"), or always use batch_size ("fixed", the default)?
+    std::string scheduling = get_inifile_value<std::string>("scheduling","fixed");
+    if(scheduling!="fixed" and scheduling!="guided")
+    {
+        std::ostringstream err;
+        err << "Unrecognised value '"<<scheduling<<"' for the 'scheduling' option of the postprocessor scanner plugin. Valid options are 'fixed' and 'guided'.";
+        scan_error().raise(LOCAL_INFO,err.str());
+    }
+    settings.guided_scheduling = (scheduling=="guided");
+    settings.min_chunksize = get_inifile_value<std::size_t>("min_batch_size",1);
+
     // Finally, there is the 'Purpose' value of the likelihood container. This may well clash
     // with the old name used in the input file, so better check for this and make the user
     // change their choice if so.
@@ -360,11 +378,13 @@ scanner_plugin(postprocessor, version(2, 0, 0))
          else if(rank==0)
          { 
             // Master checks for work requests from other processes
+            bool any_requests = false;
             for(int worker=1; worker<numtasks; worker++)
             {
                bool needs_work = ppComm.Iprobe(worker, request_work_tag);
                if(needs_work)
                {
+                  any_requests = true;
                   // Receive the work request message (no information, just cleaning up)
                   int quit_flag = 0; // The message itself propagates quit flags, if seen by workers
                   //std::cout<<"Master waiting for message from "<<worker<<std::endl;
@@ -402,6 +422,9 @@ scanner_plugin(postprocessor, version(2, 0, 0))
                }
             }
 
+            // Don't spin at full speed while all workers are busy; the master often shares a node with them.
+            if(not any_requests) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
             // Set zero-length chunk for master
             bool any_still_running=false;
             for(int i=1; i<numtasks; i++)
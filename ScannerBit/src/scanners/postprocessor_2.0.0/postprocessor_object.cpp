@@ -33,22 +33,6 @@ namespace Gambit
 
       /// @{ Helper functions for performing resume related tasks
 
-      /// Answer queries as to whether a given dataset index has been postprocessed in a previous run or not
-      bool point_done(const ChunkSet done_chunks, size_t index)
-      {
-        bool answer = false;
-        for(ChunkSet::const_iterator it=done_chunks.begin();
-             it!=done_chunks.end(); ++it)
-        {
-           if(it->iContain(index))
-           {
-              answer = true;
-              break;
-           }
-        }
-        return answer;
-      }
-
       /// Get 'effective' start and end positions for a processing batch
       /// i.e. simply divides up an integer into the most even parts possible
       /// over a given number of processes
@@ -139,60 +123,6 @@ namespace Gambit
          return merge_chunks(done_chunks); // Simplify the chunks and return them
       }
 
-      /// Simplify a ChunkSet by merging chunks which overlap (or are directly adjacent).
-      ChunkSet merge_chunks(const ChunkSet& input_chunks)
-      {
-        ChunkSet merged_chunks;
-        if(input_chunks.size()>0)
-        {
-           Chunk new_chunk;
-           std::size_t prev_chunk_end = 0;
-           new_chunk.start = input_chunks.begin()->start; // Start of first chunk
-           for(ChunkSet::const_iterator it=input_chunks.begin();
-                it!=input_chunks.end(); ++it)
-           {
-              if(prev_chunk_end!=0 and it->start > prev_chunk_end+1)
-              {
-                 // Gap detected; close the existing chunk and start a new one.
-                 new_chunk.end = prev_chunk_end;
-                 merged_chunks.insert(new_chunk);
-                 new_chunk.start = it->start;
-              }
-
-              if(it->end > prev_chunk_end)
-              {
-                prev_chunk_end = it->end;
-              }
-           }
-           // No more chunks, close the last open chunk
-           new_chunk.end = prev_chunk_end;
-           merged_chunks.insert(new_chunk);
-           // Sanity check; Starts and ends of merged chunks should match some start/end in the input chunks
-           for(ChunkSet::const_iterator it=merged_chunks.begin();
-                it!=merged_chunks.end(); ++it)
-           {
-              bool found_start = false;
-              bool found_end = false;
-              for(ChunkSet::const_iterator jt=input_chunks.begin();
-                   jt!=input_chunks.end(); ++jt)
-              {
-                if(it->start==jt->start) found_start = true;
-                if(it->end==jt->end) found_end = true;
-              }
-              if(not found_start or not found_end)
-              {
-                 std::ostringstream err;
-                 err << "Error, merged 'done_chunks' are not consistent with the originally input done_chunks! This indicates a bug in the merge_chunks routine of the postprocessor, please report it. Debug output:" << endl;
-                 err << "Problem merged chunk was ["<<it->start<<","<<it->end<<"]"<<endl;
-                 Scanner::scan_error().raise(LOCAL_INFO,err.str());
-              }
-              // else fine, move to next merged chunk
-           }
-        }
-        // else there are no input chunks, just return an empty ChunkSet
-        return merged_chunks;
-      }
-
       // Gather a bunch of ints from all processes (COLLECTIVE OPERATION)
       #ifdef WITH_MPI
       std::vector<int> allgather_int(int myval, GMPI::Comm& comm)
@@ -227,6 +157,8 @@ namespace Gambit
         , total_length()
         , next_point(0)
         , chunksize()
+        , guided_scheduling(false)
+        , min_chunksize(1)
         , done_chunks()
         , all_params()
         , data_labels()
@@ -266,6 +198,8 @@ namespace Gambit
         , total_length(getReader().get_dataset_length())
         , next_point(0)
         , chunksize(o.chunksize)
+        , guided_scheduling(o.guided_scheduling)
+        , min_chunksize(std::max<std::size_t>(1,std::min(o.min_chunksize,o.chunksize)))
         , done_chunks()
         , all_params                 (o.all_params                 )
         , data_labels                (o.data_labels                )
@@ -1115,7 +1049,25 @@ namespace Gambit
       // Define the set of points that can be auto-skipped
       void PPDriver::set_done_chunks(const ChunkSet& in_done_chunks)
       {
-         done_chunks = in_done_chunks;
+         // Merge overlapping chunks, so that is_done can use a binary search
+         done_chunks = merge_chunks(in_done_chunks);
+      }
+
+      /// Check whether a given dataset index has been processed in a previous run
+      bool PPDriver::is_done(std::size_t index) const
+      {
+         return point_done_merged(done_chunks, index);
+      }
+
+      /// Number of unprocessed points to put into the next chunk
+      std::size_t PPDriver::next_chunksize() const
+      {
+         if(not guided_scheduling or numtasks<2) return chunksize;
+         // Guided scheduling: hand out roughly half of the remaining points per worker, so chunks
+         // shrink towards min_chunksize as the end of the dataset approaches.
+         std::size_t remaining = (next_point < total_length) ? total_length - next_point : 0;
+         std::size_t size = remaining / (2*(numtasks-1));
+         return std::max<std::size_t>(min_chunksize, std::min<std::size_t>(size, chunksize));
       }
 
       /// Compute start/end indices for a given rank process, given previous "done_chunk" data.
@@ -1124,6 +1076,7 @@ namespace Gambit
          std::size_t chunk_start = next_point;
          std::size_t chunk_end   = next_point;
          std::size_t chunk_length = 0;
+         const std::size_t target_length = next_chunksize();
          bool stop = false;
          bool found_start = false;
 
@@ -1139,13 +1092,8 @@ namespace Gambit
             // through the dataset, but skipping points that have already been processed.
             while(not stop)
             {
-               bool point_is_done = false;
-               for(ChunkSet::const_iterator donechunk=done_chunks.begin();
-                    donechunk!=done_chunks.end(); ++donechunk)
-               {
-                  // Check if the next scheduled point has been processed previously
-                  if(donechunk->iContain(next_point)) point_is_done = true;
-               }
+               // Check if the next scheduled point has been processed previously
+               bool point_is_done = is_done(next_point);
 
                if(not point_is_done) 
                {
@@ -1163,7 +1111,7 @@ namespace Gambit
                   chunk_end = total_length;
                   stop = true; 
                }
-               else if(chunk_length == chunksize)
+               else if(chunk_length == target_length)
                {
                   // Chunk contains enough unprocessed points; stop adding more.
                   chunk_end = next_point;
@@ -1175,7 +1123,7 @@ namespace Gambit
                   err << "Error generating chunk to be processed; next_point exceeds total length of dataset. Something has gone wrong for this to happen, please report this as a postprocessor bug." << std::endl;
                   Scanner::scan_error().raise(LOCAL_INFO,err.str());
                }
-               else if(chunk_length > chunksize)
+               else if(chunk_length > target_length)
                {
                   std::ostringstream err;
                   err << "Error generating chunk to be processed; length of generated chunk exceeds allocated size. Something has gone wrong for this to happen, please report this as a postprocessor bug." << std::endl;
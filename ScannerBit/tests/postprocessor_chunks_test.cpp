@@ -0,0 +1,125 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the chunk helpers of the
+///  postprocessor used when resuming: merge_chunks
+///  simplifies overlapping, nested and adjacent
+///  chunks without changing which points are done,
+///  and the binary search behind PPDriver::is_done
+///  agrees with a linear search of the original
+///  chunks.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/ScannerBit/scanners/postprocessor_2.0.0/postprocessor.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::PostProcessor;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// Build a ChunkSet from (start, end) pairs
+  ChunkSet chunks(const std::vector<std::pair<std::size_t,std::size_t>>& ranges)
+  {
+    ChunkSet result;
+    for (const auto& r : ranges) result.insert(Chunk(r.first, r.second));
+    return result;
+  }
+
+  /// Do two ChunkSets hold the same (start, end) ranges?
+  bool same_ranges(const ChunkSet& a, const ChunkSet& b)
+  {
+    if (a.size() != b.size()) return false;
+    for (auto it = a.begin(), jt = b.begin(); it != a.end(); ++it, ++jt)
+    {
+      if (it->start != jt->start or it->end != jt->end) return false;
+    }
+    return true;
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+
+  std::cout << "merge_chunks" << std::endl;
+  {
+    check(merge_chunks(ChunkSet()).empty(), "no chunks give no merged chunks");
+    check(same_ranges(merge_chunks(chunks({{3,7}})), chunks({{3,7}})), "a single chunk is unchanged");
+    check(same_ranges(merge_chunks(chunks({{0,10},{5,20}})), chunks({{0,20}})), "overlapping chunks are merged");
+    check(same_ranges(merge_chunks(chunks({{0,5},{6,8}})), chunks({{0,8}})), "directly adjacent chunks are merged");
+    check(same_ranges(merge_chunks(chunks({{0,10},{2,3},{4,12}})), chunks({{0,12}})), "nested chunks are absorbed");
+    check(same_ranges(merge_chunks(chunks({{0,5},{7,9},{20,20}})), chunks({{0,5},{7,9},{20,20}})), "chunks separated by gaps are kept apart");
+    check(same_ranges(merge_chunks(chunks({{10,15},{0,4},{5,9},{30,31}})), chunks({{0,15},{30,31}})),
+          "chunks given out of order are merged");
+  }
+
+  std::cout << "Done points" << std::endl;
+  {
+    const ChunkSet merged = merge_chunks(chunks({{2,4},{10,12},{11,20}}));
+    bool ok = true;
+    for (std::size_t i = 0; i <= 25; ++i)
+    {
+      const bool expected = (i >= 2 and i <= 4) or (i >= 10 and i <= 20);
+      ok = ok and point_done_merged(merged, i) == expected;
+    }
+    check(ok, "points inside, between, before and after the chunks are classified correctly");
+    check(not point_done_merged(ChunkSet(), 0), "no point is done when there are no chunks");
+
+    // Random sets of chunks, as gathered from the resume data of several processes
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<std::size_t> start(0, 200), length(0, 15), number(1, 20);
+    bool agree = true, simplified = true;
+    for (int trial = 0; trial < 500; ++trial)
+    {
+      ChunkSet input;
+      for (std::size_t n = number(gen); n > 0; --n)
+      {
+        const std::size_t s = start(gen);
+        input.insert(Chunk(s, s + length(gen)));
+      }
+      const ChunkSet merged = merge_chunks(input);
+      std::size_t previous_end = 0;
+      for (auto it = merged.begin(); it != merged.end(); ++it)
+      {
+        simplified = simplified and it->start <= it->end and (it == merged.begin() or it->start > previous_end + 1);
+        previous_end = it->end;
+      }
+      for (std::size_t i = 0; i <= 230; ++i)
+      {
+        agree = agree and point_done_merged(merged, i) == point_done(input, i) and point_done(merged, i) == point_done(input, i);
+      }
+    }
+    check(simplified, "merged chunks are sorted, disjoint and separated by gaps");
+    check(agree, "merging does not change which points are done, and the binary search agrees with a linear one");
+  }
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -24,6 +24,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015 Aug
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef MSSMSPEC_H
@@ -98,6 +102,13 @@ namespace Gambit
          slhahelp::add_MSSM_spectrum_to_SLHAea(*this, slha, slha_version);
       }
 
+      // Fill an SLHAview object with spectrum information (SPINFO holds only strings, so it is left out)
+      template <class MI>
+      void MSSMSpec<MI>::add_to_SLHAview(int slha_version, SLHAview& slha) const
+      {
+         slhahelp::add_MSSM_spectrum_to_SLHAview(*this, slha, slha_version);
+      }
+
       //inspired by softsusy's lsp method.
       //This MSSM version assumes all states mass ordered.
       //returns lsp mass and gives 3 integers to specify the state
@@ -19,6 +19,10 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///  \date 2014, 2015 Jan, Feb, Mar
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef MSSMSPEC_HEAD_H
@@ -112,6 +116,9 @@ namespace Gambit
             // Fill an SLHAea object with spectrum information
             virtual void add_to_SLHAea(int slha_version, SLHAstruct& slha) const;
 
+            // Fill an SLHAview object with spectrum information
+            virtual void add_to_SLHAview(int slha_version, SLHAview& slha) const;
+
             /// TODO: Need to implement this properly...
             /// Copy low energy spectrum information from another model object
             // Should work from any flexiblesusy model object with the same particle content as the MSSM
@@ -25,6 +25,10 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///  \date 2015 Mar
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __QedQcdWrapper_hpp__
@@ -79,6 +83,9 @@ namespace Gambit
             /// Add QEDQCD information to an SLHAea object
             virtual void add_to_SLHAea(int, SLHAstruct& slha) const;
 
+            /// Add QEDQCD information to an SLHAview object
+            virtual void add_to_SLHAview(int, SLHAview& slha) const;
+
             /// RunningPars interface overrides
             virtual double GetScale() const;      /***/
             virtual void SetScale(double scale);  /***/
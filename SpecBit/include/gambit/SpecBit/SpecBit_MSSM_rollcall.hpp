@@ -21,6 +21,10 @@
 ///          (t.e.gonzalo@fys.uio.no)
 ///  \date 2016 Jue, 2017 Jan
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 ///
 ///  SPECIAL NOTE: Since FlexibleSUSY cannot yet be backended via BOSS, we
@@ -238,6 +242,16 @@
     #undef FUNCTION
   #undef CAPABILITY
 
+  // Warm-start statistics (seeded or not, iterations, time saved) of the FlexibleSUSY run
+  // that produced the unimproved MSSM spectrum, so that they can be printed
+  #define CAPABILITY FS_warm_start_info
+  START_CAPABILITY
+    #define FUNCTION get_FS_warm_start_info
+    START_FUNCTION(map_str_dbl)
+    DEPENDENCY(unimproved_MSSM_spectrum, Spectrum)
+    #undef FUNCTION
+  #undef CAPABILITY
+
   #define CAPABILITY SM_subspectrum
   START_CAPABILITY
 
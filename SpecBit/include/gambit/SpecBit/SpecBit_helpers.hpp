@@ -14,16 +14,23 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///    \date 2014 Sep - Dec, 2015 Jan - May
 ///  
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __SpecBit_helpers_hpp__
 #define __SpecBit_helpers_hpp__
 
 #include "gambit/Elements/sminputs.hpp"
+#include "gambit/Elements/spectrum.hpp"
+#include "gambit/Utils/yaml_options.hpp"
 
 // Flexible SUSY stuff (should not be needed by the rest of gambit)
 //#include "flexiblesusy/src/ew_input.hpp"
 #include "flexiblesusy/src/lowe.h" // From softsusy; used by flexiblesusy
+#include "flexiblesusy/src/spectrum_generator_settings.hpp"
 //#include "flexiblesusy/src/numerics.hpp"
 
 namespace Gambit
@@ -42,6 +49,35 @@ namespace Gambit
     /// Initialise QedQcd object from SMInputs data
     void setup_QedQcd(softsusy::QedQcd& oneset /*output*/, const SMInputs& sminputs /*input*/);
 
+    /// Options of the FlexibleSUSY spectrum generator drivers for non-SUSY models.
+    /// Parsed once per set of options (see Options::getParsed), not at every point.
+    struct FS_options
+    {
+      flexiblesusy::Spectrum_generator_settings settings;
+      bool invalid_point_fatal;
+      Spectrum::mc_info mass_cut;
+      Spectrum::mr_info mass_ratio_cut;
+
+      FS_options(const Options& runOptions)
+      {
+        using flexiblesusy::Spectrum_generator_settings;
+        settings.set(Spectrum_generator_settings::precision, runOptions.getValueOrDef<double>(1.0e-4,"precision_goal"));
+        settings.set(Spectrum_generator_settings::max_iterations, runOptions.getValueOrDef<double>(0,"max_iterations"));
+        settings.set(Spectrum_generator_settings::calculate_sm_masses, runOptions.getValueOrDef<bool> (true, "calculate_sm_masses"));
+        settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"pole_mass_loop_order"));
+        settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"ewsb_loop_order"));
+        settings.set(Spectrum_generator_settings::beta_loop_order, runOptions.getValueOrDef<int>(2,"beta_loop_order"));
+        settings.set(Spectrum_generator_settings::threshold_corrections_loop_order, runOptions.getValueOrDef<int>(2,"threshold_corrections_loop_order"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_as"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_ab_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_ab_as"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_at, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_at"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_atau_atau, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_atau_atau"));
+        invalid_point_fatal = runOptions.getValueOrDef<bool>(false,"invalid_point_fatal");
+        mass_cut = runOptions.getValueOrDef<Spectrum::mc_info>(Spectrum::mc_info(), "mass_cut");
+        mass_ratio_cut = runOptions.getValueOrDef<Spectrum::mr_info>(Spectrum::mr_info(), "mass_ratio_cut");
+      }
+    };
+
   }
 }
  
@@ -17,6 +17,10 @@
 ///          (benjamin.farmer@fysik.su.se)
 ///  \date 2015 Mar
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -90,6 +94,12 @@ namespace Gambit
         SLHAea_add_from_subspec(slha, LOCAL_INFO, *this, Par::Pole_Mass,"d_3","MASS",5,"# mb (pole)");
       }
 
+      /// Add QED x QCD information to an SLHAview object (the same entries as add_to_SLHAea)
+      void QedQcdWrapper::add_to_SLHAview(int, SLHAview& slha) const
+      {
+        SLHAea_add_from_subspec(slha, LOCAL_INFO, *this, Par::Pole_Mass,"d_3","MASS",5,"# mb (pole)");
+      }
+
       /// Run masses and couplings to end_scale
       void QedQcdWrapper::RunToScaleOverride(double end_scale)
       {
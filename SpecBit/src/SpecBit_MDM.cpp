@@ -69,20 +69,9 @@ namespace Gambit
       // Create spectrum generator object
       typename MI::SpectrumGenerator spectrum_generator;
 
-      Spectrum_generator_settings settings;
-      settings.set(Spectrum_generator_settings::precision, runOptions.getValueOrDef<double>(1.0e-4,"precision_goal"));
-      settings.set(Spectrum_generator_settings::max_iterations, runOptions.getValueOrDef<double>(0,"max_iterations"));
-      settings.set(Spectrum_generator_settings::calculate_sm_masses, runOptions.getValueOrDef<bool> (true, "calculate_sm_masses"));
-      settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"pole_mass_loop_order"));
-      settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"ewsb_loop_order"));
-      settings.set(Spectrum_generator_settings::beta_loop_order, runOptions.getValueOrDef<int>(2,"beta_loop_order"));
-      settings.set(Spectrum_generator_settings::threshold_corrections_loop_order, runOptions.getValueOrDef<int>(2,"threshold_corrections_loop_order"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_as"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_ab_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_ab_as"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_at, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_at"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_atau_atau, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_atau_atau"));
-
-      spectrum_generator.set_settings(settings);
+      // Spectrum generator settings (see FS_options)
+      const FS_options& options = runOptions.getParsed<FS_options>();
+      spectrum_generator.set_settings(options.settings);
 
       // Generate spectrum
       spectrum_generator.run(oneset, input);
@@ -107,7 +96,7 @@ namespace Gambit
       #endif
       if( problems.have_problem() )
       {
-         if( runOptions.getValueOrDef<bool>(false,"invalid_point_fatal") )
+         if( options.invalid_point_fatal )
          {
             std::ostringstream errmsg;
             errmsg << "A serious problem was encountered during spectrum generation!";
@@ -128,11 +117,8 @@ namespace Gambit
 			double QEWSB  = *input_Param.at("QEWSB");
 			mdmspec.RunToScaleOverride(QEWSB);
 
-      // Retrieve any mass cuts
-      static const Spectrum::mc_info mass_cut = runOptions.getValueOrDef<Spectrum::mc_info>(Spectrum::mc_info(), "mass_cut");
-      static const Spectrum::mr_info mass_ratio_cut = runOptions.getValueOrDef<Spectrum::mr_info>(Spectrum::mr_info(), "mass_ratio_cut");
 
-      return Spectrum(qedqcdspec,mdmspec,sminputs,&input_Param, mass_cut, mass_ratio_cut);
+      return Spectrum(qedqcdspec,mdmspec,sminputs,&input_Param, options.mass_cut, options.mass_ratio_cut);
 
     }
 
@@ -28,12 +28,20 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015, 2016
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include <string>
 #include <sstream>
 #include <cmath>
 #include <complex>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
 
 #include "gambit/Elements/gambit_module_headers.hpp"
 #include "gambit/Elements/spectrum_factories.hpp"
@@ -53,6 +61,7 @@
 #include "flexiblesusy/src/numerics2.hpp"
 //#include "flexiblesusy/src/mssm_twoloophiggs.hpp"
 #include "flexiblesusy/src/spectrum_generator_settings.hpp"
+#include "flexiblesusy/src/two_scale_solver.hpp"
 
 // Switch for debug mode
 //#define SPECBIT_DEBUG
@@ -74,6 +83,178 @@ namespace Gambit
     //  The Gambit module functions merely wrap the functions here and hook
     //  them up to their dependencies, and input parameters.
 
+    /// Converged FlexibleSUSY solutions of recent points, used to warm-start the
+    /// two-scale solver at nearby points.
+    //  The Two_scale_warm_start hook of the solver is not part of FlexibleSUSY,
+    //  but is added by contrib/patches/flexiblesusy/<version>/, which the build
+    //  applies before configuring FlexibleSUSY.
+    //  Entries are keyed on the model parameters of the point they were obtained
+    //  at.  Only a handful of entries are kept, so the nearest one is found by a
+    //  linear scan.  Distances are measured in relative differences of each
+    //  parameter (absolute differences for parameters below 1 in magnitude).
+    //  All methods lock the cache, as module functions may run concurrently.
+    class FS_warm_start_cache
+    {
+      public:
+        /// Store the solution obtained at parameters x, dropping the oldest entry if full
+        void insert(const std::vector<double>& x, const Two_scale_warm_start& solution, size_t capacity)
+        {
+          if (capacity == 0) return;
+          std::lock_guard<std::mutex> lock(mtx);
+          while (entries.size() >= capacity) entries.pop_front();
+          entries.emplace_back(x, solution);
+          entries.back().second.use_solution = true;
+        }
+
+        /// Copy the nearest stored solution to x into solution; false if none lies within max_distance
+        bool nearest(const std::vector<double>& x, double max_distance, Two_scale_warm_start& solution) const
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          const Two_scale_warm_start* best = NULL;
+          double best_distance = max_distance;
+          for (const auto& entry : entries)
+          {
+            if (entry.first.size() != x.size()) continue;
+            double d2 = 0.0;
+            for (size_t i = 0; i < x.size(); ++i)
+            {
+              const double norm = std::max(1.0, std::max(std::abs(x[i]), std::abs(entry.first[i])));
+              d2 += std::pow((x[i] - entry.first[i])/norm, 2);
+            }
+            const double distance = std::sqrt(d2);
+            if (distance <= best_distance)
+            {
+              best_distance = distance;
+              best = &entry.second;
+            }
+          }
+          if (best != NULL) solution = *best;
+          return best != NULL;
+        }
+
+        /// Record the wall time of a cold-started run
+        void add_cold_run(double seconds)
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          cold_time += seconds;
+          ++cold_runs;
+        }
+
+        /// Record a warm-started run that did not converge and was rerun from a cold start
+        void add_fallback()
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          ++fallbacks;
+        }
+
+        /// Mean wall time of the cold-started runs so far (zero if there were none)
+        double mean_cold_time() const
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          return cold_runs > 0 ? cold_time/cold_runs : 0.0;
+        }
+
+        /// Number of warm-started runs so far that had to be rerun from a cold start
+        long n_fallbacks() const
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          return fallbacks;
+        }
+
+      private:
+        mutable std::mutex mtx;
+        std::deque<std::pair<std::vector<double>, Two_scale_warm_start> > entries;
+        double cold_time = 0.0;
+        long cold_runs = 0;
+        long fallbacks = 0;
+    };
+
+    /// Warm-start cache of the module function with the given options.  Each module function
+    /// gets its own cache, even if several of them use the same FlexibleSUSY model interface.
+    FS_warm_start_cache& get_FS_warm_start_cache(const Options& runOptions)
+    {
+      static std::map<const Options*, FS_warm_start_cache> caches;
+      static std::mutex mtx;
+      std::lock_guard<std::mutex> lock(mtx);
+      return caches[&runOptions];
+    }
+
+    /// Warm-start statistics of the most recent FlexibleSUSY MSSM run, and their lock
+    map_str_dbl FS_warm_start_stats;
+    std::mutex FS_warm_start_stats_mutex;
+
+    /// Options of the FlexibleSUSY MSSM spectrum generator drivers.
+    /// Parsed once per set of options (see Options::getParsed), not at every point.
+    struct FS_MSSM_options
+    {
+      Spectrum_generator_settings settings;
+      std::vector<std::pair<str,double> > override_pole_masses;
+      bool invalid_point_fatal;
+      int warm_start_cache_size;
+      double warm_start_max_distance;
+      Spectrum::mc_info mass_cut;
+      Spectrum::mr_info mass_ratio_cut;
+
+      FS_MSSM_options(const Options& runOptions)
+      {
+        // Spectrum generator settings
+        // Default options copied from flexiblesusy/src/spectrum_generator_settings.hpp
+        //
+        // | enum                             | possible values              | default value   |
+        // |----------------------------------|------------------------------|-----------------|
+        // | precision                        | any positive double          | 1.0e-4          |
+        // | max_iterations                   | any positive double          | 0 (= automatic) |
+        // | algorithm                        | 0 (two-scale) or 1 (lattice) | 0 (= two-scale) |
+        // | calculate_sm_masses              | 0 (no) or 1 (yes)            | 0 (= no)        |
+        // | pole_mass_loop_order             | 0, 1, 2                      | 2 (= 2-loop)    |
+        // | ewsb_loop_order                  | 0, 1, 2                      | 2 (= 2-loop)    |
+        // | beta_loop_order                  | 0, 1, 2                      | 2 (= 2-loop)    |
+        // | threshold_corrections_loop_order | 0, 1                         | 1 (= 1-loop)    |
+        // | higgs_2loop_correction_at_as     | 0, 1                         | 1 (= enabled)   |
+        // | higgs_2loop_correction_ab_as     | 0, 1                         | 1 (= enabled)   |
+        // | higgs_2loop_correction_at_at     | 0, 1                         | 1 (= enabled)   |
+        // | higgs_2loop_correction_atau_atau | 0, 1                         | 1 (= enabled)   |
+
+        settings.set(Spectrum_generator_settings::precision, runOptions.getValueOrDef<double>(1.0e-4,"precision_goal"));
+        settings.set(Spectrum_generator_settings::max_iterations, runOptions.getValueOrDef<double>(0,"max_iterations"));
+        settings.set(Spectrum_generator_settings::calculate_sm_masses, runOptions.getValueOrDef<bool> (false, "calculate_sm_masses"));
+        settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"pole_mass_loop_order"));
+        settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"ewsb_loop_order"));
+        settings.set(Spectrum_generator_settings::beta_loop_order, runOptions.getValueOrDef<int>(2,"beta_loop_order"));
+        settings.set(Spectrum_generator_settings::threshold_corrections_loop_order, runOptions.getValueOrDef<int>(2,"threshold_corrections_loop_order"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_as"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_ab_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_ab_as"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_at, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_at"));
+        settings.set(Spectrum_generator_settings::higgs_2loop_correction_atau_atau, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_atau_atau"));
+        settings.set(Spectrum_generator_settings::top_pole_qcd_corrections, runOptions.getValueOrDef<int>(1,"top_pole_qcd_corrections"));
+        settings.set(Spectrum_generator_settings::beta_zero_threshold, runOptions.getValueOrDef<int>(1.000000000e-14,"beta_zero_threshold"));
+        settings.set(Spectrum_generator_settings::eft_matching_loop_order_up, runOptions.getValueOrDef<int>(1,"eft_matching_loop_order_up"));
+        settings.set(Spectrum_generator_settings::eft_matching_loop_order_down, runOptions.getValueOrDef<int>(1,"eft_matching_loop_order_down"));
+        settings.set(Spectrum_generator_settings::threshold_corrections, runOptions.getValueOrDef<int>(123111321,"threshold_corrections"));
+
+        // Pole mass values that should override those computed by FlexibleSUSY
+        if (runOptions.hasKey("override_FS_pole_masses"))
+        {
+          for (const str& name : runOptions.getNames("override_FS_pole_masses"))
+          {
+            override_pole_masses.push_back(std::make_pair(name, runOptions.getValue<double>("override_FS_pole_masses", name)));
+          }
+        }
+
+        invalid_point_fatal = runOptions.getValueOrDef<bool>(false,"invalid_point_fatal");
+
+        /// Option warm_start_cache_size<int>: Number of converged solutions kept for warm-starting
+        /// the two-scale solver at nearby points; 0 disables warm starts (default 0)
+        warm_start_cache_size = runOptions.getValueOrDef<int>(0, "warm_start_cache_size");
+        /// Option warm_start_max_distance<double>: Maximum distance in (relative) parameter space
+        /// between a point and a stored solution for the latter to be used (default 0.1)
+        warm_start_max_distance = runOptions.getValueOrDef<double>(0.1, "warm_start_max_distance");
+
+        mass_cut = runOptions.getValueOrDef<Spectrum::mc_info>(Spectrum::mc_info(), "mass_cut");
+        mass_ratio_cut = runOptions.getValueOrDef<Spectrum::mr_info>(Spectrum::mr_info(), "mass_ratio_cut");
+      }
+    };
+
     /// Compute an MSSM spectrum using flexiblesusy
     // In GAMBIT there are THREE flexiblesusy MSSM spectrum generators currently in
     // use, for each of three possible boundary condition types:
@@ -107,47 +288,62 @@ namespace Gambit
       // Create spectrum generator object
       typename MI::SpectrumGenerator spectrum_generator;
 
-      // Spectrum generator settings
-      // Default options copied from flexiblesusy/src/spectrum_generator_settings.hpp
-      //
-      // | enum                             | possible values              | default value   |
-      // |----------------------------------|------------------------------|-----------------|
-      // | precision                        | any positive double          | 1.0e-4          |
-      // | max_iterations                   | any positive double          | 0 (= automatic) |
-      // | algorithm                        | 0 (two-scale) or 1 (lattice) | 0 (= two-scale) |
-      // | calculate_sm_masses              | 0 (no) or 1 (yes)            | 0 (= no)        |
-      // | pole_mass_loop_order             | 0, 1, 2                      | 2 (= 2-loop)    |
-      // | ewsb_loop_order                  | 0, 1, 2                      | 2 (= 2-loop)    |
-      // | beta_loop_order                  | 0, 1, 2                      | 2 (= 2-loop)    |
-      // | threshold_corrections_loop_order | 0, 1                         | 1 (= 1-loop)    |
-      // | higgs_2loop_correction_at_as     | 0, 1                         | 1 (= enabled)   |
-      // | higgs_2loop_correction_ab_as     | 0, 1                         | 1 (= enabled)   |
-      // | higgs_2loop_correction_at_at     | 0, 1                         | 1 (= enabled)   |
-      // | higgs_2loop_correction_atau_atau | 0, 1                         | 1 (= enabled)   |
+      // Spectrum generator settings (see FS_MSSM_options)
+      const FS_MSSM_options& options = runOptions.getParsed<FS_MSSM_options>();
+      spectrum_generator.set_settings(options.settings);
 
-      Spectrum_generator_settings settings;
-      settings.set(Spectrum_generator_settings::precision, runOptions.getValueOrDef<double>(1.0e-4,"precision_goal"));
-      settings.set(Spectrum_generator_settings::max_iterations, runOptions.getValueOrDef<double>(0,"max_iterations"));
-      settings.set(Spectrum_generator_settings::calculate_sm_masses, runOptions.getValueOrDef<bool> (false, "calculate_sm_masses"));
-      settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"pole_mass_loop_order"));
-      settings.set(Spectrum_generator_settings::pole_mass_loop_order, runOptions.getValueOrDef<int>(2,"ewsb_loop_order"));
-      settings.set(Spectrum_generator_settings::beta_loop_order, runOptions.getValueOrDef<int>(2,"beta_loop_order"));
-      settings.set(Spectrum_generator_settings::threshold_corrections_loop_order, runOptions.getValueOrDef<int>(2,"threshold_corrections_loop_order"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_as"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_ab_as, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_ab_as"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_at_at, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_at_at"));
-      settings.set(Spectrum_generator_settings::higgs_2loop_correction_atau_atau, runOptions.getValueOrDef<int>(1,"higgs_2loop_correction_atau_atau"));
-      settings.set(Spectrum_generator_settings::top_pole_qcd_corrections, runOptions.getValueOrDef<int>(1,"top_pole_qcd_corrections"));
-      settings.set(Spectrum_generator_settings::beta_zero_threshold, runOptions.getValueOrDef<int>(1.000000000e-14,"beta_zero_threshold"));
-      settings.set(Spectrum_generator_settings::eft_matching_loop_order_up, runOptions.getValueOrDef<int>(1,"eft_matching_loop_order_up"));
-      settings.set(Spectrum_generator_settings::eft_matching_loop_order_down, runOptions.getValueOrDef<int>(1,"eft_matching_loop_order_down"));
-      settings.set(Spectrum_generator_settings::threshold_corrections, runOptions.getValueOrDef<int>(123111321,"threshold_corrections"));
-
-
-      spectrum_generator.set_settings(settings);
+      // Seed the solver from the nearest recently converged solution, if warm starts are enabled.
+      const int warm_start_cache_size = options.warm_start_cache_size;
+      FS_warm_start_cache* warm_start_cache = NULL;
+      std::vector<double> warm_start_key;
+      Two_scale_warm_start warm_start;
+      if (warm_start_cache_size > 0)
+      {
+        warm_start_cache = &get_FS_warm_start_cache(runOptions);
+        for (const auto& par : input_Param) warm_start_key.push_back(*par.second);
+        warm_start_cache->nearest(warm_start_key, options.warm_start_max_distance, warm_start);
+      }
 
       // Generate spectrum
+      const auto start = std::chrono::steady_clock::now();
+      RGFlow<Two_scale>::set_warm_start(&warm_start);
       spectrum_generator.run(oneset, input);
+      const bool warm_started = warm_start.seeded;
+      const bool fallback = warm_started and not warm_start.converged;
+      const int warm_iterations = warm_start.iterations;
+      auto cold_start = start;
+      if (fallback)
+      {
+        // Fall back to the usual initial guess
+        logger() << LogTags::debug << "Warm-started FlexibleSUSY run did not converge after "
+                 << warm_start.iterations << " iterations; retrying from cold start." << EOM;
+        cold_start = std::chrono::steady_clock::now();
+        warm_start.use_solution = false;
+        spectrum_generator.run(oneset, input);
+      }
+      RGFlow<Two_scale>::set_warm_start(NULL);
+      const auto stop = std::chrono::steady_clock::now();
+      // Total wall time, including any failed warm-started attempt
+      const double run_time = std::chrono::duration<double>(stop - start).count();
+
+      if (warm_start_cache != NULL)
+      {
+        if (warm_start.converged and not warm_start.parameters.empty())
+        {
+          warm_start_cache->insert(warm_start_key, warm_start, warm_start_cache_size);
+        }
+        // The cold rerun after a fallback is a genuine cold run; the failed attempt before it is not.
+        if (not warm_started or fallback) warm_start_cache->add_cold_run(std::chrono::duration<double>(stop - cold_start).count());
+        if (fallback) warm_start_cache->add_fallback();
+      }
+      {
+        std::lock_guard<std::mutex> lock(FS_warm_start_stats_mutex);
+        FS_warm_start_stats["warm_started"] = warm_started;
+        FS_warm_start_stats["fallback"] = fallback;
+        FS_warm_start_stats["fallbacks"] = warm_start_cache != NULL ? warm_start_cache->n_fallbacks() : 0;
+        FS_warm_start_stats["iterations"] = warm_iterations + (fallback ? warm_start.iterations : 0);
+        FS_warm_start_stats["time_saved"] = warm_started ? warm_start_cache->mean_cold_time() - run_time : 0.0;
+      }
 
       // Extract report on problems...
       const typename MI::Problems& problems = spectrum_generator.get_problems();
@@ -181,14 +377,9 @@ namespace Gambit
 
       // Has the user chosen to override any pole mass values?
       // This will typically break consistency, but may be useful in some special cases
-      if (runOptions.hasKey("override_FS_pole_masses"))
+      for (const auto& override_mass : options.override_pole_masses)
       {
-        std::vector<str> particle_names = runOptions.getNames("override_FS_pole_masses");
-        for (auto& name : particle_names)
-        {
-          double mass = runOptions.getValue<double>("override_FS_pole_masses", name);
-          mssmspec.set_override(Par::Pole_Mass, mass, name);
-        }
+        mssmspec.set_override(Par::Pole_Mass, override_mass.second, override_mass.first);
       }
 
       // Add theory errors
@@ -240,7 +431,7 @@ namespace Gambit
       #endif
       if( problems.have_problem() )
       {
-         if( runOptions.getValueOrDef<bool>(false,"invalid_point_fatal") )
+         if( options.invalid_point_fatal )
          {
             ///TODO: Need to tell gambit that the spectrum is not viable somehow. For now
             /// just die.
@@ -292,12 +483,8 @@ namespace Gambit
          slha_io.write_to_file("SpecBit/initial_CMSSM_spectrum->slha");
       #endif
 
-      // Retrieve any mass cuts
-      static const Spectrum::mc_info mass_cut = runOptions.getValueOrDef<Spectrum::mc_info>(Spectrum::mc_info(), "mass_cut");
-      static const Spectrum::mr_info mass_ratio_cut = runOptions.getValueOrDef<Spectrum::mr_info>(Spectrum::mr_info(), "mass_ratio_cut");
-
       // Package QedQcd SubSpectrum object, MSSM SubSpectrum object, and SMInputs struct into a 'full' Spectrum object
-      return Spectrum(qedqcdspec,mssmspec,sminputs,&input_Param,mass_cut,mass_ratio_cut);
+      return Spectrum(qedqcdspec,mssmspec,sminputs,&input_Param,options.mass_cut,options.mass_ratio_cut);
     }
 
   //Version for 1.5.1 commented out because we should make it possible to support FS versions in parallel.
@@ -1749,6 +1936,20 @@ namespace Gambit
     }
     /// @}
 
+    /// Warm-start statistics of the FlexibleSUSY run for the unimproved MSSM spectrum at this point:
+    /// whether the solver was seeded from a nearby solution, whether that run failed and the point
+    /// was rerun from a cold start (and how many times that has happened so far), the number of
+    /// two-scale iterations of all attempts, and the wall time (in s) saved relative to the mean
+    /// cold-started run, which is negative if a failed warm start cost time.
+    void get_FS_warm_start_info (map_str_dbl& result)
+    {
+      namespace myPipe = Pipes::get_FS_warm_start_info;
+      // Only ensures that the spectrum for this point has been computed
+      (void)*myPipe::Dep::unimproved_MSSM_spectrum;
+      std::lock_guard<std::mutex> lock(FS_warm_start_stats_mutex);
+      result = FS_warm_start_stats;
+    }
+
     /// Extract all parameters from a subspectrum and put them into a map
     template<class Contents>
     void fill_map_from_subspectrum(std::map<std::string,double>& specmap, const SubSpectrum& subspec)
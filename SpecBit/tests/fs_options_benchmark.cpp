@@ -0,0 +1,97 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Microbenchmark of the per-point cost of reading
+///  the options of a FlexibleSUSY spectrum
+///  generator driver: parsing them from the yaml
+///  options at every point, as the drivers used
+///  to, against reading the view cached by
+///  Options::getParsed.  Also checks that both
+///  give the same settings.
+///
+///  Usage: fs_options_benchmark [npoints]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/SpecBit/SpecBit_helpers.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::SpecBit;
+using flexiblesusy::Spectrum_generator_settings;
+
+namespace
+{
+
+  /// Time per point (ns) of reading the options npoints times, and the precision goal last read
+  template <typename F>
+  double time_per_point_ns(int npoints, F read, double& precision)
+  {
+    precision = 0.;
+    const auto start = std::chrono::steady_clock::now();
+    for (int point = 0; point < npoints; ++point) precision += read().settings.get(Spectrum_generator_settings::precision);
+    precision /= npoints;
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / npoints;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const int npoints = (argc > 1 ? std::atoi(argv[1]) : 100000);
+
+  logger().disable();
+
+  // Options of a spectrum generator driver, as in yaml_files/CMSSM.yaml, plus a mass cut
+  const Options runOptions(YAML::Load(
+    "precision_goal: 1.0e-4\n"
+    "max_iterations: 0\n"
+    "calculate_sm_masses: false\n"
+    "pole_mass_loop_order: 2\n"
+    "ewsb_loop_order: 2\n"
+    "beta_loop_order: 2\n"
+    "threshold_corrections_loop_order: 2\n"
+    "invalid_point_fatal: false\n"
+    "mass_cut: [[\"h0_1\", 100, 150]]\n"));
+
+  double precision_parsed, precision_cached;
+  const double t_parsed = time_per_point_ns(npoints, [&]{ return FS_options(runOptions); }, precision_parsed);
+  const double t_cached = time_per_point_ns(npoints, [&]() -> const FS_options& { return runOptions.getParsed<FS_options>(); }, precision_cached);
+
+  Utils::benchmark_table table("FlexibleSUSY driver options, " + std::to_string(npoints) + " points",
+                                {{"options read", 28, ""}, {"per point [ns]", 16, "%.1f"}});
+  table.row("parsed at every point", t_parsed);
+  table.row("cached view (getParsed)", t_cached);
+  table.row("speedup", t_parsed/t_cached);
+
+  const FS_options parsed(runOptions);
+  const FS_options& cached = runOptions.getParsed<FS_options>();
+  bool agree = (precision_parsed == precision_cached and parsed.invalid_point_fatal == cached.invalid_point_fatal
+                and parsed.mass_cut.size() == cached.mass_cut.size());
+  for (int i = 0; i < Spectrum_generator_settings::NUMBER_OF_OPTIONS; ++i)
+  {
+    const Spectrum_generator_settings::Settings setting = static_cast<Spectrum_generator_settings::Settings>(i);
+    agree = agree and parsed.settings.get(setting) == cached.settings.get(setting);
+  }
+  if (not agree)
+  {
+    std::printf("The cached view differs from the options parsed at each point.\n");
+    return 1;
+  }
+  return 0;
+}
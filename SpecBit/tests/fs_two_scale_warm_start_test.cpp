@@ -0,0 +1,246 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Unit test of GAMBIT's warm-start patch to the
+///  FlexibleSUSY two-scale solver, on a toy model
+///  that needs no spectrum generator: two gauge
+///  couplings that unify at a high scale, where a
+///  soft mass is set, with low-scale threshold
+///  corrections that depend on that mass.  A run
+///  seeded from the solution of the same or a
+///  nearby point must reproduce the cold-started
+///  solution, in fewer iterations.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "flexiblesusy/src/betafunction.hpp"
+#include "flexiblesusy/src/convergence_tester.hpp"
+#include "flexiblesusy/src/initial_guesser.hpp"
+#include "flexiblesusy/src/model.hpp"
+#include "flexiblesusy/src/single_scale_constraint.hpp"
+#include "flexiblesusy/src/two_scale_solver.hpp"
+
+using namespace flexiblesusy;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const std::string& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  const double oneOver16PiSqr = 1./(16.*M_PI*M_PI);
+  const double MZ = 91.1876;
+
+  /// Toy model: couplings g1 and g2 with one-loop coefficients b1 and b2 and a small two-loop term, and a mass m
+  /// that runs with g2
+  class Toy_model : public Model, public Beta_function
+  {
+    public:
+      double g1 = 0, g2 = 0, m = 0;
+
+      Toy_model() { set_number_of_parameters(3); set_loops(2); }
+
+      Eigen::ArrayXd get() const override
+      {
+        Eigen::ArrayXd pars(3);
+        pars << g1, g2, m;
+        return pars;
+      }
+      void set(const Eigen::ArrayXd& pars) override { g1 = pars(0); g2 = pars(1); m = pars(2); }
+      Eigen::ArrayXd beta() const override
+      {
+        Eigen::ArrayXd betas(3);
+        betas << oneOver16PiSqr*6.6*std::pow(g1,3) + std::pow(oneOver16PiSqr,2)*8.*std::pow(g1,5),
+                 oneOver16PiSqr*1.0*std::pow(g2,3) + std::pow(oneOver16PiSqr,2)*25.*std::pow(g2,5),
+                 -oneOver16PiSqr*6.*g2*g2*m;
+        return betas;
+      }
+
+      void calculate_spectrum() override {}
+      void clear_problems() override {}
+      std::string name() const override { return "Toy"; }
+      void print(std::ostream& out) const override { out << g1 << " " << g2 << " " << m << "\n"; }
+      void run_to(double scale, double eps) override { Beta_function::run_to(scale, eps); }
+      void set_precision(double) override {}
+  };
+
+  /// Sets the couplings at MZ, with threshold corrections depending on the mass there
+  class Low_scale_constraint : public Single_scale_constraint
+  {
+    public:
+      Toy_model* model = nullptr;
+      void apply() override
+      {
+        const double threshold = std::log(std::abs(model->m)/MZ);
+        model->g1 = 0.46*(1. - 0.004*threshold);
+        model->g2 = 0.65*(1. - 0.012*threshold);
+      }
+      double get_scale() const override { return MZ; }
+      void set_model(Model* m) override { model = static_cast<Toy_model*>(m); }
+  };
+
+  /// Finds the scale where the couplings unify (with a one-loop estimate, so it takes several iterations) and
+  /// sets the mass m0 there
+  class High_scale_constraint : public Single_scale_constraint
+  {
+    public:
+      Toy_model* model = nullptr;
+      double m0 = 0, scale = 0;
+      void apply() override
+      {
+        model->m = m0;
+        const double dt = (1./std::pow(model->g1,2) - 1./std::pow(model->g2,2)) / (2.*oneOver16PiSqr*(6.6 - 1.0));
+        scale = model->get_scale()*std::exp(dt);
+      }
+      double get_scale() const override { return scale; }
+      void set_model(Model* m) override { model = static_cast<Toy_model*>(m); }
+  };
+
+  /// Starts from the low-scale couplings and a high scale of 2e16 GeV
+  class Toy_initial_guesser : public Initial_guesser
+  {
+    public:
+      Toy_model* model;
+      High_scale_constraint* high;
+      Toy_initial_guesser(Toy_model* m, High_scale_constraint* h) : model(m), high(h) {}
+      void guess() override
+      {
+        model->set_scale(MZ);
+        model->g1 = 0.46;
+        model->g2 = 0.65;
+        model->m = high->m0;
+        high->scale = 2.e16;
+      }
+  };
+
+  /// Converged when the mass at MZ and the high scale change by less than the precision goal between iterations
+  class Toy_convergence_tester : public Convergence_tester
+  {
+    public:
+      static constexpr double precision = 1e-6;
+      Toy_model* model;
+      High_scale_constraint* high;
+      double last_m = 0, last_scale = 0;
+      Toy_convergence_tester(Toy_model* m, High_scale_constraint* h) : model(m), high(h) {}
+      bool accuracy_goal_reached() override
+      {
+        const bool reached = std::abs(model->m - last_m) <= precision*std::abs(model->m)
+                             and std::abs(high->scale - last_scale) <= precision*high->scale;
+        last_m = model->m;
+        last_scale = high->scale;
+        return reached;
+      }
+      int max_iterations() const override { return 100; }
+      void restart() override { last_m = 0; last_scale = 0; }
+  };
+
+  /// Solution of a toy point
+  struct solution
+  {
+    bool converged;
+    double m_low, g1_low, g2_low, high_scale;
+    bool agrees_with(const solution& s, double tolerance) const
+    {
+      auto close = [=](double a, double b) { return std::abs(a-b) <= tolerance*std::max(std::abs(a), std::abs(b)); };
+      return close(m_low, s.m_low) and close(g1_low, s.g1_low) and close(g2_low, s.g2_low) and close(high_scale, s.high_scale);
+    }
+  };
+
+  /// Solve the toy model with the given m0, seeded from warm_start if its use_solution flag is set
+  solution solve(double m0, Two_scale_warm_start& warm_start)
+  {
+    Toy_model model;
+    Low_scale_constraint low;
+    High_scale_constraint high;
+    low.set_model(&model);
+    high.set_model(&model);
+    high.m0 = m0;
+    Toy_initial_guesser guesser(&model, &high);
+    Toy_convergence_tester tester(&model, &high);
+
+    RGFlow<Two_scale> solver;
+    solver.set_convergence_tester(&tester);
+    solver.set_initial_guesser(&guesser);
+    solver.add(&low, &model);
+    solver.add(&high, &model);
+    solver.add(&low, &model);
+
+    solution result = {true, 0, 0, 0, 0};
+    RGFlow<Two_scale>::set_warm_start(&warm_start);
+    try { solver.solve(); }
+    catch (const Error&) { result.converged = false; }
+    RGFlow<Two_scale>::set_warm_start(nullptr);
+    result.m_low = model.m;
+    result.g1_low = model.g1;
+    result.g2_low = model.g2;
+    result.high_scale = high.scale;
+    return result;
+  }
+
+}
+
+int main()
+{
+  const double tolerance = 10.*Toy_convergence_tester::precision;
+
+  std::cout << "Cold start:" << std::endl;
+  Two_scale_warm_start cold;
+  const solution reference = solve(500., cold);
+  check(reference.converged and cold.converged and not cold.seeded, "the cold-started run converges without being seeded");
+  check(cold.parameters.size() == 1 and cold.parameters[0].size() == 3 and cold.scales.size() == 1,
+        "the converged solution of the model is saved");
+  check(cold.iterations > 2, "the cold-started run needs several iterations (" + std::to_string(cold.iterations) + ")");
+
+  std::cout << "Warm start at the same point:" << std::endl;
+  Two_scale_warm_start same = cold;
+  same.use_solution = true;
+  const solution reseeded = solve(500., same);
+  check(reseeded.converged and same.seeded and same.converged, "the seeded run converges");
+  check(reseeded.agrees_with(reference, tolerance), "the seeded run reproduces the cold-started solution");
+  check(same.iterations < cold.iterations, "the seeded run needs fewer iterations than the cold start ("
+                                           + std::to_string(same.iterations) + ")");
+
+  std::cout << "Warm start at a nearby point:" << std::endl;
+  Two_scale_warm_start nearby_cold;
+  const solution nearby_reference = solve(520., nearby_cold);
+  Two_scale_warm_start nearby = cold;
+  nearby.use_solution = true;
+  const solution nearby_seeded = solve(520., nearby);
+  check(nearby_seeded.converged and nearby.seeded and nearby.converged, "the run seeded from a nearby point converges");
+  check(nearby_seeded.agrees_with(nearby_reference, tolerance), "the run seeded from a nearby point reproduces its cold-started solution");
+  check(nearby.iterations <= nearby_cold.iterations, "the run seeded from a nearby point needs no more iterations than its cold start ("
+                                                     + std::to_string(nearby.iterations) + " vs "
+                                                     + std::to_string(nearby_cold.iterations) + ")");
+
+  std::cout << "Unusable warm starts:" << std::endl;
+  Two_scale_warm_start unused = cold;
+  const solution unseeded = solve(500., unused);
+  check(not unused.seeded and unseeded.agrees_with(reference, tolerance), "a stored solution is not used unless use_solution is set");
+  Two_scale_warm_start mismatched = cold;
+  mismatched.use_solution = true;
+  mismatched.parameters[0].resize(2);
+  const solution unmatched = solve(500., mismatched);
+  check(not mismatched.seeded and unmatched.converged and unmatched.agrees_with(reference, tolerance),
+        "a stored solution for a different set of parameters is ignored");
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Unit test of warm-starting the FlexibleSUSY
+///  two-scale solver (Two_scale_warm_start): a
+///  CMSSM spectrum solved from the converged
+///  solution of the same or a nearby point must
+///  reproduce the cold-started spectrum.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cmath>
+#include <iostream>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+#include "flexiblesusy/src/lowe.h"
+#include "flexiblesusy/src/spectrum_generator_settings.hpp"
+#include "flexiblesusy/src/two_scale_solver.hpp"
+#include "CMSSM_input_parameters.hpp"
+#include "CMSSM_two_scale_spectrum_generator.hpp"
+
+using namespace Gambit;
+using namespace flexiblesusy;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool condition, const str& what)
+  {
+    if (not condition) failures++;
+    std::cout << (condition ? "  passed: " : "  FAILED: ") << what << std::endl;
+  }
+
+  /// Pole masses compared between runs
+  struct masses
+  {
+    double mh, mA, mglu, mchi1, msu1;
+    bool agrees_with(const masses& m, double tolerance) const
+    {
+      auto close = [=](double a, double b) { return std::abs(a-b) <= tolerance*std::max(std::abs(a), std::abs(b)); };
+      return close(mh, m.mh) and close(mA, m.mA) and close(mglu, m.mglu) and close(mchi1, m.mchi1) and close(msu1, m.msu1);
+    }
+  };
+
+  /// Solve the CMSSM at the given point, seeded from warm_start if its use_solution flag is set
+  masses solve(double m0, double m12, Two_scale_warm_start& warm_start, bool& ok)
+  {
+    CMSSM_input_parameters input;
+    input.m0 = m0;
+    input.m12 = m12;
+    input.TanBeta = 10.;
+    input.SignMu = 1;
+    input.Azero = 0.;
+    softsusy::QedQcd qedqcd;
+
+    CMSSM_spectrum_generator<Two_scale> spectrum_generator;
+    spectrum_generator.set_settings(Spectrum_generator_settings());
+    RGFlow<Two_scale>::set_warm_start(&warm_start);
+    spectrum_generator.run(qedqcd, input);
+    RGFlow<Two_scale>::set_warm_start(NULL);
+
+    ok = not spectrum_generator.get_problems().have_problem();
+    const auto model = spectrum_generator.get_model();
+    const auto& physical = model.get_physical();
+    return masses{physical.Mhh(0), physical.MAh(1), physical.MGlu, physical.MChi(0), physical.MSu(0)};
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+  // Ten times the default precision goal of the two-scale solver
+  const double tolerance = 10.*Spectrum_generator_settings().get(Spectrum_generator_settings::precision);
+  bool ok;
+
+  std::cout << "Cold start:" << std::endl;
+  Two_scale_warm_start cold;
+  const masses reference = solve(125., 500., cold, ok);
+  check(ok and cold.converged and not cold.seeded, "the cold-started run converges without being seeded");
+  check(not cold.parameters.empty(), "the converged solution is saved");
+
+  std::cout << "Warm start at the same point:" << std::endl;
+  Two_scale_warm_start same = cold;
+  same.use_solution = true;
+  const masses reseeded = solve(125., 500., same, ok);
+  check(ok and same.seeded and same.converged, "the seeded run converges");
+  check(reseeded.agrees_with(reference, tolerance), "the seeded run reproduces the cold-started spectrum");
+  check(same.iterations <= cold.iterations, "the seeded run needs no more iterations than the cold start");
+
+  std::cout << "Warm start at a nearby point:" << std::endl;
+  Two_scale_warm_start nearby_cold;
+  const masses nearby_reference = solve(130., 510., nearby_cold, ok);
+  Two_scale_warm_start nearby = cold;
+  nearby.use_solution = true;
+  const masses nearby_seeded = solve(130., 510., nearby, ok);
+  check(ok and nearby.seeded and nearby.converged, "the run seeded from a nearby point converges");
+  check(nearby_seeded.agrees_with(nearby_reference, tolerance), "the run seeded from a nearby point reproduces its cold-started spectrum");
+
+  std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " test(s) failed.") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
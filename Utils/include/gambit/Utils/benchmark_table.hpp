@@ -0,0 +1,85 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Table of timings printed by the GAMBIT
+///  benchmarks ('make benchmarks').
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __benchmark_table_hpp__
+#define __benchmark_table_hpp__
+
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "gambit/Utils/util_types.hpp"
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    /// A column of a benchmark_table
+    struct benchmark_column
+    {
+      str title;   ///< Column title
+      int width;   ///< Width in characters
+      str format;  ///< printf format of floating-point entries, e.g. "%.3f"
+    };
+
+    /// Table of benchmark results printed to stdout one row at a time.  The first column (what was timed) is
+    /// left-justified and the others right-justified.
+    class benchmark_table
+    {
+
+      public:
+
+        /// Prints the caption and the column titles
+        benchmark_table(const str& caption, const std::vector<benchmark_column>& columns);
+
+        /// Prints a row.  Strings are printed as they are, integers in full and floating-point numbers with the
+        /// format of their column; columns left out at the end of the row are left empty.
+        template <typename... T>
+        void row(const T&... entries) const
+        {
+          std::size_t column = 0;
+          print({cell(column++, entries)...});
+        }
+
+      private:
+
+        std::vector<benchmark_column> columns;
+
+        /// Entry of a column as text
+        /// @{
+        str cell(std::size_t, const str& entry) const { return entry; }
+        str cell(std::size_t, const char* entry) const { return entry; }
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value, str>::type cell(std::size_t, T entry) const
+        {
+          return std::to_string(entry);
+        }
+        str cell(std::size_t column, double entry) const;
+        /// @}
+
+        /// Print a row of entries as text
+        void print(const std::vector<str>& cells) const;
+
+    };
+
+  }
+
+}
+
+#endif //#defined __benchmark_table_hpp__
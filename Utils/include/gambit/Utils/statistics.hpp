@@ -12,8 +12,17 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2015 Aug
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
+#ifndef __statistics_hpp__
+#define __statistics_hpp__
+
+#include <vector>
+
 #include "gambit/Utils/util_types.hpp" 
 
 
@@ -40,6 +49,90 @@ namespace Gambit
     /// Use a detection to compute a gaussian log-likelihood for a lower limit
     double gaussian_lower_limit(double theory, double obs, double theoryerr, double obserr, bool profile_systematics);
 
+
+    /// @brief Multivariate Gaussian likelihood with a fixed experimental covariance and a per-point theory covariance.
+    ///
+    /// The chi-square diff^T (cov_exp + cov_th)^-1 diff is computed from the Cholesky factor L of the total
+    /// covariance, by solving L y = diff and taking y.y, without ever forming the inverse.  The factor is kept
+    /// between calls: it is reused as is if the theory covariance has not changed, updated with one rank-one
+    /// update (or downdate) per changed entry if the matrix is large and only a few diagonal entries have
+    /// changed, and recomputed from scratch otherwise.
+    ///
+    /// The matrix arguments can be of any type with element access via m(i,j), e.g. boost ublas or Eigen matrices.
+    class MultivariateGaussian
+    {
+
+      public:
+
+        /// Constructor
+        MultivariateGaussian() : n(0), factor_valid(false) {}
+
+        /// Set the experimental covariance matrix, of dimension dim x dim
+        template <typename Matrix>
+        void set_experimental_covariance(const Matrix& cov, size_t dim)
+        {
+          n = dim;
+          cov_exp.resize(n*n);
+          for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < n; ++j) cov_exp[i*n+j] = cov(i,j);
+          cov_th.assign(n*n, 0.);
+          factor_valid = false;
+        }
+
+        /// Set the theory covariance matrix for the current point
+        template <typename Matrix>
+        void set_theory_covariance(const Matrix& cov)
+        {
+          for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < n; ++j) cov_th[i*n+j] = cov(i,j);
+        }
+
+        /// Has the experimental covariance been set?
+        bool initialised() const { return n > 0; }
+
+        /// Dimension of the covariance matrices
+        size_t dim() const { return n; }
+
+        /// The chi-square for the given differences between measurements and predictions
+        double chi2(const std::vector<double>& diff);
+
+        /// The log-likelihood -chi2/2 for the given differences between measurements and predictions
+        double loglikelihood(const std::vector<double>& diff) { return -0.5*chi2(diff); }
+
+      private:
+
+        /// Bring the Cholesky factor up to date with the current theory covariance
+        void update_factor();
+
+        /// Recompute the Cholesky factor of the total covariance from scratch, raising invalid_point if it is not positive definite
+        void factorise();
+
+        /// Rank-one update (sign > 0) or downdate (sign < 0) of the factor by x x^T. Returns false if the result is not positive definite.
+        bool rank_one_update(std::vector<double>& x, size_t first, double sign);
+
+        /// Smallest dimension for which rank-one updates are used; smaller matrices are always refactorised.
+        static const size_t min_update_dim = 24;
+        /// Rank-one updates are used for at most dim/dim_per_update changed diagonal entries.  Each update takes
+        /// about 2 dim^2 flops against dim^3/3 for a factorisation, but with strided access to the factor; both
+        /// values are where updates were measured to start paying off.
+        static const size_t dim_per_update = 12;
+
+        /// Dimension
+        size_t n;
+        /// Experimental and theory covariances, row-major
+        std::vector<double> cov_exp, cov_th;
+        /// Theory covariance that the current factor corresponds to
+        std::vector<double> cov_th_factorised;
+        /// Lower-triangular Cholesky factor of cov_exp + cov_th_factorised, row-major
+        std::vector<double> L;
+        /// Is L up to date with cov_exp?
+        bool factor_valid;
+        /// Work space
+        std::vector<double> work, update;
+        std::vector<size_t> changed;
+
+    };
+
   }
 
 }
+
+#endif // __statistics_hpp__
@@ -0,0 +1,67 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Per-thread slot indices for thread-aware
+///  infrastructure (logging, random numbers).
+///
+///  GAMBIT stores per-thread state in arrays
+///  indexed by omp_get_thread_num().  Threads that
+///  are not part of the main OpenMP team (e.g. the
+///  worker threads of the dependency resolver's
+///  task-graph executor) each run as the master of
+///  their own one-thread team, so they all report
+///  omp_get_thread_num() == 0.  Such threads are
+///  given a slot offset beyond the main team, so
+///  that thread_slot() is unique per thread.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#ifndef __thread_slots_hpp__
+#define __thread_slots_hpp__
+
+#include <omp.h>
+
+#include "gambit/Utils/util_macros.hpp"
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    /// Number of slots reserved for the main OpenMP team.
+    EXPORT_SYMBOLS int main_team_thread_slots();
+
+    /// Total number of slots that per-thread arrays must provide: one for each thread of the
+    /// main OpenMP team, plus one for each additional thread that may be registered via set_thread_slot_offset.
+    EXPORT_SYMBOLS int max_thread_slots();
+
+    /// Register the calling thread as owning the slots starting at offset (for threads outside the main team).
+    EXPORT_SYMBOLS void set_thread_slot_offset(int offset);
+
+    /// Get the slot offset of the calling thread (zero for the main team).
+    EXPORT_SYMBOLS int thread_slot_offset();
+
+    /// Set the number of threads currently running outside the main OpenMP team (set before starting them).
+    EXPORT_SYMBOLS void set_threads_outside_main_team(int n);
+
+    /// Get the number of threads currently running outside the main OpenMP team.
+    EXPORT_SYMBOLS int threads_outside_main_team();
+
+    /// Get the slot index of the calling thread, 0 <= slot < max_thread_slots().
+    inline int thread_slot() { return thread_slot_offset() + omp_get_thread_num(); }
+
+  }
+
+}
+
+#endif //#defined __thread_slots_hpp__
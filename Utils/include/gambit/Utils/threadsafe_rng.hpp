@@ -27,6 +27,18 @@
 ///      Ranlux 48 generator
 ///    knuth_b
 ///      Knuth-B generator
+///    philox4x32_10
+///      Philox4x32-10 counter-based generator, with
+///      independent streams per (seed, MPI rank,
+///      thread, point ID) for draws made while a
+///      point is evaluated, and separate per-thread
+///      streams for all other draws (e.g. those of
+///      the scanner)
+///
+///  The optional option
+///    rng_seed: integer
+///  makes the streams reproducible; otherwise
+///  they are seeded from the system clock.
 ///
 ///  *********************************************
 ///
@@ -44,6 +56,10 @@
 ///          (benjamin.farmer@imperial.ac.uk)
 ///  \data 2018 Aug
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -52,9 +68,13 @@
 
 #include <random>
 #include <chrono>
+#include <cstdint>
+#include <new>
 
 #include "gambit/Utils/util_macros.hpp"
 #include "gambit/Utils/util_types.hpp"
+#include "gambit/Utils/thread_slots.hpp"
+#include "gambit/Utils/counter_rng.hpp"
 
 
 namespace Gambit
@@ -63,6 +83,50 @@ namespace Gambit
   namespace Utils
   {
 
+    /// Fixed-size array with each element aligned to, and padded out to, its own cache line,
+    /// so that per-thread entries updated concurrently never share a cache line.
+    template<typename T>
+    class cache_aligned_array
+    {
+
+      public:
+        static const std::size_t cache_line = 64;
+
+        explicit cache_aligned_array(std::size_t n)
+          : n_elements(n)
+          , stride(((sizeof(T) + cache_line - 1) / cache_line) * cache_line)
+          , raw(new char[n*stride + cache_line])
+        {
+          const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(raw);
+          base = reinterpret_cast<char*>((p + cache_line - 1) & ~std::uintptr_t(cache_line - 1));
+          for (std::size_t i = 0; i < n_elements; ++i) new (base + i*stride) T();
+        }
+
+        ~cache_aligned_array()
+        {
+          for (std::size_t i = 0; i < n_elements; ++i) (*this)[i].~T();
+          delete [] raw;
+        }
+
+        cache_aligned_array(const cache_aligned_array&) = delete;
+        cache_aligned_array& operator=(const cache_aligned_array&) = delete;
+
+        T& operator[](std::size_t i) { return *reinterpret_cast<T*>(base + i*stride); }
+        std::size_t size() const { return n_elements; }
+
+      private:
+        const std::size_t n_elements;
+        const std::size_t stride;
+        char* raw;
+        char* base;
+    };
+
+    /// Derive a 64-bit seed for one thread slot from the global seed and MPI rank.
+    inline std::uint64_t thread_slot_seed(std::uint64_t seed, int rank, int slot)
+    {
+      return splitmix64(splitmix64(splitmix64(seed) + std::uint64_t(rank)) + std::uint64_t(slot));
+    }
+
     /// Base class for thread-safe random number generators.
     /// Must conform to the requirements of UniformRandomBitGenerator,
     /// see e.g. https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator
@@ -83,6 +147,20 @@ namespace Gambit
         /// Operators for compliance with RandomNumberEngine interface -> random distribution sampling
         virtual result_type min() = 0; // Needs to connect to equivalent function in underlying rng class
         virtual result_type max() = 0; // "   "
+
+        /// Fill out[0..n) with uniform random deviates from (0,1), using the calling thread's engine.
+        /// Costs a single virtual call per batch rather than one per deviate.  Gives the same
+        /// sequence as n calls of fill(out+i, 1), i.e. of Random::draw().
+        virtual void fill(double* out, std::size_t n) = 0;
+
+        /// Move every thread's engine to the stream belonging to the given point ID, until end_point.
+        /// Only meaningful for counter-based engines; a no-op otherwise.
+        /// Must not be called while other threads are drawing.
+        virtual void set_point(unsigned long long) {}
+
+        /// Return every thread to the streams used outside point evaluation, where they left off.
+        /// Must not be called while other threads are drawing.
+        virtual void end_point() {}
     };
 
     /// Give an inline implementation of the destructor, to prevent link errors but keep base class pure virtual.
@@ -96,37 +174,112 @@ namespace Gambit
       public:
         typedef unsigned long long result_type;
 
-        /// Create RNG engines, one for each thread.
-        specialised_threadsafe_rng()
+        /// Create RNG engines, one for each thread slot.
+        /// A negative seed means seed from the system clock.
+        specialised_threadsafe_rng(long long seed = -1, int rank = 0)
+          : rngs(Utils::max_thread_slots())
         {
-          const int max_threads = omp_get_max_threads();
-          rngs = new Engine[max_threads];
-          for(int index = 0; index < max_threads; ++index)
+          for(std::size_t index = 0; index < rngs.size(); ++index)
           {
-            /// @todo Would it be better to hardware-seed via std::random_device?
-            rngs[index] = Engine(index+std::chrono::system_clock::now().time_since_epoch().count());
+            if (seed < 0)
+            {
+              /// @todo Would it be better to hardware-seed via std::random_device?
+              rngs[index] = Engine(index+std::chrono::system_clock::now().time_since_epoch().count());
+            }
+            else
+            {
+              rngs[index] = Engine(thread_slot_seed(seed, rank, index));
+            }
           }
         }
 
         /// Destroy RNG engines
-        virtual ~specialised_threadsafe_rng() { delete [] rngs; }
+        virtual ~specialised_threadsafe_rng() {}
 
         /// Generate a random integer using the chosen engine
         /// Selected uniformly from range (min,max).
         /// To be used as an entropy source for stdlib distributions.
         /// If you want (0,1) random doubles then please use Random::draw(), NOT this function!
-        virtual result_type operator()() { return rngs[omp_get_thread_num()](); }
+        virtual result_type operator()() { return rngs[Utils::thread_slot()](); }
 
         /// Connect to min/max functions of underlying engine
         // No particular need for the threading stuff here, but I
         // don't think we can rely on the min/max functions being static.
-        virtual result_type min() { return rngs[omp_get_thread_num()].min(); }
-        virtual result_type max() { return rngs[omp_get_thread_num()].max(); }
+        virtual result_type min() { return rngs[Utils::thread_slot()].min(); }
+        virtual result_type max() { return rngs[Utils::thread_slot()].max(); }
+
+        /// Bulk uniform (0,1) deviates, drawn directly from this thread's engine
+        virtual void fill(double* out, std::size_t n)
+        {
+          Engine& engine = rngs[Utils::thread_slot()];
+          for (std::size_t i = 0; i < n; ++i) out[i] = std::generate_canonical<double, 32>(engine);
+        }
+
+      private:
+
+        /// RNGs, one for each thread slot, each on its own cache line
+        cache_aligned_array<Engine> rngs;
+
+    };
+
+    /// Thread-safe wrapper for the counter-based Philox engine.
+    /// Each thread slot gets its own key, derived from (seed, MPI rank, slot), and the counter is
+    /// split into a per-point stream and a position within it. Draws made while evaluating a given
+    /// point are therefore reproducible, independent of how many draws were made beforehand.
+    /// Draws made outside point evaluation (i.e. by the scanner, between end_point and the next
+    /// set_point) come from a second set of engines with their own keys, which set_point never
+    /// rewinds, so the scanner's sequence is neither restarted nor correlated with the points'.
+    class counter_threadsafe_rng : public threadsafe_rng
+    {
+
+      public:
+        typedef unsigned long long result_type;
+
+        /// Create engines, two for each thread slot.
+        /// A negative seed means seed from the system clock.
+        counter_threadsafe_rng(long long seed = -1, int rank = 0)
+          : point_rngs(Utils::max_thread_slots())
+          , scanner_rngs(Utils::max_thread_slots())
+          , in_point(false)
+        {
+          const std::uint64_t base_seed = (seed < 0 ? std::chrono::system_clock::now().time_since_epoch().count() : seed);
+          const std::size_t n = point_rngs.size();
+          for(std::size_t index = 0; index < n; ++index)
+          {
+            point_rngs[index].seed(thread_slot_seed(base_seed, rank, index));
+            scanner_rngs[index].seed(thread_slot_seed(base_seed, rank, n + index));
+          }
+        }
+
+        virtual ~counter_threadsafe_rng() {}
+
+        virtual result_type operator()() { return engine()(); }
+        virtual result_type min() { return philox4x32_10::min(); }
+        virtual result_type max() { return philox4x32_10::max(); }
+
+        virtual void fill(double* out, std::size_t n) { engine().fill(out, n); }
+
+        virtual void set_point(unsigned long long pointID)
+        {
+          for(std::size_t index = 0; index < point_rngs.size(); ++index) point_rngs[index].set_stream(pointID);
+          in_point = true;
+        }
+
+        virtual void end_point() { in_point = false; }
 
       private:
 
-        /// Pointer to array of RNGs, one each for each thread
-        Engine* rngs;
+        /// The calling thread's engine for the current phase
+        philox4x32_10& engine() { return (in_point ? point_rngs : scanner_rngs)[Utils::thread_slot()]; }
+
+        /// Engines for draws made while evaluating a point, one for each thread slot, each on its own cache line
+        cache_aligned_array<philox4x32_10> point_rngs;
+
+        /// Engines for all other draws, one for each thread slot, each on its own cache line
+        cache_aligned_array<philox4x32_10> scanner_rngs;
+
+        /// Is a point being evaluated?
+        bool in_point;
 
     };
 
@@ -138,11 +291,25 @@ namespace Gambit
     public:
 
       /// Choose the engine to use for random number generation, based on the contents of the ini file.
-      static void create_rng_engine(str);
+      /// A non-negative seed makes the per-thread streams reproducible; rank is the MPI rank of this process.
+      static void create_rng_engine(str, long long seed = -1, int rank = 0);
 
       /// Draw a single uniform random deviate from the interval (0,1) using the chosen RNG engine
       static double draw();
 
+      /// Fill out[0..n) with uniform random deviates from the interval (0,1) using the chosen RNG engine.
+      /// Much cheaper per deviate than repeated calls to draw() in Monte Carlo loops.
+      static void fill(double* out, std::size_t n);
+
+      /// Fill out[0..n) with unit normal deviates, from one bulk draw of uniform deviates.
+      static void fill_normal(double* out, std::size_t n);
+
+      /// Switch the RNG to the stream for the given point ID (counter-based engines only).
+      static void set_point(unsigned long long pointID);
+
+      /// Switch the RNG back to the streams used outside point evaluation (counter-based engines only).
+      static void end_point();
+
       /// Return a threadsafe wrapper for the chosen RNG engine (to be passed to e.g. std library
       /// distribution function objects)
       static Utils::threadsafe_rng& rng() { return *local_rng; }
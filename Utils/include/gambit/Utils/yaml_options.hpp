@@ -24,13 +24,21 @@
 ///          (patscott@physics.mcgill.ca)
 ///  \date 2014 Mar
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #ifndef __yaml_options_hpp__
 #define __yaml_options_hpp__
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <sstream>
+#include <typeindex>
 #include <utility>
 
 #include "gambit/Utils/util_types.hpp"
@@ -49,13 +57,24 @@ namespace Gambit
     public:
 
       /// Default constructor
-      Options() {}
+      Options() : parsed(new parsed_cache) {}
 
       /// Copy constructor
-      Options(const YAML::Node &options) : options(options) {}
+      Options(const YAML::Node &options) : options(options), parsed(new parsed_cache) {}
       
       /// Move constructor
-      Options(YAML::Node &&options) : options(std::move(options)) {}
+      Options(YAML::Node &&options) : options(std::move(options)), parsed(new parsed_cache) {}
+
+      /// Copy constructor from another Options object (pre-parsed views are not copied)
+      Options(const Options &other) : options(other.options), parsed(new parsed_cache) {}
+
+      /// Assignment (discards any pre-parsed views)
+      Options& operator=(const Options &other)
+      {
+        options = other.options;
+        clearParsed();
+        return *this;
+      }
 
       /// Getters for key/value pairs (which is all the options node should contain)
       /// @{
@@ -134,10 +153,25 @@ namespace Gambit
       void setValue(const KEYTYPE &key, const VALTYPE &val)
       {
          options[key] = val;
+         clearParsed();
          return;
       }
       /// @}
 
+      /// Typed, pre-parsed view of the options.
+      /// TYPE declares its option schema in a constructor TYPE(const Options&), reading each
+      /// option it needs with getValueOrDef (i.e. with its type and default).  The view is
+      /// built once, on first request, and kept until the options are changed, so that code
+      /// run at every point can read plain struct members instead of looking up YAML nodes.
+      template<typename TYPE>
+      const TYPE& getParsed() const
+      {
+        std::lock_guard<std::recursive_mutex> lock(parsed->mutex);
+        std::shared_ptr<const void>& view = parsed->views[std::type_index(typeid(TYPE))];
+        if (not view) view = std::make_shared<const TYPE>(*this);
+        return *static_cast<const TYPE*>(view.get());
+      }
+
       /// Retrieve values from key-value pairs in options node.
       /// Works for an arbitrary set of input keys (of any type), and returns
       /// all values as strings.
@@ -223,6 +257,21 @@ namespace Gambit
 
       YAML::Node options;
 
+      /// Pre-parsed views of the options, by type
+      struct parsed_cache
+      {
+        std::recursive_mutex mutex;
+        std::map<std::type_index, std::shared_ptr<const void> > views;
+      };
+      std::unique_ptr<parsed_cache> parsed;
+
+      /// Discard all pre-parsed views
+      void clearParsed()
+      {
+        std::lock_guard<std::recursive_mutex> lock(parsed->mutex);
+        parsed->views.clear();
+      }
+
   };
 
 }
@@ -0,0 +1,59 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Table of timings printed by the GAMBIT
+///  benchmarks ('make benchmarks').
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <cstdio>
+
+#include "gambit/Utils/benchmark_table.hpp"
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    /// Prints the caption and the column titles
+    benchmark_table::benchmark_table(const str& caption, const std::vector<benchmark_column>& columns)
+     : columns(columns)
+    {
+      std::printf("%s\n", caption.c_str());
+      std::vector<str> titles;
+      for (const benchmark_column& column : columns) titles.push_back(column.title);
+      print(titles);
+    }
+
+    /// Floating-point entry of a column as text
+    str benchmark_table::cell(std::size_t column, double entry) const
+    {
+      char text[64];
+      std::snprintf(text, sizeof(text), columns.at(column).format.c_str(), entry);
+      return text;
+    }
+
+    /// Print a row of entries as text
+    void benchmark_table::print(const std::vector<str>& cells) const
+    {
+      for (std::size_t i = 0; i < cells.size() and i < columns.size(); ++i)
+      {
+        if (i > 0) std::printf(" ");
+        std::printf(i == 0 ? "%-*s" : "%*s", columns[i].width, cells[i].c_str());
+      }
+      std::printf("\n");
+    }
+
+  }
+
+}
@@ -15,12 +15,17 @@
 ///          (cornellj@physics.mcgill.ca)
 ///  \date 2016 Feb
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 #include <cmath>
 #include <limits>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
 
 #include "gambit/Utils/statistics.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
@@ -223,6 +228,110 @@ namespace Gambit
       return gaussian_upper_limit(-theory, -obs, theoryerr, obserr, profile_systematics);
     }
 
+
+    /// The chi-square for the given differences between measurements and predictions
+    double MultivariateGaussian::chi2(const std::vector<double>& diff)
+    {
+      if (n == 0) utils_error().raise(LOCAL_INFO, "The experimental covariance has not been set.");
+      if (diff.size() != n) utils_error().raise(LOCAL_INFO, "Length of diff does not match the dimension of the covariance.");
+
+      update_factor();
+
+      // Forward substitution L y = diff; the chi-square is then y.y
+      work.resize(n);
+      double result = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        double sum = diff[i];
+        const double* Li = &L[i*n];
+        for (size_t k = 0; k < i; ++k) sum -= Li[k] * work[k];
+        work[i] = sum / Li[i];
+        result += work[i] * work[i];
+      }
+      return result;
+    }
+
+    /// Bring the Cholesky factor up to date with the current theory covariance
+    void MultivariateGaussian::update_factor()
+    {
+      if (not factor_valid) return factorise();
+
+      // See which entries of the theory covariance have changed since the last factorisation.  Refactorise as
+      // soon as the changes are more than a few rank-one updates can handle cheaper.
+      const size_t max_updates = (n < min_update_dim ? 0 : n/dim_per_update);
+      changed.clear();
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = 0; j < n; ++j)
+        {
+          if (cov_th[i*n+j] == cov_th_factorised[i*n+j]) continue;
+          if (i != j or changed.size() == max_updates) return factorise();
+          changed.push_back(i);
+        }
+      }
+      if (changed.empty()) return;
+
+      update.resize(n);
+      for (size_t i : changed)
+      {
+        const double delta = cov_th[i*n+i] - cov_th_factorised[i*n+i];
+        std::fill(update.begin(), update.end(), 0.);
+        update[i] = sqrt(std::abs(delta));
+        if (not rank_one_update(update, i, delta > 0 ? 1 : -1)) return factorise();
+        cov_th_factorised[i*n+i] = cov_th[i*n+i];
+      }
+    }
+
+    /// Recompute the Cholesky factor of the total covariance from scratch
+    void MultivariateGaussian::factorise()
+    {
+      L.assign(n*n, 0.);
+      for (size_t j = 0; j < n; ++j)
+      {
+        double* Lj = &L[j*n];
+        double d = cov_exp[j*n+j] + cov_th[j*n+j];
+        for (size_t k = 0; k < j; ++k) d -= Lj[k] * Lj[k];
+        if (not (d > 0))
+        {
+          // A bad theory covariance only rules out this point
+          factor_valid = false;
+          invalid_point().raise("Total covariance matrix is not positive definite.");
+        }
+        Lj[j] = sqrt(d);
+        for (size_t i = j+1; i < n; ++i)
+        {
+          double* Li = &L[i*n];
+          double sum = cov_exp[i*n+j] + cov_th[i*n+j];
+          for (size_t k = 0; k < j; ++k) sum -= Li[k] * Lj[k];
+          Li[j] = sum / Lj[j];
+        }
+      }
+      cov_th_factorised = cov_th;
+      factor_valid = true;
+    }
+
+    /// Rank-one update or downdate of the Cholesky factor by x x^T, where x is zero before index first
+    bool MultivariateGaussian::rank_one_update(std::vector<double>& x, size_t first, double sign)
+    {
+      for (size_t k = first; k < n; ++k)
+      {
+        double& Lkk = L[k*n+k];
+        const double r2 = Lkk*Lkk + sign*x[k]*x[k];
+        if (not (r2 > 0)) return false;
+        const double r = sqrt(r2);
+        const double c = r / Lkk;
+        const double s = x[k] / Lkk;
+        Lkk = r;
+        for (size_t i = k+1; i < n; ++i)
+        {
+          double& Lik = L[i*n+k];
+          Lik = (Lik + sign*s*x[i]) / c;
+          x[i] = c*x[i] - s*Lik;
+        }
+      }
+      return true;
+    }
+
   }
 
 }
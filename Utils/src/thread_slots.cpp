@@ -0,0 +1,73 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Per-thread slot indices for thread-aware
+///  infrastructure (logging, random numbers).
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <atomic>
+
+#include "gambit/Utils/thread_slots.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    namespace
+    {
+      /// Slot offset of the calling thread
+      thread_local int local_slot_offset = 0;
+
+      /// Number of threads running outside the main team
+      std::atomic<int> n_outside_main_team(0);
+    }
+
+    /// Number of slots reserved for the main OpenMP team (fixed at first use).
+    int main_team_thread_slots()
+    {
+      static const int n = omp_get_max_threads();
+      return n;
+    }
+
+    /// Total number of slots: the main team plus one per available processor for extra threads.
+    int max_thread_slots()
+    {
+      static const int n = main_team_thread_slots() + omp_get_num_procs();
+      return n;
+    }
+
+    /// Register the calling thread as owning the slots starting at offset.
+    void set_thread_slot_offset(int offset)
+    {
+      if (offset < 0 or offset >= max_thread_slots())
+      {
+        utils_error().raise(LOCAL_INFO, "Requested thread slot offset is out of range.");
+      }
+      local_slot_offset = offset;
+    }
+
+    /// Get the slot offset of the calling thread.
+    int thread_slot_offset() { return local_slot_offset; }
+
+    /// Set the number of threads running outside the main team.
+    void set_threads_outside_main_team(int n) { n_outside_main_team = n; }
+
+    /// Get the number of threads running outside the main team.
+    int threads_outside_main_team() { return n_outside_main_team; }
+
+  }
+
+}
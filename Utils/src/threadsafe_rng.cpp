@@ -27,6 +27,8 @@
 ///      Ranlux 48 generator
 ///    knuth_b
 ///      Knuth-B generator
+///    philox4x32_10
+///      Philox4x32-10 counter-based generator
 ///
 ///  *********************************************
 ///
@@ -36,6 +38,10 @@
 ///          (p.scott@imperial.ac.uk)
 ///  \date 2014 Dec
 ///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
 ///  *********************************************
 
 
@@ -44,6 +50,10 @@
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/preprocessor/tuple/to_seq.hpp>
 
@@ -51,7 +61,7 @@
 #define MAKE_SPECIALISED_RNG(r, data, elem)                              \
         else if (engine == STRINGIFY(elem))                              \
         {                                                                \
-          static Utils::specialised_threadsafe_rng<elem> ultralocal_rng; \
+          static Utils::specialised_threadsafe_rng<elem> ultralocal_rng(seed, rank); \
           local_rng = &ultralocal_rng;                                   \
         }
 #define ENABLE_ALL_RNGS BOOST_PP_SEQ_FOR_EACH(MAKE_SPECIALISED_RNG, , BOOST_PP_TUPLE_TO_SEQ(ALL_RNGS))
@@ -60,25 +70,76 @@ namespace Gambit
 {
 
   /// Choose the engine to use for random number generation, based on the contents of the ini file.
-  void Random::create_rng_engine(str engine)
+  void Random::create_rng_engine(str engine, long long seed, int rank)
   { 
     using namespace std;
     if (engine == "default")
     {
       engine = "mt19937_64 (default)";
-      static Utils::specialised_threadsafe_rng<mt19937_64> ultralocal_rng; 
+      static Utils::specialised_threadsafe_rng<mt19937_64> ultralocal_rng(seed, rank); 
+      local_rng = &ultralocal_rng;
+    }
+    else if (engine == "philox4x32_10")
+    {
+      static Utils::counter_threadsafe_rng ultralocal_rng(seed, rank);
       local_rng = &ultralocal_rng;
     }
     ENABLE_ALL_RNGS
     else utils_error().raise(LOCAL_INFO, "Unknown random number generation engine: "+engine+".  Please check your yaml file.");
-    logger() << LogTags::utils << "Random number engine " << engine << " selected." << EOM;
+    logger() << LogTags::utils << "Random number engine " << engine << " selected";
+    if (seed >= 0) logger() << " (seed " << seed << ")";
+    logger() << "." << EOM;
   }
 
   /// Draw a single uniform random deviate in the range (0,1) using the chosen RNG engine
   double Random::draw()
   {
     if (local_rng == NULL) create_rng_engine("default");
-    return std::generate_canonical<double, 32>(rng());
+    // Go through fill, so that repeated draws give the same sequence as a bulk fill.
+    double x;
+    local_rng->fill(&x, 1);
+    return x;
+  }
+
+  /// Fill an array with uniform random deviates in the range (0,1) using the chosen RNG engine
+  void Random::fill(double* out, std::size_t n)
+  {
+    if (local_rng == NULL) create_rng_engine("default");
+    local_rng->fill(out, n);
+  }
+
+  /// Fill an array with unit normal deviates using the chosen RNG engine
+  void Random::fill_normal(double* out, std::size_t n)
+  {
+    if (n == 0) return;
+    fill(out, n);
+    // Box-Muller transform of pairs of uniform deviates, in place.  An odd last element is paired with an extra draw.
+    const double twopi = 2.0*M_PI;
+    std::size_t i = 0;
+    for (; i + 1 < n; i += 2)
+    {
+      const double r = std::sqrt(-2.0*std::log(std::max(out[i], std::numeric_limits<double>::min())));
+      const double theta = twopi*out[i+1];
+      out[i] = r*std::cos(theta);
+      out[i+1] = r*std::sin(theta);
+    }
+    if (i < n)
+    {
+      const double r = std::sqrt(-2.0*std::log(std::max(out[i], std::numeric_limits<double>::min())));
+      out[i] = r*std::cos(twopi*draw());
+    }
+  }
+
+  /// Switch the RNG to the stream for the given point ID
+  void Random::set_point(unsigned long long pointID)
+  {
+    if (local_rng != NULL) local_rng->set_point(pointID);
+  }
+
+  /// Switch the RNG back to the streams used outside point evaluation
+  void Random::end_point()
+  {
+    if (local_rng != NULL) local_rng->end_point();
   }
 
 }
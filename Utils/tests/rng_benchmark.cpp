@@ -0,0 +1,119 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Microbenchmark of the thread-safe random
+///  number generators: uniform draws per second
+///  per thread from the original unpadded engine
+///  array, against the cache-line padded engines
+///  and the counter-based Philox engine, one
+///  deviate at a time and in bulk via fill().
+///
+///  Usage: rng_benchmark [ndraws] [nthreads]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <omp.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/benchmark_table.hpp"
+#include "gambit/Utils/threadsafe_rng.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::Utils;
+
+namespace
+{
+
+  /// The original specialised_threadsafe_rng: one engine per thread slot, packed into a plain array
+  template<typename Engine>
+  class original_threadsafe_rng : public threadsafe_rng
+  {
+    public:
+      original_threadsafe_rng() : rngs(new Engine[max_thread_slots()])
+      {
+        for (int index = 0; index < max_thread_slots(); ++index) rngs[index] = Engine(index+1234);
+      }
+      virtual ~original_threadsafe_rng() { delete [] rngs; }
+      virtual result_type operator()() { return rngs[thread_slot()](); }
+      virtual result_type min() { return rngs[thread_slot()].min(); }
+      virtual result_type max() { return rngs[thread_slot()].max(); }
+      virtual void fill(double* out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) out[i] = std::generate_canonical<double, 32>(*this); }
+    private:
+      Engine* rngs;
+  };
+
+  /// Millions of draws per second per thread, drawing ndraws deviates on each of nthreads threads,
+  /// one at a time as in Random::draw() or in batches of 1024 via fill().
+  double mdraws_per_thread(threadsafe_rng& rng, std::size_t ndraws, int nthreads, bool bulk)
+  {
+    std::vector<double> sums(nthreads, 0.);
+    const auto start = std::chrono::steady_clock::now();
+    #pragma omp parallel num_threads(nthreads)
+    {
+      double sum = 0.;
+      if (bulk)
+      {
+        double batch[1024];
+        for (std::size_t i = 0; i < ndraws; i += 1024)
+        {
+          rng.fill(batch, 1024);
+          for (int j = 0; j < 1024; ++j) sum += batch[j];
+        }
+      }
+      else
+      {
+        for (std::size_t i = 0; i < ndraws; ++i) sum += std::generate_canonical<double, 32>(rng);
+      }
+      sums[omp_get_thread_num()] = sum;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // Use the sums so that the draws cannot be optimised away.
+    double total = 0.;
+    for (double sum : sums) total += sum;
+    if (total < 0.) std::printf("impossible\n");
+    return 1e-6 * ndraws / elapsed.count();
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t ndraws = (argc > 1 ? std::strtoul(argv[1], NULL, 10) : 20000000);
+  const int nthreads = (argc > 2 ? std::atoi(argv[2]) : omp_get_max_threads());
+
+  logger().disable();
+
+  original_threadsafe_rng<std::mt19937_64> original;
+  specialised_threadsafe_rng<std::mt19937_64> padded(1234);
+  counter_threadsafe_rng philox(1234);
+
+  Utils::benchmark_table table("Uniform deviates, " + std::to_string(ndraws) + " draws per thread, millions of draws per second per thread",
+                                {{"engine", 32, ""}, {"1 thread", 12, "%.1f"}, {std::to_string(nthreads) + " threads", 12, "%.1f"}});
+  auto row = [&](const char* name, threadsafe_rng& rng, bool bulk)
+  {
+    const double single = mdraws_per_thread(rng, ndraws, 1, bulk);
+    const double multi = mdraws_per_thread(rng, ndraws, nthreads, bulk);
+    table.row(name, single, multi);
+  };
+  row("mt19937_64, original, draw", original, false);
+  row("mt19937_64, padded, draw", padded, false);
+  row("mt19937_64, padded, fill", padded, true);
+  row("philox4x32_10, padded, draw", philox, false);
+  row("philox4x32_10, padded, fill", philox, true);
+  return 0;
+}
@@ -0,0 +1,168 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Tests of the thread-safe random number
+///  generators: bulk fill() gives the same
+///  sequence as repeated single draws, draws made
+///  while evaluating a point are reproducible per
+///  point ID, and the streams used by the scanner
+///  between points are neither rewound nor shared
+///  with the points' streams by set_point.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author agent
+///          (agent@local)
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gambit/Utils/static_members.hpp"
+#include "gambit/Utils/threadsafe_rng.hpp"
+#include "gambit/Logs/logmaster.hpp"
+
+using namespace Gambit;
+using namespace Gambit::Utils;
+
+namespace
+{
+
+  int failures = 0;
+
+  void check(bool ok, const str& what)
+  {
+    std::cout << (ok ? "  passed: " : "  FAILED: ") << what << std::endl;
+    if (not ok) failures++;
+  }
+
+  /// n deviates drawn one at a time
+  std::vector<double> singles(threadsafe_rng& rng, std::size_t n)
+  {
+    std::vector<double> x(n);
+    for (std::size_t i = 0; i < n; ++i) rng.fill(&x[i], 1);
+    return x;
+  }
+
+  /// n deviates drawn in batches of irregular sizes, starting with an odd one
+  std::vector<double> batches(threadsafe_rng& rng, std::size_t n)
+  {
+    std::vector<double> x(n);
+    const std::size_t sizes[] = {3, 1, 4, 1, 5, 9, 2, 6};
+    for (std::size_t i = 0, j = 0; i < n; ++j)
+    {
+      std::size_t m = std::min(sizes[j%8], n - i);
+      rng.fill(&x[i], m);
+      i += m;
+    }
+    return x;
+  }
+
+  /// Check that single draws and bulk fills of different sizes agree for one engine
+  void check_fill(threadsafe_rng& a, threadsafe_rng& b, threadsafe_rng& c, const str& name)
+  {
+    const std::size_t n = 101;
+    std::vector<double> x = singles(a, n);
+    std::vector<double> y = batches(b, n);
+    std::vector<double> z(n);
+    c.fill(z.data(), n);
+    check(x == y and x == z, name + ": fill gives the same sequence as repeated single draws");
+    bool in_range = true;
+    for (double d : z) in_range = in_range and d > 0. and d < 1.;
+    check(in_range, name + ": deviates lie in (0,1)");
+  }
+
+}
+
+int main()
+{
+  logger().disable();
+
+  std::cout << "Bulk and single draws" << std::endl;
+  {
+    specialised_threadsafe_rng<std::mt19937_64> a(42), b(42), c(42);
+    check_fill(a, b, c, "mt19937_64");
+    counter_threadsafe_rng d(42), e(42), f(42);
+    check_fill(d, e, f, "philox4x32_10");
+
+    // Integer draws through operator() and bulk fills share the counter blocks in the same order.
+    counter_threadsafe_rng g(42), h(42);
+    double from_fill[3];
+    h.fill(from_fill, 3);
+    const double x0 = philox4x32_10::to_double(g());
+    double rest[2];
+    g.fill(rest, 2);
+    check(x0 == from_fill[0] and rest[0] == from_fill[1] and rest[1] == from_fill[2],
+          "philox4x32_10: operator() and fill interleave consistently");
+  }
+
+  std::cout << "Random::draw and Random::fill" << std::endl;
+  {
+    Random::create_rng_engine("philox4x32_10", 42);
+    Random::set_point(7);
+    std::vector<double> x(25);
+    for (double& d : x) d = Random::draw();
+    Random::set_point(7);
+    std::vector<double> y(25);
+    Random::fill(y.data(), y.size());
+    check(x == y, "repeated Random::draw gives the same sequence as Random::fill");
+    Random::end_point();
+  }
+
+  std::cout << "Point streams" << std::endl;
+  {
+    counter_threadsafe_rng a(42), b(42);
+    a.set_point(5);
+    std::vector<double> x = singles(a, 10);
+    singles(b, 37);
+    b.set_point(3);
+    singles(b, 11);
+    b.set_point(5);
+    std::vector<double> y = singles(b, 10);
+    check(x == y, "draws for a point do not depend on earlier draws");
+    b.set_point(6);
+    check(singles(b, 10) != x, "different points get different streams");
+    counter_threadsafe_rng c(42, 1);
+    c.set_point(5);
+    check(singles(c, 10) != x, "different MPI ranks get different streams for the same point");
+  }
+
+  std::cout << "Scanner streams" << std::endl;
+  {
+    // a: the scanner draws without any points being evaluated in between.
+    // b: the same scanner draws, interleaved with point evaluations.
+    counter_threadsafe_rng a(42), b(42);
+    std::vector<double> x = singles(a, 30);
+    std::vector<double> y, points;
+    for (int point = 0; point < 3; ++point)
+    {
+      std::vector<double> s = singles(b, 10);
+      y.insert(y.end(), s.begin(), s.end());
+      b.set_point(point);
+      std::vector<double> p = singles(b, 10);
+      points.insert(points.end(), p.begin(), p.end());
+      b.end_point();
+    }
+    check(x == y, "set_point neither rewinds nor advances the scanner's stream");
+    bool overlap = false;
+    for (double d : points) for (double e : x) overlap = overlap or d == e;
+    check(not overlap, "the scanner's stream is distinct from the points' streams");
+
+    // The same point evaluated without any scanner draws beforehand.
+    counter_threadsafe_rng c(42);
+    c.set_point(1);
+    check(singles(c, 10) == std::vector<double>(points.begin() + 10, points.begin() + 20),
+          "the points' draws do not depend on the scanner's draws");
+  }
+
+  if (failures == 0) std::cout << "All tests passed." << std::endl;
+  else std::cout << failures << " test(s) failed." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -126,6 +126,7 @@ set(GAMBIT_BASIC_COMMON_OBJECTS "${GAMBIT_BASIC_COMMON_OBJECTS}" $<TARGET_OBJECT
 
 #contrib/MassSpectra; include only if SpecBit is in use
 set (FS_DIR "${PROJECT_SOURCE_DIR}/contrib/MassSpectra/flexiblesusy")
+set (flexiblesusy_VERSION "2.0.1")
 if(";${GAMBIT_BITS};" MATCHES ";SpecBit;")
 
   set (EXCLUDE_FLEXIBLESUSY FALSE)
@@ -207,6 +208,29 @@ if(";${GAMBIT_BITS};" MATCHES ";SpecBit;")
     endif()
   endforeach()
 
+  # Patch FlexibleSUSY to allow warm starts of the two-scale solver (used by SpecBit).  Do this now rather than as a
+  # patch step of the external project, as the GAMBIT sources include the patched headers.  The patch is only applied
+  # if it has not been already, i.e. if it cannot be reversed.
+  set(FS_PATCH "${PROJECT_SOURCE_DIR}/contrib/patches/flexiblesusy/${flexiblesusy_VERSION}/patch_flexiblesusy_${flexiblesusy_VERSION}.dif")
+  execute_process(COMMAND patch -p1 -R -s -f --dry-run -i ${FS_PATCH}
+                  WORKING_DIRECTORY ${FS_DIR}
+                  RESULT_VARIABLE result
+                  OUTPUT_QUIET ERROR_QUIET
+                 )
+  if (NOT "${result}" STREQUAL "0")
+    execute_process(COMMAND patch -p1 -N -s -i ${FS_PATCH}
+                    WORKING_DIRECTORY ${FS_DIR}
+                    RESULT_VARIABLE result
+                    OUTPUT_VARIABLE output
+                    ERROR_VARIABLE output
+                   )
+    if (NOT "${result}" STREQUAL "0")
+      message("${BoldRed}-- Patching FlexibleSUSY with ${FS_PATCH} failed:\n${output}${ColourReset}" )
+      message(FATAL_ERROR "Patching FlexibleSUSY failed." )
+    endif()
+    message("${Yellow}-- Patched FlexibleSUSY with ${FS_PATCH}${ColourReset}")
+  endif()
+
   # Explain how to build each of the flexiblesusy spectrum generators we need.  Configure now, serially, to prevent parallel build issues.
   string (REPLACE ";" "," BUILD_FS_MODELS_COMMAS "${BUILD_FS_MODELS}")
   string (REPLACE ";" "," EXCLUDED_FS_MODELS_COMMAS "${EXCLUDED_FS_MODELS}")
@@ -18,12 +18,22 @@
 #          (p.scott@imperial.ac.uk)
 #  \date 2014 Nov, Dec
 #
+#  \author agent
+#          (agent@local)
+#  \date 2026 Oct
+#
 #************************************************
 
 # Add the module standalones
 add_custom_target(standalones)
 include(cmake/standalones.cmake)
 
+# Add the unit tests and benchmarks
+enable_testing()
+add_custom_target(tests)
+add_custom_target(benchmarks)
+include(cmake/tests.cmake)
+
 # Add the main GAMBIT executable
 if(EXISTS "${PROJECT_SOURCE_DIR}/Core/")
   if (NOT EXCLUDE_FLEXIBLESUSY)
@@ -0,0 +1,160 @@
+# GAMBIT: Global and Modular BSM Inference Tool
+#************************************************
+# \file
+#
+#  CMake configuration script for unit tests
+#  and benchmarks of individual GAMBIT
+#  components.  Build with 'make tests' or
+#  'make benchmarks'; run the tests with ctest.
+#
+#************************************************
+#
+#  Authors (add name and date if you modify):
+#
+#  \author agent
+#          (agent@local)
+#  \date 2026 Oct
+#
+#************************************************
+
+# Core
+if(EXISTS "${PROJECT_SOURCE_DIR}/Core/")
+  add_gambit_test(calcobslike_benchmark BENCHMARK
+                  SOURCES Core/tests/calcobslike_benchmark.cpp
+                          Core/src/functors_with_signals.cpp
+                  OBJECTS $<TARGET_OBJECTS:Models> $<TARGET_OBJECTS:Backends> $<TARGET_OBJECTS:Elements>)
+  add_gambit_test(task_graph_test
+                  SOURCES Core/tests/task_graph_test.cpp
+                          Core/src/task_graph.cpp
+                          Core/src/error_handlers.cpp
+                          Core/src/functors_with_signals.cpp
+                  OBJECTS $<TARGET_OBJECTS:Models> $<TARGET_OBJECTS:Backends> $<TARGET_OBJECTS:Elements>)
+  add_gambit_test(obslike_order_test
+                  SOURCES Core/tests/obslike_order_test.cpp
+                          Core/src/obslike_order.cpp
+                          Core/src/error_handlers.cpp
+                          Core/src/functors_with_signals.cpp
+                  OBJECTS $<TARGET_OBJECTS:Models> $<TARGET_OBJECTS:Backends> $<TARGET_OBJECTS:Elements>)
+endif()
+
+# ColliderBit
+if(EXISTS "${PROJECT_SOURCE_DIR}/ColliderBit/")
+  add_gambit_test(marginalisation_benchmark BENCHMARK
+                  SOURCES ColliderBit/tests/marginalisation_benchmark.cpp
+                          ColliderBit/src/covariance_marginalisation.cpp)
+  add_gambit_test(bkg_covariance_cache_test
+                  SOURCES ColliderBit/tests/bkg_covariance_cache_test.cpp
+                          ColliderBit/src/covariance_marginalisation.cpp)
+  add_gambit_test(lep_limit_grid_benchmark BENCHMARK
+                  SOURCES ColliderBit/tests/lep_limit_grid_benchmark.cpp
+                          ColliderBit/src/limits/BaseLimitContainer.cpp
+                          ColliderBit/src/limits/ALEPHSleptonLimits.cpp
+                          ColliderBit/src/limits/L3SleptonLimits.cpp
+                          ColliderBit/src/limits/L3GauginoLimits.cpp
+                          ColliderBit/src/limits/OPALGauginoLimits.cpp
+                          ColliderBit/src/limits/OPALDegenerateCharginoLimits.cpp)
+  add_gambit_test(event_object_cache_benchmark BENCHMARK
+                  SOURCES ColliderBit/tests/event_object_cache_benchmark.cpp
+                          ColliderBit/src/Utils.cpp
+                          ColliderBit/src/analyses/Analysis_ATLAS_13TeV_0LEP_13invfb.cpp
+                          ColliderBit/src/analyses/Analysis_ATLAS_13TeV_0LEP_36invfb.cpp
+                          ColliderBit/src/analyses/Analysis_CMS_13TeV_0LEP_13invfb.cpp
+                          ColliderBit/src/analyses/Analysis_CMS_13TeV_0LEP_36invfb.cpp
+                          ColliderBit/src/analyses/Analysis_CMS_13TeV_MONOJET_36invfb.cpp)
+  add_gambit_test(xsec_prescreen_test
+                  SOURCES ColliderBit/tests/xsec_prescreen_test.cpp
+                          ColliderBit/src/XsecPrescreen.cpp)
+  add_gambit_test(signal_yield_cache_test
+                  SOURCES ColliderBit/tests/signal_yield_cache_test.cpp
+                          ColliderBit/src/SignalYieldCache.cpp)
+  add_gambit_test(event_tickets_test
+                  SOURCES ColliderBit/tests/event_tickets_test.cpp
+                          ColliderBit/src/EventTickets.cpp)
+  # Needs the BOSSed Pythia backend, so is built like the ColliderBit standalone
+  add_standalone(pythia_init_benchmark SOURCES ColliderBit/tests/pythia_init_benchmark.cpp MODULES ColliderBit)
+  if(TARGET pythia_init_benchmark)
+    set_target_properties(pythia_init_benchmark PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_BINARY_DIR}/tests")
+    add_dependencies(benchmarks pythia_init_benchmark)
+  endif()
+endif()
+
+# FlavBit
+if(EXISTS "${PROJECT_SOURCE_DIR}/FlavBit/")
+  add_gambit_test(multivariate_gaussian_benchmark BENCHMARK
+                  SOURCES FlavBit/tests/multivariate_gaussian_benchmark.cpp)
+  add_gambit_test(superiso_fill_benchmark BENCHMARK
+                  SOURCES FlavBit/tests/superiso_fill_benchmark.cpp
+                          FlavBit/src/SuperIso_parameters.cpp
+                  OBJECTS $<TARGET_OBJECTS:Models> $<TARGET_OBJECTS:Backends> $<TARGET_OBJECTS:Elements>)
+endif()
+
+# Printers
+if(EXISTS "${PROJECT_SOURCE_DIR}/Printers/" AND HDF5_FOUND)
+  add_gambit_test(hdf5_combine_test
+                  SOURCES Printers/tests/hdf5_combine_test.cpp
+                          Printers/src/printers/hdf5printer/hdf5_combine_tools.cpp
+                          Printers/src/printers/hdf5printer/hdf5tools.cpp
+                  LIBRARIES ${HDF5_LIBRARIES})
+  add_gambit_test(hdf5_reader_test
+                  SOURCES Printers/tests/hdf5_reader_test.cpp
+                          Printers/src/baseprinter.cpp
+                          Printers/src/printer_id_tools.cpp
+                          Printers/src/printers/hdf5printer/hdf5reader.cpp
+                          Printers/src/printers/hdf5printer/hdf5printer.cpp
+                          Printers/src/printers/hdf5printer/print_overloads.cpp
+                          Printers/src/printers/hdf5printer/retrieve_overloads.cpp
+                          Printers/src/printers/hdf5printer/hdf5_combine_tools.cpp
+                          Printers/src/printers/hdf5printer/hdf5tools.cpp
+                  LIBRARIES ${HDF5_LIBRARIES})
+endif()
+
+# ScannerBit
+if(EXISTS "${PROJECT_SOURCE_DIR}/ScannerBit/")
+  add_gambit_test(postprocessor_chunks_test
+                  SOURCES ScannerBit/tests/postprocessor_chunks_test.cpp
+                          ScannerBit/src/scanners/postprocessor_2.0.0/chunks.cpp
+                          ScannerBit/src/scanner_utils.cpp)
+endif()
+
+# Utils
+add_gambit_test(rng_benchmark BENCHMARK
+                SOURCES Utils/tests/rng_benchmark.cpp)
+add_gambit_test(rng_test
+                SOURCES Utils/tests/rng_test.cpp)
+
+# Backends
+add_gambit_test(backend_instances_test
+                SOURCES Backends/tests/backend_instances_test.cpp
+                LIBRARIES ${CMAKE_DL_LIBS}
+                ARGS $<TARGET_FILE:first>)
+add_dependencies(backend_instances_test first)
+
+# SpecBit
+if(EXISTS "${PROJECT_SOURCE_DIR}/SpecBit/" AND NOT EXCLUDE_FLEXIBLESUSY)
+  add_gambit_test(fs_two_scale_warm_start_test
+                  SOURCES SpecBit/tests/fs_two_scale_warm_start_test.cpp
+                  LIBRARIES ${flexiblesusy_LDFLAGS})
+  add_dependencies(fs_two_scale_warm_start_test flexiblesusy)
+  if(";${BUILD_FS_MODELS};" MATCHES ";CMSSM;")
+    add_gambit_test(fs_warm_start_test
+                    SOURCES SpecBit/tests/fs_warm_start_test.cpp
+                    LIBRARIES ${flexiblesusy_LDFLAGS})
+    add_dependencies(fs_warm_start_test flexiblesusy)
+    add_gambit_test(fs_options_benchmark BENCHMARK
+                    SOURCES SpecBit/tests/fs_options_benchmark.cpp
+                    LIBRARIES ${flexiblesusy_LDFLAGS})
+    add_dependencies(fs_options_benchmark flexiblesusy)
+  endif()
+endif()
+
+# Elements
+add_gambit_test(backend_call_cache_test
+                SOURCES Elements/tests/backend_call_cache_test.cpp
+                        Elements/src/backend_call_cache.cpp)
+add_gambit_test(functor_point_cache_test
+                SOURCES Elements/tests/functor_point_cache_test.cpp
+                        Core/src/error_handlers.cpp
+                        Core/src/functors_with_signals.cpp
+                OBJECTS $<TARGET_OBJECTS:Models> $<TARGET_OBJECTS:Backends> $<TARGET_OBJECTS:Elements>)
+add_gambit_test(decay_table_benchmark BENCHMARK
+                SOURCES Elements/tests/decay_table_benchmark.cpp)
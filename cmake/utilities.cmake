@@ -30,6 +30,10 @@
 #          (wh260@cam.ac.uk)
 #  \date 2018 Dec
 #
+#  \author agent
+#          (agent@local)
+#  \date 2026 Oct
+#
 #************************************************
 
 include(CMakeParseArguments)
@@ -418,6 +422,32 @@ function(add_standalone executablename)
 endfunction()
 
 
+# Function to add a unit test or benchmark.  These are built from their own sources plus the basic GAMBIT objects
+# and any other objects given, and are not part of 'all'.  Tests are also registered with CTest, to be run from
+# the GAMBIT root directory.
+function(add_gambit_test testname)
+  cmake_parse_arguments(ARG "BENCHMARK" "" "SOURCES;OBJECTS;LIBRARIES;ARGS" ${ARGN})
+
+  foreach(source_file ${ARG_SOURCES})
+    list(APPEND TEST_SOURCES ${PROJECT_SOURCE_DIR}/${source_file})
+  endforeach()
+
+  add_gambit_executable(${testname} "${ARG_LIBRARIES}"
+                        SOURCES ${TEST_SOURCES}
+                                ${ARG_OBJECTS}
+                                ${GAMBIT_BASIC_COMMON_OBJECTS})
+  set_target_properties(${testname} PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_BINARY_DIR}/tests")
+
+  if(ARG_BENCHMARK)
+    add_dependencies(benchmarks ${testname})
+  else()
+    add_dependencies(tests ${testname})
+    add_test(NAME ${testname} COMMAND ${testname} ${ARG_ARGS} WORKING_DIRECTORY ${PROJECT_SOURCE_DIR})
+  endif()
+
+endfunction()
+
+
 # Function to retrieve version number from git
 macro(get_version_from_git major minor revision patch full)
 